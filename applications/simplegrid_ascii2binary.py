@@ -0,0 +1,31 @@
+#!/usr/bin/env nemesis
+#
+# =================================================================================================
+# This code is part of SpatialData, developed through the Computational Infrastructure
+# for Geodynamics (https://github.com/geodynamics/spatialdata).
+#
+# Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+# All rights reserved.
+#
+# See https://mit-license.org/ and LICENSE.md and for license information. 
+# =================================================================================================
+# @file spatialdata/applications/simplegrid_ascii2binary.py
+#
+# @brief Convert SimpleGridDB files from ASCII format to binary format.
+
+# ----------------------------------------------------------------------
+if __name__ == '__main__':
+    import argparse
+    from spatialdata.spatialdb.spatialdb import SimpleGridBinary
+
+    parser = argparse.ArgumentParser(description="Convert SimpleGridDB file from ASCII format to binary format.")
+    parser.add_argument("--ascii", action="store", dest="ascii_filename", required=True,
+                        help="Name of input SimpleGridDB file in ASCII format.")
+    parser.add_argument("--binary", action="store", dest="binary_filename", required=True,
+                        help="Name of output SimpleGridDB file in binary format.")
+    args = parser.parse_args()
+
+    SimpleGridBinary.convertAscii(args.ascii_filename, args.binary_filename)
+
+
+# End of file
@@ -23,16 +23,130 @@ extern "C" {
 #include <cstring> // USES memcpy()
 #include <sstream> // USES std::ostringsgream
 #include <iostream> // USES std::istream, std::ostream
+#include <map> // USES std::map
 
 #include <strings.h> // USES strcasecmp()
 #include <stdexcept> // USES std::runtime_error, std::exception
 #include <assert.h> // USES assert()
 
+namespace spatialdata {
+    namespace geocoords {
+        namespace _csgeo {
+            /// Interned CRS string.
+            struct CRSInfo {
+                size_t id; ///< Identifier for CRS string.
+                int projType; ///< PROJ type (PJ_TYPE) of CRS.
+            };
+
+            /// Case-insensitive ordering of CRS strings.
+            struct CRSLess {
+                bool operator()(const std::string& a,
+                                const std::string& b) const {
+                    return strcasecmp(a.c_str(), b.c_str()) < 0;
+                }
+
+            }; // CRSLess
+
+            /// Process-wide table of interned CRS strings.
+            class CRSTable {
+public:
+
+                PJ_CONTEXT* context; ///< PROJ context for determining type of CRS.
+                std::map<std::string, CRSInfo, CRSLess> entries; ///< Interned CRS strings.
+
+                CRSTable(void) :
+                    context(proj_context_create()) {
+                    // Invalid CRS strings are reported when they are used in a conversion.
+                    proj_log_level(context, PJ_LOG_NONE);
+                }
+
+
+                ~CRSTable(void) {
+                    proj_context_destroy(context);context = NULL;
+                }
+
+                /** Get information for CRS string, interning the string if it has not been seen before.
+                 *
+                 * Identifiers are shared by all coordinate systems in the process, so coordinate systems
+                 * with CRS strings that differ only in case have identical identifiers. The PROJ type of
+                 * each CRS string is determined once, when the string is interned.
+                 *
+                 * @param[in] value CRS string.
+                 * @returns Information for CRS string (identifier is nonzero).
+                 */
+                static
+                CRSInfo intern(const std::string& value) {
+                    static CRSTable table;
+                    CRSInfo info;
+                    #pragma omp critical (spatialdata_geocoords_crsid)
+                    {
+                        const std::map<std::string, CRSInfo, CRSLess>::const_iterator iter = table.entries.find(value);
+                        if (iter != table.entries.end()) {
+                            info = iter->second;
+                        } else {
+                            PJ* const proj = proj_create(table.context, value.c_str());
+                            info.id = table.entries.size() + 1;
+                            info.projType = proj ? proj_get_type(proj) : PJ_TYPE_UNKNOWN;
+                            proj_destroy(proj);
+                            table.entries[value] = info;
+                        } // if/else
+                    } // omp critical
+                    return info;
+                } // intern
+
+            }; // CRSTable
+
+            /** Apply horizontal affine transformation to coordinates.
+             *
+             * @param[inout] coords Array of coordinates [numLocs*stride].
+             * @param[in] numLocs Number of locations.
+             * @param[in] stride Number of values per location.
+             * @param[in] matrix Transformation matrix (row major) [4].
+             * @param[in] shift Shift applied before transformation [2].
+             * @param[in] offset Offset applied after transformation [2].
+             */
+            inline
+            void transformHorizontal(double* coords,
+                                     const size_t numLocs,
+                                     const size_t stride,
+                                     const double matrix[4],
+                                     const double shift[2],
+                                     const double offset[2]) {
+                const double m00 = matrix[0], m01 = matrix[1], m10 = matrix[2], m11 = matrix[3];
+                const double shiftX = shift[0], shiftY = shift[1];
+                const double offsetX = offset[0], offsetY = offset[1];
+                for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+                    double* xy = &coords[iLoc*stride];
+                    const double x = xy[0] - shiftX;
+                    const double y = xy[1] - shiftY;
+                    xy[0] = offsetX + (m00 * x + m01 * y);
+                    xy[1] = offsetY + (m10 * x + m11 * y);
+                } // for
+            } // transformHorizontal
+
+            /** Get WGS84 geographic coordinate system used for surface normals.
+             *
+             * @returns WGS84 coordinate system.
+             */
+            const CSGeo& getWGS84(void) {
+                static const CSGeo csWGS84; // Default is EPSG:4326 with 3 dimensions.
+                return csWGS84;
+            } // getWGS84
+
+        } // _csgeo
+    } // geocoords
+} // spatialdata
+
 // ----------------------------------------------------------------------
 // Default constructor
 spatialdata::geocoords::CSGeo::CSGeo(void) :
     _string("EPSG:4326" /* WGS84 */),
+    _crsId(0),
+    _projType(PJ_TYPE_UNKNOWN),
     _converter(new spatialdata::geocoords::Converter) {
+    const _csgeo::CRSInfo info = _csgeo::CRSTable::intern(_string);
+    _crsId = info.id;
+    _projType = info.projType;
     setSpaceDim(3);
     setCSType(GEOGRAPHIC);
 } // constructor
@@ -58,6 +172,8 @@ spatialdata::geocoords::CSGeo::clone(void) const {
 spatialdata::geocoords::CSGeo::CSGeo(const CSGeo& cs) :
     CoordSys(cs),
     _string(cs._string),
+    _crsId(cs._crsId),
+    _projType(cs._projType),
     _converter(new spatialdata::geocoords::Converter) {}
 
 
@@ -66,6 +182,9 @@ spatialdata::geocoords::CSGeo::CSGeo(const CSGeo& cs) :
 void
 spatialdata::geocoords::CSGeo::setString(const char* value) {
     _string = value;
+    const _csgeo::CRSInfo info = _csgeo::CRSTable::intern(_string);
+    _crsId = info.id;
+    _projType = info.projType;
 } // setString
 
 
@@ -77,6 +196,14 @@ spatialdata::geocoords::CSGeo::getString(void) const {
 } // getString
 
 
+// ----------------------------------------------------------------------
+// Get identifier of string specifying coordinate system.
+size_t
+spatialdata::geocoords::CSGeo::getCRSId(void) const {
+    return _crsId;
+} // getCRSId
+
+
 // ----------------------------------------------------------------------
 // Set number of spatial dimensions in coordinate system.
 void
@@ -99,7 +226,8 @@ spatialdata::geocoords::CSGeo::computeSurfaceNormal(double* dir,
                                                     const double* coords,
                                                     const size_t numLocs,
                                                     const size_t numDims,
-                                                    const double dx) const {
+                                                    const double dx,
+                                                    Converter* converter) const {
     assert( (0 < numLocs && dir) || (0 == numLocs && !dir) );
     assert( (0 < numLocs && coords) || (0 == numLocs && !coords) );
 
@@ -113,9 +241,7 @@ spatialdata::geocoords::CSGeo::computeSurfaceNormal(double* dir,
     } // if
 
     if (numDims > 2) {
-        PJ* const proj = proj_create(PJ_DEFAULT_CTX, _string.c_str());
-        const PJ_TYPE projType = proj_get_type(proj);
-        proj_destroy(proj);
+        const PJ_TYPE projType = PJ_TYPE(_projType);
         switch (projType) {
         case PJ_TYPE_GEOGRAPHIC_2D_CRS:
         case PJ_TYPE_GEOGRAPHIC_3D_CRS:
@@ -130,12 +256,12 @@ spatialdata::geocoords::CSGeo::computeSurfaceNormal(double* dir,
             break;
         case PJ_TYPE_GEOCENTRIC_CRS: {
             // Surface normal is associated with geodetic lon/lat
-            CSGeo csLL;
-            csLL.setString("EPSG:4326"); // WGS84
+            const CSGeo& csLL = _csgeo::getWGS84();
             double* coordsLL = (numLocs*numDims > 0) ? new double[numLocs*numDims] : NULL;
             memcpy(coordsLL, coords, numLocs*numDims*sizeof(double));
-            assert(_converter);
-            _converter->convert(coordsLL, numLocs, numDims, &csLL, this);
+            Converter* llConverter = converter ? converter : _converter;
+            assert(llConverter);
+            llConverter->convert(coordsLL, numLocs, numDims, &csLL, this);
             for (size_t i = 0; i < numLocs; ++i) {
                 const double latRad = coordsLL[i*numDims+0] * M_PI/180.0;
                 const double lonRad = coordsLL[i*numDims+1] * M_PI/180.0;
@@ -183,6 +309,42 @@ spatialdata::geocoords::CSGeo::geographicToLocal(double* coords,
 }
 
 
+// ----------------------------------------------------------------------
+// Get horizontal affine transformation from local coordinates to geographic coordinates.
+void
+spatialdata::geocoords::CSGeo::getLocalTransform(double rotation[4],
+                                                 double origin[2]) const {
+    assert(rotation);
+    assert(origin);
+
+    rotation[0] = 1.0;rotation[1] = 0.0;
+    rotation[2] = 0.0;rotation[3] = 1.0;
+    origin[0] = 0.0;origin[1] = 0.0;
+} // getLocalTransform
+
+
+// ----------------------------------------------------------------------
+// Apply horizontal affine transformation to coordinates.
+void
+spatialdata::geocoords::CSGeo::transformHorizontal(double* coords,
+                                                   const size_t numLocs,
+                                                   const size_t numDims,
+                                                   const double matrix[4],
+                                                   const double shift[2],
+                                                   const double offset[2]) {
+    assert( (0 < numLocs && coords) || (0 == numLocs) );
+    assert(numDims >= 2);
+
+    if (2 == numDims) {
+        // Contiguous (x, y) pairs; a constant stride lets the compiler vectorize the loop.
+        _csgeo::transformHorizontal(coords, numLocs, 2, matrix, shift, offset);
+    } else {
+        // Vectorizing with larger strides requires gathers, which are slower than scalar code.
+        _csgeo::transformHorizontal(coords, numLocs, numDims, matrix, shift, offset);
+    } // if/else
+} // transformHorizontal
+
+
 // ----------------------------------------------------------------------
 // Pickle coordinate system to ascii stream.
 void
@@ -208,7 +370,7 @@ spatialdata::geocoords::CSGeo::unpickle(std::istream& s) {
     char cbuffer[maxBuffer];
 
     // Set parameters to empty values.
-    _string = "EPSG:4326"; // WGS84
+    setString("EPSG:4326"); // WGS84
     setSpaceDim(3);
 
     parser.ignore('{');
@@ -47,6 +47,16 @@ public:
      */
     const char* getString(void) const;
 
+    /** Get identifier of string specifying coordinate system.
+     *
+     * Coordinate systems with strings that differ only in case have
+     * identical identifiers, so comparing identifiers is a cheap way to
+     * check whether two coordinate systems use the same CRS.
+     *
+     * @returns Identifier of string specifying coordinate system.
+     */
+    size_t getCRSId(void) const;
+
     /** Set number of spatial dimensions in coordinate system.
      *
      * @param ndims Number of dimensions
@@ -64,12 +74,15 @@ public:
      * @param numLocs Number of locations.
      * @param numDims Number of dimensions in coordinates.
      * @param dx Length scale for approximate surface tangent.
+     * @param converter Converter to use instead of the coordinate system's own converter
+     *   (for example, from a query context).
      */
     void computeSurfaceNormal(double* dir,
                               const double* coords,
                               const size_t numLocs,
                               const size_t numDims,
-                              const double dx=1000.0) const;
+                              const double dx=1000.0,
+                              Converter* converter=NULL) const;
 
     /** Convert coordinates from local coordinate system to geographic coordinate system.
      *
@@ -93,6 +106,37 @@ public:
                            const size_t numLocs,
                            const size_t numDims) const;
 
+    /** Get horizontal affine transformation from local coordinates to geographic coordinates.
+     *
+     * geographic = origin + rotation * local for the first two components of each location.
+     *
+     * @param[out] rotation Rotation matrix (row major) [4].
+     * @param[out] origin Geographic coordinates of local origin [2].
+     */
+    virtual
+    void getLocalTransform(double rotation[4],
+                           double origin[2]) const;
+
+    /** Apply horizontal affine transformation to coordinates.
+     *
+     * x' = matrix * (x - shift) + offset for the first two components of each location.
+     * The loop for 2 spatial dimensions uses a fixed stride so it can be vectorized.
+     *
+     * @param[inout] coords Array of coordinates [numLocs*numDims].
+     * @param[in] numLocs Number of locations.
+     * @param[in] numDims Number of spatial dimensions in coordinates.
+     * @param[in] matrix Transformation matrix (row major) [4].
+     * @param[in] shift Shift applied before transformation [2].
+     * @param[in] offset Offset applied after transformation [2].
+     */
+    static
+    void transformHorizontal(double* coords,
+                             const size_t numLocs,
+                             const size_t numDims,
+                             const double matrix[4],
+                             const double shift[2],
+                             const double offset[2]);
+
     /** Pickle coordinate system to ascii stream.
      *
      * @param s Output stream
@@ -122,6 +166,8 @@ private:
     // PRIVATE MEMBERS ////////////////////////////////////////////////////
 
     std::string _string; ///< String specifying coordinate system.
+    size_t _crsId; ///< Interned identifier of string specifying coordinate system.
+    int _projType; ///< PROJ type (PJ_TYPE) of coordinate system.
     int _spaceDim; ///< Number of spatial dimensions in coordinate system
     spatialdata::geocoords::Converter* _converter; ///< Converter for coordinate transformations.
 
@@ -27,7 +27,9 @@
 spatialdata::geocoords::CSGeoLocal::CSGeoLocal(void) :
     _originX(0.0),
     _originY(0.0),
-    _yAzimuth(0.0) {}
+    _yAzimuth(0.0) {
+    _updateRotation();
+}
 
 
 // ----------------------------------------------------------------------
@@ -49,7 +51,9 @@ spatialdata::geocoords::CSGeoLocal::CSGeoLocal(const CSGeoLocal& cs) :
     CSGeo(cs),
     _originX(cs._originX),
     _originY(cs._originY),
-    _yAzimuth(cs._yAzimuth) {}
+    _yAzimuth(cs._yAzimuth) {
+    _updateRotation();
+}
 
 
 // ----------------------------------------------------------------------
@@ -61,6 +65,7 @@ spatialdata::geocoords::CSGeoLocal::setLocal(const double originX,
     _originX = originX;
     _originY = originY;
     _yAzimuth = yAzimuth;
+    _updateRotation();
 }
 
 
@@ -82,17 +87,9 @@ void
 spatialdata::geocoords::CSGeoLocal::localToGeographic(double* coords,
                                                       const size_t numLocs,
                                                       const size_t numDims) const {
-    const double yAzimuthR = _yAzimuth * M_PI / 180.0;
-    const double cosTheta = cos(yAzimuthR);
-    const double sinTheta = sin(yAzimuthR);
-    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
-        const double localX = coords[iLoc*numDims+0];
-        const double localY = coords[iLoc*numDims+1];
-        const double unrotX = cosTheta * localX + sinTheta * localY;
-        const double unrotY = -sinTheta * localX + cosTheta * localY;
-        coords[iLoc*numDims + 0] = _originX + unrotX;
-        coords[iLoc*numDims + 1] = _originY + unrotY;
-    } // for
+    const double noShift[2] = { 0.0, 0.0 };
+    const double origin[2] = { _originX, _originY };
+    transformHorizontal(coords, numLocs, numDims, _rotation, noShift, origin);
 }
 
 
@@ -102,18 +99,30 @@ void
 spatialdata::geocoords::CSGeoLocal::geographicToLocal(double* coords,
                                                       const size_t numLocs,
                                                       const size_t numDims) const {
-    const double yAzimuthR = _yAzimuth * M_PI / 180.0;
-    const double cosTheta = cos(yAzimuthR);
-    const double sinTheta = sin(yAzimuthR);
-    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
-        const double unrotX = coords[iLoc*numDims + 0] - _originX;
-        const double unrotY = coords[iLoc*numDims + 1] - _originY;
-        coords[iLoc*numDims + 0] = cosTheta * unrotX - sinTheta * unrotY;
-        coords[iLoc*numDims + 1] = sinTheta * unrotX + cosTheta * unrotY;
-    } // for
+    // Inverse of rotation is its transpose.
+    const double inverse[4] = { _rotation[0], _rotation[2], _rotation[1], _rotation[3] };
+    const double origin[2] = { _originX, _originY };
+    const double noOffset[2] = { 0.0, 0.0 };
+    transformHorizontal(coords, numLocs, numDims, inverse, origin, noOffset);
 }
 
 
+// ----------------------------------------------------------------------
+// Get horizontal affine transformation from local coordinates to geographic coordinates.
+void
+spatialdata::geocoords::CSGeoLocal::getLocalTransform(double rotation[4],
+                                                      double origin[2]) const {
+    assert(rotation);
+    assert(origin);
+
+    for (size_t i = 0; i < 4; ++i) {
+        rotation[i] = _rotation[i];
+    } // for
+    origin[0] = _originX;
+    origin[1] = _originY;
+} // getLocalTransform
+
+
 // ----------------------------------------------------------------------
 // Pickle coordinate system to ascii stream.
 void
@@ -178,7 +187,20 @@ spatialdata::geocoords::CSGeoLocal::unpickle(std::istream& s) {
     if (token != "}") {
         throw std::runtime_error("I/O error while parsing CSGeoLocal settings.");
     }
+    _updateRotation();
 } // unpickle
 
 
+// ----------------------------------------------------------------------
+// Update rotation matrix from azimuth of y axis.
+void
+spatialdata::geocoords::CSGeoLocal::_updateRotation(void) {
+    const double yAzimuthR = _yAzimuth * M_PI / 180.0;
+    const double cosTheta = cos(yAzimuthR);
+    const double sinTheta = sin(yAzimuthR);
+    _rotation[0] = +cosTheta;_rotation[1] = sinTheta;
+    _rotation[2] = -sinTheta;_rotation[3] = cosTheta;
+} // _updateRotation
+
+
 // End of file
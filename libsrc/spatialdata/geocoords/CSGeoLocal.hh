@@ -75,6 +75,14 @@ public:
                            const size_t numLocs,
                            const size_t numDims) const override;
 
+    /** Get horizontal affine transformation from local coordinates to geographic coordinates.
+     *
+     * @param[out] rotation Rotation matrix (row major) [4].
+     * @param[out] origin Geographic coordinates of local origin [2].
+     */
+    void getLocalTransform(double rotation[4],
+                           double origin[2]) const override;
+
     /** Pickle coordinate system to ascii stream.
      *
      * @param s Output stream
@@ -99,11 +107,17 @@ protected:
 
 private:
 
+    // PRIVATE METHODS ////////////////////////////////////////////////////
+
+    /// Update rotation matrix from azimuth of y axis.
+    void _updateRotation(void);
+
     // PRIVATE MEMBERS ////////////////////////////////////////////////////
 
     double _originX; ///< X coordinate of local origin.
     double _originY; ///< Y coordinate of local origin.
     double _yAzimuth; ///< Azimuth (degrees) of y axis.
+    double _rotation[4]; ///< Rotation matrix (row major) from local to geographic coordinates.
 
 }; // class CSGeoLocal
 
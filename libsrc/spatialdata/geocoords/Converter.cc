@@ -21,34 +21,268 @@ extern "C" {
 }
 
 #include <cmath> // USES HUGE_VAL
-#include <strings.h> // USES strcasecmp()
+#include <list> // USES std::list
+#include <map> // USES std::map
+#include <string> // USES std::string
+#include <chrono> // USES std::chrono
 #include <stdexcept> // USES std::runtime_error, std::exception
 #include <sstream> // USES std::ostringsgream
+#include <vector> // USES std::vector
+#include <exception> // USES std::exception_ptr
+#include <algorithm> // USES std::min(), std::max()
 #include <cassert> // USES assert()
 
+#if defined(_OPENMP)
+#include <omp.h> // USES omp_get_max_threads(), omp_get_thread_num()
+#endif
+
 namespace spatialdata {
     namespace geocoords {
         namespace _converter {
+            typedef std::pair<size_t, size_t> key_type;
+
+            /** Process-wide PROJ transformations keyed by source and destination CRS identifiers.
+             *
+             * Creating a transformation involves PROJ database lookups, so each transformation is
+             * created once in a shared PROJ context and cloned into the context of each converter
+             * that needs it. The shared context is only used within the critical section.
+             */
+            class SharedTransforms {
+public:
+
+                PJ_CONTEXT* context; ///< PROJ context for shared transformations.
+                std::map<key_type, PJ*> transforms; ///< Shared transformations.
+
+                SharedTransforms(void) :
+                    context(proj_context_create()) {}
+
+
+                ~SharedTransforms(void) {
+                    for (std::map<key_type, PJ*>::iterator iter = transforms.begin(); iter != transforms.end(); ++iter) {
+                        proj_destroy(iter->second);iter->second = NULL;
+                    } // for
+                    proj_context_destroy(context);context = NULL;
+                }
+
+                /** Get process-wide shared transformations.
+                 *
+                 * @returns Shared transformations.
+                 */
+                static
+                SharedTransforms& instance(void) {
+                    static SharedTransforms shared;
+                    return shared;
+                }
+
+                /** Create transformation in PROJ context by cloning shared transformation.
+                 *
+                 * @param[in] ctx PROJ context for new transformation.
+                 * @param[in] csSrc Source coordinate system.
+                 * @param[in] csDest Destination coordinate system.
+                 * @param[out] errorCode PROJ error number from the context in which creating the
+                 *   transformation failed.
+                 * @returns PROJ transformation in context (NULL on error).
+                 */
+                PJ* clone(PJ_CONTEXT* ctx,
+                          const CSGeo* csSrc,
+                          const CSGeo* csDest,
+                          int* errorCode) {
+                    assert(csSrc);
+                    assert(csDest);
+                    assert(errorCode);
+
+                    const key_type key(csSrc->getCRSId(), csDest->getCRSId());
+                    PJ* proj = NULL;
+                    bool haveShared = false;
+                    #pragma omp critical (spatialdata_geocoords_proj)
+                    {
+                        const std::map<key_type, PJ*>::const_iterator iter = transforms.find(key);
+                        PJ* shared = (iter != transforms.end()) ? iter->second : NULL;
+                        if (!shared) {
+                            shared = proj_create_crs_to_crs(context, csSrc->getString(), csDest->getString(), NULL);
+                            if (shared) {
+                                transforms[key] = shared;
+                            } else {
+                                *errorCode = proj_context_errno(context);
+                            } // if/else
+                        } // if
+                        if (shared) {
+                            haveShared = true;
+                            proj = proj_clone(ctx, shared);
+                        } // if
+                    } // omp critical
+                    if (!haveShared) {
+                        return NULL;
+                    } // if
+
+                    // Older versions of PROJ cannot clone transformations with alternative operations.
+                    if (!proj) {
+                        proj = proj_create_crs_to_crs(ctx, csSrc->getString(), csDest->getString(), NULL);
+                        if (!proj) {
+                            *errorCode = proj_context_errno(ctx);
+                        } // if
+                    } // if
+                    return proj;
+                }
+
+            }; // SharedTransforms
+
+            /// Least recently used cache of PROJ transformations keyed by source and destination CRS identifiers.
             class Cache {
 public:
 
-                std::string csDest;
-                std::string csSrc;
-                PJ* proj;
+                /// Cached transformation.
+                struct Entry {
+                    key_type key; ///< Source and destination CRS identifiers.
+                    PJ* proj; ///< PROJ transformation.
+                };
+
+                PJ_CONTEXT* context; ///< PROJ context for transformations (created when first needed).
+                std::list<Entry> entries; ///< Transformations, most recently used first.
+                std::map<key_type, std::list<Entry>::iterator> index; ///< Lookup of transformations by key.
+                size_t maxSize; ///< Maximum number of transformations.
+                size_t numHits; ///< Number of lookups that found a transformation.
+                size_t numMisses; ///< Number of lookups that created a transformation.
+                double creationTime; ///< Time (seconds) spent creating transformations.
 
                 Cache(void) :
-                    csDest(""),
-                    csSrc(""),
-                    proj(NULL) {}
+                    context(NULL),
+                    maxSize(8),
+                    numHits(0),
+                    numMisses(0),
+                    creationTime(0.0) {}
 
 
                 ~Cache(void) {
-                    csDest = "";
-                    csSrc = "";
-                    proj_destroy(proj);proj = NULL;
+                    clear();
+                    if (context) {
+                        proj_context_destroy(context);context = NULL;
+                    } // if
+                }
+
+                /// Destroy all transformations.
+                void clear(void) {
+                    for (std::list<Entry>::iterator iter = entries.begin(); iter != entries.end(); ++iter) {
+                        proj_destroy(iter->proj);iter->proj = NULL;
+                    } // for
+                    entries.clear();
+                    index.clear();
+                }
+
+                /// Destroy least recently used transformations until cache holds at most maxSize entries.
+                void trim(void) {
+                    while (entries.size() > maxSize) {
+                        Entry& entry = entries.back();
+                        index.erase(entry.key);
+                        proj_destroy(entry.proj);entry.proj = NULL;
+                        entries.pop_back();
+                    } // while
+                }
+
+                /** Get transformation, creating it if it is not in the cache.
+                 *
+                 * @param[in] csSrc Source coordinate system.
+                 * @param[in] csDest Destination coordinate system.
+                 * @returns PROJ transformation.
+                 */
+                PJ* get(const CSGeo* csSrc,
+                        const CSGeo* csDest) {
+                    assert(csSrc);
+                    assert(csDest);
+
+                    // CRS identifiers ignore case, so keys of CRS strings that differ only in case match.
+                    const key_type key(csSrc->getCRSId(), csDest->getCRSId());
+                    // Most queries reuse the transformation from the previous conversion.
+                    if (!entries.empty() && (entries.front().key == key)) {
+                        ++numHits;
+                        return entries.front().proj;
+                    } // if
+
+                    const std::map<key_type, std::list<Entry>::iterator>::iterator iter = index.find(key);
+                    if (iter != index.end()) {
+                        ++numHits;
+                        entries.splice(entries.begin(), entries, iter->second);
+                        return iter->second->proj;
+                    } // if
+
+                    ++numMisses;
+                    if (!context) {
+                        context = proj_context_create();
+                    } // if
+                    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                    int errorCode = 0;
+                    PJ* proj = SharedTransforms::instance().clone(context, csSrc, csDest, &errorCode);
+                    creationTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                    if (!proj) {
+                        std::stringstream msg;
+                        msg << "Error creating projection from '" << csSrc->getString() << "' to '" << csDest->getString() << "'.\n";
+                        const char* errorString = proj_errno_string(errorCode);
+                        if (errorString) {
+                            msg << errorString;
+                        } // if
+                        throw std::runtime_error(msg.str());
+                    } // if
+
+                    Entry entry;
+                    entry.key = key;
+                    entry.proj = proj;
+                    entries.push_front(entry);
+                    index[key] = entries.begin();
+                    trim();
+
+                    return proj;
                 }
 
             }; // Cache
+
+            /// Minimum number of locations converted by each thread in parallel conversion.
+            const size_t minChunkSize = 16384;
+
+            /** Convert coordinates using PROJ transformation.
+             *
+             * @param[in] proj PROJ transformation from source to destination CRS.
+             * @param[inout] coords Array of coordinates.
+             * @param[in] numLocs Number of locations.
+             * @param[in] numDims Number of spatial dimensions in coordinates.
+             * @param[in] csDest Destination coordinate system.
+             * @param[in] csSrc Source coordinate system.
+             */
+            void transform(PJ* proj,
+                           double* coords,
+                           const size_t numLocs,
+                           const size_t numDims,
+                           const CSGeo* csDest,
+                           const CSGeo* csSrc) {
+                assert(proj);
+                assert(csDest);
+                assert(csSrc);
+
+                double* const x = (numDims >= 2) ? coords + 0 : NULL;
+                double* const y = (numDims >= 2) ? coords + 1 : NULL;
+                double* const z = (numDims >= 3) ? coords + 2 : NULL;
+                const size_t stride = numDims * sizeof(double);
+
+                csSrc->localToGeographic(coords, numLocs, numDims);
+
+                // Transformation belongs to the PROJ context of its cache, so transformations from
+                // different caches can convert coordinates concurrently.
+                double t = HUGE_VAL;
+                const size_t numSuccessful =
+                    proj_trans_generic(proj, PJ_FWD,
+                                       x, stride, numLocs,
+                                       y, stride, numLocs,
+                                       z, stride, numLocs,
+                                       &t, 0, numLocs);
+                if (numSuccessful < numLocs) {
+                    std::ostringstream msg;
+                    msg << "Error while converting coordinates:\n"
+                        << "  " << proj_errno_string(proj_errno(proj));
+                    throw std::runtime_error(msg.str());
+                } // if
+
+                csDest->geographicToLocal(coords, numLocs, numDims);
+            } // transform
+
         } // _converter
     } // geocoords
 } // spatialdata
@@ -56,16 +290,117 @@ public:
 // ----------------------------------------------------------------------
 // Default constructor
 spatialdata::geocoords::Converter::Converter(void) :
-    _cache(new _converter::Cache) {}
+    _cache(new _converter::Cache),
+    _numThreads(1) {}
 
 
 // ----------------------------------------------------------------------
 // Default destructor
 spatialdata::geocoords::Converter::~Converter(void) {
     delete _cache;_cache = NULL;
+    for (size_t i = 0; i < _workerCaches.size(); ++i) {
+        delete _workerCaches[i];_workerCaches[i] = NULL;
+    } // for
 } // destructor
 
 
+// ----------------------------------------------------------------------
+// Set number of threads used to convert large arrays of coordinates.
+void
+spatialdata::geocoords::Converter::setNumThreads(const size_t value) {
+    _numThreads = value;
+} // setNumThreads
+
+
+// ----------------------------------------------------------------------
+// Get number of threads used to convert large arrays of coordinates.
+size_t
+spatialdata::geocoords::Converter::getNumThreads(void) const {
+    return _numThreads;
+} // getNumThreads
+
+
+// ----------------------------------------------------------------------
+// Set maximum number of PROJ transformations kept in cache.
+void
+spatialdata::geocoords::Converter::setCacheSize(const size_t value) {
+    if (0 == value) {
+        throw std::invalid_argument("Size of PROJ transformation cache must be positive.");
+    } // if
+    assert(_cache);
+    _cache->maxSize = value;
+    _cache->trim();
+    for (size_t i = 0; i < _workerCaches.size(); ++i) {
+        _workerCaches[i]->maxSize = value;
+        _workerCaches[i]->trim();
+    } // for
+} // setCacheSize
+
+
+// ----------------------------------------------------------------------
+// Get maximum number of PROJ transformations kept in cache.
+size_t
+spatialdata::geocoords::Converter::getCacheSize(void) const {
+    assert(_cache);
+    return _cache->maxSize;
+} // getCacheSize
+
+
+// ----------------------------------------------------------------------
+// Get number of conversions that used a cached PROJ transformation.
+size_t
+spatialdata::geocoords::Converter::getNumCacheHits(void) const {
+    assert(_cache);
+    size_t value = _cache->numHits;
+    for (size_t i = 0; i < _workerCaches.size(); ++i) {
+        value += _workerCaches[i]->numHits;
+    } // for
+    return value;
+} // getNumCacheHits
+
+
+// ----------------------------------------------------------------------
+// Get number of conversions that created a PROJ transformation.
+size_t
+spatialdata::geocoords::Converter::getNumCacheMisses(void) const {
+    assert(_cache);
+    size_t value = _cache->numMisses;
+    for (size_t i = 0; i < _workerCaches.size(); ++i) {
+        value += _workerCaches[i]->numMisses;
+    } // for
+    return value;
+} // getNumCacheMisses
+
+
+// ----------------------------------------------------------------------
+// Get total time spent creating PROJ transformations.
+double
+spatialdata::geocoords::Converter::getProjCreationTime(void) const {
+    assert(_cache);
+    double value = _cache->creationTime;
+    for (size_t i = 0; i < _workerCaches.size(); ++i) {
+        value += _workerCaches[i]->creationTime;
+    } // for
+    return value;
+} // getProjCreationTime
+
+
+// ----------------------------------------------------------------------
+// Reset cache hit, miss, and PROJ creation time counters.
+void
+spatialdata::geocoords::Converter::resetCacheStats(void) {
+    assert(_cache);
+    _cache->numHits = 0;
+    _cache->numMisses = 0;
+    _cache->creationTime = 0.0;
+    for (size_t i = 0; i < _workerCaches.size(); ++i) {
+        _workerCaches[i]->numHits = 0;
+        _workerCaches[i]->numMisses = 0;
+        _workerCaches[i]->creationTime = 0.0;
+    } // for
+} // resetCacheStats
+
+
 // ----------------------------------------------------------------------
 // Convert coordinates from source coordinate system to destination
 // coordinate system.
@@ -80,6 +415,9 @@ spatialdata::geocoords::Converter::convert(double* coords,
     assert(csDest);
     assert(csSrc);
 
+    if (csSrc == csDest) {
+        return;
+    } // if
     if (csSrc->getCSType() != csDest->getCSType()) {
         throw std::invalid_argument("Cannot convert between coordinate systems of different types.");
     } // if
@@ -127,45 +465,79 @@ spatialdata::geocoords::Converter::_convert(double* coords,
     assert( (0 < numLocs && 0 != coords) ||
             (0 == numLocs && 0 == coords));
 
-    double* const x = (numDims >= 2) ? coords + 0 : NULL;
-    double* const y = (numDims >= 2) ? coords + 1 : NULL;
-    double* const z = (numDims >= 3) ? coords + 2 : NULL;
-    const size_t stride = numDims * sizeof(double);
-
-    bool needsNewProj = false;
-    assert(_cache);
-    if ((0 == _cache->csSrc.length()) || (0 != strcasecmp(_cache->csSrc.c_str(), csSrc->getString()))) { needsNewProj = true; }
-    if ((0 == _cache->csDest.length()) || (0 != strcasecmp(_cache->csDest.c_str(), csDest->getString()))) { needsNewProj = true; }
-    if (needsNewProj) {
-        proj_destroy(_cache->proj);
-        _cache->proj = proj_create_crs_to_crs(PJ_DEFAULT_CTX, csSrc->getString(), csDest->getString(), NULL);
-        if (!_cache->proj) {
-            std::stringstream msg;
-            msg << "Error creating projection from '" << csSrc->getString() << "' to '" << csDest->getString() << "'.\n"
-                << proj_errno_string(proj_errno(_cache->proj));
-            throw std::runtime_error(msg.str());
+    if (csSrc->getCRSId() == csDest->getCRSId()) {
+        // Same CRS, so only the local transformations (if any) can differ. Combine them into a
+        // single pass: dest = inv(rotDest) * (rotSrc * src + originSrc - originDest).
+        double rotSrc[4], originSrc[2];
+        double rotDest[4], originDest[2];
+        csSrc->getLocalTransform(rotSrc, originSrc);
+        csDest->getLocalTransform(rotDest, originDest);
+        const double invDest[4] = { rotDest[0], rotDest[2], rotDest[1], rotDest[3] };
+        const double matrix[4] = {
+            invDest[0]*rotSrc[0] + invDest[1]*rotSrc[2], invDest[0]*rotSrc[1] + invDest[1]*rotSrc[3],
+            invDest[2]*rotSrc[0] + invDest[3]*rotSrc[2], invDest[2]*rotSrc[1] + invDest[3]*rotSrc[3],
+        };
+        const double dx = originSrc[0] - originDest[0];
+        const double dy = originSrc[1] - originDest[1];
+        const double offset[2] = {
+            invDest[0]*dx + invDest[1]*dy,
+            invDest[2]*dx + invDest[3]*dy,
+        };
+        const bool isIdentity = (1.0 == matrix[0]) && (0.0 == matrix[1]) && (0.0 == matrix[2]) && (1.0 == matrix[3])
+                                && (0.0 == offset[0]) && (0.0 == offset[1]);
+        if (!isIdentity) {
+            const double noShift[2] = { 0.0, 0.0 };
+            CSGeo::transformHorizontal(coords, numLocs, numDims, matrix, noShift, offset);
         } // if
-        _cache->csSrc = csSrc->getString();
-        _cache->csDest = csDest->getString();
+        return;
     } // if
 
-    csSrc->localToGeographic(coords, numLocs, numDims);
+#if defined(_OPENMP)
+    const size_t maxThreads = (_numThreads > 0) ? _numThreads : size_t(omp_get_max_threads());
+    const size_t numThreads = std::min(maxThreads, numLocs / _converter::minChunkSize);
+    if (numThreads >= 2) {
+        // Get transformations for each thread before parallel region, so errors are reported as in
+        // serial conversion.
+        while (_workerCaches.size() < numThreads) {
+            _converter::Cache* cache = new _converter::Cache;
+            cache->maxSize = _cache->maxSize;
+            _workerCaches.push_back(cache);
+        } // while
+        std::vector<PJ*> projs(numThreads, NULL);
+        for (size_t iThread = 0; iThread < numThreads; ++iThread) {
+            projs[iThread] = _workerCaches[iThread]->get(csSrc, csDest);
+        } // for
 
-    double t = HUGE_VAL;
-    const size_t numSuccessful =
-        proj_trans_generic(_cache->proj, PJ_FWD,
-                           x, stride, numLocs,
-                           y, stride, numLocs,
-                           z, stride, numLocs,
-                           &t, 0, numLocs);
-    if (numSuccessful < numLocs) {
-        std::ostringstream msg;
-        msg << "Error while converting coordinates:\n"
-            << "  " << proj_errno_string(proj_errno(_cache->proj));
-        throw std::runtime_error(msg.str());
+        // Use several chunks per thread for load balancing; results do not depend on assignment of chunks.
+        const size_t chunkSize = std::max(_converter::minChunkSize, numLocs / (4*numThreads));
+        const size_t numChunks = (numLocs + chunkSize - 1) / chunkSize;
+        std::vector<std::exception_ptr> errors(numChunks);
+
+        #pragma omp parallel for num_threads(numThreads) schedule(dynamic)
+        for (long iChunk = 0; iChunk < long(numChunks); ++iChunk) {
+            const size_t iStart = iChunk * chunkSize;
+            const size_t chunkLocs = std::min(chunkSize, numLocs - iStart);
+            try {
+                _converter::transform(projs[omp_get_thread_num()], &coords[iStart*numDims], chunkLocs, numDims,
+                                      csDest, csSrc);
+            } catch (...) {
+                errors[iChunk] = std::current_exception();
+            } // try/catch
+        } // for
+
+        // Report first error, as in serial conversion.
+        for (size_t iChunk = 0; iChunk < numChunks; ++iChunk) {
+            if (errors[iChunk]) {
+                std::rethrow_exception(errors[iChunk]);
+            } // if
+        } // for
+        return;
     } // if
+#endif
 
-    csDest->geographicToLocal(coords, numLocs, numDims);
+    assert(_cache);
+    PJ* proj = _cache->get(csSrc, csDest);
+    _converter::transform(proj, coords, numLocs, numDims, csDest, csSrc);
 
 } // convert
 
@@ -184,9 +556,12 @@ spatialdata::geocoords::Converter::_convert(double* coords,
     assert( (0 < numLocs && 0 != coords) ||
             (0 == numLocs && 0 == coords));
 
-    const int size = numLocs*numDims;
     const double scale = csSrc->getToMeters() / csDest->getToMeters();
-    for (int i = 0; i < size; ++i) {
+    if (1.0 == scale) {
+        return;
+    } // if
+    const size_t size = numLocs*numDims;
+    for (size_t i = 0; i < size; ++i) {
         coords[i] *= scale;
     } // for
 } // convert
@@ -12,6 +12,7 @@
 #include "geocoordsfwd.hh"
 
 #include <cstddef> // USES size_t
+#include <vector> // HASA std::vector
 
 namespace spatialdata {
     namespace geocoords {
@@ -49,6 +50,61 @@ public:
                  const CoordSys* csDest,
                  const CoordSys* csSrc);
 
+    /** Set number of threads used to convert large arrays of coordinates.
+     *
+     * Geographic coordinates are divided into chunks, and each thread
+     * converts its chunks with its own PROJ context and copy of the
+     * transformation. The converted coordinates are identical to those
+     * from serial conversion. Arrays with fewer than 16384 locations per
+     * thread use fewer threads. The number of threads is ignored if
+     * spatialdata was not built with OpenMP.
+     *
+     * @param[in] value Number of threads (0 for OpenMP default, 1 for serial conversion).
+     */
+    void setNumThreads(const size_t value);
+
+    /** Get number of threads used to convert large arrays of coordinates.
+     *
+     * @returns Number of threads (0 for OpenMP default, 1 for serial conversion).
+     */
+    size_t getNumThreads(void) const;
+
+    /** Set maximum number of PROJ transformations kept in cache.
+     *
+     * When the cache is full, the least recently used transformation is
+     * destroyed to make room for a new one.
+     *
+     * @param[in] value Maximum number of transformations (must be positive).
+     */
+    void setCacheSize(const size_t value);
+
+    /** Get maximum number of PROJ transformations kept in cache.
+     *
+     * @returns Maximum number of transformations.
+     */
+    size_t getCacheSize(void) const;
+
+    /** Get number of conversions that used a cached PROJ transformation.
+     *
+     * @returns Number of cache hits.
+     */
+    size_t getNumCacheHits(void) const;
+
+    /** Get number of conversions that created a PROJ transformation.
+     *
+     * @returns Number of cache misses.
+     */
+    size_t getNumCacheMisses(void) const;
+
+    /** Get total time spent creating PROJ transformations.
+     *
+     * @returns Time in seconds.
+     */
+    double getProjCreationTime(void) const;
+
+    /// Reset cache hit, miss, and PROJ creation time counters.
+    void resetCacheStats(void);
+
 private:
 
     // PRIVATE METHODS ////////////////////////////////////////////////////
@@ -87,7 +143,9 @@ private:
 
     // PRIVATE MEMBERS ////////////////////////////////////////////////////
 
-    _converter::Cache* _cache;
+    _converter::Cache* _cache; ///< Transformations used in serial conversion.
+    std::vector<_converter::Cache*> _workerCaches; ///< Transformations used by each thread in parallel conversion.
+    size_t _numThreads; ///< Number of threads used in parallel conversion.
 
 }; // class Converter
 
@@ -81,6 +81,7 @@ namespace mu
 	};
 
 	const int ParserBase::s_MaxNumOpenMPThreads = 16;
+	const int ParserBase::s_BlockSize = 256;
 
 	//------------------------------------------------------------------------------
 	/** \brief Constructor.
@@ -104,6 +105,7 @@ namespace mu
 		, m_sOprtChars()
 		, m_sInfixOprtChars()
 		, m_vStackBuffer()
+		, m_vBlockStackBuffer()
 		, m_nFinalResultIdx(0)
 	{
 		InitTokenReader();
@@ -1256,6 +1258,132 @@ namespace mu
 		return stack[m_nFinalResultIdx];
 	}
 
+	//---------------------------------------------------------------------------
+	/** \brief Evaluate the RPN for a block of values.
+
+		Each token is applied to all values in the block before moving on to the
+		next token, so the inner loops operate on contiguous arrays and can be
+		vectorized by the compiler. The stack holds one column of s_BlockSize
+		values per stack position. Since the operations are the same as in
+		ParseCmdCodeBulk() and are applied in the same order, the results are
+		identical.
+
+		Requires bytecode for which ParserByteCode::IsBlockEvaluable() is true.
+
+		\param results Array receiving the results.
+		\param nOffset The offset added to variable addresses.
+		\param nBlockSize Number of values to evaluate (at most s_BlockSize).
+	*/
+	void ParserBase::ParseCmdCodeBlock(value_type* results, int nOffset, int nBlockSize) const
+	{
+		assert(m_vRPN.IsBlockEvaluable());
+		assert(nBlockSize <= s_BlockSize);
+
+		const std::size_t nStackSize = m_vRPN.GetMaxStackSize() * s_BlockSize;
+		if (m_vBlockStackBuffer.size() < nStackSize)
+			m_vBlockStackBuffer.resize(nStackSize);
+
+		value_type* stack = &m_vBlockStackBuffer[0];
+		const int n = nBlockSize;
+		int sidx(0);
+		for (const SToken* pTok = m_vRPN.GetBase(); pTok->Cmd != cmEND; ++pTok)
+		{
+			value_type* a = nullptr;
+			const value_type* b = nullptr;
+			const value_type* c = nullptr;
+			const value_type* v = nullptr;
+			switch (pTok->Cmd)
+			{
+			// built in binary operators
+			case  cmLE:   --sidx; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize; for (int i = 0; i < n; ++i) a[i] = a[i] <= b[i]; continue;
+			case  cmGE:   --sidx; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize; for (int i = 0; i < n; ++i) a[i] = a[i] >= b[i]; continue;
+			case  cmNEQ:  --sidx; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize; for (int i = 0; i < n; ++i) a[i] = a[i] != b[i]; continue;
+			case  cmEQ:   --sidx; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize; for (int i = 0; i < n; ++i) a[i] = a[i] == b[i]; continue;
+			case  cmLT:   --sidx; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize; for (int i = 0; i < n; ++i) a[i] = a[i] < b[i];  continue;
+			case  cmGT:   --sidx; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize; for (int i = 0; i < n; ++i) a[i] = a[i] > b[i];  continue;
+			case  cmADD:  --sidx; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize; for (int i = 0; i < n; ++i) a[i] += b[i]; continue;
+			case  cmSUB:  --sidx; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize; for (int i = 0; i < n; ++i) a[i] -= b[i]; continue;
+			case  cmMUL:  --sidx; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize; for (int i = 0; i < n; ++i) a[i] *= b[i]; continue;
+			case  cmDIV:  --sidx; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize; for (int i = 0; i < n; ++i) a[i] /= b[i]; continue;
+
+			case  cmPOW:
+				--sidx; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize;
+				for (int i = 0; i < n; ++i) a[i] = MathImpl<value_type>::Pow(a[i], b[i]);
+				continue;
+
+			case  cmLAND: --sidx; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize; for (int i = 0; i < n; ++i) a[i] = a[i] && b[i]; continue;
+			case  cmLOR:  --sidx; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize; for (int i = 0; i < n; ++i) a[i] = a[i] || b[i]; continue;
+
+				// value and variable tokens
+			case  cmVAR:
+				a = &stack[++sidx * s_BlockSize]; v = pTok->Val.ptr + nOffset;
+				for (int i = 0; i < n; ++i) a[i] = v[i];
+				continue;
+
+			case  cmVAL:
+				a = &stack[++sidx * s_BlockSize];
+				for (int i = 0; i < n; ++i) a[i] = pTok->Val.data2;
+				continue;
+
+			case  cmVARPOW2:
+				a = &stack[++sidx * s_BlockSize]; v = pTok->Val.ptr + nOffset;
+				for (int i = 0; i < n; ++i) a[i] = v[i] * v[i];
+				continue;
+
+			case  cmVARPOW3:
+				a = &stack[++sidx * s_BlockSize]; v = pTok->Val.ptr + nOffset;
+				for (int i = 0; i < n; ++i) a[i] = v[i] * v[i] * v[i];
+				continue;
+
+			case  cmVARPOW4:
+				a = &stack[++sidx * s_BlockSize]; v = pTok->Val.ptr + nOffset;
+				for (int i = 0; i < n; ++i) a[i] = v[i] * v[i] * v[i] * v[i];
+				continue;
+
+			case  cmVARMUL:
+				a = &stack[++sidx * s_BlockSize]; v = pTok->Val.ptr + nOffset;
+				for (int i = 0; i < n; ++i) a[i] = v[i] * pTok->Val.data + pTok->Val.data2;
+				continue;
+
+				// Next is treatment of numeric functions
+			case  cmFUNC:
+				switch (pTok->Fun.argc)
+				{
+				case 0:
+					a = &stack[++sidx * s_BlockSize];
+					for (int i = 0; i < n; ++i) a[i] = pTok->Fun.cb.call_fun<0>();
+					continue;
+
+				case 1:
+					a = &stack[sidx * s_BlockSize];
+					for (int i = 0; i < n; ++i) a[i] = pTok->Fun.cb.call_fun<1>(a[i]);
+					continue;
+
+				case 2:
+					sidx -= 1; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize;
+					for (int i = 0; i < n; ++i) a[i] = pTok->Fun.cb.call_fun<2>(a[i], b[i]);
+					continue;
+
+				case 3:
+					sidx -= 2; a = &stack[sidx * s_BlockSize]; b = a + s_BlockSize; c = b + s_BlockSize;
+					for (int i = 0; i < n; ++i) a[i] = pTok->Fun.cb.call_fun<3>(a[i], b[i], c[i]);
+					continue;
+
+				default:
+					Error(ecINTERNAL_ERROR, -1);
+				}
+				continue;
+
+			default:
+				Error(ecINTERNAL_ERROR, -1);
+			}
+		}
+
+		const value_type* result = &stack[m_nFinalResultIdx * s_BlockSize];
+		for (int i = 0; i < n; ++i)
+			results[i] = result[i];
+	}
+
 	//---------------------------------------------------------------------------
 	void ParserBase::CreateRPN() const
 	{
@@ -1858,7 +1986,21 @@ namespace mu
 	//---------------------------------------------------------------------------
 	void ParserBase::Eval(value_type* results, int nBulkSize)
 	{
-		CreateRPN();
+		// Create the bytecode only if the expression or the variables changed since the
+		// last evaluation, so that evaluating successive blocks does not reparse the expression.
+		if (m_pParseFormula == &ParserBase::ParseString)
+		{
+			try
+			{
+				CreateRPN();
+			}
+			catch (ParserError& exc)
+			{
+				exc.SetFormula(m_pTokenReader->GetExpr());
+				throw;
+			}
+			m_pParseFormula = (m_vRPN.GetSize() == 2) ? &ParserBase::ParseCmdCodeShort : &ParserBase::ParseCmdCode;
+		}
 
 		int i = 0;
 
@@ -1907,9 +2049,19 @@ namespace mu
 #endif
 
 #else
-		for (i = 0; i < nBulkSize; ++i)
+		if (m_vRPN.IsBlockEvaluable())
+		{
+			for (i = 0; i < nBulkSize; i += s_BlockSize)
+			{
+				ParseCmdCodeBlock(&results[i], i, std::min(s_BlockSize, nBulkSize - i));
+			}
+		}
+		else
 		{
-			results[i] = ParseCmdCodeBulk(i, 0);
+			for (i = 0; i < nBulkSize; ++i)
+			{
+				results[i] = ParseCmdCodeBulk(i, 0);
+			}
 		}
 #endif
 
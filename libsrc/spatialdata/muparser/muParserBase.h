@@ -94,6 +94,9 @@ namespace mu
 		/** \brief Maximum number of threads spawned by OpenMP when using the bulk mode. */
 		static const int s_MaxNumOpenMPThreads;
 
+		/** \brief Number of values evaluated together by each bytecode token in bulk mode. */
+		static const int s_BlockSize;
+
 	public:
 
 		/** \brief Type of the error class.
@@ -272,6 +275,7 @@ namespace mu
 		value_type ParseCmdCode() const;
 		value_type ParseCmdCodeShort() const;
 		value_type ParseCmdCodeBulk(int nOffset, int nThreadID) const;
+		void ParseCmdCodeBlock(value_type* results, int nOffset, int nBlockSize) const;
 
 		void  CheckName(const string_type& a_strName, const string_type& a_CharSet) const;
 		void  CheckOprt(const string_type& a_sName, const ParserCallback& a_Callback, const string_type& a_szCharSet) const;
@@ -305,6 +309,7 @@ namespace mu
 
 		// items merely used for caching state information
 		mutable valbuf_type m_vStackBuffer; ///< This is merely a buffer used for the stack in the cmd parsing routine
+		mutable valbuf_type m_vBlockStackBuffer; ///< Buffer used for the stack when evaluating blocks of values
 		mutable int m_nFinalResultIdx;
 	};
 
@@ -53,6 +53,7 @@ namespace mu
 		, m_iMaxStackSize(0)
 		, m_vRPN()
 		, m_bEnableOptimizer(true)
+		, m_bBlockEval(false)
 	{
 		m_vRPN.reserve(50);
 	}
@@ -98,6 +99,7 @@ namespace mu
 		m_vRPN = a_ByteCode.m_vRPN;
 		m_iMaxStackSize = a_ByteCode.m_iMaxStackSize;
 		m_bEnableOptimizer = a_ByteCode.m_bEnableOptimizer;
+		m_bBlockEval = a_ByteCode.m_bBlockEval;
 	}
 
 
@@ -491,14 +493,44 @@ namespace mu
 		m_vRPN.push_back(tok);
 		rpn_type(m_vRPN).swap(m_vRPN);     // shrink bytecode vector to fit
 
-		// Determine the if-then-else jump offsets
+		// Determine the if-then-else jump offsets and whether the bytecode
+		// can be evaluated for a block of values at a time.
 		std::stack<int> stIf, stElse;
 		int idx;
+		m_bBlockEval = true;
 		for (int i = 0; i < (int)m_vRPN.size(); ++i)
 		{
 			switch (m_vRPN[i].Cmd)
 			{
+			case cmLE:
+			case cmGE:
+			case cmNEQ:
+			case cmEQ:
+			case cmLT:
+			case cmGT:
+			case cmADD:
+			case cmSUB:
+			case cmMUL:
+			case cmDIV:
+			case cmPOW:
+			case cmLAND:
+			case cmLOR:
+			case cmVAR:
+			case cmVAL:
+			case cmVARPOW2:
+			case cmVARPOW3:
+			case cmVARPOW4:
+			case cmVARMUL:
+			case cmEND:
+				break;
+
+			case cmFUNC:
+				if (m_vRPN[i].Fun.argc < 0 || m_vRPN[i].Fun.argc > 3)
+					m_bBlockEval = false;
+				break;
+
 			case cmIF:
+				m_bBlockEval = false;
 				stIf.push(i);
 				break;
 
@@ -516,6 +548,7 @@ namespace mu
 				break;
 
 			default:
+				m_bBlockEval = false;
 				break;
 			}
 		}
@@ -541,6 +574,7 @@ namespace mu
 		m_vRPN.clear();
 		m_iStackPos = 0;
 		m_iMaxStackSize = 0;
+		m_bBlockEval = false;
 	}
 
 
@@ -105,6 +105,9 @@ namespace mu
 
 		bool m_bEnableOptimizer;
 
+		/** \brief True if the bytecode contains only tokens that can be evaluated for a block of values. */
+		bool m_bBlockEval;
+
 		void ConstantFolding(ECmdCode a_Oprt);
 
 	public:
@@ -129,6 +132,16 @@ namespace mu
 		void clear();
 		std::size_t GetMaxStackSize() const;
 
+		/** \brief Check whether the bytecode can be evaluated for a block of values at a time.
+
+			This is the case if it contains no branches, assignments, string, bulk or
+			multi-argument functions.
+		*/
+		bool IsBlockEvaluable() const
+		{
+			return m_bBlockEval;
+		}
+
 		std::size_t GetSize() const
 		{
 			return m_vRPN.size();
@@ -15,21 +15,87 @@
 // Include ios here to avoid some Python/gcc issues
 #include <ios>
 
+#include "QueryContext.hh" // ISA QueryContext
+
 #include "spatialdata/units/Parser.hh" // USES Parser
 #include "spatialdata/geocoords/CSCart.hh" // HASA CoordSys
 #include "spatialdata/geocoords/Converter.hh" // USES Converter
 #include "spatialdata/muparser/muParser.h" // USES mu::parser
 
 #include <vector> // USES std::vector
+#include <algorithm> // USES std::min()
 #include <stdexcept> // USES std::runtime_error
 
 #include <sstream> // USES std::ostringsgream
 #include <strings.h> // USES strcasecmp()
 #include <assert.h> // USES assert()
 
+// ----------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        namespace _analyticdb {
+            /// Number of locations evaluated together in multiquery().
+            const size_t blockSize = 256;
+
+            /** Set up parser for expression with x, y, and z as variables.
+             *
+             * The variables are arrays of blockSize values, so the parser can
+             * evaluate the expression for a block of locations in bulk mode.
+             * Single queries use the first value of each array.
+             *
+             * @param parser Parser for expression.
+             * @param expression Expression for value.
+             * @param vars Storage for x, y, and z variables [3*blockSize].
+             */
+            void setupParser(mu::Parser* parser,
+                             const std::string& expression,
+                             mu::value_type* vars) {
+                assert(parser);
+                assert(vars);
+                parser->SetArgSep(',');
+                parser->SetDecSep('.');
+                // Only allow built-in variables mupSetVarFactory(_parsers, AddVariable, NULL);
+                parser->DefineConst("pi", M_PI);
+                parser->DefineVar("x", &vars[0]);
+                parser->DefineVar("y", &vars[blockSize]);
+                parser->DefineVar("z", &vars[2*blockSize]);
+                parser->SetExpr(expression);
+            } // setupParser
+
+            /// Query context with its own parsers bound to its own variables.
+            class Context : public spatialdata::spatialdb::QueryContext {
+public:
+
+                mu::value_type* vars; ///< Storage for expression variables [3*blockSize].
+                mu::Parser* parsers; ///< Parsers for expressions in database.
+
+                Context(const SpatialDB& db,
+                        const std::string* expressions,
+                        const size_t numValues) :
+                    QueryContext(db),
+                    vars(new mu::value_type[3*blockSize]()),
+                    parsers(NULL) {
+                    parsers = (numValues > 0) ? new mu::Parser[numValues] : NULL;
+                    for (size_t i = 0; i < numValues; ++i) {
+                        setupParser(&parsers[i], expressions[i], vars);
+                    } // for
+                }
+
+
+                ~Context(void) {
+                    delete[] parsers;parsers = NULL;
+                    delete[] vars;vars = NULL;
+                }
+
+            }; // Context
+        } // _analyticdb
+    } // spatialdb
+} // spatialdata
+
 // ----------------------------------------------------------------------
 /// Default constructor
 spatialdata::spatialdb::AnalyticDB::AnalyticDB(void) :
+    _expVars(new mu::value_type[3*_analyticdb::blockSize]()),
     _names(NULL),
     _scales(NULL),
     _expressions(NULL),
@@ -45,6 +111,7 @@ spatialdata::spatialdb::AnalyticDB::AnalyticDB(void) :
 /// Constructor with label
 spatialdata::spatialdb::AnalyticDB::AnalyticDB(const char* label) :
     SpatialDB(label),
+    _expVars(new mu::value_type[3*_analyticdb::blockSize]()),
     _names(NULL),
     _scales(NULL),
     _expressions(NULL),
@@ -62,6 +129,7 @@ spatialdata::spatialdb::AnalyticDB::~AnalyticDB(void) {
     clear();
     delete _cs;_cs = NULL;
     delete _converter;_converter = NULL;
+    delete[] _expVars;_expVars = NULL;
 } // destructor
 
 
@@ -117,14 +185,7 @@ spatialdata::spatialdb::AnalyticDB::setData(const char* const* names,
     _parsers = new mu::Parser[_numValues];
     for (size_t i = 0; i < _numValues; ++i) {
         _expressions[i] = expressions[i];
-        _parsers[i].SetArgSep(',');
-        _parsers[i].SetDecSep('.');
-        // Only allow built-in variables mupSetVarFactory(_parsers, AddVariable, NULL);
-        _parsers[i].DefineConst("pi", M_PI);
-        _parsers[i].DefineVar("x", &_expVars[0]);
-        _parsers[i].DefineVar("y", &_expVars[1]);
-        _parsers[i].DefineVar("z", &_expVars[2]);
-        _parsers[i].SetExpr(_expressions[i]);
+        _analyticdb::setupParser(&_parsers[i], _expressions[i], _expVars);
     } // for
 
     // Default query values is all values.
@@ -162,6 +223,14 @@ spatialdata::spatialdb::AnalyticDB::getNamesDBValues(const char*** valueNames,
 } // getNamesDBValues
 
 
+// ----------------------------------------------------------------------
+// Get coordinate system of database.
+const spatialdata::geocoords::CoordSys*
+spatialdata::spatialdb::AnalyticDB::getCoordSys(void) const {
+    return _cs;
+} // getCoordSys
+
+
 // ----------------------------------------------------------------------
 // Set values to be returned by queries.
 void
@@ -208,45 +277,189 @@ spatialdata::spatialdb::AnalyticDB::query(double* vals,
                                           const double* coords,
                                           const size_t numDims,
                                           const spatialdata::geocoords::CoordSys* csQuery) {
-    if (0 == _querySize) {
-        std::ostringstream msg;
-        msg << "Values to be returned by spatial database " << getDescription() << "\n"
-            << "have not been set. Please call setQueryValues() before query().\n";
-        throw std::logic_error(msg.str());
+    return _query(vals, numVals, coords, numDims, csQuery, _parsers, _expVars, _converter);
+} // query
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database.
+void
+spatialdata::spatialdb::AnalyticDB::multiquery(double* vals,
+                                               const size_t numLocsV,
+                                               const size_t numValsV,
+                                               int* err,
+                                               const size_t numLocsE,
+                                               const double* coords,
+                                               const size_t numLocsC,
+                                               const size_t numDimsC,
+                                               const spatialdata::geocoords::CoordSys* csQuery) {
+    assert(_isMultiqueryConsistent(vals, numLocsV, numValsV, err, numLocsE, coords, numLocsC, numDimsC));
+
+    if (_parallelMultiquery(vals, numLocsC, numValsV, err, coords, numDimsC, csQuery)) {
+        return;
     } // if
-    else if (numVals != _querySize) {
+    _multiquery(vals, numLocsC, numValsV, err, coords, numDimsC, csQuery, _parsers, _expVars, _converter);
+} // multiquery
+
+
+// ----------------------------------------------------------------------
+// Check whether database supports query contexts.
+bool
+spatialdata::spatialdb::AnalyticDB::supportsQueryContexts(void) const {
+    return true;
+} // supportsQueryContexts
+
+
+// ----------------------------------------------------------------------
+// Create context for querying the database.
+spatialdata::spatialdb::QueryContext*
+spatialdata::spatialdb::AnalyticDB::createQueryContext(void) const {
+    if (!_parsers) {
         std::ostringstream msg;
-        msg << "Number of values to be returned by spatial database "
-            << getDescription() << "\n"
-            << "(" << _querySize << ") does not match size of array provided ("
-            << numVals << ").\n";
-        throw std::invalid_argument(msg.str());
+        msg << "Spatial database " << getDescription() << " does not contain any values.\n"
+            << "Please call setData() before calling createQueryContext().";
+        throw std::logic_error(msg.str());
     } // if
 
+    return new _analyticdb::Context(*this, _expressions, _numValues);
+} // createQueryContext
+
+
+// ----------------------------------------------------------------------
+// Query the database using scratch storage in query context.
+int
+spatialdata::spatialdb::AnalyticDB::_contextQuery(QueryContext* context,
+                                                  double* vals,
+                                                  const size_t numVals,
+                                                  const double* coords,
+                                                  const size_t numDims,
+                                                  const spatialdata::geocoords::CoordSys* csQuery) const {
+    _analyticdb::Context* analyticContext = dynamic_cast<_analyticdb::Context*>(context);
+    assert(analyticContext);
+    return _query(vals, numVals, coords, numDims, csQuery, analyticContext->parsers, analyticContext->vars,
+                  analyticContext->getConverter());
+} // _contextQuery
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database using scratch storage in query context.
+void
+spatialdata::spatialdb::AnalyticDB::_contextMultiquery(QueryContext* context,
+                                                       double* vals,
+                                                       const size_t numLocs,
+                                                       const size_t numVals,
+                                                       int* err,
+                                                       const double* coords,
+                                                       const size_t numDims,
+                                                       const spatialdata::geocoords::CoordSys* csQuery) const {
+    _analyticdb::Context* analyticContext = dynamic_cast<_analyticdb::Context*>(context);
+    assert(analyticContext);
+    _multiquery(vals, numLocs, numVals, err, coords, numDims, csQuery, analyticContext->parsers, analyticContext->vars,
+                analyticContext->getConverter());
+} // _contextMultiquery
+
+
+// ----------------------------------------------------------------------
+// Query the database.
+int
+spatialdata::spatialdb::AnalyticDB::_query(double* vals,
+                                           const size_t numVals,
+                                           const double* coords,
+                                           const size_t numDims,
+                                           const spatialdata::geocoords::CoordSys* csQuery,
+                                           mu::Parser* parsers,
+                                           mu::value_type* vars,
+                                           spatialdata::geocoords::Converter* converter) const {
+    _checkQuerySize(numVals, _querySize);
+
     // Convert coordinates
     assert(numDims <= 3);
+    double xyz[3];
     for (size_t d = 0; d < numDims; ++d) {
-        _expVars[d] = coords[d];
+        xyz[d] = coords[d];
     }
     assert(csQuery);
     assert(_cs);
-    assert(_converter);
-    _converter->convert(_expVars, 1, numDims, _cs, csQuery);
+    assert(converter);
+    converter->convert(xyz, 1, numDims, _cs, csQuery);
+    for (size_t d = 0; d < numDims; ++d) {
+        vars[d*_analyticdb::blockSize] = xyz[d];
+    } // for
 
     assert(_queryValues);
     assert(_scales);
-    assert(_parsers);
+    assert(parsers);
     try {
         for (size_t iVal = 0; iVal < _querySize; ++iVal) {
             const size_t index = _queryValues[iVal];
-            vals[iVal] = _scales[index] * _parsers[index].Eval();
+            vals[iVal] = _scales[index] * parsers[index].Eval();
         } // for
     } catch (const mu::Parser::exception_type& exception) {
         throw std::runtime_error(exception.GetMsg());
     }
 
     return 0;
-} // query
+} // _query
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database.
+void
+spatialdata::spatialdb::AnalyticDB::_multiquery(double* vals,
+                                                const size_t numLocs,
+                                                const size_t numVals,
+                                                int* err,
+                                                const double* coords,
+                                                const size_t numDims,
+                                                const spatialdata::geocoords::CoordSys* csQuery,
+                                                mu::Parser* parsers,
+                                                mu::value_type* vars,
+                                                spatialdata::geocoords::Converter* converter) const {
+    _checkQuerySize(numVals, _querySize);
+    if (0 == numLocs) {
+        return;
+    } // if
+
+    // Convert coordinates of all locations at once.
+    assert(numDims <= 3);
+    std::vector<double> xyz(coords, coords + numLocs*numDims);
+    assert(csQuery);
+    assert(_cs);
+    assert(converter);
+    converter->convert(&xyz[0], numLocs, numDims, _cs, csQuery);
+
+    // Evaluate all values for each block of locations using bulk mode of the parsers.
+    assert(_queryValues);
+    assert(_scales);
+    assert(parsers);
+    const size_t blockSize = _analyticdb::blockSize;
+    std::vector<mu::value_type> results(blockSize);
+    try {
+        for (size_t iStart = 0; iStart < numLocs; iStart += blockSize) {
+            const size_t numBlockLocs = std::min(blockSize, numLocs - iStart);
+            for (size_t iLoc = 0; iLoc < numBlockLocs; ++iLoc) {
+                for (size_t d = 0; d < numDims; ++d) {
+                    vars[d*blockSize+iLoc] = xyz[(iStart+iLoc)*numDims+d];
+                } // for
+            } // for
+
+            for (size_t iVal = 0; iVal < _querySize; ++iVal) {
+                const size_t index = _queryValues[iVal];
+                parsers[index].Eval(&results[0], int(numBlockLocs));
+                const double scale = _scales[index];
+                for (size_t iLoc = 0; iLoc < numBlockLocs; ++iLoc) {
+                    vals[(iStart+iLoc)*numVals+iVal] = scale * results[iLoc];
+                } // for
+            } // for
+        } // for
+    } catch (const mu::Parser::exception_type& exception) {
+        throw std::runtime_error(exception.GetMsg());
+    }
+
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        err[iLoc] = 0;
+    } // for
+} // _multiquery
 
 
 // End of file
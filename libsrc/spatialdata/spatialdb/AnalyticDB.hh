@@ -70,6 +70,12 @@ public:
     void getNamesDBValues(const char*** valueNames,
                           size_t* numValues) const;
 
+    /** Get coordinate system of database.
+     *
+     * @returns Coordinate system.
+     */
+    const spatialdata::geocoords::CoordSys* getCoordSys(void) const;
+
     /** Set values to be returned by queries.
      *
      * @pre Must call open() before setQueryValues()
@@ -100,10 +106,139 @@ public:
               const size_t numDims,
               const spatialdata::geocoords::CoordSys* csQuery);
 
+    using SpatialDB::multiquery; // Keep float version visible.
+
+    /** Perform multiple queries of the database.
+     *
+     * All locations are converted at once, and each expression is evaluated
+     * for blocks of locations using bulk mode of the parser.
+     *
+     * @pre Must call setQueryValues() before multiquery().
+     *
+     * @param vals Array for computed values (output from query), must be
+     *   allocated BEFORE calling multiquery() [numLocs*numVals].
+     * @param numLocsV Number of locations.
+     * @param numValsV Number of values expected.
+     * @param err Array for error flag values (output from query), must be
+     *   allocated BEFORE calling multiquery() [numLocs].
+     * @param numLocsE Number of locations.
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numLocsC Number of locations.
+     * @param numDimsC Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     */
+    void multiquery(double* vals,
+                    const size_t numLocsV,
+                    const size_t numValsV,
+                    int* err,
+                    const size_t numLocsE,
+                    const double* coords,
+                    const size_t numLocsC,
+                    const size_t numDimsC,
+                    const spatialdata::geocoords::CoordSys* csQuery);
+
+    /** Check whether database supports query contexts.
+     *
+     * @returns True if database supports query contexts, false otherwise.
+     */
+    bool supportsQueryContexts(void) const;
+
+    /** Create context for querying the database.
+     *
+     * @pre Must call setData() before createQueryContext().
+     *
+     * @returns Query context (caller is responsible for deleting it).
+     */
+    QueryContext* createQueryContext(void) const;
+
 private:
 
     // PRIVATE METHODS ////////////////////////////////////////////////////
 
+    /** Query the database using scratch storage in query context.
+     *
+     * @param context Query context created by createQueryContext().
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate)
+     */
+    int _contextQuery(QueryContext* context,
+                      double* vals,
+                      const size_t numVals,
+                      const double* coords,
+                      const size_t numDims,
+                      const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Perform multiple queries of the database using scratch storage in query context.
+     *
+     * @param context Query context created by createQueryContext().
+     * @param vals Array for computed values (output from query) [numLocs*numVals].
+     * @param numLocs Number of locations.
+     * @param numVals Number of values expected.
+     * @param err Array for error flag values (output from query) [numLocs].
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     */
+    void _contextMultiquery(QueryContext* context,
+                            double* vals,
+                            const size_t numLocs,
+                            const size_t numVals,
+                            int* err,
+                            const double* coords,
+                            const size_t numDims,
+                            const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Query the database.
+     *
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     * @param parsers Parsers for expressions of values in database.
+     * @param vars Storage for expression variables bound to parsers [3*blockSize].
+     * @param converter Converter for query points.
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate)
+     */
+    int _query(double* vals,
+               const size_t numVals,
+               const double* coords,
+               const size_t numDims,
+               const spatialdata::geocoords::CoordSys* csQuery,
+               mu::Parser* parsers,
+               mu::value_type* vars,
+               spatialdata::geocoords::Converter* converter) const;
+
+    /** Perform multiple queries of the database.
+     *
+     * @param vals Array for computed values (output from query) [numLocs*numVals].
+     * @param numLocs Number of locations.
+     * @param numVals Number of values expected.
+     * @param err Array for error flag values (output from query) [numLocs].
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     * @param parsers Parsers for expressions of values in database.
+     * @param vars Storage for expression variables bound to parsers [3*blockSize].
+     * @param converter Converter for query points.
+     */
+    void _multiquery(double* vals,
+                     const size_t numLocs,
+                     const size_t numVals,
+                     int* err,
+                     const double* coords,
+                     const size_t numDims,
+                     const spatialdata::geocoords::CoordSys* csQuery,
+                     mu::Parser* parsers,
+                     mu::value_type* vars,
+                     spatialdata::geocoords::Converter* converter) const;
+
     AnalyticDB(const AnalyticDB& data); ///< Not implemented
     const AnalyticDB& operator=(const AnalyticDB& data); ///< Not implemented
 
@@ -111,7 +246,7 @@ private:
 
     // PRIVATE MEMBERS /////////////////////////////////////////////////////
 
-    mu::value_type _expVars[3]; ///< Storage for default expression variables
+    mu::value_type* _expVars; ///< Storage for default expression variables [3*blockSize]
     std::string* _names; ///< Names of values in database
     double* _scales; ///< Scales to convert expressions to SI units.
     std::string* _expressions; ///< Expressions in database
@@ -12,37 +12,132 @@
 
 #include "CompositeDB.hh" // Implementation of class methods
 
+#include "QueryContext.hh" // ISA QueryContext
+
+#include "spatialdata/geocoords/CSCart.hh" // USES CSCart
+#include "spatialdata/geocoords/CSGeo.hh" // USES CSGeo
+#include "spatialdata/geocoords/Converter.hh" // HASA Converter
+
 #include <stdexcept> // USES std::runtime_error
+#include <algorithm> // USES std::max()
+#include <vector> // USES std::vector
 #include <sstream> // USES std::ostringsgream
+#include <cstring> // USES memcpy(), memcmp()
 #include <strings.h> // USES strcasecmp()
 #include <cassert> // USES assert()
 
+// ----------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        namespace _compositedb {
+            /// Query context with contexts and buffers for each database.
+            class Context : public spatialdata::spatialdb::QueryContext {
+public:
+
+                std::vector<QueryContext*> contexts; ///< Query context for each database.
+                std::vector<double*> buffers; ///< Buffer for values from each database.
+                double* xyz; ///< Query point in each distinct coordinate system.
+
+                Context(const SpatialDB& db,
+                        const size_t numDBs,
+                        const size_t numCoordSys) :
+                    QueryContext(db),
+                    contexts(numDBs, NULL),
+                    buffers(numDBs, NULL),
+                    xyz((numCoordSys > 0) ? new double[3*numCoordSys] : NULL) {}
+
+
+                ~Context(void) {
+                    for (size_t i = 0; i < contexts.size(); ++i) {
+                        delete contexts[i];contexts[i] = NULL;
+                        delete[] buffers[i];buffers[i] = NULL;
+                    } // for
+                    delete[] xyz;xyz = NULL;
+                }
+
+            }; // Context
+
+            /** Get name of database for error messages.
+             *
+             * @param index Index of database.
+             * @returns Name of database (A, B, ...).
+             */
+            std::string dbName(const size_t index) {
+                std::ostringstream name;
+                if (index < 26) {
+                    name << char('A' + index);
+                } else {
+                    name << index;
+                } // if/else
+                return name.str();
+            } // dbName
+
+            /** Check whether converting points to two coordinate systems gives the same coordinates.
+             *
+             * @param csA Coordinate system A.
+             * @param csB Coordinate system B.
+             * @returns True if coordinate systems are equivalent, false otherwise.
+             */
+            bool sameCoordSys(const spatialdata::geocoords::CoordSys& csA,
+                              const spatialdata::geocoords::CoordSys& csB) {
+                if (&csA == &csB) {
+                    return true;
+                } // if
+                if ((csA.getCSType() != csB.getCSType()) || (csA.getSpaceDim() != csB.getSpaceDim())) {
+                    return false;
+                } // if
+
+                const spatialdata::geocoords::CSGeo* csGeoA = dynamic_cast<const spatialdata::geocoords::CSGeo*>(&csA);
+                const spatialdata::geocoords::CSGeo* csGeoB = dynamic_cast<const spatialdata::geocoords::CSGeo*>(&csB);
+                if (csGeoA && csGeoB) {
+                    if (csGeoA->getCRSId() != csGeoB->getCRSId()) {
+                        return false;
+                    } // if
+                    double rotationA[4], originA[2];
+                    double rotationB[4], originB[2];
+                    csGeoA->getLocalTransform(rotationA, originA);
+                    csGeoB->getLocalTransform(rotationB, originB);
+                    return 0 == memcmp(rotationA, rotationB, sizeof(rotationA)) && 0 == memcmp(originA, originB, sizeof(originA));
+                } // if
+
+                const spatialdata::geocoords::CSCart* csCartA = dynamic_cast<const spatialdata::geocoords::CSCart*>(&csA);
+                const spatialdata::geocoords::CSCart* csCartB = dynamic_cast<const spatialdata::geocoords::CSCart*>(&csB);
+                if (csCartA && csCartB) {
+                    return csCartA->getToMeters() == csCartB->getToMeters();
+                } // if
+
+                return false;
+            } // sameCoordSys
+
+        } // _compositedb
+    } // spatialdb
+} // spatialdata
+
 // ----------------------------------------------------------------------
 /// Default constructor
 spatialdata::spatialdb::CompositeDB::CompositeDB(void) :
-    _dbA(NULL),
-    _dbB(NULL),
-    _infoA(NULL),
-    _infoB(NULL) {}
+    _converter(new spatialdata::geocoords::Converter),
+    _xyz(NULL) {}
 
 
 // ----------------------------------------------------------------------
 /// Constructor with label
 spatialdata::spatialdb::CompositeDB::CompositeDB(const char* label) :
     SpatialDB(label),
-    _dbA(NULL),
-    _dbB(NULL),
-    _infoA(NULL),
-    _infoB(NULL) {}
+    _converter(new spatialdata::geocoords::Converter),
+    _xyz(NULL) {}
 
 
 // ----------------------------------------------------------------------
 /// Default destructor
 spatialdata::spatialdb::CompositeDB::~CompositeDB(void) {
-    // Don't manage memory for dbA and dbB
+    // Don't manage memory for databases
 
-    delete _infoA;_infoA = NULL;
-    delete _infoB;_infoB = NULL;
+    for (size_t i = 0; i < _infos.size(); ++i) {
+        delete _infos[i];_infos[i] = NULL;
+    } // for
+    delete _converter;_converter = NULL;
+    delete[] _xyz;_xyz = NULL;
 } // destructor
 
 
@@ -52,22 +147,7 @@ void
 spatialdata::spatialdb::CompositeDB::setDBA(SpatialDB* db,
                                             const char* const* names,
                                             const size_t numNames) {
-    assert(db);
-    assert(names);
-    assert(numNames > 0);
-
-    // Clear out old data
-    delete _infoA;_infoA = new DBInfo;
-    _dbA = db;
-
-    // Set data
-    if (numNames > 0) {
-        _infoA->names_values = new std::string[numNames];
-        _infoA->num_names = numNames;
-        for (size_t i = 0; i < numNames; ++i) {
-            _infoA->names_values[i] = names[i];
-        } // for
-    } // if
+    _setDB(0, db, names, numNames);
 } // setDBA
 
 
@@ -77,65 +157,56 @@ void
 spatialdata::spatialdb::CompositeDB::setDBB(SpatialDB* db,
                                             const char* const* names,
                                             const size_t numNames) {
-    assert(db);
-    assert(names);
-    assert(numNames > 0);
+    _setDB(1, db, names, numNames);
+} // setDBB
 
-    // Clear out old data
-    delete _infoB;_infoB = new DBInfo;
-    _dbB = db;
 
-    // Set data
-    if (numNames > 0) {
-        _infoB->names_values = new std::string[numNames];
-        _infoB->num_names = numNames;
-        for (size_t i = 0; i < numNames; ++i) {
-            _infoB->names_values[i] = names[i];
-        } // for
-    } // if
-} // setDBB
+// ----------------------------------------------------------------------
+// Add database after the databases already set.
+void
+spatialdata::spatialdb::CompositeDB::addDB(SpatialDB* db,
+                                           const char* const* names,
+                                           const size_t numNames) {
+    _setDB(_infos.size(), db, names, numNames);
+} // addDB
+
+
+// ----------------------------------------------------------------------
+// Get number of databases.
+size_t
+spatialdata::spatialdb::CompositeDB::getNumDBs(void) const {
+    return _infos.size();
+} // getNumDBs
 
 
 // ----------------------------------------------------------------------
 // Open the database and prepare for querying.
 void
 spatialdata::spatialdb::CompositeDB::open(void) {
-    if (!_dbA) {
-        throw std::logic_error("Cannot open database A. Database was not set.");
-    } // if
-    if (!_dbB) {
-        throw std::logic_error("Cannot open database B. Database was not set.");
-    } // if
+    _checkDBs("open");
+
+    const size_t numDBs = _infos.size();
+    for (size_t iDB = 0, offset = 0; iDB < numDBs; ++iDB) {
+        DBInfo* info = _infos[iDB];
+        info->db->open();
+
+        // Setup query values
+        info->query_size = info->num_names;
+        const size_t qsize = info->query_size;
+        char** queryValues = (qsize > 0) ? new char*[qsize] : NULL;
+        delete[] info->query_indices;info->query_indices = (qsize > 0) ? new size_t[qsize] : NULL;
+        delete[] info->query_buffer;info->query_buffer = (qsize > 0) ? new double[qsize] : NULL;
+        for (size_t i = 0; i < qsize; ++i) {
+            info->query_indices[i] = offset + i;
+            queryValues[i] = const_cast<char*>(info->names_values[i].c_str());
+        } // for
+        info->db->setQueryValues(const_cast<const char**>(queryValues), qsize);
+        offset += qsize;
 
-    _dbA->open();
-    _dbB->open();
-
-    // Setup query values for A
-    _infoA->query_size = _infoA->num_names;
-    const size_t qsizeA = _infoA->query_size;
-    char** queryValuesA = (qsizeA > 0) ? new char*[qsizeA] : NULL;
-    delete[] _infoA->query_indices;_infoA->query_indices = (qsizeA > 0) ? new size_t[qsizeA] : NULL;
-    delete[] _infoA->query_buffer;_infoA->query_buffer = (qsizeA > 0) ? new double[qsizeA] : NULL;
-    for (size_t i = 0; i < qsizeA; ++i) {
-        _infoA->query_indices[i] = i;
-        queryValuesA[i] = const_cast<char*>(_infoA->names_values[i].c_str());
-    } // for
-    _dbA->setQueryValues(const_cast<const char**>(queryValuesA), qsizeA);
-
-    // Setup query values for A
-    _infoB->query_size = _infoB->num_names;
-    const size_t qsizeB = _infoB->query_size;
-    char** queryValuesB = (qsizeB > 0) ? new char*[qsizeB] : NULL;
-    delete[] _infoB->query_indices;_infoB->query_indices = (qsizeB > 0) ? new size_t[qsizeB] : NULL;
-    delete[] _infoB->query_buffer;_infoB->query_buffer = (qsizeB > 0) ? new double[qsizeB] : NULL;
-    for (size_t i = 0; i < qsizeB; ++i) {
-        _infoB->query_indices[i] = qsizeA + i;
-        queryValuesB[i] = const_cast<char*>(_infoB->names_values[i].c_str());
+        delete[] queryValues;queryValues = NULL;
     } // for
-    _dbB->setQueryValues(const_cast<const char**>(queryValuesB), qsizeB);
 
-    delete[] queryValuesA;queryValuesA = NULL;
-    delete[] queryValuesB;queryValuesB = NULL;
+    _setupCoordSys();
 } // open
 
 
@@ -143,15 +214,13 @@ spatialdata::spatialdb::CompositeDB::open(void) {
 // Close the database.
 void
 spatialdata::spatialdb::CompositeDB::close(void) {
-    if (!_dbA) {
-        throw std::logic_error("Cannot close database A. Database was not set.");
-    } // if
-    _dbA->close();
+    _checkDBs("close");
 
-    if (!_dbB) {
-        throw std::logic_error("Cannot close database B. Database was not set.");
-    } // if
-    _dbB->close();
+    for (size_t iDB = 0; iDB < _infos.size(); ++iDB) {
+        _infos[iDB]->db->close();
+        _infos[iDB]->cs_index = -1;
+    } // for
+    _coordsysDBs.clear();
 } // close
 
 
@@ -160,22 +229,23 @@ spatialdata::spatialdb::CompositeDB::close(void) {
 void
 spatialdata::spatialdb::CompositeDB::getNamesDBValues(const char*** valueNames,
                                                       size_t* numValues) const {
-    const size_t numValuesA = _infoA->num_names;
-    const size_t numValuesB = _infoB->num_names;
-    const size_t numValuesAB = numValuesA + numValuesB;
+    size_t numValuesAll = 0;
+    for (size_t iDB = 0; iDB < _infos.size(); ++iDB) {
+        assert(_infos[iDB]);
+        numValuesAll += _infos[iDB]->num_names;
+    } // for
 
     if (valueNames) {
-        *valueNames = (numValuesAB > 0) ? new const char*[numValuesAB] : NULL;
-        size_t iAB = 0;
-        for (size_t iA = 0; iA < numValuesA; ++iA, ++iAB) {
-            (*valueNames)[iAB] = _infoA->names_values[iA].c_str();
-        } // for
-        for (size_t iB = 0; iB < numValuesB; ++iB, ++iAB) {
-            (*valueNames)[iAB] = _infoB->names_values[iB].c_str();
+        *valueNames = (numValuesAll > 0) ? new const char*[numValuesAll] : NULL;
+        size_t iAll = 0;
+        for (size_t iDB = 0; iDB < _infos.size(); ++iDB) {
+            for (size_t iName = 0; iName < _infos[iDB]->num_names; ++iName, ++iAll) {
+                (*valueNames)[iAll] = _infos[iDB]->names_values[iName].c_str();
+            } // for
         } // for
     } // if
     if (numValues) {
-        *numValues = numValuesAB;
+        *numValues = numValuesAll;
     } // if
 } // getNamesDBValues
 
@@ -185,10 +255,7 @@ spatialdata::spatialdb::CompositeDB::getNamesDBValues(const char*** valueNames,
 void
 spatialdata::spatialdb::CompositeDB::setQueryValues(const char* const* names,
                                                     const size_t numVals) {
-    assert(_dbA);
-    assert(_infoA);
-    assert(_dbB);
-    assert(_infoB);
+    _checkDBs("set query values for");
 
     if (0 == numVals) {
         std::ostringstream msg;
@@ -198,100 +265,64 @@ spatialdata::spatialdb::CompositeDB::setQueryValues(const char* const* names,
     } // if
     assert(names && 0 < numVals);
 
-    _infoA->query_size = 0;
-    _infoB->query_size = 0;
-    const size_t numNamesA = _infoA->num_names;
-    const size_t numNamesB = _infoB->num_names;
+    // Find database and name of each value.
+    const size_t numDBs = _infos.size();
+    std::vector<size_t> dbIndices(numVals);
+    std::vector<size_t> nameIndices(numVals);
+    std::vector<size_t> querySizes(numDBs, 0);
     for (size_t iVal = 0; iVal < numVals; ++iVal) {
-        bool foundA = false;
-        bool foundB = false;
-
-        // Search database A names for name
-        size_t iName = 0;
-        while (iName < numNamesA) {
-            if (0 == strcasecmp(names[iVal], _infoA->names_values[iName].c_str())) {
-                foundA = true;
-                ++_infoA->query_size;
-                break;
-            } // if
-            ++iName;
-        } // while
-
-        // Search database B names for name
-        iName = 0;
-        while (iName < numNamesB) {
-            if (0 == strcasecmp(names[iVal], _infoB->names_values[iName].c_str())) {
-                foundB = true;
-                ++_infoB->query_size;
-                break;
-            } // if
-            ++iName;
-        } // while
+        size_t numFound = 0;
+        for (size_t iDB = 0; iDB < numDBs; ++iDB) {
+            const DBInfo* info = _infos[iDB];
+            for (size_t iName = 0; iName < info->num_names; ++iName) {
+                if (0 == strcasecmp(names[iVal], info->names_values[iName].c_str())) {
+                    dbIndices[iVal] = iDB;
+                    nameIndices[iVal] = iName;
+                    ++numFound;
+                    break;
+                } // if
+            } // for
+        } // for
 
-        if (!foundA && !foundB) {
+        if (0 == numFound) {
             std::ostringstream msg;
-            msg << "Value " << names[iVal] << " not found in either database A or database B.";
+            msg << "Value " << names[iVal] << " not found in any database.";
             throw std::domain_error(msg.str());
-        } else if (foundA && foundB) {
+        } else if (numFound > 1) {
             std::ostringstream msg;
-            msg << "Value " << names[iVal] << " found in both database A or database B.";
+            msg << "Value " << names[iVal] << " found in more than one database.";
             throw std::domain_error(msg.str());
         } // if/else
+        ++querySizes[dbIndices[iVal]];
     } // for
-    assert(_infoA->query_size + _infoB->query_size == numVals);
-
-    // Setup query values for A
-    const size_t qsizeA = _infoA->query_size;
-    char** queryValsA = (qsizeA > 0) ? new char*[qsizeA] : NULL;
-    delete[] _infoA->query_indices;
-    _infoA->query_indices = (qsizeA > 0) ? new size_t[qsizeA] : NULL;
-    delete[] _infoA->query_buffer;
-    _infoA->query_buffer = (qsizeA > 0) ? new double[qsizeA] : NULL;
-
-    // Setup query values for B
-    const size_t qsizeB = _infoB->query_size;
-    char** queryValsB = (qsizeB > 0) ? new char*[qsizeB] : NULL;
-    delete[] _infoB->query_indices;
-    _infoB->query_indices = (qsizeB > 0) ? new size_t[qsizeB] : NULL;
-    delete[] _infoB->query_buffer;
-    _infoB->query_buffer = (qsizeB > 0) ? new double[qsizeB] : NULL;
-
-    for (size_t iVal = 0, indexA = 0, indexB = 0; iVal < numVals; ++iVal) {
-        size_t iName = 0;
-        // Search database A names
-        while (iName < numNamesA) {
-            if (0 == strcasecmp(names[iVal], _infoA->names_values[iName].c_str())) {
-                assert(indexA < qsizeA);
-                _infoA->query_indices[indexA] = iVal;
-                queryValsA[indexA] = const_cast<char*>(_infoA->names_values[iName].c_str());
-                ++indexA;
-                break;
-            } // if
-            ++iName;
-        } // while
 
-        // Search database B names
-        iName = 0;
-        while (iName < numNamesB) {
-            if (0 == strcasecmp(names[iVal], _infoB->names_values[iName].c_str())) {
-                assert(indexB < qsizeB);
-                _infoB->query_indices[indexB] = iVal;
-                queryValsB[indexB] = const_cast<char*>(_infoB->names_values[iName].c_str());
-                ++indexB;
-                break;
+    // Setup query values for each database.
+    for (size_t iDB = 0; iDB < numDBs; ++iDB) {
+        DBInfo* info = _infos[iDB];
+        const size_t qsize = querySizes[iDB];
+        info->query_size = qsize;
+        char** queryVals = (qsize > 0) ? new char*[qsize] : NULL;
+        delete[] info->query_indices;
+        info->query_indices = (qsize > 0) ? new size_t[qsize] : NULL;
+        delete[] info->query_buffer;
+        info->query_buffer = (qsize > 0) ? new double[qsize] : NULL;
+
+        for (size_t iVal = 0, index = 0; iVal < numVals; ++iVal) {
+            if (dbIndices[iVal] == iDB) {
+                assert(index < qsize);
+                info->query_indices[index] = iVal;
+                queryVals[index] = const_cast<char*>(info->names_values[nameIndices[iVal]].c_str());
+                ++index;
             } // if
-            ++iName;
-        } // while
+        } // for
+        if (qsize > 0) {
+            info->db->setQueryValues(const_cast<const char**>(queryVals), qsize);
+        } // if
+
+        delete[] queryVals;queryVals = NULL;
     } // for
-    if (qsizeA > 0) {
-        _dbA->setQueryValues(const_cast<const char**>(queryValsA), qsizeA);
-    } // if
-    if (qsizeB > 0) {
-        _dbB->setQueryValues(const_cast<const char**>(queryValsB), qsizeB);
-    } // if
 
-    delete[] queryValsA;queryValsA = NULL;
-    delete[] queryValsB;queryValsB = NULL;
+    _setupCoordSys();
 } // queryVals
 
 
@@ -303,49 +334,316 @@ spatialdata::spatialdb::CompositeDB::query(double* vals,
                                            const double* coords,
                                            const size_t numDims,
                                            const spatialdata::geocoords::CoordSys* pCSQuery) {
-    assert(_dbA);
-    assert(_infoA);
-    assert(_dbB);
-    assert(_infoB);
-
-    const size_t qsizeA = _infoA->query_size;
-    const size_t qsizeB = _infoB->query_size;
-    const size_t querySize = qsizeA + qsizeB;
-    if (0 == querySize) {
-        std::ostringstream msg;
-        msg << "Values to be returned by spatial database " << getDescription()
-            << " have not been set. Please call setQueryValues() before query().\n";
-        throw std::logic_error(msg.str());
+    return _query(vals, numVals, coords, numDims, pCSQuery, NULL, NULL, _xyz, _converter);
+} // query
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database.
+void
+spatialdata::spatialdb::CompositeDB::multiquery(double* vals,
+                                                const size_t numLocsV,
+                                                const size_t numValsV,
+                                                int* err,
+                                                const size_t numLocsE,
+                                                const double* coords,
+                                                const size_t numLocsC,
+                                                const size_t numDimsC,
+                                                const spatialdata::geocoords::CoordSys* csQuery) {
+    assert(_isMultiqueryConsistent(vals, numLocsV, numValsV, err, numLocsE, coords, numLocsC, numDimsC));
+
+    if (_parallelMultiquery(vals, numLocsC, numValsV, err, coords, numDimsC, csQuery)) {
+        return;
     } // if
-    else if (numVals != querySize) {
-        std::ostringstream msg;
-        msg << "Number of values to be returned by spatial database "
-            << getDescription()
-            << "(" << querySize << ") does not match size of array provided ("
-            << numVals << ").\n";
-        throw std::logic_error(msg.str());
+    _multiquery(vals, numLocsC, numValsV, err, coords, numDimsC, csQuery, NULL, _converter);
+} // multiquery
+
+
+// ----------------------------------------------------------------------
+// Check whether database supports query contexts.
+bool
+spatialdata::spatialdb::CompositeDB::supportsQueryContexts(void) const {
+    for (size_t iDB = 0; iDB < _infos.size(); ++iDB) {
+        assert(_infos[iDB]);
+        if ((_infos[iDB]->query_size > 0) && !_infos[iDB]->db->supportsQueryContexts()) {
+            return false;
+        } // if
+    } // for
+    return true;
+} // supportsQueryContexts
+
+
+// ----------------------------------------------------------------------
+// Create context for querying the database.
+spatialdata::spatialdb::QueryContext*
+spatialdata::spatialdb::CompositeDB::createQueryContext(void) const {
+    _checkDBs("create query context for");
+
+    const size_t numDBs = _infos.size();
+    _compositedb::Context* context = new _compositedb::Context(*this, numDBs, _coordsysDBs.size());
+    try {
+        for (size_t iDB = 0; iDB < numDBs; ++iDB) {
+            const size_t qsize = _infos[iDB]->query_size;
+            if (qsize > 0) {
+                context->contexts[iDB] = _infos[iDB]->db->createQueryContext();
+                context->buffers[iDB] = new double[qsize];
+            } // if
+        } // for
+    } catch (...) {
+        delete context;context = NULL;
+        throw;
+    } // try/catch
+
+    return context;
+} // createQueryContext
+
+
+// ----------------------------------------------------------------------
+// Query the database using scratch storage in query context.
+int
+spatialdata::spatialdb::CompositeDB::_contextQuery(QueryContext* context,
+                                                   double* vals,
+                                                   const size_t numVals,
+                                                   const double* coords,
+                                                   const size_t numDims,
+                                                   const spatialdata::geocoords::CoordSys* csQuery) const {
+    _compositedb::Context* compositeContext = dynamic_cast<_compositedb::Context*>(context);
+    assert(compositeContext);
+    assert(compositeContext->contexts.size() == _infos.size());
+    return _query(vals, numVals, coords, numDims, csQuery,
+                  &compositeContext->contexts[0], &compositeContext->buffers[0],
+                  compositeContext->xyz, compositeContext->getConverter());
+} // _contextQuery
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database using scratch storage in query context.
+void
+spatialdata::spatialdb::CompositeDB::_contextMultiquery(QueryContext* context,
+                                                        double* vals,
+                                                        const size_t numLocs,
+                                                        const size_t numVals,
+                                                        int* err,
+                                                        const double* coords,
+                                                        const size_t numDims,
+                                                        const spatialdata::geocoords::CoordSys* csQuery) const {
+    _compositedb::Context* compositeContext = dynamic_cast<_compositedb::Context*>(context);
+    assert(compositeContext);
+    assert(compositeContext->contexts.size() == _infos.size());
+    _multiquery(vals, numLocs, numVals, err, coords, numDims, csQuery,
+                &compositeContext->contexts[0], compositeContext->getConverter());
+} // _contextMultiquery
+
+
+// ----------------------------------------------------------------------
+// Set database.
+void
+spatialdata::spatialdb::CompositeDB::_setDB(const size_t index,
+                                            SpatialDB* db,
+                                            const char* const* names,
+                                            const size_t numNames) {
+    assert(db);
+    assert(names);
+    assert(numNames > 0);
+
+    if (index >= _infos.size()) {
+        _infos.resize(index+1, NULL);
     } // if
 
-    // Query database A
-    int errA = 0;
-    if (qsizeA > 0) {
-        errA = _dbA->query(_infoA->query_buffer, qsizeA, coords, numDims, pCSQuery);
-        for (size_t i = 0; i < qsizeA; ++i) {
-            vals[_infoA->query_indices[i]] = _infoA->query_buffer[i];
+    // Clear out old data
+    DBInfo*& info = _infos[index];
+    delete info;info = new DBInfo;
+    info->db = db;
+
+    // Set data
+    if (numNames > 0) {
+        info->names_values = new std::string[numNames];
+        info->num_names = numNames;
+        for (size_t i = 0; i < numNames; ++i) {
+            info->names_values[i] = names[i];
         } // for
     } // if
+} // _setDB
+
+
+// ----------------------------------------------------------------------
+// Check that all databases have been set.
+void
+spatialdata::spatialdb::CompositeDB::_checkDBs(const char* action) const {
+    // Composite database requires at least databases A and B.
+    const size_t numDBs = std::max(size_t(2), _infos.size());
+    for (size_t iDB = 0; iDB < numDBs; ++iDB) {
+        if ((iDB >= _infos.size()) || !_infos[iDB]) {
+            std::ostringstream msg;
+            msg << "Cannot " << action << " database " << _compositedb::dbName(iDB) << ". Database was not set.";
+            throw std::logic_error(msg.str());
+        } // if
+    } // for
+} // _checkDBs
+
 
-    // Query database B
-    int errB = 0;
-    if (qsizeB > 0) {
-        errB = _dbB->query(_infoB->query_buffer, qsizeB, coords, numDims, pCSQuery);
-        for (size_t i = 0; i < qsizeB; ++i) {
-            vals[_infoB->query_indices[i]] = _infoB->query_buffer[i];
+// ----------------------------------------------------------------------
+// Find distinct coordinate systems of databases with values to be returned by queries.
+void
+spatialdata::spatialdb::CompositeDB::_setupCoordSys(void) {
+    _coordsysDBs.clear();
+    for (size_t iDB = 0; iDB < _infos.size(); ++iDB) {
+        DBInfo* info = _infos[iDB];
+        assert(info);
+        info->cs_index = -1;
+        const spatialdata::geocoords::CoordSys* cs = info->db->getCoordSys();
+        if (!cs || (0 == info->query_size)) {
+            continue;
+        } // if
+
+        size_t iCS = 0;
+        while (iCS < _coordsysDBs.size() &&
+               !_compositedb::sameCoordSys(*_infos[_coordsysDBs[iCS]]->db->getCoordSys(), *cs)) {
+            ++iCS;
+        } // while
+        if (iCS == _coordsysDBs.size()) {
+            _coordsysDBs.push_back(iDB);
+        } // if
+        info->cs_index = int(iCS);
+    } // for
+
+    delete[] _xyz;_xyz = (_coordsysDBs.size() > 0) ? new double[3*_coordsysDBs.size()] : NULL;
+} // _setupCoordSys
+
+
+// ----------------------------------------------------------------------
+// Query the database.
+int
+spatialdata::spatialdb::CompositeDB::_query(double* vals,
+                                            const size_t numVals,
+                                            const double* coords,
+                                            const size_t numDims,
+                                            const spatialdata::geocoords::CoordSys* pCSQuery,
+                                            QueryContext* const* contexts,
+                                            double* const* buffers,
+                                            double* xyz,
+                                            spatialdata::geocoords::Converter* converter) const {
+    assert(converter);
+
+    _checkQuerySize(numVals, _getQuerySize());
+
+    // Convert query point once for each distinct coordinate system. Each database is queried
+    // using its own coordinate system, so it does not convert the query point again.
+    const size_t numCoordSys = _coordsysDBs.size();
+    assert(!numCoordSys || (xyz && numDims <= 3));
+    for (size_t iCS = 0; iCS < numCoordSys; ++iCS) {
+        double* xyzCS = &xyz[3*iCS];
+        for (size_t iDim = 0; iDim < numDims; ++iDim) {
+            xyzCS[iDim] = coords[iDim];
+        } // for
+        converter->convert(xyzCS, 1, numDims, _infos[_coordsysDBs[iCS]]->db->getCoordSys(), pCSQuery);
+    } // for
+
+    int err = 0;
+    for (size_t iDB = 0; iDB < _infos.size(); ++iDB) {
+        const DBInfo* info = _infos[iDB];
+        const size_t qsize = info->query_size;
+        if (0 == qsize) {
+            continue;
+        } // if
+
+        const bool useCS = info->cs_index >= 0;
+        const double* coordsDB = (useCS) ? &xyz[3*info->cs_index] : coords;
+        const spatialdata::geocoords::CoordSys* csDB = (useCS) ? info->db->getCoordSys() : pCSQuery;
+        double* buffer = (buffers) ? buffers[iDB] : info->query_buffer;
+        assert(buffer);
+        QueryContext* context = (contexts) ? contexts[iDB] : NULL;
+        const int errDB = (context) ?
+                          context->query(buffer, qsize, coordsDB, numDims, csDB) :
+                          info->db->query(buffer, qsize, coordsDB, numDims, csDB);
+        for (size_t i = 0; i < qsize; ++i) {
+            vals[info->query_indices[i]] = buffer[i];
         } // for
+        err = err || errDB;
+    } // for
+
+    return err;
+} // _query
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database.
+void
+spatialdata::spatialdb::CompositeDB::_multiquery(double* vals,
+                                                 const size_t numLocs,
+                                                 const size_t numVals,
+                                                 int* err,
+                                                 const double* coords,
+                                                 const size_t numDims,
+                                                 const spatialdata::geocoords::CoordSys* csQuery,
+                                                 QueryContext* const* contexts,
+                                                 spatialdata::geocoords::Converter* converter) const {
+    assert(converter);
+
+    _checkQuerySize(numVals, _getQuerySize());
+    if (0 == numLocs) {
+        return;
     } // if
 
-    return errA || errB;
-} // query
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        err[iLoc] = 0;
+    } // for
+
+    // Convert locations once for each distinct coordinate system.
+    const size_t numCoordSys = _coordsysDBs.size();
+    const size_t coordsSize = numLocs*numDims;
+    std::vector<double> xyz(numCoordSys*coordsSize);
+    for (size_t iCS = 0; iCS < numCoordSys; ++iCS) {
+        double* xyzCS = &xyz[iCS*coordsSize];
+        memcpy(xyzCS, coords, coordsSize*sizeof(double));
+        converter->convert(xyzCS, numLocs, numDims, _infos[_coordsysDBs[iCS]]->db->getCoordSys(), csQuery);
+    } // for
+
+    // Query each database for all locations and scatter its values into the output.
+    std::vector<double> buffer;
+    std::vector<int> errDB(numLocs);
+    for (size_t iDB = 0; iDB < _infos.size(); ++iDB) {
+        const DBInfo* info = _infos[iDB];
+        const size_t qsize = info->query_size;
+        if (0 == qsize) {
+            continue;
+        } // if
+
+        const bool useCS = info->cs_index >= 0;
+        const double* coordsDB = (useCS) ? &xyz[info->cs_index*coordsSize] : coords;
+        const spatialdata::geocoords::CoordSys* csDB = (useCS) ? info->db->getCoordSys() : csQuery;
+        buffer.resize(numLocs*qsize);
+        QueryContext* context = (contexts) ? contexts[iDB] : NULL;
+        if (context) {
+            context->multiquery(&buffer[0], numLocs, qsize, &errDB[0], numLocs, coordsDB, numLocs, numDims, csDB);
+        } else {
+            info->db->multiquery(&buffer[0], numLocs, qsize, &errDB[0], numLocs, coordsDB, numLocs, numDims, csDB);
+        } // if/else
+        for (size_t i = 0; i < qsize; ++i) {
+            const size_t index = info->query_indices[i];
+            for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+                vals[iLoc*numVals+index] = buffer[iLoc*qsize+i];
+            } // for
+        } // for
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            err[iLoc] = err[iLoc] || errDB[iLoc];
+        } // for
+    } // for
+} // _multiquery
+
+
+// ----------------------------------------------------------------------
+// Get number of values returned by query.
+size_t
+spatialdata::spatialdb::CompositeDB::_getQuerySize(void) const {
+    size_t querySize = 0;
+    for (size_t iDB = 0; iDB < _infos.size(); ++iDB) {
+        assert(_infos[iDB]);
+        querySize += _infos[iDB]->query_size;
+    } // for
+
+    return querySize;
+} // _getQuerySize
 
 
 // End of file
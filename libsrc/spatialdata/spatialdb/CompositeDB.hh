@@ -12,8 +12,14 @@
 #include "SpatialDB.hh"
 
 #include <string> // HASA std::string
+#include <vector> // HASA std::vector
 
-/// C++ manager for simple spatial database.
+/** C++ manager for spatial database composed of other spatial databases.
+ *
+ * Each value is queried from exactly one of the databases. Query points are
+ * converted once for each distinct coordinate system of the databases (see
+ * SpatialDB::getCoordSys()) rather than once per database.
+ */
 class spatialdata::spatialdb::CompositeDB : public SpatialDB { // class CompositeDB
     friend class TestCompositeDB; // unit testing
 
@@ -33,7 +39,7 @@ public:
     /// Default destructor.
     ~CompositeDB(void);
 
-    /** Set database A.
+    /** Set database A (first database).
      *
      * @param db Pointer to database.
      * @param names Array of names of values to use with database.
@@ -43,7 +49,7 @@ public:
                 const char* const* names,
                 const size_t numNames);
 
-    /** Set database B.
+    /** Set database B (second database).
      *
      * @param db Pointer to database.
      * @param names Array of names of values to use with database.
@@ -53,6 +59,22 @@ public:
                 const char* const* names,
                 const size_t numNames);
 
+    /** Add database after the databases already set.
+     *
+     * @param db Pointer to database.
+     * @param names Array of names of values to use with database.
+     * @param numNames Size of array of names.
+     */
+    void addDB(SpatialDB* db,
+               const char* const* names,
+               const size_t numNames);
+
+    /** Get number of databases.
+     *
+     * @returns Number of databases.
+     */
+    size_t getNumDBs(void) const;
+
     /// Open the database and prepare for querying.
     void open(void);
 
@@ -97,6 +119,178 @@ public:
               const size_t numDims,
               const spatialdata::geocoords::CoordSys* pCSQuery);
 
+    using SpatialDB::multiquery; // Keep float version visible.
+
+    /** Perform multiple queries of the database.
+     *
+     * All locations are passed to multiquery() of each database, so
+     * databases with batched queries are queried efficiently, and the
+     * values are scattered into the output once per database. Locations
+     * are converted once for each distinct coordinate system of the
+     * databases.
+     *
+     * @pre Must call open() before multiquery().
+     *
+     * @param vals Array for computed values (output from query), must be
+     *   allocated BEFORE calling multiquery() [numLocs*numVals].
+     * @param numLocsV Number of locations.
+     * @param numValsV Number of values expected.
+     * @param err Array for error flag values (output from query), must be
+     *   allocated BEFORE calling multiquery() [numLocs].
+     * @param numLocsE Number of locations.
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numLocsC Number of locations.
+     * @param numDimsC Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     */
+    void multiquery(double* vals,
+                    const size_t numLocsV,
+                    const size_t numValsV,
+                    int* err,
+                    const size_t numLocsE,
+                    const double* coords,
+                    const size_t numLocsC,
+                    const size_t numDimsC,
+                    const spatialdata::geocoords::CoordSys* csQuery);
+
+    /** Check whether database supports query contexts.
+     *
+     * @returns True if database supports query contexts, false otherwise.
+     */
+    bool supportsQueryContexts(void) const;
+
+    /** Create context for querying the database.
+     *
+     * @pre Must call open() and setQueryValues() before createQueryContext().
+     *
+     * @note The context holds query contexts for the databases, so it must be
+     * recreated after changing the values returned by queries.
+     *
+     * @returns Query context (caller is responsible for deleting it).
+     */
+    QueryContext* createQueryContext(void) const;
+
+private:
+
+    // PRIVATE METHODS ////////////////////////////////////////////////////
+
+    /** Query the database using scratch storage in query context.
+     *
+     * @param context Query context created by createQueryContext().
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate)
+     */
+    int _contextQuery(QueryContext* context,
+                      double* vals,
+                      const size_t numVals,
+                      const double* coords,
+                      const size_t numDims,
+                      const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Perform multiple queries of the database using scratch storage in query context.
+     *
+     * @param context Query context created by createQueryContext().
+     * @param vals Array for computed values (output from query) [numLocs*numVals].
+     * @param numLocs Number of locations.
+     * @param numVals Number of values expected.
+     * @param err Array for error flag values (output from query) [numLocs].
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     */
+    void _contextMultiquery(QueryContext* context,
+                            double* vals,
+                            const size_t numLocs,
+                            const size_t numVals,
+                            int* err,
+                            const double* coords,
+                            const size_t numDims,
+                            const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Set database.
+     *
+     * @param index Index of database.
+     * @param db Pointer to database.
+     * @param names Array of names of values to use with database.
+     * @param numNames Size of array of names.
+     */
+    void _setDB(const size_t index,
+                SpatialDB* db,
+                const char* const* names,
+                const size_t numNames);
+
+    /** Check that all databases have been set.
+     *
+     * @param action Action requiring databases (used in error message).
+     */
+    void _checkDBs(const char* action) const;
+
+    /** Find distinct coordinate systems of databases with values to be returned by queries.
+     *
+     * Only the index of a database with each coordinate system is stored; coordinate systems
+     * are looked up with SpatialDB::getCoordSys() at query time, because databases own them.
+     *
+     * @pre Databases must be open.
+     */
+    void _setupCoordSys(void);
+
+    /** Query the database.
+     *
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param pCSQuery Coordinate system of coordinates.
+     * @param contexts Query context for each database (NULL to query databases directly).
+     * @param buffers Buffer for values from each database (NULL to use buffers of database information).
+     * @param xyz Buffer for query point in each distinct coordinate system [3*numCoordSys].
+     * @param converter Converter for query point.
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate)
+     */
+    int _query(double* vals,
+               const size_t numVals,
+               const double* coords,
+               const size_t numDims,
+               const spatialdata::geocoords::CoordSys* pCSQuery,
+               QueryContext* const* contexts,
+               double* const* buffers,
+               double* xyz,
+               spatialdata::geocoords::Converter* converter) const;
+
+    /** Perform multiple queries of the database.
+     *
+     * @param vals Array for computed values (output from query) [numLocs*numVals].
+     * @param numLocs Number of locations.
+     * @param numVals Number of values expected.
+     * @param err Array for error flag values (output from query) [numLocs].
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     * @param contexts Query context for each database (NULL to query databases directly).
+     * @param converter Converter for query points.
+     */
+    void _multiquery(double* vals,
+                     const size_t numLocs,
+                     const size_t numVals,
+                     int* err,
+                     const double* coords,
+                     const size_t numDims,
+                     const spatialdata::geocoords::CoordSys* csQuery,
+                     QueryContext* const* contexts,
+                     spatialdata::geocoords::Converter* converter) const;
+
+    /** Get number of values returned by query.
+     *
+     * @returns Number of values from all databases.
+     */
+    size_t _getQuerySize(void) const;
+
 private:
 
     // NOT IMPLEMENTED ////////////////////////////////////////////////////
@@ -109,6 +303,8 @@ private:
     // PRIVATE STRUCTS ////////////////////////////////////////////////////
 
     struct DBInfo {
+        SpatialDB* db;
+        int cs_index; ///< Index of coordinate system in distinct coordinate systems (-1 if none).
         double* query_buffer;
         size_t* query_indices;
         std::string* names_values;
@@ -116,6 +312,8 @@ private:
         size_t num_names;
 
         DBInfo(void) :
+            db(NULL),
+            cs_index(-1),
             query_buffer(NULL),
             query_indices(NULL),
             names_values(NULL),
@@ -137,11 +335,10 @@ private:
 
     // PRIVATE MEMBERS /////////////////////////////////////////////////////
 
-    SpatialDB* _dbA; ///< Spatial database A
-    SpatialDB* _dbB; ///< Spatial database B
-
-    DBInfo* _infoA; ///< Information for database A
-    DBInfo* _infoB; ///< Information for database B
+    std::vector<DBInfo*> _infos; ///< Information for each database (A, B, ...).
+    std::vector<size_t> _coordsysDBs; ///< Index of database with each distinct coordinate system.
+    spatialdata::geocoords::Converter* _converter; ///< Converter for query points.
+    double* _xyz; ///< Query point in each distinct coordinate system [3*numCoordSys].
 }; // class CompositeDB
 
 // End of file
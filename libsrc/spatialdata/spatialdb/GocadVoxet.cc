@@ -13,13 +13,20 @@
 #include "GocadVoxet.hh" // Implementation of class methods
 
 #include "spatialdata/utils/LineParser.hh" // USES LineParser
+#include "spatialdata/utils/BinaryIO.hh" // USES BinaryIO
 
 #include <fstream> // USES std::ifstream
-#include <math.h> // USES round()
+#include <algorithm> // USES std::min(), std::max(), std::sort(), std::fill()
+#include <vector> // USES std::vector
+#include <utility> // USES std::pair
+#include <limits> // USES std::numeric_limits
+#include <math.h> // USES round(), floor()
+#include <cmath> // USES std::isfinite()
 
 #include <stdexcept> // USES std::runtime_error
 #include <sstream> // USES std::ostringsgream
 #include <cstring> // USES memcpy() and strcmp()
+#include <stdint.h> // USES uint32_t
 #include <assert.h> // USES assert()
 
 #if defined(WORDS_BIGENDIAN)
@@ -31,16 +38,56 @@
 // ----------------------------------------------------------------------
 // Constructor
 spatialdata::spatialdb::GocadVoxet::GocadVoxet(void) :
-    _data(NULL) {}
+    _data(NULL),
+    _validZ(NULL),
+    _mappedData(NULL),
+    _mappedSize(0),
+    _useMemoryMap(false),
+    _useBlockedLayout(false) {
+    _numBlocks[0] = 0;
+    _numBlocks[1] = 0;
+} // constructor
 
 
 // ----------------------------------------------------------------------
 // Destructor
 spatialdata::spatialdb::GocadVoxet::~GocadVoxet(void) {
-    delete[] _data;_data = NULL;
+    _deallocate();
 } // destructor
 
 
+// ----------------------------------------------------------------------
+// Set flag for memory-mapping the property file.
+void
+spatialdata::spatialdb::GocadVoxet::setUseMemoryMap(const bool value) {
+    _useMemoryMap = value;
+} // setUseMemoryMap
+
+
+// ----------------------------------------------------------------------
+// Get flag for memory-mapping the property file.
+bool
+spatialdata::spatialdb::GocadVoxet::getUseMemoryMap(void) const {
+    return _useMemoryMap;
+} // getUseMemoryMap
+
+
+// ----------------------------------------------------------------------
+// Set flag for storing data in blocks of points.
+void
+spatialdata::spatialdb::GocadVoxet::setUseBlockedLayout(const bool value) {
+    _useBlockedLayout = value;
+} // setUseBlockedLayout
+
+
+// ----------------------------------------------------------------------
+// Get flag for storing data in blocks of points.
+bool
+spatialdata::spatialdb::GocadVoxet::getUseBlockedLayout(void) const {
+    return _useBlockedLayout;
+} // getUseBlockedLayout
+
+
 // ----------------------------------------------------------------------
 // Read data files.
 void
@@ -78,25 +125,14 @@ spatialdata::spatialdb::GocadVoxet::query(double* value,
     if (( indexX >= 0) && ( indexX < numX) &&
         ( indexY >= 0) && ( indexY < numY) &&
         ( indexZ >= 0) && ( indexZ < numZ) ) {
-        int indexV = indexZ*numY*numX + indexY*numX + indexX;
-        *value = _data[indexV];
-
-        // If voxet value is "no data value"
-        if (fabs(1.0 - *value / _property.noDataValue) < 1.0e-6) {
-            // If near indexZ=0, retry with indexZ+1, otherwise if near
-            // indexZ=numZ, retry with indexZ-1.
-            const int dz = (indexZ < numZ/2) ? +1 : -1;
-            const int maxRetries = 32;
-            for (int iTry = 0; iTry < maxRetries; ++iTry) {
-                const int indexZNew = indexZ + dz*iTry;
-                assert(indexZNew >= 0 && indexZNew < numZ);
-                indexV = indexZNew*numY*numX + indexY*numX + indexX;
-                *value = _data[indexV];
-                if (fabs(1.0 - *value / _property.noDataValue) > 1.0e-6) {
-                    break;
-                }
-            } // for
+        float valueV = _value(_getDataIndex(indexX, indexY, indexZ));
+
+        // If voxet value is "no data value", use value at nearby point along z axis.
+        if (_isNoData(valueV)) {
+            const int indexZNew = _fillIndexZ(indexX, indexY, indexZ);
+            valueV = _value(_getDataIndex(indexX, indexY, indexZNew));
         } // if
+        *value = valueV;
     } else {
         *value = _property.noDataValue;
         flag = 1;
@@ -145,12 +181,12 @@ spatialdata::spatialdb::GocadVoxet::queryNearest(double* value,
     assert(indexY >= 0 && indexY < numY);
     assert(indexZ >= 0 && indexZ < numZ);
 
-    int indexV = indexZ*numY*numX + indexY*numX + indexX;
-    *value = _data[indexV];
+    size_t indexV = _getDataIndex(indexX, indexY, indexZ);
+    *value = _value(indexV);
 
 #if 0
     // If voxet value is "no data value"
-    if (fabs(1.0 - *value / _property.noDataValue) < 1.0e-6) {
+    if (_isNoData(*value)) {
         // If near indexZ=0, retry with indexZ+1, otherwise if near
         // indexZ=numZ, retry with indexZ-1.
         const int dz = (indexZ < numZ/2) ? +1 : -1;
@@ -158,9 +194,9 @@ spatialdata::spatialdb::GocadVoxet::queryNearest(double* value,
         for (int iTry = 0; iTry < maxRetries; ++iTry) {
             const int indexZNew = indexZ + dz*iTry;
             assert(indexZNew >= 0 && indexZNew < numZ);
-            indexV = indexZNew*numY*numX + indexY*numX + indexX;
-            *value = _data[indexV];
-            if (fabs(1.0 - *value / _property.noDataValue) > 1.0e-6) {
+            indexV = _getDataIndex(indexX, indexY, indexZNew);
+            *value = _value(indexV);
+            if (!_isNoData(*value)) {
                 break;
             }
         } // for
@@ -171,6 +207,125 @@ spatialdata::spatialdb::GocadVoxet::queryNearest(double* value,
 } // queryNearest
 
 
+// ----------------------------------------------------------------------
+// Query voxet for values at multiple locations.
+void
+spatialdata::spatialdb::GocadVoxet::query(double* values,
+                                          int* flags,
+                                          const double* pts,
+                                          const size_t numPts) const {
+    assert(!numPts || (values && flags && pts));
+
+    std::vector<size_t> order(numPts);
+    _sortLocations(order.data(), pts, numPts);
+    for (size_t i = 0; i < numPts; ++i) {
+        const size_t iPt = order[i];
+        flags[iPt] = query(&values[iPt], &pts[3*iPt]);
+    } // for
+} // query
+
+
+// ----------------------------------------------------------------------
+// Query voxet for values at nearest location for multiple locations.
+void
+spatialdata::spatialdb::GocadVoxet::queryNearest(double* values,
+                                                 int* flags,
+                                                 const double* pts,
+                                                 const size_t numPts) const {
+    assert(!numPts || (values && flags && pts));
+
+    std::vector<size_t> order(numPts);
+    _sortLocations(order.data(), pts, numPts);
+    for (size_t i = 0; i < numPts; ++i) {
+        const size_t iPt = order[i];
+        flags[iPt] = queryNearest(&values[iPt], &pts[3*iPt]);
+    } // for
+} // queryNearest
+
+
+// ----------------------------------------------------------------------
+// Query voxet for value using trilinear interpolation.
+int
+spatialdata::spatialdb::GocadVoxet::queryLinear(double* value,
+                                                const double pt[3],
+                                                const bool clamp) const {
+    // Compute fractional indices of pt. The point is inside the voxet if the nearest voxet point
+    // is inside, consistent with query().
+    int flag = 0;
+    double index[3];
+    for (int i = 0; i < 3; ++i) {
+        index[i] = (pt[i] - (_geometry.o[i]+_geometry.min[i]))*_geometry.scale[i];
+        const int indexNearest = round(index[i]);
+        if (( indexNearest < 0) || ( indexNearest >= _geometry.n[i]) ) {
+            flag = 1;
+        } // if
+        index[i] = std::min(std::max(index[i], 0.0), double(_geometry.n[i]-1));
+    } // for
+    if (flag && !clamp) {
+        *value = _property.noDataValue;
+        return 1;
+    } // if
+
+    // Indices of lower corner of cell and weights of upper corner.
+    int index0[3];
+    double weight1[3];
+    for (int i = 0; i < 3; ++i) {
+        index0[i] = std::min(int(floor(index[i])), std::max(_geometry.n[i]-2, 0));
+        weight1[i] = index[i] - index0[i];
+    } // for
+
+    double valueSum = 0.0;
+    double weightSum = 0.0;
+    for (int iCorner = 0; iCorner < 8; ++iCorner) {
+        const int dx = iCorner & 1;
+        const int dy = (iCorner >> 1) & 1;
+        const int dz = (iCorner >> 2) & 1;
+        const double weight =
+            (dx ? weight1[0] : 1.0 - weight1[0]) *
+            (dy ? weight1[1] : 1.0 - weight1[1]) *
+            (dz ? weight1[2] : 1.0 - weight1[2]);
+        if (0.0 == weight) {
+            continue;
+        } // if
+
+        const float cornerValue = _value(_getDataIndex(index0[0]+dx, index0[1]+dy, index0[2]+dz));
+        if (!_isNoData(cornerValue)) {
+            valueSum += weight*cornerValue;
+            weightSum += weight;
+        } // if
+    } // for
+
+    if (weightSum > 0.0) {
+        *value = valueSum / weightSum;
+    } else if (clamp) {
+        queryNearest(value, pt);
+    } else {
+        query(value, pt);
+    } // if/else
+
+    return 0;
+} // queryLinear
+
+
+// ----------------------------------------------------------------------
+// Query voxet for values at multiple locations using trilinear interpolation.
+void
+spatialdata::spatialdb::GocadVoxet::queryLinear(double* values,
+                                                int* flags,
+                                                const double* pts,
+                                                const size_t numPts,
+                                                const bool clamp) const {
+    assert(!numPts || (values && flags && pts));
+
+    std::vector<size_t> order(numPts);
+    _sortLocations(order.data(), pts, numPts);
+    for (size_t i = 0; i < numPts; ++i) {
+        const size_t iPt = order[i];
+        flags[iPt] = queryLinear(&values[iPt], &pts[3*iPt], clamp);
+    } // for
+} // queryLinear
+
+
 // ----------------------------------------------------------------------
 // Read voxet file.
 void
@@ -326,27 +481,44 @@ spatialdata::spatialdb::GocadVoxet::_readVoxetFile(const char* filename,
 void
 spatialdata::spatialdb::GocadVoxet::_readPropertyFile(const char* filename) {
     assert(sizeof(float) == _property.esize);
-    const int nvals = _geometry.n[0] * _geometry.n[1] * _geometry.n[2];
-    delete[] _data;_data = new float[nvals];
+    const size_t nvals = size_t(_geometry.n[0]) * size_t(_geometry.n[1]) * size_t(_geometry.n[2]);
+    _deallocate();
 
     try {
-        std::ifstream pfile(filename);
-        if (!pfile.is_open() || !pfile.good()) {
-            std::ostringstream msg;
-            msg << "Could not open Gocad Voxet property file '" << filename
-                << "' for reading.\n";
-            throw std::runtime_error(msg.str());
-        } // if
-
-        pfile.read((char*) _data, sizeof(float)*nvals);
-        _endianBigToNative(_data, nvals);
+        if (_useMemoryMap) {
+            _mappedData = utils::BinaryIO::mapReadOnly(filename, &_mappedSize);
+            if (_mappedSize < sizeof(float)*nvals) {
+                std::ostringstream msg;
+                msg << "Expected " << nvals << " values in Gocad Voxet property file '" << filename
+                    << "' but file only has " << _mappedSize << " bytes.\n";
+                throw std::runtime_error(msg.str());
+            } // if
+        } else {
+            std::ifstream pfile(filename);
+            if (!pfile.is_open() || !pfile.good()) {
+                std::ostringstream msg;
+                msg << "Could not open Gocad Voxet property file '" << filename
+                    << "' for reading.\n";
+                throw std::runtime_error(msg.str());
+            } // if
+
+            _data = new float[nvals];
+            pfile.read((char*) _data, sizeof(float)*nvals);
+            _endianBigToNative(_data, nvals);
+            if (_useBlockedLayout) {
+                _setupBlockedLayout();
+            } // if
+        } // if/else
+        _setupValidZ();
     } catch (const std::exception& err) {
+        _deallocate();
         std::ostringstream msg;
         msg << "Error occurred while reading Gocad Voxet property file '"
             << filename << "'.\n"
             << err.what();
         throw std::runtime_error(msg.str());
     } catch (...) {
+        _deallocate();
         std::ostringstream msg;
         msg << "Unknown error occurred while reading Gocad Voxet property file '"
             << filename << "'.\n";
@@ -355,6 +527,198 @@ spatialdata::spatialdb::GocadVoxet::_readPropertyFile(const char* filename) {
 } // _readPropertyFile
 
 
+// ----------------------------------------------------------------------
+// Get value in voxet.
+float
+spatialdata::spatialdb::GocadVoxet::_value(const size_t index) const {
+    if (_data) {
+        return _data[index];
+    } // if
+
+    // Memory-mapped values are big-endian; convert a copy so the mapped pages are never modified.
+    assert(_mappedData);
+    assert(sizeof(float)*(index+1) <= _mappedSize);
+    float value;
+    memcpy(&value, (const char*) _mappedData + sizeof(float)*index, sizeof(float));
+    _endianBigToNative(&value, 1);
+    return value;
+} // _value
+
+
+// ----------------------------------------------------------------------
+// Reorder data values into blocks of points.
+void
+spatialdata::spatialdb::GocadVoxet::_setupBlockedLayout(void) {
+    assert(_data);
+
+    // Pad voxet to whole number of blocks along each axis.
+    const int numX = _geometry.n[0];
+    const int numY = _geometry.n[1];
+    const int numZ = _geometry.n[2];
+    const int blockSize = 1 << BLOCKBITS;
+    const size_t numBlocksX = (numX + blockSize - 1) >> BLOCKBITS;
+    const size_t numBlocksY = (numY + blockSize - 1) >> BLOCKBITS;
+    const size_t numBlocksZ = (numZ + blockSize - 1) >> BLOCKBITS;
+    const size_t size = numBlocksX*numBlocksY*numBlocksZ << 3*BLOCKBITS;
+    float* data = new float[size];
+    std::fill(data, data+size, _property.noDataValue);
+
+    // Indices into new data array use blocks once the number of blocks is set.
+    _numBlocks[0] = numBlocksX;
+    _numBlocks[1] = numBlocksY;
+    size_t iLinear = 0;
+    for (int indexZ = 0; indexZ < numZ; ++indexZ) {
+        for (int indexY = 0; indexY < numY; ++indexY) {
+            for (int indexX = 0; indexX < numX; ++indexX, ++iLinear) {
+                data[_getDataIndex(indexX, indexY, indexZ)] = _data[iLinear];
+            } // for
+        } // for
+    } // for
+
+    delete[] _data;_data = data;
+} // _setupBlockedLayout
+
+
+// ----------------------------------------------------------------------
+// Get index of point in data array.
+size_t
+spatialdata::spatialdb::GocadVoxet::_getDataIndex(const int indexX,
+                                                  const int indexY,
+                                                  const int indexZ) const {
+    assert(indexX >= 0 && indexX < _geometry.n[0]);
+    assert(indexY >= 0 && indexY < _geometry.n[1]);
+    assert(indexZ >= 0 && indexZ < _geometry.n[2]);
+
+    if (_numBlocks[0] > 0) {
+        // Blocks are ordered with x varying fastest, as are points within each block.
+        const size_t mask = (size_t(1) << BLOCKBITS) - 1;
+        const size_t blockIndex = ((indexZ >> BLOCKBITS)*_numBlocks[1] + (indexY >> BLOCKBITS))*_numBlocks[0] + (indexX >> BLOCKBITS);
+        const size_t pointIndex = ((((indexZ & mask) << BLOCKBITS) + (indexY & mask)) << BLOCKBITS) + (indexX & mask);
+        return (blockIndex << 3*BLOCKBITS) + pointIndex;
+    } // if
+
+    return (size_t(indexZ)*_geometry.n[1] + indexY)*_geometry.n[0] + indexX;
+} // _getDataIndex
+
+
+// ----------------------------------------------------------------------
+// Find first and last point with data along z axis in each (x,y) column.
+void
+spatialdata::spatialdb::GocadVoxet::_setupValidZ(void) {
+    const int numX = _geometry.n[0];
+    const int numY = _geometry.n[1];
+    const int numZ = _geometry.n[2];
+
+    delete[] _validZ;_validZ = new int[2*size_t(numX)*size_t(numY)];
+    for (int indexY = 0, iColumn = 0; indexY < numY; ++indexY) {
+        for (int indexX = 0; indexX < numX; ++indexX, ++iColumn) {
+            int indexZ = 0;
+            while (indexZ < numZ && _isNoData(_value(_getDataIndex(indexX, indexY, indexZ)))) {
+                ++indexZ;
+            } // while
+            _validZ[2*iColumn+0] = indexZ;
+
+            indexZ = numZ-1;
+            while (indexZ >= 0 && _isNoData(_value(_getDataIndex(indexX, indexY, indexZ)))) {
+                --indexZ;
+            } // while
+            _validZ[2*iColumn+1] = indexZ;
+        } // for
+    } // for
+} // _setupValidZ
+
+
+// ----------------------------------------------------------------------
+// Get index along z axis of point used in place of point without data.
+int
+spatialdata::spatialdb::GocadVoxet::_fillIndexZ(const int indexX,
+                                                const int indexY,
+                                                const int indexZ) const {
+    assert(_validZ);
+    const int numX = _geometry.n[0];
+    const int numZ = _geometry.n[2];
+    const int maxRetries = 32;
+
+    const int* validZ = &_validZ[2*(indexY*numX + indexX)];
+    if (validZ[0] > validZ[1]) {
+        return indexZ; // No data in column.
+    } // if
+
+    // If near indexZ=0, use first point with data above, otherwise if near indexZ=numZ, use first
+    // point with data below.
+    const int dz = (indexZ < numZ/2) ? +1 : -1;
+    const int indexZValid = (dz > 0) ? validZ[0] : validZ[1];
+    const int distance = (indexZValid - indexZ) * dz;
+    if (distance > 0) {
+        return (distance < maxRetries) ? indexZValid : indexZ;
+    } // if
+
+    // Point is in a gap between points with data, so search along the column.
+    int indexZNew = indexZ + dz;
+    for (int iTry = 1; iTry < maxRetries && indexZNew >= 0 && indexZNew < numZ; ++iTry, indexZNew += dz) {
+        if (!_isNoData(_value(_getDataIndex(indexX, indexY, indexZNew)))) {
+            return indexZNew;
+        } // if
+    } // for
+    return indexZ;
+} // _fillIndexZ
+
+
+// ----------------------------------------------------------------------
+// Get order of locations sorted by index of nearest voxet point.
+void
+spatialdata::spatialdb::GocadVoxet::_sortLocations(size_t* order,
+                                                   const double* pts,
+                                                   const size_t numPts) const {
+    assert(!numPts || (order && pts));
+
+    // Locations with non-finite coordinates get a sentinel key (sorted last) instead of an index.
+    const size_t keyNonFinite = std::numeric_limits<size_t>::max();
+
+    std::vector<std::pair<size_t, size_t> > keys(numPts);
+    for (size_t iPt = 0; iPt < numPts; ++iPt) {
+        bool isFinite = true;
+        int index[3];
+        for (int i = 0; i < 3 && isFinite; ++i) {
+            const double indexF = round( (pts[3*iPt+i] - (_geometry.o[i]+_geometry.min[i]))*_geometry.scale[i]);
+            isFinite = std::isfinite(indexF);
+            index[i] = (isFinite) ? int(std::min(std::max(indexF, 0.0), double(_geometry.n[i]-1))) : 0;
+        } // for
+        keys[iPt] = std::make_pair((isFinite) ? _getDataIndex(index[0], index[1], index[2]) : keyNonFinite, iPt);
+    } // for
+    std::sort(keys.begin(), keys.end());
+
+    for (size_t i = 0; i < numPts; ++i) {
+        order[i] = keys[i].second;
+    } // for
+} // _sortLocations
+
+
+// ----------------------------------------------------------------------
+// Check whether value is the "no data" value.
+bool
+spatialdata::spatialdb::GocadVoxet::_isNoData(const float value) const {
+    uint32_t valueBits;
+    uint32_t noDataBits;
+    memcpy(&valueBits, &value, sizeof(float));
+    memcpy(&noDataBits, &_property.noDataValue, sizeof(float));
+    return valueBits == noDataBits;
+} // _isNoData
+
+
+// ----------------------------------------------------------------------
+// Release property data.
+void
+spatialdata::spatialdb::GocadVoxet::_deallocate(void) {
+    delete[] _data;_data = NULL;
+    delete[] _validZ;_validZ = NULL;
+    _numBlocks[0] = 0;
+    _numBlocks[1] = 0;
+    utils::BinaryIO::unmap(_mappedData, _mappedSize);_mappedData = NULL;
+    _mappedSize = 0;
+} // _deallocate
+
+
 // ----------------------------------------------------------------------
 // Convert array of float values from big endian to native float type.
 void
@@ -403,7 +767,7 @@ spatialdata::spatialdb::GocadVoxet::_resetData(void) {
     _property.offset = 0;
     _property.filename = "";
 
-    delete[] _data;_data = 0;
+    _deallocate();
 } // _resetData
 
 
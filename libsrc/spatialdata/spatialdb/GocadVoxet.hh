@@ -25,6 +25,38 @@ public:
     /// Destructor
     ~GocadVoxet(void);
 
+    /** Set flag for memory-mapping the property file.
+     *
+     * When memory-mapped, the big-endian values are converted to native byte order when they are
+     * accessed, so the pages of the property file are never modified and are shared among all
+     * processes on a node that map the same file.
+     *
+     * @param value True to memory-map the property file, false to read it into memory.
+     */
+    void setUseMemoryMap(const bool value);
+
+    /** Get flag for memory-mapping the property file.
+     *
+     * @returns True if memory-mapping the property file, false otherwise.
+     */
+    bool getUseMemoryMap(void) const;
+
+    /** Set flag for storing data in blocks of points.
+     *
+     * When true, read() reorders the data into blocks of 8x8x8 points, so the points around a
+     * query location are close together in memory regardless of the direction in which queries
+     * move through the voxet. Memory-mapped property files always keep the order of the file.
+     *
+     * @param value True to store data in blocks of points, false to store data with x varying fastest.
+     */
+    void setUseBlockedLayout(const bool value);
+
+    /** Get flag for storing data in blocks of points.
+     *
+     * @returns True if storing data in blocks of points, false otherwise.
+     */
+    bool getUseBlockedLayout(void) const;
+
     /** Read voxet file and property data.
      *
      * @param dir Directory containing voxet data files.
@@ -53,6 +85,62 @@ public:
     int queryNearest(double* value,
                      const double pt[3]) const;
 
+    /** Query voxet for values at multiple locations.
+     *
+     * Locations are visited in order of the voxet points they fall in, so each batch walks the
+     * voxet data once.
+     *
+     * @param values Array of values for result [numPts].
+     * @param flags Array of flags for result [numPts], 0 if inside voxet, 1 if outside voxet.
+     * @param pts Array of locations of queries [numPts*3].
+     * @param numPts Number of locations.
+     */
+    void query(double* values,
+               int* flags,
+               const double* pts,
+               const size_t numPts) const;
+
+    /** Query voxet for values at nearest location for multiple locations.
+     *
+     * @param values Array of values for result [numPts].
+     * @param flags Array of flags for result [numPts], always 0.
+     * @param pts Array of locations of queries [numPts*3].
+     * @param numPts Number of locations.
+     */
+    void queryNearest(double* values,
+                      int* flags,
+                      const double* pts,
+                      const size_t numPts) const;
+
+    /** Query voxet for value using trilinear interpolation.
+     *
+     * Points without data are excluded from the interpolation, and the weights of the remaining
+     * points are renormalized. If none of the points have data, the value is that of query() or
+     * queryNearest().
+     *
+     * @param value Value for result.
+     * @param pt Location of query.
+     * @param clamp If true, use the nearest location in the voxet for points outside the voxet.
+     * @returns 0 if pt is inside voxet (or clamp is true), 1 if outside voxet.
+     */
+    int queryLinear(double* value,
+                    const double pt[3],
+                    const bool clamp=false) const;
+
+    /** Query voxet for values at multiple locations using trilinear interpolation.
+     *
+     * @param values Array of values for result [numPts].
+     * @param flags Array of flags for result [numPts], 0 if inside voxet, 1 if outside voxet.
+     * @param pts Array of locations of queries [numPts*3].
+     * @param numPts Number of locations.
+     * @param clamp If true, use the nearest location in the voxet for points outside the voxet.
+     */
+    void queryLinear(double* values,
+                     int* flags,
+                     const double* pts,
+                     const size_t numPts,
+                     const bool clamp=false) const;
+
     // NOT IMPLEMENTED //////////////////////////////////////////////////////
 private:
 
@@ -102,6 +190,69 @@ private:
      */
     void _readPropertyFile(const char* filename);
 
+    /** Get value in voxet.
+     *
+     * @param index Index of value in voxet.
+     * @returns Value in native byte order.
+     */
+    float _value(const size_t index) const;
+
+    /// Reorder data values into blocks of points.
+    void _setupBlockedLayout(void);
+
+    /** Get index of point in data array.
+     *
+     * @param indexX Index of point along x axis.
+     * @param indexY Index of point along y axis.
+     * @param indexZ Index of point along z axis.
+     * @returns Index of point in data array.
+     */
+    size_t _getDataIndex(const int indexX,
+                         const int indexY,
+                         const int indexZ) const;
+
+    /// Find first and last point with data along z axis in each (x,y) column.
+    void _setupValidZ(void);
+
+    /** Get index along z axis of point used in place of point without data.
+     *
+     * Points without data near the bottom of the voxet use the first point with data above them;
+     * points without data near the top use the first point with data below them. Points within
+     * 32 points of the end of the data in a column use a precomputed index, and only points in a
+     * gap between points with data search along the column.
+     *
+     * @param indexX Index of point along x axis.
+     * @param indexY Index of point along y axis.
+     * @param indexZ Index of point along z axis.
+     * @returns Index along z axis of point with data, or indexZ if none is found.
+     */
+    int _fillIndexZ(const int indexX,
+                    const int indexY,
+                    const int indexZ) const;
+
+    /** Get order of locations sorted by index of nearest voxet point.
+     *
+     * @param order Indices of locations in sorted order [numPts].
+     * @param pts Array of locations [numPts*3].
+     * @param numPts Number of locations.
+     */
+    void _sortLocations(size_t* order,
+                        const double* pts,
+                        const size_t numPts) const;
+
+    /** Check whether value is the "no data" value.
+     *
+     * Values are compared bit for bit, because the "no data" value is stored in the property file
+     * as the same float as in the voxet file.
+     *
+     * @param value Value in voxet.
+     * @returns True if value is the "no data" value, false otherwise.
+     */
+    bool _isNoData(const float value) const;
+
+    /// Release property data.
+    void _deallocate(void);
+
     /** Convert array of float values from big endian to native float type.
      *
      * @param vals Array of values.
@@ -118,7 +269,15 @@ private:
 
     Geometry _geometry; ///< Geometry of voxet data.
     Property _property; ///< Voxet properties.
-    float* _data; ///< Array with data values
+    float* _data; ///< Array with data values (NULL if memory-mapped).
+    int* _validZ; ///< First and last index along z axis of points with data in each (x,y) column.
+    const void* _mappedData; ///< Memory-mapped property file with big-endian data values.
+    size_t _mappedSize; ///< Size of memory-mapped property file.
+    bool _useMemoryMap; ///< Flag for memory-mapping property file.
+    bool _useBlockedLayout; ///< Flag for storing data in blocks of points.
+    size_t _numBlocks[2]; ///< Number of blocks along x and y axes (0 if data is not in blocks).
+
+    static const int BLOCKBITS = 3; ///< Blocks have 2^BLOCKBITS points along each axis.
 
 }; // GocadVoxet
 
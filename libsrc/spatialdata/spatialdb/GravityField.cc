@@ -12,10 +12,13 @@
 
 #include "GravityField.hh" // Implementation of class methods
 
+#include "QueryContext.hh" // USES QueryContext
+
 #include "spatialdata/geocoords/CoordSys.hh" // USES CoordSys
 #include "spatialdata/geocoords/CSGeo.hh" // USES CSGeo
 
 #include <cmath> // USES sqrt()
+#include <vector> // USES std::vector
 #include <strings.h> // USES strcasecmp()
 #include <stdexcept> // USES std::runtime_error
 #include <sstream> // USES std::ostringsgream
@@ -162,21 +165,89 @@ spatialdata::spatialdb::GravityField::query(double* vals,
                                             const double* coords,
                                             const size_t numDims,
                                             const spatialdata::geocoords::CoordSys* cs) {
-    assert(cs);
+    return _query(vals, numVals, coords, numDims, cs, NULL);
+} // query
 
-    if (0 == _querySize) {
-        std::ostringstream msg;
-        msg << "Values to be returned by spatial database " << getDescription() << "\n"
-            << "have not been set. Please call setQueryValues() before query().\n";
-        throw std::logic_error(msg.str());
-    } else if (numVals != _querySize) {
-        std::ostringstream msg;
-        msg << "Number of values to be returned by spatial database "
-            << getDescription() << "\n"
-            << "(" << _querySize << ") does not match size of array provided ("
-            << numVals << ").\n";
-        throw std::logic_error(msg.str());
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database.
+void
+spatialdata::spatialdb::GravityField::multiquery(double* vals,
+                                                 const size_t numLocsV,
+                                                 const size_t numValsV,
+                                                 int* err,
+                                                 const size_t numLocsE,
+                                                 const double* coords,
+                                                 const size_t numLocsC,
+                                                 const size_t numDimsC,
+                                                 const spatialdata::geocoords::CoordSys* csQuery) {
+    assert(_isMultiqueryConsistent(vals, numLocsV, numValsV, err, numLocsE, coords, numLocsC, numDimsC));
+
+    if (_parallelMultiquery(vals, numLocsC, numValsV, err, coords, numDimsC, csQuery)) {
+        return;
     } // if
+    _multiquery(vals, numLocsC, numValsV, err, coords, numDimsC, csQuery, NULL);
+} // multiquery
+
+
+// ----------------------------------------------------------------------
+// Check whether database supports query contexts.
+bool
+spatialdata::spatialdb::GravityField::supportsQueryContexts(void) const {
+    return true;
+} // supportsQueryContexts
+
+
+// ----------------------------------------------------------------------
+// Create context for querying the database.
+spatialdata::spatialdb::QueryContext*
+spatialdata::spatialdb::GravityField::createQueryContext(void) const {
+    return new QueryContext(*this);
+} // createQueryContext
+
+
+// ----------------------------------------------------------------------
+// Query the database using scratch storage in query context.
+int
+spatialdata::spatialdb::GravityField::_contextQuery(QueryContext* context,
+                                                    double* vals,
+                                                    const size_t numVals,
+                                                    const double* coords,
+                                                    const size_t numDims,
+                                                    const spatialdata::geocoords::CoordSys* csQuery) const {
+    assert(context);
+    return _query(vals, numVals, coords, numDims, csQuery, context->getConverter());
+} // _contextQuery
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database using scratch storage in query context.
+void
+spatialdata::spatialdb::GravityField::_contextMultiquery(QueryContext* context,
+                                                         double* vals,
+                                                         const size_t numLocs,
+                                                         const size_t numVals,
+                                                         int* err,
+                                                         const double* coords,
+                                                         const size_t numDims,
+                                                         const spatialdata::geocoords::CoordSys* csQuery) const {
+    assert(context);
+    _multiquery(vals, numLocs, numVals, err, coords, numDims, csQuery, context->getConverter());
+} // _contextMultiquery
+
+
+// ----------------------------------------------------------------------
+// Query the database.
+int
+spatialdata::spatialdb::GravityField::_query(double* vals,
+                                             const size_t numVals,
+                                             const double* coords,
+                                             const size_t numDims,
+                                             const spatialdata::geocoords::CoordSys* cs,
+                                             spatialdata::geocoords::Converter* converter) const {
+    assert(cs);
+
+    _checkQuerySize(numVals, _querySize);
 
     if (geocoords::CoordSys::CARTESIAN == cs->getCSType()) {
         for (size_t i = 0; i < _querySize; ++i) {
@@ -186,14 +257,52 @@ spatialdata::spatialdb::GravityField::query(double* vals,
         const geocoords::CSGeo* csGeo = dynamic_cast<const geocoords::CSGeo*>(cs);
         double surfaceNormal[3];
         const int numLocs = 1;
-        csGeo->computeSurfaceNormal(surfaceNormal, coords, numLocs, numDims);
+        const double dx = 1000.0;
+        csGeo->computeSurfaceNormal(surfaceNormal, coords, numLocs, numDims, dx, converter);
         for (size_t i = 0; i < _querySize; ++i) {
             vals[i] = -_acceleration * surfaceNormal[_queryValues[i]];
         } // for
     } // if/else
 
     return 0;
-} // query
+} // _query
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database.
+void
+spatialdata::spatialdb::GravityField::_multiquery(double* vals,
+                                                  const size_t numLocs,
+                                                  const size_t numVals,
+                                                  int* err,
+                                                  const double* coords,
+                                                  const size_t numDims,
+                                                  const spatialdata::geocoords::CoordSys* cs,
+                                                  spatialdata::geocoords::Converter* converter) const {
+    assert(cs);
+
+    _checkQuerySize(numVals, _querySize);
+
+    if (geocoords::CoordSys::CARTESIAN == cs->getCSType()) {
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            for (size_t i = 0; i < _querySize; ++i) {
+                vals[iLoc*numVals+i] = _acceleration*_gravityDir[_queryValues[i]];
+            } // for
+            err[iLoc] = 0;
+        } // for
+    } else {
+        const geocoords::CSGeo* csGeo = dynamic_cast<const geocoords::CSGeo*>(cs);
+        std::vector<double> surfaceNormal(numLocs*numDims);
+        const double dx = 1000.0;
+        csGeo->computeSurfaceNormal(numLocs > 0 ? &surfaceNormal[0] : NULL, coords, numLocs, numDims, dx, converter);
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            for (size_t i = 0; i < _querySize; ++i) {
+                vals[iLoc*numVals+i] = -_acceleration * surfaceNormal[iLoc*numDims+_queryValues[i]];
+            } // for
+            err[iLoc] = 0;
+        } // for
+    } // if/else
+} // _multiquery
 
 
 // End of file
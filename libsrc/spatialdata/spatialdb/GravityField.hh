@@ -88,10 +88,133 @@ public:
               const size_t numDims,
               const spatialdata::geocoords::CoordSys* cs);
 
+    using SpatialDB::multiquery; // Keep float version visible.
+
+    /** Perform multiple queries of the database.
+     *
+     * Surface normals for all locations are computed together, avoiding
+     * the per-location overhead of query().
+     *
+     * @pre Must call open() before multiquery().
+     *
+     * @param vals Array for computed values (output from query), must be
+     *   allocated BEFORE calling multiquery() [numLocs*numVals].
+     * @param numLocsV Number of locations.
+     * @param numValsV Number of values expected.
+     * @param err Array for error flag values (output from query), must be
+     *   allocated BEFORE calling multiquery() [numLocs].
+     * @param numLocsE Number of locations.
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numLocsC Number of locations.
+     * @param numDimsC Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     */
+    void multiquery(double* vals,
+                    const size_t numLocsV,
+                    const size_t numValsV,
+                    int* err,
+                    const size_t numLocsE,
+                    const double* coords,
+                    const size_t numLocsC,
+                    const size_t numDimsC,
+                    const spatialdata::geocoords::CoordSys* csQuery);
+
+    /** Check whether database supports query contexts.
+     *
+     * @returns True if database supports query contexts, false otherwise.
+     */
+    bool supportsQueryContexts(void) const;
+
+    /** Create context for querying the database.
+     *
+     * @pre Must call open() before createQueryContext().
+     *
+     * @returns Query context (caller is responsible for deleting it).
+     */
+    QueryContext* createQueryContext(void) const;
+
 private:
 
     // PRIVATE METHODS ////////////////////////////////////////////////////
 
+    /** Query the database using scratch storage in query context.
+     *
+     * @param context Query context created by createQueryContext().
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate)
+     */
+    int _contextQuery(QueryContext* context,
+                      double* vals,
+                      const size_t numVals,
+                      const double* coords,
+                      const size_t numDims,
+                      const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Perform multiple queries of the database using scratch storage in query context.
+     *
+     * @param context Query context created by createQueryContext().
+     * @param vals Array for computed values (output from query) [numLocs*numVals].
+     * @param numLocs Number of locations.
+     * @param numVals Number of values expected.
+     * @param err Array for error flag values (output from query) [numLocs].
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     */
+    void _contextMultiquery(QueryContext* context,
+                            double* vals,
+                            const size_t numLocs,
+                            const size_t numVals,
+                            int* err,
+                            const double* coords,
+                            const size_t numDims,
+                            const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Query the database.
+     *
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param cs Coordinate system of coordinates.
+     * @param converter Converter for computing surface normal (NULL to use converter of
+     *   coordinate system).
+     *
+     * @returns 0 on success, 1 on failure.
+     */
+    int _query(double* vals,
+               const size_t numVals,
+               const double* coords,
+               const size_t numDims,
+               const spatialdata::geocoords::CoordSys* cs,
+               spatialdata::geocoords::Converter* converter) const;
+
+    /** Perform multiple queries of the database.
+     *
+     * @param vals Array for computed values (output from query) [numLocs*numVals].
+     * @param numLocs Number of locations.
+     * @param numVals Number of values expected.
+     * @param err Array for error flag values (output from query) [numLocs].
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param cs Coordinate system of coordinates.
+     * @param converter Converter for computing surface normal (NULL to use converter of
+     *   coordinate system).
+     */
+    void _multiquery(double* vals,
+                     const size_t numLocs,
+                     const size_t numVals,
+                     int* err,
+                     const double* coords,
+                     const size_t numDims,
+                     const spatialdata::geocoords::CoordSys* cs,
+                     spatialdata::geocoords::Converter* converter) const;
+
     GravityField(const GravityField& data); ///< Not implemented
     const GravityField& operator=(const GravityField& data); ///< Not implemented
 
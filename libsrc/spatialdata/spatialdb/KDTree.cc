@@ -0,0 +1,236 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "KDTree.hh" // implementation of class methods
+
+#include <algorithm> // USES std::nth_element(), std::push_heap(), std::pop_heap(), std::sort_heap()
+#include <stdexcept> // USES std::invalid_argument
+#include <sstream> // USES std::ostringstream
+#include <cassert> // USES assert()
+
+// ----------------------------------------------------------------------
+const size_t spatialdata::spatialdb::KDTree::_leafSize = 8;
+
+// ----------------------------------------------------------------------
+// Default constructor.
+spatialdata::spatialdb::KDTree::KDTree(void) {}
+
+
+// ----------------------------------------------------------------------
+// Default destructor.
+spatialdata::spatialdb::KDTree::~KDTree(void) {
+    deallocate();
+} // destructor
+
+
+// ----------------------------------------------------------------------
+// Deallocate data structures.
+void
+spatialdata::spatialdb::KDTree::deallocate(void) {
+    std::vector<double>().swap(_coords);
+    std::vector<size_t>().swap(_indices);
+    std::vector<unsigned char>().swap(_splitDim);
+} // deallocate
+
+
+// ----------------------------------------------------------------------
+// Build tree over locations.
+void
+spatialdata::spatialdb::KDTree::build(const double* coords,
+                                      const size_t numLocs,
+                                      const size_t spaceDim) {
+    assert( (0 < numLocs && coords) || (0 == numLocs && !coords) );
+    if (( spaceDim < 1) || ( spaceDim > 3) ) {
+        std::ostringstream msg;
+        msg << "Spatial dimension (" << spaceDim << ") of locations for k-d tree must be in the range [1,3].";
+        throw std::invalid_argument(msg.str());
+    } // if
+
+    // Use original ordering while partitioning, then reorder coordinates to match tree.
+    _coords.assign(numLocs*3, 0.0);
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+            _coords[iLoc*3+iDim] = coords[iLoc*spaceDim+iDim];
+        } // for
+    } // for
+    _indices.resize(numLocs);
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        _indices[iLoc] = iLoc;
+    } // for
+    _splitDim.assign(numLocs, 0);
+
+    _build(0, numLocs);
+
+    std::vector<double> coordsTree(numLocs*3);
+    for (size_t iNode = 0; iNode < numLocs; ++iNode) {
+        const size_t iLoc = _indices[iNode];
+        coordsTree[iNode*3+0] = _coords[iLoc*3+0];
+        coordsTree[iNode*3+1] = _coords[iLoc*3+1];
+        coordsTree[iNode*3+2] = _coords[iLoc*3+2];
+    } // for
+    _coords.swap(coordsTree);
+} // build
+
+
+// ----------------------------------------------------------------------
+// Get number of locations in tree.
+size_t
+spatialdata::spatialdb::KDTree::getNumLocs(void) const {
+    return _indices.size();
+} // getNumLocs
+
+
+// ----------------------------------------------------------------------
+// Find location nearest to point.
+size_t
+spatialdata::spatialdb::KDTree::findNearest(const double pt[3]) const {
+    assert(_indices.size() > 0);
+
+    std::vector<Neighbor> neighbors;
+    neighbors.reserve(1);
+    _search(&neighbors, pt, 1, 0, _indices.size());
+    assert(1 == neighbors.size());
+
+    return neighbors[0].second;
+} // findNearest
+
+
+// ----------------------------------------------------------------------
+// Find locations nearest to point.
+void
+spatialdata::spatialdb::KDTree::findNearest(std::vector<size_t>* nearest,
+                                            const double pt[3],
+                                            const size_t numNearest) const {
+    assert(nearest);
+
+    std::vector<Neighbor> neighbors;
+    neighbors.reserve(numNearest);
+    if (numNearest > 0) {
+        _search(&neighbors, pt, numNearest, 0, _indices.size());
+    } // if
+    std::sort_heap(neighbors.begin(), neighbors.end());
+
+    const size_t numFound = neighbors.size();
+    nearest->resize(numFound);
+    for (size_t i = 0; i < numFound; ++i) {
+        (*nearest)[i] = neighbors[i].second;
+    } // for
+} // findNearest
+
+
+// ----------------------------------------------------------------------
+// Recursively build subtree over range of locations.
+void
+spatialdata::spatialdb::KDTree::_build(const size_t begin,
+                                       const size_t end) {
+    if (end - begin <= _leafSize) {
+        return;
+    } // if
+
+    // Split along dimension with largest extent.
+    double xMin[3];
+    double xMax[3];
+    for (size_t iDim = 0; iDim < 3; ++iDim) {
+        xMin[iDim] = _coords[_indices[begin]*3+iDim];
+        xMax[iDim] = xMin[iDim];
+    } // for
+    for (size_t iNode = begin+1; iNode < end; ++iNode) {
+        const double* xyz = &_coords[_indices[iNode]*3];
+        for (size_t iDim = 0; iDim < 3; ++iDim) {
+            xMin[iDim] = std::min(xMin[iDim], xyz[iDim]);
+            xMax[iDim] = std::max(xMax[iDim], xyz[iDim]);
+        } // for
+    } // for
+    size_t dim = 0;
+    for (size_t iDim = 1; iDim < 3; ++iDim) {
+        if (xMax[iDim] - xMin[iDim] > xMax[dim] - xMin[dim]) {
+            dim = iDim;
+        } // if
+    } // for
+
+    const size_t mid = begin + (end - begin) / 2;
+    const std::vector<double>& coords = _coords;
+    std::nth_element(_indices.begin()+begin, _indices.begin()+mid, _indices.begin()+end,
+                     [&coords, dim](const size_t a,
+                                    const size_t b) {
+        return coords[a*3+dim] < coords[b*3+dim] || (coords[a*3+dim] == coords[b*3+dim] && a < b);
+    });
+    _splitDim[mid] = (unsigned char)(dim);
+
+    _build(begin, mid);
+    _build(mid+1, end);
+} // _build
+
+
+// ----------------------------------------------------------------------
+// Recursively search subtree over range of locations.
+void
+spatialdata::spatialdb::KDTree::_search(std::vector<Neighbor>* neighbors,
+                                        const double pt[3],
+                                        const size_t numNearest,
+                                        const size_t begin,
+                                        const size_t end) const {
+    assert(neighbors);
+
+    if (end - begin <= _leafSize) {
+        for (size_t iNode = begin; iNode < end; ++iNode) {
+            _visit(neighbors, pt, numNearest, iNode);
+        } // for
+        return;
+    } // if
+
+    const size_t mid = begin + (end - begin) / 2;
+    _visit(neighbors, pt, numNearest, mid);
+
+    const size_t dim = _splitDim[mid];
+    const double dx = pt[dim] - _coords[mid*3+dim];
+    if (dx < 0.0) {
+        _search(neighbors, pt, numNearest, begin, mid);
+        if (( neighbors->size() < numNearest) || ( dx*dx <= neighbors->front().first) ) {
+            _search(neighbors, pt, numNearest, mid+1, end);
+        } // if
+    } else {
+        _search(neighbors, pt, numNearest, mid+1, end);
+        if (( neighbors->size() < numNearest) || ( dx*dx <= neighbors->front().first) ) {
+            _search(neighbors, pt, numNearest, begin, mid);
+        } // if
+    } // if/else
+} // _search
+
+
+// ----------------------------------------------------------------------
+// Add location to heap of nearest locations if it is closer than current candidates.
+void
+spatialdata::spatialdb::KDTree::_visit(std::vector<Neighbor>* neighbors,
+                                       const double pt[3],
+                                       const size_t numNearest,
+                                       const size_t iNode) const {
+    assert(neighbors);
+
+    const double* xyz = &_coords[iNode*3];
+    const double abX = xyz[0] - pt[0];
+    const double abY = xyz[1] - pt[1];
+    const double abZ = xyz[2] - pt[2];
+    const Neighbor neighbor(abX*abX + abY*abY + abZ*abZ, _indices[iNode]);
+
+    if (neighbors->size() < numNearest) {
+        neighbors->push_back(neighbor);
+        std::push_heap(neighbors->begin(), neighbors->end());
+    } else if (neighbor < neighbors->front()) {
+        std::pop_heap(neighbors->begin(), neighbors->end());
+        neighbors->back() = neighbor;
+        std::push_heap(neighbors->begin(), neighbors->end());
+    } // if/else
+} // _visit
+
+
+// End of file
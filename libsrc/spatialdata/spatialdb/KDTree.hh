@@ -0,0 +1,137 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+#pragma once
+
+#include "spatialdbfwd.hh" // forward declarations
+
+#include <vector> // HASA std::vector
+#include <utility> // USES std::pair
+#include <cstddef> // USES size_t
+
+/** Static k-d tree for finding nearest locations in a scattered set of points.
+ *
+ * The tree is built once from an array of coordinates and is not modified by
+ * queries. Coordinates are padded to 3-D with zeros so that distances match
+ * those computed by SimpleDBQuery. Ties in distance are broken by selecting
+ * the location with the lower index.
+ */
+class spatialdata::spatialdb::KDTree { // KDTree
+    friend class TestKDTree; // unit testing
+
+public:
+
+    // PUBLIC METHODS /////////////////////////////////////////////////////
+
+    /// Default constructor.
+    KDTree(void);
+
+    /// Default destructor.
+    ~KDTree(void);
+
+    /// Deallocate data structures.
+    void deallocate(void);
+
+    /** Build tree over locations.
+     *
+     * @param coords Coordinates of locations [numLocs*spaceDim].
+     * @param numLocs Number of locations.
+     * @param spaceDim Spatial dimension of coordinates.
+     */
+    void build(const double* coords,
+               const size_t numLocs,
+               const size_t spaceDim);
+
+    /** Get number of locations in tree.
+     *
+     * @returns Number of locations.
+     */
+    size_t getNumLocs(void) const;
+
+    /** Find location nearest to point.
+     *
+     * @pre Must call build() before findNearest().
+     *
+     * @param pt Coordinates of point in 3-D space.
+     * @returns Index of nearest location.
+     */
+    size_t findNearest(const double pt[3]) const;
+
+    /** Find locations nearest to point.
+     *
+     * @pre Must call build() before findNearest().
+     *
+     * @param nearest Indices of nearest locations ordered by increasing distance.
+     * @param pt Coordinates of point in 3-D space.
+     * @param numNearest Maximum number of locations to find.
+     */
+    void findNearest(std::vector<size_t>* nearest,
+                     const double pt[3],
+                     const size_t numNearest) const;
+
+private:
+
+    // PRIVATE TYPEDEFS ///////////////////////////////////////////////////
+
+    typedef std::pair<double, size_t> Neighbor; ///< Squared distance and index of location.
+
+private:
+
+    // PRIVATE METHODS ////////////////////////////////////////////////////
+
+    /** Recursively build subtree over range of locations.
+     *
+     * @param begin Index of first location in range.
+     * @param end Index one past last location in range.
+     */
+    void _build(const size_t begin,
+                const size_t end);
+
+    /** Recursively search subtree over range of locations.
+     *
+     * @param neighbors Max-heap of nearest locations found so far.
+     * @param pt Coordinates of point in 3-D space.
+     * @param numNearest Maximum number of locations to find.
+     * @param begin Index of first location in range.
+     * @param end Index one past last location in range.
+     */
+    void _search(std::vector<Neighbor>* neighbors,
+                 const double pt[3],
+                 const size_t numNearest,
+                 const size_t begin,
+                 const size_t end) const;
+
+    /** Add location to heap of nearest locations if it is closer than current candidates.
+     *
+     * @param neighbors Max-heap of nearest locations found so far.
+     * @param pt Coordinates of point in 3-D space.
+     * @param numNearest Maximum number of locations to find.
+     * @param iNode Index of location in tree.
+     */
+    void _visit(std::vector<Neighbor>* neighbors,
+                const double pt[3],
+                const size_t numNearest,
+                const size_t iNode) const;
+
+    KDTree(const KDTree&); ///< Not implemented
+    const KDTree& operator=(const KDTree&); ///< Not implemented
+
+private:
+
+    // PRIVATE MEMBERS ////////////////////////////////////////////////////
+
+    std::vector<double> _coords; ///< Coordinates of locations in tree order [numLocs*3].
+    std::vector<size_t> _indices; ///< Original index of locations in tree order.
+    std::vector<unsigned char> _splitDim; ///< Splitting dimension of each node.
+
+    static const size_t _leafSize; ///< Maximum number of locations in a leaf.
+
+}; // class KDTree
+
+// End of file
@@ -0,0 +1,80 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "QueryContext.hh" // Implementation of class methods
+
+#include "SpatialDB.hh" // USES SpatialDB
+#include "spatialdata/geocoords/Converter.hh" // HASA Converter
+
+#include <cassert> // USES assert()
+
+// ----------------------------------------------------------------------
+// Constructor.
+spatialdata::spatialdb::QueryContext::QueryContext(const SpatialDB& db) :
+    _db(db),
+    _converter(new spatialdata::geocoords::Converter) {}
+
+
+// ----------------------------------------------------------------------
+// Default destructor.
+spatialdata::spatialdb::QueryContext::~QueryContext(void) {
+    delete _converter;_converter = NULL;
+} // destructor
+
+
+// ----------------------------------------------------------------------
+// Get spatial database associated with context.
+const spatialdata::spatialdb::SpatialDB&
+spatialdata::spatialdb::QueryContext::getDB(void) const {
+    return _db;
+} // getDB
+
+
+// ----------------------------------------------------------------------
+// Get converter for query points owned by context.
+spatialdata::geocoords::Converter*
+spatialdata::spatialdb::QueryContext::getConverter(void) {
+    return _converter;
+} // getConverter
+
+
+// ----------------------------------------------------------------------
+// Query the database.
+int
+spatialdata::spatialdb::QueryContext::query(double* vals,
+                                            const size_t numVals,
+                                            const double* coords,
+                                            const size_t numDims,
+                                            const spatialdata::geocoords::CoordSys* csQuery) {
+    return _db._contextQuery(this, vals, numVals, coords, numDims, csQuery);
+} // query
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database.
+void
+spatialdata::spatialdb::QueryContext::multiquery(double* vals,
+                                                 const size_t numLocsV,
+                                                 const size_t numValsV,
+                                                 int* err,
+                                                 const size_t numLocsE,
+                                                 const double* coords,
+                                                 const size_t numLocsC,
+                                                 const size_t numDimsC,
+                                                 const spatialdata::geocoords::CoordSys* csQuery) {
+    assert(SpatialDB::_isMultiqueryConsistent(vals, numLocsV, numValsV, err, numLocsE, coords, numLocsC, numDimsC));
+
+    _db._contextMultiquery(this, vals, numLocsV, numValsV, err, coords, numDimsC, csQuery);
+} // multiquery
+
+
+// End of file
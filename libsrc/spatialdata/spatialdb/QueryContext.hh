@@ -0,0 +1,112 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+#pragma once
+
+#include "spatialdbfwd.hh"
+#include "spatialdata/geocoords/geocoordsfwd.hh"
+
+#include <cstddef> // USES size_t
+
+/** Context for querying an opened spatial database.
+ *
+ * The context holds all of the scratch storage modified during queries, so
+ * that queries of one opened spatial database using different contexts may
+ * be done concurrently (for example, one context per thread). The database
+ * itself is only read during queries using a context.
+ *
+ * Contexts are created with SpatialDB::createQueryContext() after opening the
+ * database and setting the values to be returned by queries. Create new
+ * contexts after changing the query values or query type, and delete all
+ * contexts before closing the database.
+ */
+class spatialdata::spatialdb::QueryContext {
+public:
+
+    // PUBLIC METHODS /////////////////////////////////////////////////////
+
+    /** Constructor.
+     *
+     * @param db Spatial database.
+     */
+    QueryContext(const SpatialDB& db);
+
+    /// Default destructor.
+    virtual ~QueryContext(void);
+
+    /** Get spatial database associated with context.
+     *
+     * @returns Spatial database.
+     */
+    const SpatialDB& getDB(void) const;
+
+    /** Get converter for query points owned by context.
+     *
+     * @returns Converter.
+     */
+    spatialdata::geocoords::Converter* getConverter(void);
+
+    /** Query the database.
+     *
+     * @note vals should be preallocated to accommodate numVals values.
+     *
+     * @param vals Array for computed values (output from query), must be
+     *   allocated BEFORE calling query().
+     * @param numVals Number of values expected (size of pVals array)
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate)
+     */
+    int query(double* vals,
+              const size_t numVals,
+              const double* coords,
+              const size_t numDims,
+              const spatialdata::geocoords::CoordSys* csQuery);
+
+    /** Perform multiple queries of the database.
+     *
+     * @param vals Array for computed values (output from query), must be
+     *   allocated BEFORE calling multiquery() [numLocs*numVals].
+     * @param numLocsV Number of locations.
+     * @param numValsV Number of values expected.
+     * @param err Array for error flag values (output from query), must be
+     *   allocated BEFORE calling multiquery() [numLocs].
+     * @param numLocsE Number of locations.
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numLocsC Number of locations.
+     * @param numDimsC Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     */
+    void multiquery(double* vals,
+                    const size_t numLocsV,
+                    const size_t numValsV,
+                    int* err,
+                    const size_t numLocsE,
+                    const double* coords,
+                    const size_t numLocsC,
+                    const size_t numDimsC,
+                    const spatialdata::geocoords::CoordSys* csQuery);
+
+    // PRIVATE METHODS ////////////////////////////////////////////////////
+private:
+
+    QueryContext(const QueryContext&); ///< Not implemented
+    const QueryContext& operator=(const QueryContext&); ///< Not implemented
+
+    // PRIVATE MEMBERS ////////////////////////////////////////////////////
+private:
+
+    const SpatialDB& _db; ///< Spatial database.
+    spatialdata::geocoords::Converter* _converter; ///< Convert query points to coordinate system of database.
+
+}; // class QueryContext
+
+// End of file
@@ -13,17 +13,43 @@
 #include "SCECCVMH.hh" // Implementation of class methods
 
 #include "GocadVoxet.hh" // USES GocadVoxet
+#include "QueryContext.hh" // USES QueryContext
 
 #include "spatialdata/geocoords/CSGeo.hh" // USES CSGeo
 #include "spatialdata/geocoords/Converter.hh" // USES Converter
 
 #include <math.h> // USES pow()
 #include <sstream> // USES std::ostringstream
+#include <vector> // USES std::vector
 #include <stdexcept> // USES std::logic_error
 #include <cstring> // USES memcpy()
 #include <strings.h> // USES strcasecmp()
 #include <cassert> // USES assert()
 
+// ----------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        namespace _sceccvmh {
+            /** Copy subset of locations.
+             *
+             * @param xyzSubset Array of locations in subset [indices.size()*3].
+             * @param indices Indices of locations in subset.
+             * @param xyz Array of all locations.
+             */
+            void gather(std::vector<double>* xyzSubset,
+                        const std::vector<size_t>& indices,
+                        const double* xyz) {
+                assert(xyzSubset);
+                xyzSubset->resize(3*indices.size());
+                for (size_t i = 0; i < indices.size(); ++i) {
+                    memcpy(&(*xyzSubset)[3*i], &xyz[3*indices[i]], 3*sizeof(double));
+                } // for
+            } // gather
+
+        } // _sceccvmh
+    } // spatialdb
+} // spatialdata
+
 // ----------------------------------------------------------------------
 // Constructor
 spatialdata::spatialdb::SCECCVMH::SCECCVMH(void) :
@@ -45,7 +71,10 @@ spatialdata::spatialdb::SCECCVMH::SCECCVMH(void) :
     _minVs(0.0),
     _queryValues(NULL),
     _querySize(7),
-    _squashTopo(false) {
+    _squashTopo(false),
+    _useMemoryMap(false),
+    _useBlockedLayout(false),
+    _queryType(NEAREST) {
     assert(_csUTM);
     _csUTM->setString("+proj=utm +zone=11 +datum=NAD27 +units=m +type=crs");
 
@@ -101,48 +130,68 @@ spatialdata::spatialdb::SCECCVMH::open(void) {
     if (0 == _laLowResVp) {
         _laLowResVp = new GocadVoxet;
     }
+    _laLowResVp->setUseMemoryMap(_useMemoryMap);
+    _laLowResVp->setUseBlockedLayout(_useBlockedLayout);
     _laLowResVp->read(_dataDir.c_str(), "LA_LR.vo", "\"VINT1D\"");
 
     if (0 == _laLowResTag) {
         _laLowResTag = new GocadVoxet;
     }
+    _laLowResTag->setUseMemoryMap(_useMemoryMap);
+    _laLowResTag->setUseBlockedLayout(_useBlockedLayout);
     _laLowResTag->read(_dataDir.c_str(), "LA_LR.vo", "\"flag\"");
 
     if (0 == _laHighResVp) {
         _laHighResVp = new GocadVoxet;
     }
+    _laHighResVp->setUseMemoryMap(_useMemoryMap);
+    _laHighResVp->setUseBlockedLayout(_useBlockedLayout);
     _laHighResVp->read(_dataDir.c_str(), "LA_HR.vo", "\"vp\"");
     if (0 == _laHighResTag) {
         _laHighResTag = new GocadVoxet;
     }
+    _laHighResTag->setUseMemoryMap(_useMemoryMap);
+    _laHighResTag->setUseBlockedLayout(_useBlockedLayout);
     _laHighResTag->read(_dataDir.c_str(), "LA_HR.vo", "\"tag\"");
 
     if (0 == _crustMantleVp) {
         _crustMantleVp = new GocadVoxet;
     }
+    _crustMantleVp->setUseMemoryMap(_useMemoryMap);
+    _crustMantleVp->setUseBlockedLayout(_useBlockedLayout);
     _crustMantleVp->read(_dataDir.c_str(), "CM.vo", "\"cvp\"");
     if (0 == _crustMantleVs) {
         _crustMantleVs = new GocadVoxet;
     }
+    _crustMantleVs->setUseMemoryMap(_useMemoryMap);
+    _crustMantleVs->setUseBlockedLayout(_useBlockedLayout);
     _crustMantleVs->read(_dataDir.c_str(), "CM.vo", "\"cvs\"");
     if (0 == _crustMantleTag) {
         _crustMantleTag = new GocadVoxet;
     }
+    _crustMantleTag->setUseMemoryMap(_useMemoryMap);
+    _crustMantleTag->setUseBlockedLayout(_useBlockedLayout);
     _crustMantleTag->read(_dataDir.c_str(), "CM.vo", "\"tag\"");
 
     if (0 == _topoElev) {
         _topoElev = new GocadVoxet;
     }
+    _topoElev->setUseMemoryMap(_useMemoryMap);
+    _topoElev->setUseBlockedLayout(_useBlockedLayout);
     _topoElev->read(_dataDir.c_str(), "topo.vo", "\"topo\"");
 
     if (0 == _baseDepth) {
         _baseDepth = new GocadVoxet;
     }
+    _baseDepth->setUseMemoryMap(_useMemoryMap);
+    _baseDepth->setUseBlockedLayout(_useBlockedLayout);
     _baseDepth->read(_dataDir.c_str(), "base.vo", "\"base\"");
 
     if (0 == _mohoDepth) {
         _mohoDepth = new GocadVoxet;
     }
+    _mohoDepth->setUseMemoryMap(_useMemoryMap);
+    _mohoDepth->setUseBlockedLayout(_useBlockedLayout);
     _mohoDepth->read(_dataDir.c_str(), "moho.vo", "\"moho\"");
 } // open
 
@@ -240,35 +289,107 @@ spatialdata::spatialdb::SCECCVMH::query(double* vals,
                                         const double* coords,
                                         const size_t numDims,
                                         const spatialdata::geocoords::CoordSys* csQuery) {
-    if (0 == _querySize) {
+    return _query(vals, numVals, coords, numDims, csQuery, _converter);
+} // query
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database.
+void
+spatialdata::spatialdb::SCECCVMH::multiquery(double* vals,
+                                             const size_t numLocsV,
+                                             const size_t numValsV,
+                                             int* err,
+                                             const size_t numLocsE,
+                                             const double* coords,
+                                             const size_t numLocsC,
+                                             const size_t numDimsC,
+                                             const spatialdata::geocoords::CoordSys* csQuery) {
+    assert(_isMultiqueryConsistent(vals, numLocsV, numValsV, err, numLocsE, coords, numLocsC, numDimsC));
+
+    if (_parallelMultiquery(vals, numLocsC, numValsV, err, coords, numDimsC, csQuery)) {
+        return;
+    } // if
+    _multiquery(vals, numLocsC, numValsV, err, coords, numDimsC, csQuery, _converter);
+} // multiquery
+
+
+// ----------------------------------------------------------------------
+// Check whether database supports query contexts.
+bool
+spatialdata::spatialdb::SCECCVMH::supportsQueryContexts(void) const {
+    return true;
+} // supportsQueryContexts
+
+
+// ----------------------------------------------------------------------
+// Create context for querying the database.
+spatialdata::spatialdb::QueryContext*
+spatialdata::spatialdb::SCECCVMH::createQueryContext(void) const {
+    if (!_laLowResVp) {
         std::ostringstream msg;
-        msg << "Values to be returned by spatial database " << getDescription() << "\n"
-            << "have not been set. Please call setQueryValues() before query().\n";
+        msg << "Spatial database " << getDescription() << " has not been opened.\n"
+            << "Please call open() before calling createQueryContext().";
         throw std::logic_error(msg.str());
-    } else if (numVals != _querySize) {
-        std::ostringstream msg;
-        msg << "Number of values to be returned by spatial database "
-            << getDescription() << "\n"
-            << "(" << _querySize << ") does not match size of array provided ("
-            << numVals << ").\n";
-        throw std::invalid_argument(msg.str());
-    } else if (3 != numDims) {
-        std::ostringstream msg;
-        msg << "Spatial dimension (" << numDims << ") when querying SCEC CVM-H must be 3.";
-        throw std::invalid_argument(msg.str());
     } // if
 
+    return new QueryContext(*this);
+} // createQueryContext
+
+
+// ----------------------------------------------------------------------
+// Query the database using scratch storage in query context.
+int
+spatialdata::spatialdb::SCECCVMH::_contextQuery(QueryContext* context,
+                                                double* vals,
+                                                const size_t numVals,
+                                                const double* coords,
+                                                const size_t numDims,
+                                                const spatialdata::geocoords::CoordSys* csQuery) const {
+    assert(context);
+    return _query(vals, numVals, coords, numDims, csQuery, context->getConverter());
+} // _contextQuery
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database using scratch storage in query context.
+void
+spatialdata::spatialdb::SCECCVMH::_contextMultiquery(QueryContext* context,
+                                                     double* vals,
+                                                     const size_t numLocs,
+                                                     const size_t numVals,
+                                                     int* err,
+                                                     const double* coords,
+                                                     const size_t numDims,
+                                                     const spatialdata::geocoords::CoordSys* csQuery) const {
+    assert(context);
+    _multiquery(vals, numLocs, numVals, err, coords, numDims, csQuery, context->getConverter());
+} // _contextMultiquery
+
+
+// ----------------------------------------------------------------------
+// Query the database.
+int
+spatialdata::spatialdb::SCECCVMH::_query(double* vals,
+                                         const size_t numVals,
+                                         const double* coords,
+                                         const size_t numDims,
+                                         const spatialdata::geocoords::CoordSys* csQuery,
+                                         spatialdata::geocoords::Converter* converter) const {
+    _checkQueryArgs(numVals, numDims);
+
     // Convert coordinates to UTM
-    memcpy(_xyzUTM, coords, numDims*sizeof(double));
-    assert(_converter);
-    _converter->convert(_xyzUTM, 1, numDims, _csUTM, csQuery);
+    double xyzUTM[3];
+    memcpy(xyzUTM, coords, numDims*sizeof(double));
+    assert(converter);
+    converter->convert(xyzUTM, 1, numDims, _csUTM, csQuery);
 
     bool haveTopo = false;
     double topoElev = 0;
-    if (_squashTopo && ( _xyzUTM[2] > _squashLimit) ) {
-        _topoElev->queryNearest(&topoElev, _xyzUTM);
+    if (_squashTopo && ( xyzUTM[2] > _squashLimit) ) {
+        _queryVoxet(_topoElev, &topoElev, xyzUTM, true);
         haveTopo = true;
-        _xyzUTM[2] += topoElev;
+        xyzUTM[2] += topoElev;
     } // if
 
     int outsideVoxet = 0;
@@ -278,7 +399,7 @@ spatialdata::spatialdb::SCECCVMH::query(double* vals,
     for (size_t iVal = 0; iVal < numVals; ++iVal) {
         switch (_queryValues[iVal]) {
         case QUERY_VP:
-            outsideVoxet = _queryVp(&vals[iVal]);
+            outsideVoxet = _queryVp(&vals[iVal], xyzUTM);
             if (outsideVoxet) {
                 queryFlag |= outsideVoxet;
             }
@@ -287,7 +408,7 @@ spatialdata::spatialdb::SCECCVMH::query(double* vals,
             break;
         case QUERY_DENSITY:
             if (!haveVp) {
-                outsideVoxet = _queryVp(&vp);
+                outsideVoxet = _queryVp(&vp, xyzUTM);
                 haveVp = true;
                 if (outsideVoxet) {
                     queryFlag |= outsideVoxet;
@@ -297,7 +418,7 @@ spatialdata::spatialdb::SCECCVMH::query(double* vals,
             break;
         case QUERY_VS:
             if (!haveVp) {
-                outsideVoxet = _queryVp(&vp);
+                outsideVoxet = _queryVp(&vp, xyzUTM);
                 haveVp = true;
                 if (outsideVoxet) {
                     queryFlag |= outsideVoxet;
@@ -308,7 +429,7 @@ spatialdata::spatialdb::SCECCVMH::query(double* vals,
         case QUERY_TOPOELEV:
             if (!haveTopo) {
                 assert(0 != _topoElev);
-                outsideVoxet = _topoElev->queryNearest(&vals[iVal], _xyzUTM);
+                outsideVoxet = _queryVoxet(_topoElev, &vals[iVal], xyzUTM, true);
                 if (outsideVoxet) {
                     queryFlag |= outsideVoxet;
                 }
@@ -318,20 +439,20 @@ spatialdata::spatialdb::SCECCVMH::query(double* vals,
             break;
         case QUERY_BASEDEPTH:
             assert(0 != _baseDepth);
-            outsideVoxet = _baseDepth->queryNearest(&vals[iVal], _xyzUTM);
+            outsideVoxet = _queryVoxet(_baseDepth, &vals[iVal], xyzUTM, true);
             if (outsideVoxet) {
                 queryFlag |= outsideVoxet;
             }
             break;
         case QUERY_MOHODEPTH:
             assert(0 != _mohoDepth);
-            outsideVoxet = _mohoDepth->queryNearest(&vals[iVal], _xyzUTM);
+            outsideVoxet = _queryVoxet(_mohoDepth, &vals[iVal], xyzUTM, true);
             if (outsideVoxet) {
                 queryFlag |= outsideVoxet;
             }
             break;
         case QUERY_VPTAG:
-            outsideVoxet = _queryTag(&vals[iVal]);
+            outsideVoxet = _queryTag(&vals[iVal], xyzUTM);
             if (outsideVoxet) {
                 queryFlag |= outsideVoxet;
             }
@@ -342,28 +463,296 @@ spatialdata::spatialdb::SCECCVMH::query(double* vals,
 
     }
     return queryFlag;
-} // query
+} // _query
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database.
+void
+spatialdata::spatialdb::SCECCVMH::_multiquery(double* vals,
+                                              const size_t numLocs,
+                                              const size_t numVals,
+                                              int* err,
+                                              const double* coords,
+                                              const size_t numDims,
+                                              const spatialdata::geocoords::CoordSys* csQuery,
+                                              spatialdata::geocoords::Converter* converter) const {
+    _checkQueryArgs(numVals, numDims);
+    if (0 == numLocs) {
+        return;
+    } // if
+
+    // Convert coordinates of all locations to UTM at once.
+    std::vector<double> xyzUTM(coords, coords + numLocs*numDims);
+    assert(converter);
+    converter->convert(&xyzUTM[0], numLocs, numDims, _csUTM, csQuery);
+
+    bool needVp = false;
+    bool needTopo = false;
+    bool needBase = false;
+    bool needMoho = false;
+    bool needTag = false;
+    for (size_t iVal = 0; iVal < numVals; ++iVal) {
+        switch (_queryValues[iVal]) {
+        case QUERY_VP:
+        case QUERY_VS:
+        case QUERY_DENSITY:
+            needVp = true;
+            break;
+        case QUERY_TOPOELEV:
+            needTopo = true;
+            break;
+        case QUERY_BASEDEPTH:
+            needBase = true;
+            break;
+        case QUERY_MOHODEPTH:
+            needMoho = true;
+            break;
+        case QUERY_VPTAG:
+            needTag = true;
+            break;
+        default:
+            assert(0);
+        } // switch
+    } // for
+
+    // Query topography at original locations for squashing and topography values.
+    std::vector<size_t> squashed;
+    if (_squashTopo) {
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            if (xyzUTM[3*iLoc+2] > _squashLimit) {
+                squashed.push_back(iLoc);
+            } // if
+        } // for
+    } // if
+    std::vector<double> topoElev;
+    std::vector<int> topoFlags;
+    if (needTopo) {
+        topoElev.resize(numLocs);
+        topoFlags.resize(numLocs);
+        _queryVoxet(_topoElev, &topoElev[0], &topoFlags[0], &xyzUTM[0], numLocs, true);
+        for (size_t i = 0; i < squashed.size(); ++i) {
+            topoFlags[squashed[i]] = 0;
+        } // for
+    } else if (squashed.size() > 0) {
+        std::vector<double> xyzSquashed;
+        _sceccvmh::gather(&xyzSquashed, squashed, &xyzUTM[0]);
+        std::vector<double> topoSquashed(squashed.size());
+        std::vector<int> flagsSquashed(squashed.size());
+        _queryVoxet(_topoElev, &topoSquashed[0], &flagsSquashed[0], &xyzSquashed[0], squashed.size(), true);
+        topoElev.resize(numLocs);
+        for (size_t i = 0; i < squashed.size(); ++i) {
+            topoElev[squashed[i]] = topoSquashed[i];
+        } // for
+    } // if/else
+    for (size_t i = 0; i < squashed.size(); ++i) {
+        xyzUTM[3*squashed[i]+2] += topoElev[squashed[i]];
+    } // for
+
+    // Query each voxet once for all locations.
+    std::vector<double> vp, baseDepth, mohoDepth, tag;
+    std::vector<int> vpFlags, baseFlags, mohoFlags, tagFlags;
+    if (needVp) {
+        vp.resize(numLocs);
+        vpFlags.resize(numLocs);
+        _multiqueryVp(&vp[0], &vpFlags[0], &xyzUTM[0], numLocs);
+    } // if
+    if (needBase) {
+        baseDepth.resize(numLocs);
+        baseFlags.resize(numLocs);
+        _queryVoxet(_baseDepth, &baseDepth[0], &baseFlags[0], &xyzUTM[0], numLocs, true);
+    } // if
+    if (needMoho) {
+        mohoDepth.resize(numLocs);
+        mohoFlags.resize(numLocs);
+        _queryVoxet(_mohoDepth, &mohoDepth[0], &mohoFlags[0], &xyzUTM[0], numLocs, true);
+    } // if
+    if (needTag) {
+        tag.resize(numLocs);
+        tagFlags.resize(numLocs);
+        _multiqueryTag(&tag[0], &tagFlags[0], &xyzUTM[0], numLocs);
+    } // if
+
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        double* valsLoc = &vals[iLoc*numVals];
+        int queryFlag = 0;
+        for (size_t iVal = 0; iVal < numVals; ++iVal) {
+            switch (_queryValues[iVal]) {
+            case QUERY_VP:
+                valsLoc[iVal] = vp[iLoc];
+                queryFlag |= vpFlags[iLoc];
+                break;
+            case QUERY_DENSITY:
+                valsLoc[iVal] = _calcDensity(vp[iLoc]);
+                queryFlag |= vpFlags[iLoc];
+                break;
+            case QUERY_VS:
+                valsLoc[iVal] = _calcVs(vp[iLoc]);
+                queryFlag |= vpFlags[iLoc];
+                break;
+            case QUERY_TOPOELEV:
+                valsLoc[iVal] = topoElev[iLoc];
+                queryFlag |= topoFlags[iLoc];
+                break;
+            case QUERY_BASEDEPTH:
+                valsLoc[iVal] = baseDepth[iLoc];
+                queryFlag |= baseFlags[iLoc];
+                break;
+            case QUERY_MOHODEPTH:
+                valsLoc[iVal] = mohoDepth[iLoc];
+                queryFlag |= mohoFlags[iLoc];
+                break;
+            case QUERY_VPTAG:
+                valsLoc[iVal] = tag[iLoc];
+                queryFlag |= tagFlags[iLoc];
+                break;
+            default:
+                assert(0);
+            } // switch
+        } // for
+        err[iLoc] = queryFlag;
+    } // for
+} // _multiquery
+
+
+// ----------------------------------------------------------------------
+// Check number of values and spatial dimension of query.
+void
+spatialdata::spatialdb::SCECCVMH::_checkQueryArgs(const size_t numVals,
+                                                  const size_t numDims) const {
+    _checkQuerySize(numVals, _querySize);
+    if (3 != numDims) {
+        std::ostringstream msg;
+        msg << "Spatial dimension (" << numDims << ") when querying SCEC CVM-H must be 3.";
+        throw std::invalid_argument(msg.str());
+    } // if
+} // _checkQueryArgs
+
+
+// ----------------------------------------------------------------------
+// Query voxet using the query type.
+int
+spatialdata::spatialdb::SCECCVMH::_queryVoxet(const GocadVoxet* voxet,
+                                              double* value,
+                                              const double xyzUTM[3],
+                                              const bool clamp) const {
+    assert(voxet);
+
+    switch (_queryType) {
+    case NEAREST:
+        return (clamp) ? voxet->queryNearest(value, xyzUTM) : voxet->query(value, xyzUTM);
+    case LINEAR:
+        return voxet->queryLinear(value, xyzUTM, clamp);
+    default:
+        assert(0);
+        throw std::logic_error("Unknown query type in SCECCVMH::_queryVoxet().");
+    } // switch
+} // _queryVoxet
+
+
+// ----------------------------------------------------------------------
+// Query voxet using the query type for multiple locations.
+void
+spatialdata::spatialdb::SCECCVMH::_queryVoxet(const GocadVoxet* voxet,
+                                              double* values,
+                                              int* flags,
+                                              const double* xyzUTM,
+                                              const size_t numLocs,
+                                              const bool clamp) const {
+    assert(voxet);
+
+    switch (_queryType) {
+    case NEAREST:
+        if (clamp) {
+            voxet->queryNearest(values, flags, xyzUTM, numLocs);
+        } else {
+            voxet->query(values, flags, xyzUTM, numLocs);
+        } // if/else
+        break;
+    case LINEAR:
+        voxet->queryLinear(values, flags, xyzUTM, numLocs, clamp);
+        break;
+    default:
+        assert(0);
+        throw std::logic_error("Unknown query type in SCECCVMH::_queryVoxet().");
+    } // switch
+} // _queryVoxet
+
+
+// ----------------------------------------------------------------------
+// Perform query for Vp at multiple locations.
+void
+spatialdata::spatialdb::SCECCVMH::_multiqueryVp(double* vp,
+                                                int* flags,
+                                                const double* xyzUTM,
+                                                const size_t numLocs) const {
+    // Try first querying low-res model
+    _queryVoxet(_laLowResVp, vp, flags, xyzUTM, numLocs, false);
+
+    std::vector<size_t> inside, outside;
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        if (flags[iLoc]) {
+            outside.push_back(iLoc);
+        } else {
+            inside.push_back(iLoc);
+        } // if/else
+    } // for
+
+    std::vector<double> xyzSubset, vpSubset;
+    std::vector<int> flagsSubset;
+    if (inside.size() > 0) {
+        // If inside low-res model, use high-res model where available.
+        _sceccvmh::gather(&xyzSubset, inside, xyzUTM);
+        vpSubset.resize(inside.size());
+        flagsSubset.resize(inside.size());
+        _queryVoxet(_laHighResVp, &vpSubset[0], &flagsSubset[0], &xyzSubset[0], inside.size(), false);
+        for (size_t i = 0; i < inside.size(); ++i) {
+            if (!flagsSubset[i]) {
+                vp[inside[i]] = vpSubset[i];
+            } // if
+        } // for
+    } // if
+    if (outside.size() > 0) {
+        // If outside low-res model, use crust/mantle model.
+        _sceccvmh::gather(&xyzSubset, outside, xyzUTM);
+        vpSubset.resize(outside.size());
+        flagsSubset.resize(outside.size());
+        _queryVoxet(_crustMantleVp, &vpSubset[0], &flagsSubset[0], &xyzSubset[0], outside.size(), true);
+        for (size_t i = 0; i < outside.size(); ++i) {
+            vp[outside[i]] = vpSubset[i];
+            flags[outside[i]] = flagsSubset[i];
+        } // for
+    } // if
+
+    const double minVp = _minVp();
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        if (!flags[iLoc] && (vp[iLoc] < minVp)) {
+            vp[iLoc] = minVp;
+        } // if
+    } // for
+} // _multiqueryVp
 
 
 // ----------------------------------------------------------------------
 // Perform query for Vp.
 int
-spatialdata::spatialdb::SCECCVMH::_queryVp(double* vp) {
+spatialdata::spatialdb::SCECCVMH::_queryVp(double* vp,
+                                           const double xyzUTM[3]) const {
     int outsideVoxet = 0;
 
     // Try first querying low-res model
-    outsideVoxet = _laLowResVp->query(vp, _xyzUTM);
+    outsideVoxet = _queryVoxet(_laLowResVp, vp, xyzUTM, false);
     if (!outsideVoxet) {
         // if inside low-res, try high-res model
         double vpHR = 0.0;
-        outsideVoxet = _laHighResVp->query(&vpHR, _xyzUTM);
+        outsideVoxet = _queryVoxet(_laHighResVp, &vpHR, xyzUTM, false);
         if (!outsideVoxet) { // if inside high-res model, use it
             *vp = vpHR;
         } else { // not in high-res model, so use low-res value
             outsideVoxet = 0;
         }
     } else {
-        outsideVoxet = _crustMantleVp->queryNearest(vp, _xyzUTM);
+        outsideVoxet = _queryVoxet(_crustMantleVp, vp, xyzUTM, true);
     }
 
     if (!outsideVoxet) {
@@ -380,26 +769,71 @@ spatialdata::spatialdb::SCECCVMH::_queryVp(double* vp) {
 // ----------------------------------------------------------------------
 // Perform query for tag.
 int
-spatialdata::spatialdb::SCECCVMH::_queryTag(double* tag) {
+spatialdata::spatialdb::SCECCVMH::_queryTag(double* tag,
+                                            const double xyzUTM[3]) const {
     int outsideVoxet = 0;
     double tagHR = 0.0;
 
-    outsideVoxet = _laLowResTag->query(tag, _xyzUTM);
+    outsideVoxet = _laLowResTag->query(tag, xyzUTM);
     if (!outsideVoxet) {
-        outsideVoxet = _laHighResTag->query(&tagHR, _xyzUTM);
+        outsideVoxet = _laHighResTag->query(&tagHR, xyzUTM);
         if (!outsideVoxet) {
             *tag = tagHR;
         } else {
             outsideVoxet = 0; // use low-res value
         }
     } else {
-        outsideVoxet = _crustMantleTag->queryNearest(tag, _xyzUTM);
+        outsideVoxet = _crustMantleTag->queryNearest(tag, xyzUTM);
     }
 
     return outsideVoxet;
 } // _queryTag
 
 
+// ----------------------------------------------------------------------
+// Perform query for tag at multiple locations.
+void
+spatialdata::spatialdb::SCECCVMH::_multiqueryTag(double* tag,
+                                                 int* flags,
+                                                 const double* xyzUTM,
+                                                 const size_t numLocs) const {
+    _laLowResTag->query(tag, flags, xyzUTM, numLocs);
+
+    std::vector<size_t> inside, outside;
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        if (flags[iLoc]) {
+            outside.push_back(iLoc);
+        } else {
+            inside.push_back(iLoc);
+        } // if/else
+    } // for
+
+    std::vector<double> xyzSubset, tagSubset;
+    std::vector<int> flagsSubset;
+    if (inside.size() > 0) {
+        _sceccvmh::gather(&xyzSubset, inside, xyzUTM);
+        tagSubset.resize(inside.size());
+        flagsSubset.resize(inside.size());
+        _laHighResTag->query(&tagSubset[0], &flagsSubset[0], &xyzSubset[0], inside.size());
+        for (size_t i = 0; i < inside.size(); ++i) {
+            if (!flagsSubset[i]) {
+                tag[inside[i]] = tagSubset[i];
+            } // if
+        } // for
+    } // if
+    if (outside.size() > 0) {
+        _sceccvmh::gather(&xyzSubset, outside, xyzUTM);
+        tagSubset.resize(outside.size());
+        flagsSubset.resize(outside.size());
+        _crustMantleTag->queryNearest(&tagSubset[0], &flagsSubset[0], &xyzSubset[0], outside.size());
+        for (size_t i = 0; i < outside.size(); ++i) {
+            tag[outside[i]] = tagSubset[i];
+            flags[outside[i]] = flagsSubset[i];
+        } // for
+    } // if
+} // _multiqueryTag
+
+
 // ----------------------------------------------------------------------
 // Compute density from Vp.
 double
@@ -16,6 +16,15 @@
 class spatialdata::spatialdb::SCECCVMH : SpatialDB {
     friend class TestSCECCVMH; // unit testing
 
+    // PUBLIC ENUM ////////////////////////////////////////////////////////
+public:
+
+    /** Type of query */
+    enum QueryEnum {
+        NEAREST=0, ///< Nearest interpolation.
+        LINEAR=1, ///< Trilinear interpolation (tags always use nearest interpolation).
+    };
+
     // PUBLIC MEMBERS ///////////////////////////////////////////////////////
 public:
 
@@ -48,6 +57,34 @@ public:
     void setSquashFlag(const bool flag,
                        const double limit=-2000.0);
 
+    /** Set query type.
+     *
+     * @param queryType Set type of query
+     */
+    void setQueryType(const QueryEnum queryType);
+
+    /** Set flag for memory-mapping the voxet property files instead of reading them into memory.
+     *
+     * Memory-mapped property files are shared among all processes on a node.
+     *
+     * @param value True to memory-map property files, false to read them into memory.
+     */
+    void setUseMemoryMap(const bool value);
+
+    /** Set flag for storing voxet data in blocks of points.
+     *
+     * Ignored for property files that are memory-mapped.
+     *
+     * @param value True to store voxet data in blocks of points, false otherwise.
+     */
+    void setUseBlockedLayout(const bool value);
+
+    /** Get flag for storing voxet data in blocks of points.
+     *
+     * @returns True if storing voxet data in blocks of points, false otherwise.
+     */
+    bool getUseBlockedLayout(void) const;
+
     /// Open the database and prepare for querying.
     void open(void);
 
@@ -93,6 +130,51 @@ public:
               const size_t numDims,
               const spatialdata::geocoords::CoordSys* pCSQuery);
 
+    using SpatialDB::multiquery; // Keep float version visible.
+
+    /** Perform multiple queries of the database.
+     *
+     * All locations are converted to UTM coordinates at once, and each voxet is queried once for
+     * all locations that need it.
+     *
+     * @pre Must call open() before multiquery().
+     *
+     * @param vals Array for computed values (output from query), must be
+     *   allocated BEFORE calling multiquery() [numLocs*numVals].
+     * @param numLocsV Number of locations.
+     * @param numValsV Number of values expected.
+     * @param err Array for error flag values (output from query), must be
+     *   allocated BEFORE calling multiquery() [numLocs].
+     * @param numLocsE Number of locations.
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numLocsC Number of locations.
+     * @param numDimsC Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     */
+    void multiquery(double* vals,
+                    const size_t numLocsV,
+                    const size_t numValsV,
+                    int* err,
+                    const size_t numLocsE,
+                    const double* coords,
+                    const size_t numLocsC,
+                    const size_t numDimsC,
+                    const spatialdata::geocoords::CoordSys* csQuery);
+
+    /** Check whether database supports query contexts.
+     *
+     * @returns True if database supports query contexts, false otherwise.
+     */
+    bool supportsQueryContexts(void) const;
+
+    /** Create context for querying the database.
+     *
+     * @pre Must call open() before createQueryContext().
+     *
+     * @returns Query context (caller is responsible for deleting it).
+     */
+    QueryContext* createQueryContext(void) const;
+
     // NOT IMPLEMENTED //////////////////////////////////////////////////////
 private:
 
@@ -115,19 +197,160 @@ private:
     // PRIVATE METHODS //////////////////////////////////////////////////////
 private:
 
+    /** Query the database using scratch storage in query context.
+     *
+     * @param context Query context created by createQueryContext().
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate)
+     */
+    int _contextQuery(QueryContext* context,
+                      double* vals,
+                      const size_t numVals,
+                      const double* coords,
+                      const size_t numDims,
+                      const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Perform multiple queries of the database using scratch storage in query context.
+     *
+     * @param context Query context created by createQueryContext().
+     * @param vals Array for computed values (output from query) [numLocs*numVals].
+     * @param numLocs Number of locations.
+     * @param numVals Number of values expected.
+     * @param err Array for error flag values (output from query) [numLocs].
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     */
+    void _contextMultiquery(QueryContext* context,
+                            double* vals,
+                            const size_t numLocs,
+                            const size_t numVals,
+                            int* err,
+                            const double* coords,
+                            const size_t numDims,
+                            const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Query the database.
+     *
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     * @param converter Converter for query points.
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate)
+     */
+    int _query(double* vals,
+               const size_t numVals,
+               const double* coords,
+               const size_t numDims,
+               const spatialdata::geocoords::CoordSys* csQuery,
+               spatialdata::geocoords::Converter* converter) const;
+
+    /** Perform multiple queries of the database.
+     *
+     * @param vals Array for computed values (output from query) [numLocs*numVals].
+     * @param numLocs Number of locations.
+     * @param numVals Number of values expected.
+     * @param err Array for error flag values (output from query) [numLocs].
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     * @param converter Converter for query points.
+     */
+    void _multiquery(double* vals,
+                     const size_t numLocs,
+                     const size_t numVals,
+                     int* err,
+                     const double* coords,
+                     const size_t numDims,
+                     const spatialdata::geocoords::CoordSys* csQuery,
+                     spatialdata::geocoords::Converter* converter) const;
+
+    /** Check number of values and spatial dimension of query.
+     *
+     * @param numVals Number of values expected.
+     * @param numDims Number of dimensions for coordinates.
+     */
+    void _checkQueryArgs(const size_t numVals,
+                         const size_t numDims) const;
+
+    /** Query voxet using the query type.
+     *
+     * @param voxet Voxet to query.
+     * @param value Result of query.
+     * @param xyzUTM Location of query in UTM coordinates.
+     * @param clamp If true, use the nearest location in the voxet for points outside the voxet.
+     * @returns 0 if found location, 1 otherwise.
+     */
+    int _queryVoxet(const GocadVoxet* voxet,
+                    double* value,
+                    const double xyzUTM[3],
+                    const bool clamp) const;
+
+    /** Query voxet using the query type for multiple locations.
+     *
+     * @param voxet Voxet to query.
+     * @param values Array of results of query [numLocs].
+     * @param flags Array of flags, 0 if found location, 1 otherwise [numLocs].
+     * @param xyzUTM Array of locations of queries in UTM coordinates [numLocs*3].
+     * @param numLocs Number of locations.
+     * @param clamp If true, use the nearest location in the voxet for points outside the voxet.
+     */
+    void _queryVoxet(const GocadVoxet* voxet,
+                     double* values,
+                     int* flags,
+                     const double* xyzUTM,
+                     const size_t numLocs,
+                     const bool clamp) const;
+
     /** Perform query for Vp.
      *
      * @param vp Result of query
+     * @param xyzUTM Location of query in UTM coordinates.
      * @returns 0 if found location, 1 otherwise.
      */
-    int _queryVp(double* vp);
+    int _queryVp(double* vp,
+                 const double xyzUTM[3]) const;
+
+    /** Perform query for Vp at multiple locations.
+     *
+     * @param vp Array of results of query [numLocs].
+     * @param flags Array of flags, 0 if found location, 1 otherwise [numLocs].
+     * @param xyzUTM Array of locations of queries in UTM coordinates [numLocs*3].
+     * @param numLocs Number of locations.
+     */
+    void _multiqueryVp(double* vp,
+                       int* flags,
+                       const double* xyzUTM,
+                       const size_t numLocs) const;
 
     /** Perform query for tag.
      *
      * @param tag Result of query
+     * @param xyzUTM Location of query in UTM coordinates.
      * @returns 0 if found location, 1 otherwise.
      */
-    int _queryTag(double* tag);
+    int _queryTag(double* tag,
+                  const double xyzUTM[3]) const;
+
+    /** Perform query for tag at multiple locations.
+     *
+     * @param tag Array of results of query [numLocs].
+     * @param flags Array of flags, 0 if found location, 1 otherwise [numLocs].
+     * @param xyzUTM Array of locations of queries in UTM coordinates [numLocs*3].
+     * @param numLocs Number of locations.
+     */
+    void _multiqueryTag(double* tag,
+                        int* flags,
+                        const double* xyzUTM,
+                        const size_t numLocs) const;
 
     /** Compute density from Vp.
      *
@@ -152,7 +375,6 @@ private:
     // PRIVATE MEMBERS //////////////////////////////////////////////////////
 private:
 
-    double _xyzUTM[3];
     std::string _dataDir;
     GocadVoxet* _laLowResVp;
     GocadVoxet* _laLowResTag;
@@ -172,6 +394,9 @@ private:
     size_t* _queryValues; ///< Indices of values to be returned in queries.
     size_t _querySize; ///< Number of values requested to be returned in queries.
     bool _squashTopo; ///< Squash topography/bathymetry to sea level.
+    bool _useMemoryMap; ///< Memory-map voxet property files.
+    bool _useBlockedLayout; ///< Store voxet data in blocks of points.
+    QueryEnum _queryType; ///< Query type.
 
 }; // SCECCVMH
 
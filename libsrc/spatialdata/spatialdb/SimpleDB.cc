@@ -16,6 +16,9 @@
 #include "SimpleIO.hh" // USES SimpleIO
 #include "SimpleDBData.hh" // USES SimpleDBData
 #include "SimpleDBQuery.hh" // USES SimpleDBQuery
+#include "KDTree.hh" // USES KDTree
+#include "Triangulation.hh" // USES Triangulation
+#include "QueryContext.hh" // ISA QueryContext
 
 #include "spatialdata/geocoords/CoordSys.hh" // USES CoordSys
 
@@ -24,13 +27,38 @@
 #include <stdexcept> // USES std::runtime_error
 #include "Exception.hh" // USES OutOfBounds
 
+// ----------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        namespace _simpledb {
+            /// Query context with its own query handler.
+            class Context : public spatialdata::spatialdb::QueryContext {
+public:
+
+                SimpleDBQuery query; ///< Query handler with scratch storage and converter.
+
+                Context(const SimpleDB& db,
+                        const SimpleDBQuery& dbQuery) :
+                    QueryContext(db),
+                    query(db) {
+                    query.copySettings(dbQuery);
+                }
+
+            }; // Context
+        } // _simpledb
+    } // spatialdb
+} // spatialdata
+
 // ----------------------------------------------------------------------
 /// Default constructor
 spatialdata::spatialdb::SimpleDB::SimpleDB(void) :
     _data(NULL),
+    _tree(NULL),
+    _triangulation(NULL),
     _iohandler(NULL),
     _query(NULL),
-    _cs(NULL) {}
+    _cs(NULL),
+    _useTriangulation(false) {}
 
 
 // ----------------------------------------------------------------------
@@ -38,15 +66,20 @@ spatialdata::spatialdb::SimpleDB::SimpleDB(void) :
 spatialdata::spatialdb::SimpleDB::SimpleDB(const char* label) :
     SpatialDB(label),
     _data(NULL),
+    _tree(NULL),
+    _triangulation(NULL),
     _iohandler(NULL),
     _query(NULL),
-    _cs(NULL) {}
+    _cs(NULL),
+    _useTriangulation(false) {}
 
 
 // ----------------------------------------------------------------------
 /// Default destructor
 spatialdata::spatialdb::SimpleDB::~SimpleDB(void) {
     delete _data;_data = NULL;
+    delete _tree;_tree = NULL;
+    delete _triangulation;_triangulation = NULL;
     delete _iohandler;_iohandler = NULL;
     delete _query;_query = NULL;
     delete _cs;_cs = NULL;
@@ -73,6 +106,14 @@ spatialdata::spatialdb::SimpleDB::setIOHandler(const SimpleIO* iohandler) {
 } // setIOHandler
 
 
+// ----------------------------------------------------------------------
+// Set flag for using precomputed triangulation in linear interpolation.
+void
+spatialdata::spatialdb::SimpleDB::setUseTriangulation(const bool value) {
+    _useTriangulation = value;
+} // setUseTriangulation
+
+
 // ----------------------------------------------------------------------
 /// Open the database and prepare for querying.
 void
@@ -85,6 +126,26 @@ spatialdata::spatialdb::SimpleDB::open(void) {
         _iohandler->read(_data, &_cs);
     } // if
 
+    // Build spatial index of locations
+    if (!_tree) {
+        _tree = new KDTree;
+        _tree->build(_data->getCoordinates(0), _data->getNumLocs(), _data->getSpaceDim());
+    } // if
+
+    // Build triangulation of locations for linear interpolation. Triangulation is only
+    // used when the locations fill the space (data dimension equals spatial dimension).
+    // If some locations cannot be inserted, linear queries search the nearest locations
+    // instead, so that no locations are left out of the interpolation.
+    const size_t dataDim = _data->getDataDim();
+    if (_useTriangulation && !_triangulation && (dataDim >= 2) && (dataDim == _data->getSpaceDim())) {
+        _triangulation = new Triangulation;
+        try {
+            _triangulation->build(_data->getCoordinates(0), _data->getNumLocs(), _data->getSpaceDim());
+        } catch (const std::runtime_error&) {
+            delete _triangulation;_triangulation = NULL;
+        } // try/catch
+    } // if
+
     // Create query object
     if (!_query) {
         _query = new SimpleDBQuery(*this);
@@ -106,6 +167,8 @@ spatialdata::spatialdb::SimpleDB::open(void) {
 void
 spatialdata::spatialdb::SimpleDB::close(void) {
     delete _data;_data = 0;
+    delete _tree;_tree = 0;
+    delete _triangulation;_triangulation = 0;
 
     if (_query) {
         _query->deallocate();
@@ -131,6 +194,14 @@ spatialdata::spatialdb::SimpleDB::getNamesDBValues(const char*** valueNames,
 } // getNamesDBValues
 
 
+// ----------------------------------------------------------------------
+// Get coordinate system of database.
+const spatialdata::geocoords::CoordSys*
+spatialdata::spatialdb::SimpleDB::getCoordSys(void) const {
+    return _cs;
+} // getCoordSys
+
+
 // ----------------------------------------------------------------------
 // Set values to be returned by queries.
 void
@@ -154,20 +225,72 @@ spatialdata::spatialdb::SimpleDB::query(double* vals,
                                         const double* coords,
                                         const size_t numDims,
                                         const spatialdata::geocoords::CoordSys* pCSQuery) {
+    if (!_query) {
+        std::ostringstream msg;
+        msg << "Spatial database " << getDescription() << " has not been opened.\n"
+            << "Please call open() before calling query().";
+        throw std::logic_error(msg.str());
+    } // if
+    return _queryDB(_query, vals, numVals, coords, numDims, pCSQuery);
+} // query
+
+
+// ----------------------------------------------------------------------
+// Check whether database supports query contexts.
+bool
+spatialdata::spatialdb::SimpleDB::supportsQueryContexts(void) const {
+    return true;
+} // supportsQueryContexts
+
+
+// ----------------------------------------------------------------------
+// Create context for querying the database.
+spatialdata::spatialdb::QueryContext*
+spatialdata::spatialdb::SimpleDB::createQueryContext(void) const {
+    if (!_query || !_data) {
+        std::ostringstream msg;
+        msg << "Spatial database " << getDescription() << " has not been opened.\n"
+            << "Please call open() before calling createQueryContext().";
+        throw std::logic_error(msg.str());
+    } // if
+
+    return new _simpledb::Context(*this, *_query);
+} // createQueryContext
+
+
+// ----------------------------------------------------------------------
+// Query the database using scratch storage in query context.
+int
+spatialdata::spatialdb::SimpleDB::_contextQuery(QueryContext* context,
+                                                double* vals,
+                                                const size_t numVals,
+                                                const double* coords,
+                                                const size_t numDims,
+                                                const spatialdata::geocoords::CoordSys* csQuery) const {
+    _simpledb::Context* simpleContext = dynamic_cast<_simpledb::Context*>(context);
+    assert(simpleContext);
+    return _queryDB(&simpleContext->query, vals, numVals, coords, numDims, csQuery);
+} // _contextQuery
+
+
+// ----------------------------------------------------------------------
+// Query the database using query handler.
+int
+spatialdata::spatialdb::SimpleDB::_queryDB(SimpleDBQuery* query,
+                                          double* vals,
+                                          const size_t numVals,
+                                          const double* coords,
+                                          const size_t numDims,
+                                          const spatialdata::geocoords::CoordSys* csQuery) const {
+    assert(query);
     try {
-        if (!_query) {
-            std::ostringstream msg;
-            msg << "Spatial database " << getDescription() << " has not been opened.\n"
-                << "Please call open() before calling query().";
-            throw std::logic_error(msg.str());
-        } // if
-        else if (!_data) {
+        if (!_data) {
             std::ostringstream msg;
             msg << "Spatial database " << getDescription() << " does not contain any data.\n"
                 << "Database query aborted.";
             throw std::domain_error(msg.str());
         } // if
-        _query->query(vals, numVals, coords, numDims, pCSQuery);
+        query->query(vals, numVals, coords, numDims, csQuery);
     } catch (const OutOfBounds& err) {
         std::fill(vals, vals+numVals, 0);
         return 1;
@@ -177,7 +300,7 @@ spatialdata::spatialdb::SimpleDB::query(double* vals,
         throw std::runtime_error("Unknown error in SpatialDB query");
     } // catch
     return 0;
-} // query
+} // _queryDB
 
 
 // End of file
@@ -65,6 +65,21 @@ public:
      */
     void setIOHandler(const SimpleIO* iohandler);
 
+    /** Set flag for using precomputed triangulation in linear interpolation.
+     *
+     * When true, open() builds a Delaunay triangulation (data dimension 2) or
+     * tetrahedralization (data dimension 3) of the locations, and linear queries
+     * interpolate within the cell containing the point. Otherwise, linear queries
+     * search the nearest locations for an interpolating simplex. Linear queries also
+     * search the nearest locations if a location cannot be inserted into the triangulation
+     * without creating degenerate cells.
+     *
+     * @pre Must call setUseTriangulation() before open().
+     *
+     * @param value True if using triangulation, false otherwise.
+     */
+    void setUseTriangulation(const bool value);
+
     /// Open the database and prepare for querying.
     void open(void);
 
@@ -79,6 +94,12 @@ public:
     void getNamesDBValues(const char*** valueNames,
                           size_t* numValues) const;
 
+    /** Get coordinate system of database.
+     *
+     * @returns Coordinate system.
+     */
+    const spatialdata::geocoords::CoordSys* getCoordSys(void) const;
+
     /** Set values to be returned by queries.
      *
      * @pre Must call open() before setQueryValues()
@@ -109,10 +130,61 @@ public:
               const size_t numDims,
               const spatialdata::geocoords::CoordSys* pCSQuery);
 
+    /** Check whether database supports query contexts.
+     *
+     * @returns True if database supports query contexts, false otherwise.
+     */
+    bool supportsQueryContexts(void) const;
+
+    /** Create context for querying the database.
+     *
+     * @pre Must call open() before createQueryContext().
+     *
+     * @returns Query context (caller is responsible for deleting it).
+     */
+    QueryContext* createQueryContext(void) const;
+
 private:
 
     // PRIVATE METHODS ////////////////////////////////////////////////////
 
+    /** Query the database using scratch storage in query context.
+     *
+     * @param context Query context created by createQueryContext().
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate)
+     */
+    int _contextQuery(QueryContext* context,
+                      double* vals,
+                      const size_t numVals,
+                      const double* coords,
+                      const size_t numDims,
+                      const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Query the database using query handler.
+     *
+     * @param query Query handler.
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate
+     *   so values set to 0)
+     */
+    int _queryDB(SimpleDBQuery* query,
+                 double* vals,
+                 const size_t numVals,
+                 const double* coords,
+                 const size_t numDims,
+                 const spatialdata::geocoords::CoordSys* csQuery) const;
+
     SimpleDB(const SimpleDB& data); ///< Not implemented
     const SimpleDB& operator=(const SimpleDB& data); ///< Not implemented
 
@@ -121,9 +193,12 @@ private:
     // PRIVATE MEMBERS /////////////////////////////////////////////////////
 
     SimpleDBData* _data; ///< Pointer to data
+    KDTree* _tree; ///< Spatial index of locations in data
+    Triangulation* _triangulation; ///< Triangulation of locations in data
     SimpleIO* _iohandler; ///< I/O handler
     SimpleDBQuery* _query; ///< Query handler
     spatialdata::geocoords::CoordSys* _cs; ///< Coordinate system
+    bool _useTriangulation; ///< Use triangulation for linear interpolation
 
 }; // class SimpleDB
 
@@ -12,6 +12,8 @@
 
 #include "SimpleDBData.hh" // Implementation of class methods
 
+#include "spatialdata/utils/BinaryIO.hh" // USES BinaryIO
+
 #include <cstring> // USES memcpy()
 
 #include <stdexcept> // USES std::runtime_error
@@ -27,20 +29,15 @@ spatialdata::spatialdb::SimpleDBData::SimpleDBData(void) :
     _numLocs(0),
     _numValues(0),
     _dataDim(0),
-    _spaceDim(0) {}
+    _spaceDim(0),
+    _map(NULL),
+    _mapSize(0) {}
 
 
 // ----------------------------------------------------------------------
 // Default destructor
 spatialdata::spatialdb::SimpleDBData::~SimpleDBData(void) {
-    delete[] _data;_data = 0;
-    delete[] _coordinates;_coordinates = 0;
-    delete[] _names;_names = 0;
-    delete[] _units;_units = 0;
-    _numLocs = 0;
-    _numValues = 0;
-    _dataDim = 0;
-    _spaceDim = 0;
+    _deallocate();
 } // destructor
 
 
@@ -51,31 +48,8 @@ spatialdata::spatialdb::SimpleDBData::allocate(const size_t numLocs,
                                                const size_t numValues,
                                                const size_t spaceDim,
                                                const size_t dataDim) {
-    delete[] _data;_data = 0;
-    delete[] _coordinates;_coordinates = 0;
-    delete[] _names;_names = 0;
-    delete[] _units;_units = 0;
-
-    if (numLocs <= 0) {
-        std::ostringstream msg;
-        msg << "Number of locations (" << numLocs << ") must be positive.";
-        throw std::invalid_argument(msg.str());
-    } // if
-    if (numValues <= 0) {
-        std::ostringstream msg;
-        msg << "Number of values (" << numValues << ") must be positive.";
-        throw std::invalid_argument(msg.str());
-    } // if
-    if (spaceDim <= 0) {
-        std::ostringstream msg;
-        msg << "Number of spatial dimensions (" << spaceDim << ") must be positive.";
-        throw std::invalid_argument(msg.str());
-    } // if
-    if (( dataDim < 0) || ( dataDim > 3) ) {
-        std::ostringstream msg;
-        msg << "Spatial dimension of data (" << dataDim << ") must be in the range [0,3].";
-        throw std::out_of_range(msg.str());
-    } // if
+    _deallocate();
+    _checkSizes(numLocs, numValues, spaceDim, dataDim);
 
     size_t size = numLocs*numValues;
     _data = (size > 0) ? new double[size] : NULL;
@@ -94,6 +68,38 @@ spatialdata::spatialdb::SimpleDBData::allocate(const size_t numLocs,
 } // allocate
 
 
+// ----------------------------------------------------------------------
+// Use memory-mapped arrays for coordinates and data values.
+void
+spatialdata::spatialdb::SimpleDBData::allocateMapped(void* map,
+                                                     const size_t mapSize,
+                                                     double* coordinates,
+                                                     double* values,
+                                                     const size_t numLocs,
+                                                     const size_t numValues,
+                                                     const size_t spaceDim,
+                                                     const size_t dataDim) {
+    assert(map);
+    assert(coordinates);
+    assert(values);
+
+    _deallocate();
+    _map = map;
+    _mapSize = mapSize;
+    _checkSizes(numLocs, numValues, spaceDim, dataDim);
+
+    _data = values;
+    _coordinates = coordinates;
+    _names = new std::string[numValues];
+    _units = new std::string[numValues];
+
+    _numLocs = numLocs;
+    _numValues = numValues;
+    _spaceDim = spaceDim;
+    _dataDim = dataDim;
+} // allocateMapped
+
+
 // ----------------------------------------------------------------------
 // Set data values.
 void
@@ -150,4 +156,57 @@ spatialdata::spatialdb::SimpleDBData::setUnits(const char* const* values,
 } // units
 
 
+// ----------------------------------------------------------------------
+// Deallocate data structures.
+void
+spatialdata::spatialdb::SimpleDBData::_deallocate(void) {
+    if (_map) {
+        spatialdata::utils::BinaryIO::unmap(_map, _mapSize);
+        _map = NULL;
+        _mapSize = 0;
+    } else {
+        delete[] _data;
+        delete[] _coordinates;
+    } // if/else
+    _data = NULL;
+    _coordinates = NULL;
+    delete[] _names;_names = NULL;
+    delete[] _units;_units = NULL;
+    _numLocs = 0;
+    _numValues = 0;
+    _dataDim = 0;
+    _spaceDim = 0;
+} // _deallocate
+
+
+// ----------------------------------------------------------------------
+// Check sizes of data structures.
+void
+spatialdata::spatialdb::SimpleDBData::_checkSizes(const size_t numLocs,
+                                                  const size_t numValues,
+                                                  const size_t spaceDim,
+                                                  const size_t dataDim) {
+    if (numLocs <= 0) {
+        std::ostringstream msg;
+        msg << "Number of locations (" << numLocs << ") must be positive.";
+        throw std::invalid_argument(msg.str());
+    } // if
+    if (numValues <= 0) {
+        std::ostringstream msg;
+        msg << "Number of values (" << numValues << ") must be positive.";
+        throw std::invalid_argument(msg.str());
+    } // if
+    if (spaceDim <= 0) {
+        std::ostringstream msg;
+        msg << "Number of spatial dimensions (" << spaceDim << ") must be positive.";
+        throw std::invalid_argument(msg.str());
+    } // if
+    if (( dataDim < 0) || ( dataDim > 3) ) {
+        std::ostringstream msg;
+        msg << "Spatial dimension of data (" << dataDim << ") must be in the range [0,3].";
+        throw std::out_of_range(msg.str());
+    } // if
+} // _checkSizes
+
+
 // End of file
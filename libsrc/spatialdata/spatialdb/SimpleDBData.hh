@@ -38,6 +38,35 @@ public:
                   const size_t spaceDim,
                   const size_t dataDim);
 
+    /** Use memory-mapped arrays for coordinates and data values.
+     *
+     * The arrays are used in place, and the mapping is unmapped when
+     * the data structures are deallocated.
+     *
+     * @param map Address of memory-mapped file.
+     * @param mapSize Size of memory-mapped file.
+     * @param coordinates Array of coordinates of locations in mapped file [numLocs*spaceDim].
+     * @param values Array of data values in mapped file [numLocs*numValues].
+     * @param numLocs Number of locations.
+     * @param numValues Number of values.
+     * @param spaceDim Spatial dimension of domain.
+     * @param dataDim Spatial dimension of data distribution.
+     */
+    void allocateMapped(void* map,
+                        const size_t mapSize,
+                        double* coordinates,
+                        double* values,
+                        const size_t numLocs,
+                        const size_t numValues,
+                        const size_t spaceDim,
+                        const size_t dataDim);
+
+    /** Check whether coordinates and data values are memory-mapped.
+     *
+     * @returns True if coordinates and data values are memory-mapped, false otherwise.
+     */
+    bool isMapped(void) const;
+
     /** Set data values.
      *
      * @pre Must call allocate() before setData().
@@ -152,6 +181,26 @@ private:
 
     // PRIVATE METHODS ////////////////////////////////////////////////////
 
+    /// Deallocate data structures, unmapping them if they are memory-mapped.
+    void _deallocate(void);
+
+    /** Check sizes of data structures.
+     *
+     * @param numLocs Number of locations.
+     * @param numValues Number of values.
+     * @param spaceDim Spatial dimension of domain.
+     * @param dataDim Spatial dimension of data distribution.
+     */
+    static
+    void _checkSizes(const size_t numLocs,
+                     const size_t numValues,
+                     const size_t spaceDim,
+                     const size_t dataDim);
+
+private:
+
+    // PRIVATE MEMBERS ////////////////////////////////////////////////////
+
     double* _data; ///< Array of data values.
     double* _coordinates; ///< Array of coordinates of locations.
     std::string* _names; ///< Names of data values.
@@ -160,6 +209,8 @@ private:
     size_t _numValues; ///< Number of values.
     size_t _dataDim; ///< Spatial dimension of data distribution.
     size_t _spaceDim; ///< Spatial dimension of coordinate locations.
+    void* _map; ///< Memory-mapped file with coordinates and data values (NULL if not memory-mapped).
+    size_t _mapSize; ///< Size of memory-mapped file.
 
 }; // class SpatialDBData
 
@@ -15,26 +15,25 @@
 #include "SimpleDBQuery.hh" // implementation of class methods
 
 #include "SimpleDBData.hh" // USEs SimpleDBData
+#include "KDTree.hh" // USES KDTree
+#include "Triangulation.hh" // USES Triangulation
 
 #include "spatialdata/geocoords/Converter.hh" // USES Converter
 
 #include "Exception.hh" // USES OutOfBounds
 
-#include <math.h> // USES MAXFLOAT
-#if !defined(MAXFLOAT)
-#define MAXFLOAT 1e+30
-#endif
+#include <math.h> // USES sqrt(), pow(), fabs()
 
 #include <cstring> // USES memcpy()
 #include <strings.h> // USES strcasecmp()
 #include <cassert> // USES assert()
 #include <sstream> // USES std::ostringsgream
-#include <algorithm> // USES std::fill(), std::lower_bound(), std::distance()
 
 // ----------------------------------------------------------------------
 // Default constructor.
 spatialdata::spatialdb::SimpleDBQuery::SimpleDBQuery(const SimpleDB& db) :
     _queryType(SimpleDB::LINEAR),
+    _cell(0),
     _db(db),
     _converter(new spatialdata::geocoords::Converter),
     _queryValues(NULL),
@@ -56,6 +55,7 @@ spatialdata::spatialdb::SimpleDBQuery::deallocate(void) {
     delete[] _queryValues;_queryValues = NULL;
     _querySize = 0;
     _nearest.resize(0);
+    _cell = 0;
 } // deallocate
 
 
@@ -107,6 +107,21 @@ spatialdata::spatialdb::SimpleDBQuery::setQueryValues(const char* const* names,
 } // setQueryVals
 
 
+// ----------------------------------------------------------------------
+// Copy query type and values to be returned by queries.
+void
+spatialdata::spatialdb::SimpleDBQuery::copySettings(const SimpleDBQuery& query) {
+    assert(&_db == &query._db);
+
+    _queryType = query._queryType;
+    _querySize = query._querySize;
+    delete[] _queryValues;_queryValues = (_querySize > 0) ? new size_t[_querySize] : NULL;
+    for (size_t iVal = 0; iVal < _querySize; ++iVal) {
+        _queryValues[iVal] = query._queryValues[iVal];
+    } // for
+} // copySettings
+
+
 // ----------------------------------------------------------------------
 // Query the database.
 void
@@ -165,21 +180,8 @@ spatialdata::spatialdb::SimpleDBQuery::_queryNearest(double* vals,
     assert(_db._data);
     assert(numVals == _querySize);
 
-    size_t iNear = 0;
-    const size_t spaceDim = _db._data->getSpaceDim();
-    double pt[3];
-    _setPoint3(pt, _db._data->getCoordinates(iNear), spaceDim);
-    double nearDist = _distSquared(_q, pt);
-
-    const size_t numLocs = _db._data->getNumLocs();
-    for (size_t iLoc = 1; iLoc < numLocs; ++iLoc) {
-        _setPoint3(pt, _db._data->getCoordinates(iLoc), spaceDim);
-        const double dist = _distSquared(_q, pt);
-        if (dist < nearDist) {
-            nearDist = dist;
-            iNear = iLoc;
-        } // if
-    } // for
+    assert(_db._tree);
+    const size_t iNear = _db._tree->findNearest(_q);
 
     const double* nearVals = _db._data->getData(iNear);
     const size_t querySize = _querySize;
@@ -207,12 +209,15 @@ spatialdata::spatialdb::SimpleDBQuery::_queryLinear(double* vals,
             vals[iVal] = nearVals[_queryValues[iVal]];
         }
     } else { // else
-        // Find nearest locations in database
-        _findNearest();
-
         // Get interpolation weights
         std::vector<WtStruct> weights;
-        _getWeights(&weights);
+        if (_db._triangulation) {
+            _findCell(&weights);
+        } else {
+            // Find nearest locations in database
+            _findNearest();
+            _getWeights(&weights);
+        } // if/else
 
         // Interpolate values
         const size_t numWts = weights.size();
@@ -232,49 +237,42 @@ spatialdata::spatialdb::SimpleDBQuery::_queryLinear(double* vals,
 
 // ----------------------------------------------------------------------
 void
-spatialdata::spatialdb::SimpleDBQuery::_findNearest(void) {
-    assert(_db._data);
+spatialdata::spatialdb::SimpleDBQuery::_findCell(std::vector<WtStruct>* pWeights) {
+    assert(_db._triangulation);
+    assert(pWeights);
 
-    const size_t maxnear = 100;
-    const size_t numLocs = _db._data->getNumLocs();
-    const size_t nearSize = (numLocs < maxnear) ? numLocs : maxnear;
-    _nearest.resize(nearSize);
-    std::fill(_nearest.begin(), _nearest.end(), -1);
+    // Check cell containing previous query location first, which is O(1) for spatially
+    // coherent queries. Otherwise, walk from a cell incident to the nearest location.
+    size_t vertices[4];
+    double wts[4];
+    if (!_db._triangulation->locate(vertices, wts, &_cell, _q, 1)) {
+        assert(_db._tree);
+        _cell = _db._triangulation->getVertexCell(_db._tree->findNearest(_q));
+        if (!_db._triangulation->locate(vertices, wts, &_cell, _q)) {
+            throw OutOfBounds("Could not find cell in triangulation containing point.");
+        } // if
+    } // if
 
-    std::vector<double> nearestDist(nearSize);
-    std::fill(nearestDist.begin(), nearestDist.end(), MAXFLOAT);
+    const size_t numWts = _db._triangulation->getSpaceDim() + 1;
+    pWeights->resize(numWts);
+    _nearest.resize(numWts);
+    for (size_t iWt = 0; iWt < numWts; ++iWt) {
+        _nearest[iWt] = vertices[iWt];
+        (*pWeights)[iWt].wt = wts[iWt];
+        (*pWeights)[iWt].nearIndex = iWt;
+    } // for
+} // _findCell
 
-    // find closest nearSize points
-    double pt[3];
-    const size_t spaceDim = _db._data->getSpaceDim();
-    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
-        // use square of distance to find closest
-        _setPoint3(pt, _db._data->getCoordinates(iLoc), spaceDim);
-        const double dist2 = _distSquared(_q, pt);
-
-        // find place in nearest list if it exists
-        const std::vector<double>::iterator pNearDist =
-            std::lower_bound(nearestDist.begin(), nearestDist.end(), dist2);
-        if (dist2 <= *pNearDist) { // if found place in nearest list
-#if !defined(_RWSTD_NO_CLASS_PARTIAL_SPEC)
-            size_t index = std::distance(nearestDist.begin(), pNearDist);
-#else
-            size_t index = 0;
-            std::distance(nearestDist.begin(), pNearDist, index);
-#endif
 
-            // move values to allow insertion of current
-            for (size_t moveIndex = nearSize-1; moveIndex > index; --moveIndex) {
-                nearestDist[moveIndex] = nearestDist[moveIndex-1];
-                _nearest[moveIndex] = _nearest[moveIndex-1];
-            } // for
-            if (index < nearSize) {
-                // insert current
-                nearestDist[index] = dist2;
-                _nearest[index] = iLoc;
-            } // if
-        } // if
-    } // for
+// ----------------------------------------------------------------------
+void
+spatialdata::spatialdb::SimpleDBQuery::_findNearest(void) {
+    assert(_db._data);
+
+    assert(_db._tree);
+
+    const size_t maxnear = 100;
+    _db._tree->findNearest(&_nearest, _q, maxnear);
 } // _findNearest
 
 
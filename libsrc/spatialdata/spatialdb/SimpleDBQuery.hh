@@ -50,6 +50,12 @@ public:
     void setQueryValues(const char* const* names,
                         const size_t numVals);
 
+    /** Copy query type and values to be returned by queries from another query handler.
+     *
+     * @param query Query handler for same database.
+     */
+    void copySettings(const SimpleDBQuery& query);
+
     /** Query the database.
      *
      * @param vals Array for computed values (output from query)
@@ -99,6 +105,12 @@ private:
     void _queryLinear(double* vals,
                       const size_t numVals);
 
+    /** Get interpolation weighting functions from cell in triangulation containing query location.
+     *
+     * @param pWeights Pointer to array of interpolation weights
+     */
+    void _findCell(std::vector<WtStruct>* pWeights);
+
     /// Find locations in database nearest query location.
     void _findNearest(void);
 
@@ -188,6 +200,7 @@ private:
     double _q[3]; ///< Location of query.
     SimpleDB::QueryEnum _queryType; ///< Query type.
     std::vector<size_t> _nearest; ///< Index of nearest points in database to location.
+    size_t _cell; ///< Cell in triangulation containing previous query location.
     const SimpleDB& _db; ///< Reference to simple database.
     spatialdata::geocoords::Converter* _converter; ///< Covert query points to local coordinate system.
 
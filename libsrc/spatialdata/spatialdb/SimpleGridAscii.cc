@@ -21,6 +21,7 @@
 #include "spatialdata/geocoords/CSPicklerAscii.hh" // USES CSPicklerAscii
 
 #include "spatialdata/utils/LineParser.hh" // USES LineParser
+#include "spatialdata/utils/NumberParser.hh" // USES NumberParser
 
 #include <fstream> // USES std::ofstream, std::ifstream
 #include <iomanip> // USES setw(), setiosflags(), resetiosflags()
@@ -285,7 +286,7 @@ spatialdata::spatialdb::SimpleGridAscii::_readData(std::istream& filein,
     delete[] db->_x;db->_x = 0;
     delete[] db->_y;db->_y = 0;
     delete[] db->_z;db->_z = 0;
-    delete[] db->_data;db->_data = 0;
+    db->_deallocateData();
 
     const int numX = db->_numX;
     const int numY = db->_numY;
@@ -297,8 +298,6 @@ spatialdata::spatialdb::SimpleGridAscii::_readData(std::istream& filein,
     utils::LineParser parser(filein, "//", bufsize);
     parser.eatwhitespace(true);
 
-    std::istringstream buffer;
-
     const bool _verbose = false;
 
     int numLocs = 1;
@@ -308,16 +307,12 @@ spatialdata::spatialdb::SimpleGridAscii::_readData(std::istream& filein,
         } // if
         numLocs *= numX;
         db->_x = new double[numX];
-        buffer.str(parser.next());
-        buffer.clear();
-        for (int i = 0; i < numX; ++i) {
-            if (!buffer.good()) {
-                std::ostringstream msg;
-                msg << "Error reading x-coordinates from buffer '" << buffer.str() << "'.";
-                throw std::runtime_error(msg.str());
-            } // if
-            buffer >> db->_x[i];
-        } // for
+        const std::string& line = parser.next();
+        if (!utils::NumberParser::parse(db->_x, numX, line)) {
+            std::ostringstream msg;
+            msg << "Error reading x-coordinates from buffer '" << line << "'.";
+            throw std::runtime_error(msg.str());
+        } // if
         std::vector<double> xVec(numX);
         for (int i = 0; i < numX; ++i) {
             xVec[i] = db->_x[i];
@@ -334,16 +329,12 @@ spatialdata::spatialdb::SimpleGridAscii::_readData(std::istream& filein,
         } // if
         numLocs *= numY;
         db->_y = new double[numY];
-        buffer.str(parser.next());
-        buffer.clear();
-        for (int i = 0; i < numY; ++i) {
-            if (!buffer.good()) {
-                std::ostringstream msg;
-                msg << "Error reading y-coordinates from buffer '" << buffer.str() << "'.";
-                throw std::runtime_error(msg.str());
-            } // if
-            buffer >> db->_y[i];
-        } // for
+        const std::string& line = parser.next();
+        if (!utils::NumberParser::parse(db->_y, numY, line)) {
+            std::ostringstream msg;
+            msg << "Error reading y-coordinates from buffer '" << line << "'.";
+            throw std::runtime_error(msg.str());
+        } // if
         std::vector<double> yVec(numY);
         for (int i = 0; i < numY; ++i) {
             yVec[i] = db->_y[i];
@@ -360,16 +351,12 @@ spatialdata::spatialdb::SimpleGridAscii::_readData(std::istream& filein,
         } // if
         numLocs *= numZ;
         db->_z = new double[numZ];
-        buffer.str(parser.next());
-        buffer.clear();
-        for (int i = 0; i < numZ; ++i) {
-            if (!buffer.good()) {
-                std::ostringstream msg;
-                msg << "Error reading z-coordinates from buffer '" << buffer.str() << "'.";
-                throw std::runtime_error(msg.str());
-            } // if
-            buffer >> db->_z[i];
-        } // for
+        const std::string& line = parser.next();
+        if (!utils::NumberParser::parse(db->_z, numZ, line)) {
+            std::ostringstream msg;
+            msg << "Error reading z-coordinates from buffer '" << line << "'.";
+            throw std::runtime_error(msg.str());
+        } // if
         std::vector<double> zVec(numZ);
         for (int i = 0; i < numZ; ++i) {
             zVec[i] = db->_z[i];
@@ -384,33 +371,25 @@ spatialdata::spatialdb::SimpleGridAscii::_readData(std::istream& filein,
     assert(numValues > 0);
     db->_data = new double[numLocs*db->_numValues];
     assert(spaceDim > 0);
-    double* coords = new double[spaceDim];
+    const size_t numLineValues = spaceDim + db->_numValues;
+    double* lineValues = new double[numLineValues];
     int count = 0;
     for (int iLoc = 0; iLoc < numLocs; ++iLoc, ++count) {
-        buffer.str(parser.next());
-        buffer.clear();
-        for (int iDim = 0; iDim < spaceDim; ++iDim) {
-            if (!buffer.good()) {
-                std::ostringstream msg;
-                msg << "Read data for " << count << " out of " << numLocs << " points.\n"
-                    << "Error reading coordinates from buffer '" << buffer.str() << "'.";
-                throw std::runtime_error(msg.str());
-            } // if
-            buffer >> coords[iDim];
-        } // for
+        const std::string& line = parser.next();
+        if (!utils::NumberParser::parse(lineValues, numLineValues, line)) {
+            delete[] lineValues;lineValues = 0;
+            std::ostringstream msg;
+            msg << "Read data for " << count << " out of " << numLocs << " points.\n"
+                << "Error reading coordinates and data from buffer '" << line << "'.";
+            throw std::runtime_error(msg.str());
+        } // if
 
-        const int indexData = db->_getDataIndex(coords, spaceDim);
+        const int indexData = db->_getDataIndex(lineValues, spaceDim);
         for (size_t iVal = 0; iVal < db->_numValues; ++iVal) {
-            if (!buffer.good()) {
-                std::ostringstream msg;
-                msg << "Read data for " << count << " out of " << numLocs << " points.\n"
-                    << "Error reading data from buffer '" << buffer.str() << "'.";
-                throw std::runtime_error(msg.str());
-            } // if
-            buffer >> db->_data[indexData+iVal];
+            db->_data[indexData+iVal] = lineValues[spaceDim+iVal];
         } // for
     } // for
-    delete[] coords;coords = 0;
+    delete[] lineValues;lineValues = 0;
     if (_verbose) {
         std::cout << "Read " << count << " lines of data.\n";
     } // if
@@ -0,0 +1,399 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "SimpleGridBinary.hh" // implementation of class methods
+
+#include "SimpleGridAscii.hh" // USES SimpleGridAscii
+
+#include "spatialdata/geocoords/CoordSys.hh" // USES CoordSys
+#include "spatialdata/geocoords/CSPicklerAscii.hh" // USES CSPicklerAscii
+#include "spatialdata/utils/BinaryIO.hh" // USES BinaryIO
+
+#include <fstream> // USES std::ofstream
+#include <sstream> // USES std::ostringstream, std::istringstream
+#include <stdexcept> // USES std::runtime_error
+#include <vector> // USES std::vector
+#include <cstring> // USES memcpy(), strlen(), strncmp()
+#include <strings.h> // USES strcasecmp()
+#include <stdint.h> // USES uint64_t
+#include <assert.h> // USES assert()
+
+// ----------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        namespace _simplegridbinary {
+            /// Layout of fixed-size header (all fields are little-endian 64-bit integers after magic header).
+            class Header {
+public:
+
+                static const size_t magicSize; ///< Size of magic header (padded with NUL characters).
+                static const size_t size; ///< Size of fixed-size header.
+                static const uint64_t version; ///< Version of file format.
+
+                uint64_t numX; ///< Number of points along x dimension.
+                uint64_t numY; ///< Number of points along y dimension.
+                uint64_t numZ; ///< Number of points along z dimension.
+                uint64_t spaceDim; ///< Spatial dimension of data.
+                uint64_t numValues; ///< Number of values at each point.
+                uint64_t textSize; ///< Size of text header.
+                uint64_t axesOffset; ///< Offset of coordinates along axes.
+                uint64_t dataOffset; ///< Offset of data values (multiple of 8 bytes).
+
+                /// Number of points in grid.
+                uint64_t numLocs(void) const {
+                    return (3 == spaceDim) ? numX * numY * numZ : (2 == spaceDim) ? numX * numY : numX;
+                }
+
+            }; // Header
+            const size_t Header::magicSize = 24;
+            const size_t Header::size = 24 + 9*8;
+            const uint64_t Header::version = 1;
+        } // _simplegridbinary
+    } // spatialdb
+} // spatialdata
+
+// ----------------------------------------------------------------------
+const char* spatialdata::spatialdb::SimpleGridBinary::FILEHEADER = "#SPATIAL_GRID.binary";
+
+// ----------------------------------------------------------------------
+// Check whether file is a SimpleGridDB file in binary format.
+bool
+spatialdata::spatialdb::SimpleGridBinary::isBinary(const char* filename) { // isBinary
+    return spatialdata::utils::BinaryIO::hasHeader(filename, FILEHEADER);
+} // isBinary
+
+
+// ----------------------------------------------------------------------
+// Read binary database file.
+void
+spatialdata::spatialdb::SimpleGridBinary::read(SimpleGridDB* db) { // read
+    assert(db);
+
+    typedef spatialdata::utils::BinaryIO BinaryIO;
+    typedef _simplegridbinary::Header Header;
+
+    try {
+        db->_deallocateData();
+        delete[] db->_x;db->_x = NULL;
+        delete[] db->_y;db->_y = NULL;
+        delete[] db->_z;db->_z = NULL;
+        delete[] db->_names;db->_names = NULL;
+        delete[] db->_units;db->_units = NULL;
+
+        // Map the file privately, so converting values to SI units
+        // modifies only the pages that change and never the file.
+        size_t fileSize = 0;
+        db->_dataMap = BinaryIO::map(db->_filename.c_str(), &fileSize);
+        db->_dataMapSize = fileSize;
+        if (fileSize < Header::size) {
+            throw std::runtime_error("File is too small to contain SimpleGridDB header.");
+        } // if
+        const char* buffer = (const char*) db->_dataMap;
+
+        const size_t headerLen = strlen(FILEHEADER);
+        if (0 != strncmp(buffer, FILEHEADER, headerLen)) {
+            std::ostringstream msg;
+            msg << "Magic header does not match expected header '" << FILEHEADER << "'.";
+            throw std::runtime_error(msg.str());
+        } // if
+
+        const char* field = buffer + Header::magicSize;
+        const uint64_t version = BinaryIO::readUInt64(field);field += 8;
+        if (version != Header::version) {
+            std::ostringstream msg;
+            msg << "Unsupported version (" << version << ") of SimpleGridDB binary format. Expected version "
+                << Header::version << ".";
+            throw std::runtime_error(msg.str());
+        } // if
+        Header header;
+        header.numX = BinaryIO::readUInt64(field);field += 8;
+        header.numY = BinaryIO::readUInt64(field);field += 8;
+        header.numZ = BinaryIO::readUInt64(field);field += 8;
+        header.spaceDim = BinaryIO::readUInt64(field);field += 8;
+        header.numValues = BinaryIO::readUInt64(field);field += 8;
+        header.textSize = BinaryIO::readUInt64(field);field += 8;
+        header.axesOffset = BinaryIO::readUInt64(field);field += 8;
+        header.dataOffset = BinaryIO::readUInt64(field);field += 8;
+
+        // Check sizes against file size before computing offsets, so
+        // corrupt headers cannot overflow the arithmetic.
+        const uint64_t maxValues = fileSize / 8;
+        if (( header.spaceDim < 1) || ( header.spaceDim > 3) ||
+            ( header.numValues < 1) || ( header.numValues > maxValues) ||
+            ( header.numX > maxValues) || ( header.numY > maxValues) || ( header.numZ > maxValues) ||
+            ( header.textSize > fileSize) || ( header.axesOffset > fileSize) ||
+            ( header.axesOffset < Header::size + header.textSize) ||
+            ( header.axesOffset + 8*(header.numX + header.numY + header.numZ) > header.dataOffset) ||
+            ( header.dataOffset % 8) ||
+            ( header.dataOffset > fileSize)) {
+            throw std::runtime_error("Inconsistent sizes in SimpleGridDB binary header.");
+        } // if
+        const uint64_t numLocs = header.numLocs();
+        if (( numLocs < 1) || ( numLocs > maxValues / header.numValues) ||
+            ( header.dataOffset + 8*numLocs*header.numValues > fileSize)) {
+            std::ostringstream msg;
+            msg << "File is too small to contain " << numLocs << " points with "
+                << header.numValues << " values.";
+            throw std::runtime_error(msg.str());
+        } // if
+
+        db->_numX = header.numX;
+        db->_numY = header.numY;
+        db->_numZ = header.numZ;
+        db->_spaceDim = header.spaceDim;
+        db->_numValues = header.numValues;
+        _readTextHeader(std::string(buffer + Header::size, header.textSize), db);
+
+        // Set data dimension based on dimensions of data.
+        db->_dataDim = 0;
+        if (db->_numX > 1) {
+            db->_dataDim += 1;
+        } // if
+        if (db->_numY > 1) {
+            db->_dataDim += 1;
+        } // if
+        if (db->_numZ > 1) {
+            db->_dataDim += 1;
+        } // if
+
+        const char* axes = buffer + header.axesOffset;
+        if (db->_numX > 0) {
+            db->_x = new double[db->_numX];
+            BinaryIO::readDoubles(db->_x, axes, db->_numX);
+            axes += 8*db->_numX;
+        } // if
+        if (db->_numY > 0) {
+            db->_y = new double[db->_numY];
+            BinaryIO::readDoubles(db->_y, axes, db->_numY);
+            axes += 8*db->_numY;
+        } // if
+        if (db->_numZ > 0) {
+            db->_z = new double[db->_numZ];
+            BinaryIO::readDoubles(db->_z, axes, db->_numZ);
+            axes += 8*db->_numZ;
+        } // if
+
+        if (BinaryIO::isNativeLittleEndian()) {
+            // Use values in place; pages are loaded on demand.
+            db->_data = (double*)(buffer + header.dataOffset);
+        } else {
+            const size_t dataSize = numLocs * header.numValues;
+            double* data = new double[dataSize];
+            BinaryIO::readDoubles(data, buffer + header.dataOffset, dataSize);
+            db->_deallocateData();
+            db->_data = data;
+        } // if/else
+
+        db->_checkCompatibility();
+    } catch (const std::exception& err) {
+        std::ostringstream msg;
+        msg << "Error occurred while reading spatial database file '" << db->_filename << "'.\n"
+            << err.what();
+        throw std::runtime_error(msg.str());
+    } catch (...) {
+        std::ostringstream msg;
+        msg << "Unknown error occurred while reading spatial database file '" << db->_filename << "'.\n";
+        throw std::runtime_error(msg.str());
+    } // try/catch
+} // read
+
+
+// ----------------------------------------------------------------------
+// Write binary database file.
+void
+spatialdata::spatialdb::SimpleGridBinary::write(const SimpleGridDB& db) { // write
+    typedef spatialdata::utils::BinaryIO BinaryIO;
+    typedef _simplegridbinary::Header Header;
+
+    try {
+        std::ofstream fileout(db._filename.c_str(), std::ios::out | std::ios::binary);
+        if (!fileout.is_open() || !fileout.good()) {
+            std::ostringstream msg;
+            msg << "Could not open spatial database file '" << db._filename
+                << "' for writing.\n";
+            throw std::runtime_error(msg.str());
+        } // if
+
+        std::ostringstream text;
+        _writeTextHeader(text, db);
+        const std::string& textHeader = text.str();
+
+        Header header;
+        header.numX = db._numX;
+        header.numY = db._numY;
+        header.numZ = db._numZ;
+        header.spaceDim = db._spaceDim;
+        header.numValues = db._numValues;
+        header.textSize = textHeader.length();
+        header.axesOffset = 8 * ((Header::size + header.textSize + 7) / 8);
+        header.dataOffset = header.axesOffset + 8*(header.numX + header.numY + header.numZ);
+
+        std::vector<char> magic(Header::magicSize, '\0');
+        memcpy(&magic[0], FILEHEADER, strlen(FILEHEADER));
+        fileout.write(&magic[0], Header::magicSize);
+        BinaryIO::writeUInt64(fileout, Header::version);
+        BinaryIO::writeUInt64(fileout, header.numX);
+        BinaryIO::writeUInt64(fileout, header.numY);
+        BinaryIO::writeUInt64(fileout, header.numZ);
+        BinaryIO::writeUInt64(fileout, header.spaceDim);
+        BinaryIO::writeUInt64(fileout, header.numValues);
+        BinaryIO::writeUInt64(fileout, header.textSize);
+        BinaryIO::writeUInt64(fileout, header.axesOffset);
+        BinaryIO::writeUInt64(fileout, header.dataOffset);
+        fileout.write(textHeader.c_str(), header.textSize);
+        BinaryIO::writePadding(fileout, Header::size + header.textSize);
+
+        if (header.numX > 0) {
+            assert(db._x);
+            BinaryIO::writeDoubles(fileout, db._x, header.numX);
+        } // if
+        if (header.numY > 0) {
+            assert(db._y);
+            BinaryIO::writeDoubles(fileout, db._y, header.numY);
+        } // if
+        if (header.numZ > 0) {
+            assert(db._z);
+            BinaryIO::writeDoubles(fileout, db._z, header.numZ);
+        } // if
+
+        assert(db._data);
+        if (db._numBlocks[0] > 0) {
+            // Write values with x varying fastest.
+            const size_t numValues = header.numValues;
+            std::vector<double> data(header.numLocs()*numValues);
+            for (size_t iZ = 0, iLinear = 0; iZ < db._numZ; ++iZ) {
+                for (size_t iY = 0; iY < db._numY; ++iY) {
+                    for (size_t iX = 0; iX < db._numX; ++iX, iLinear += numValues) {
+                        const size_t iBlocked = db._getDataIndex(iX, db._numX, iY, db._numY, iZ, db._numZ);
+                        memcpy(&data[iLinear], &db._data[iBlocked], numValues*sizeof(double));
+                    } // for
+                } // for
+            } // for
+            BinaryIO::writeDoubles(fileout, &data[0], data.size());
+        } else {
+            BinaryIO::writeDoubles(fileout, db._data, header.numLocs()*header.numValues);
+        } // if/else
+
+        if (!fileout.good()) {
+            throw std::runtime_error("Unknown error while writing.");
+        }
+
+        fileout.close();
+    } catch (const std::exception& err) {
+        std::ostringstream msg;
+        msg << "Error occurred while writing spatial database file '" << db._filename << "'.\n"
+            << err.what();
+        throw std::runtime_error(msg.str());
+    } catch (...) {
+        std::ostringstream msg;
+        msg << "Unknown error occurred while writing spatial database file '" << db._filename << "'.\n";
+        throw std::runtime_error(msg.str());
+    } // try/catch
+} // write
+
+
+// ----------------------------------------------------------------------
+// Convert SimpleGridDB file from ASCII format to binary format.
+void
+spatialdata::spatialdb::SimpleGridBinary::convertAscii(const char* asciiFilename,
+                                                       const char* binaryFilename) { // convertAscii
+    assert(asciiFilename);
+    assert(binaryFilename);
+
+    // Values are written in the units of the ASCII file.
+    SimpleGridDB db;
+    db.setFilename(asciiFilename);
+    SimpleGridAscii::read(&db);
+
+    db.setFilename(binaryFilename);
+    write(db);
+} // convertAscii
+
+
+// ----------------------------------------------------------------------
+// Read text header with names and units of values and coordinate system.
+void
+spatialdata::spatialdb::SimpleGridBinary::_readTextHeader(const std::string& buffer,
+                                                          SimpleGridDB* const db) { // _readTextHeader
+    assert(db);
+    assert(db->_numValues > 0);
+
+    std::istringstream sin(buffer);
+    const int maxIgnore = 256;
+    std::string token;
+
+    sin >> token;
+    if (0 != strcasecmp(token.c_str(), "value-names")) {
+        std::ostringstream msg;
+        msg << "Could not parse '" << token << "' into 'value-names'.";
+        throw std::runtime_error(msg.str());
+    } // if
+    sin.ignore(maxIgnore, '=');
+    db->_names = new std::string[db->_numValues];
+    for (size_t iVal = 0; iVal < db->_numValues; ++iVal) {
+        sin >> db->_names[iVal];
+    } // for
+
+    sin >> token;
+    if (0 != strcasecmp(token.c_str(), "value-units")) {
+        std::ostringstream msg;
+        msg << "Could not parse '" << token << "' into 'value-units'.";
+        throw std::runtime_error(msg.str());
+    } // if
+    sin.ignore(maxIgnore, '=');
+    db->_units = new std::string[db->_numValues];
+    for (size_t iVal = 0; iVal < db->_numValues; ++iVal) {
+        sin >> db->_units[iVal];
+    } // for
+
+    sin >> token;
+    if (0 != strcasecmp(token.c_str(), "cs-data")) {
+        std::ostringstream msg;
+        msg << "Could not parse '" << token << "' into 'cs-data'.";
+        throw std::runtime_error(msg.str());
+    } // if
+    spatialdata::geocoords::CSPicklerAscii::unpickle(sin, &db->_cs);
+
+    if (sin.fail()) {
+        throw std::runtime_error("I/O error while parsing SimpleGridDB settings.");
+    } // if
+} // _readTextHeader
+
+
+// ----------------------------------------------------------------------
+// Write text header with names and units of values and coordinate system.
+void
+spatialdata::spatialdb::SimpleGridBinary::_writeTextHeader(std::ostream& fileout,
+                                                           const SimpleGridDB& db) { // _writeTextHeader
+    const size_t numValues = db._numValues;
+
+    assert(db._names);
+    fileout << "value-names =";
+    for (size_t iVal = 0; iVal < numValues; ++iVal) {
+        fileout << "  " << db._names[iVal];
+    } // for
+    fileout << "\n";
+
+    assert(db._units);
+    fileout << "value-units =";
+    for (size_t iVal = 0; iVal < numValues; ++iVal) {
+        fileout << "  " << db._units[iVal];
+    } // for
+    fileout << "\n";
+
+    assert(db._cs);
+    fileout << "cs-data = ";
+    spatialdata::geocoords::CSPicklerAscii::pickle(fileout, db._cs);
+} // _writeTextHeader
+
+
+// End of file
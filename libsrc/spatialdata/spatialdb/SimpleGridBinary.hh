@@ -0,0 +1,103 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+#pragma once
+
+#include "SimpleGridDB.hh" // ISA SimpleGridDB
+
+#include <iosfwd> // USES std::istream
+
+/** Reader/writer for SimpleGridDB files in binary format.
+ *
+ * The file contains a fixed-size header with the magic string and the
+ * dimensions of the grid, a text header with the names and units of
+ * the values and the coordinate system, the coordinates along each
+ * axis, and the data values. All numbers are stored as little-endian
+ * 64-bit integers or doubles, and the data values are stored in the
+ * order used internally by SimpleGridDB so that they can be
+ * memory-mapped without any conversion.
+ */
+class spatialdata::spatialdb::SimpleGridBinary { // SimpleGridBinary
+public:
+
+    // PUBLIC METHODS /////////////////////////////////////////////////////
+
+    // Using default constructor.
+
+    // Using default destructor.
+
+    // Using default copy constructor
+
+    /** Check whether file is a SimpleGridDB file in binary format.
+     *
+     * @param filename Name of file.
+     * @returns True if file starts with magic header for binary format, false otherwise.
+     */
+    static
+    bool isBinary(const char* filename);
+
+    /** Read the database.
+     *
+     * On little-endian platforms the data values are memory-mapped
+     * rather than read, so pages are loaded on demand and are shared
+     * among processes reading the same file.
+     *
+     * @param db Spatial database.
+     */
+    static
+    void read(SimpleGridDB* db);
+
+    /** Write the database.
+     *
+     * @param db Spatial database.
+     */
+    static
+    void write(const SimpleGridDB& db);
+
+    /** Convert SimpleGridDB file from ASCII format to binary format.
+     *
+     * @param asciiFilename Name of file in ASCII format.
+     * @param binaryFilename Name of file in binary format.
+     */
+    static
+    void convertAscii(const char* asciiFilename,
+                      const char* binaryFilename);
+
+private:
+
+    // PRIVATE METHODS ////////////////////////////////////////////////////
+
+    /** Read text header with names and units of values and coordinate system.
+     *
+     * @param buffer Text header.
+     * @param db Spatial database.
+     */
+    static
+    void _readTextHeader(const std::string& buffer,
+                         SimpleGridDB* const db);
+
+    /** Write text header with names and units of values and coordinate system.
+     *
+     * @param fileout Output stream.
+     * @param db Spatial database.
+     */
+    static
+    void _writeTextHeader(std::ostream& fileout,
+                          const SimpleGridDB& db);
+
+private:
+
+    // PRIVATE MEMBERS ////////////////////////////////////////////////////
+
+    /** Magic header in binary files */
+    static const char* FILEHEADER;
+
+}; // class SimpleGridBinary
+
+// End of file
@@ -13,17 +13,21 @@
 #include "SimpleGridDB.hh" // Implementation of class methods
 
 #include "SimpleGridAscii.hh" // USES SimpleGridAscii
+#include "SimpleGridBinary.hh" // USES SimpleGridBinary
+#include "QueryContext.hh" // USES QueryContext
 
 #include "spatialdata/geocoords/CoordSys.hh" // HASA CoordSys
 #include "spatialdata/geocoords/Converter.hh" // USES Converter
 #include "spatialdata/utils/LineParser.hh" // USES LineParser
+#include "spatialdata/utils/BinaryIO.hh" // USES BinaryIO
 
-#include <cmath> // USES std::floor()
+#include <cmath> // USES std::floor(), fabs()
+#include <vector> // USES std::vector
 
 #include <fstream> // USES std::ifstream
 #include <sstream> // USES std::ostringstream
 #include <stdexcept> // USES std::logic_error
-#include <cstring> // USES memcpy()
+#include <cstring> // USES memcpy(), memset()
 #include <strings.h> // USES strcasecmp()
 #include <assert.h> // USES assert()
 
@@ -31,6 +35,8 @@
 // Constructor
 spatialdata::spatialdb::SimpleGridDB::SimpleGridDB(void) :
     _data(NULL),
+    _dataMap(NULL),
+    _dataMapSize(0),
     _x(NULL),
     _y(NULL),
     _z(NULL),
@@ -47,13 +53,20 @@ spatialdata::spatialdb::SimpleGridDB::SimpleGridDB(void) :
     _filename(""),
     _cs(NULL),
     _converter(new spatialdata::geocoords::Converter),
-    _queryType(NEAREST) {}
+    _queryType(NEAREST),
+    _useBlockedLayout(false) {
+    _spacing[0] = 0.0;
+    _spacing[1] = 0.0;
+    _spacing[2] = 0.0;
+    _numBlocks[0] = 0;
+    _numBlocks[1] = 0;
+} // constructor
 
 
 // ----------------------------------------------------------------------
 // Destructor
 spatialdata::spatialdb::SimpleGridDB::~SimpleGridDB(void) {
-    delete[] _data;_data = NULL;
+    _deallocateData();
     delete[] _x;_x = NULL;
     delete[] _y;_y = NULL;
     delete[] _z;_z = NULL;
@@ -83,7 +96,16 @@ spatialdata::spatialdb::SimpleGridDB::setFilename(const char* value) {
 // Open the database and prepare for querying.
 void
 spatialdata::spatialdb::SimpleGridDB::open(void) {
-    SimpleGridAscii::read(this);
+    if (SimpleGridBinary::isBinary(_filename.c_str())) {
+        SimpleGridBinary::read(this);
+    } else {
+        SimpleGridAscii::read(this);
+    } // if/else
+
+    // Use direct index arithmetic for searches along uniformly spaced axes.
+    _spacing[0] = _getUniformSpacing(_x, _numX);
+    _spacing[1] = _getUniformSpacing(_y, _numY);
+    _spacing[2] = _getUniformSpacing(_z, _numZ);
 
     // Convert to SI units
     const size_t numLocs = (3 == _spaceDim) ? _numX * _numY * _numZ : (2 == _spaceDim) ? _numX * _numY : _numX;
@@ -96,6 +118,11 @@ spatialdata::spatialdb::SimpleGridDB::open(void) {
         throw std::runtime_error(msg.str().c_str());
     } // try/catch
 
+    // Memory-mapped data keep the order of the file, so that the pages are not copied.
+    if (_useBlockedLayout && (3 == _dataDim) && !_dataMap) {
+        _setupBlockedLayout();
+    } // if
+
     // Default query values is all values.
     _querySize = _numValues;
     delete[] _queryValues;_queryValues = (_querySize > 0) ? new size_t[_querySize] : NULL;
@@ -109,7 +136,7 @@ spatialdata::spatialdb::SimpleGridDB::open(void) {
 // Close the database.
 void
 spatialdata::spatialdb::SimpleGridDB::close(void) {
-    delete[] _data;_data = NULL;
+    _deallocateData();
     delete[] _x;_x = NULL;
     delete[] _y;_y = NULL;
     delete[] _z;_z = NULL;
@@ -121,6 +148,10 @@ spatialdata::spatialdb::SimpleGridDB::close(void) {
     delete[] _names;_names = NULL;
     delete[] _units;_units = NULL;
 
+    _spacing[0] = 0.0;
+    _spacing[1] = 0.0;
+    _spacing[2] = 0.0;
+
     _querySize = 0;
     delete[] _queryValues;_queryValues = NULL;
 } // close
@@ -134,6 +165,22 @@ spatialdata::spatialdb::SimpleGridDB::setQueryType(const QueryEnum value) {
 } // setQueryType
 
 
+// ----------------------------------------------------------------------
+// Set flag for storing data in blocks of points.
+void
+spatialdata::spatialdb::SimpleGridDB::setUseBlockedLayout(const bool value) {
+    _useBlockedLayout = value;
+} // setUseBlockedLayout
+
+
+// ----------------------------------------------------------------------
+// Get flag for storing data in blocks of points.
+bool
+spatialdata::spatialdb::SimpleGridDB::getUseBlockedLayout(void) const {
+    return _useBlockedLayout;
+} // getUseBlockedLayout
+
+
 // ----------------------------------------------------------------------
 // Get names of values in spatial database.
 void
@@ -151,6 +198,14 @@ spatialdata::spatialdb::SimpleGridDB::getNamesDBValues(const char*** valueNames,
 } // getNamesDBValues
 
 
+// ----------------------------------------------------------------------
+// Get coordinate system of database.
+const spatialdata::geocoords::CoordSys*
+spatialdata::spatialdb::SimpleGridDB::getCoordSys(void) const {
+    return _cs;
+} // getCoordSys
+
+
 // ----------------------------------------------------------------------
 // Set values to be returned by queries.
 void
@@ -200,113 +255,172 @@ spatialdata::spatialdb::SimpleGridDB::query(double* vals,
                                             const double* coords,
                                             const size_t numDims,
                                             const spatialdata::geocoords::CoordSys* csQuery) {
-    const size_t querySize = _querySize;
+    return _query(vals, numVals, coords, numDims, csQuery, _converter);
+} // query
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database.
+void
+spatialdata::spatialdb::SimpleGridDB::multiquery(double* vals,
+                                                 const size_t numLocsV,
+                                                 const size_t numValsV,
+                                                 int* err,
+                                                 const size_t numLocsE,
+                                                 const double* coords,
+                                                 const size_t numLocsC,
+                                                 const size_t numDimsC,
+                                                 const spatialdata::geocoords::CoordSys* csQuery) {
+    assert(_isMultiqueryConsistent(vals, numLocsV, numValsV, err, numLocsE, coords, numLocsC, numDimsC));
+
+    if (_parallelMultiquery(vals, numLocsC, numValsV, err, coords, numDimsC, csQuery)) {
+        return;
+    } // if
+    _multiquery(vals, numLocsC, numValsV, err, coords, numDimsC, csQuery, _converter);
+} // multiquery
+
+
+// ----------------------------------------------------------------------
+// Check whether database supports query contexts.
+bool
+spatialdata::spatialdb::SimpleGridDB::supportsQueryContexts(void) const {
+    return true;
+} // supportsQueryContexts
+
 
-    if (0 == querySize) {
+// ----------------------------------------------------------------------
+// Create context for querying the database.
+spatialdata::spatialdb::QueryContext*
+spatialdata::spatialdb::SimpleGridDB::createQueryContext(void) const {
+    if (!_data) {
         std::ostringstream msg;
-        msg << "Values to be returned by spatial database " << getDescription() << "\n"
-            << "have not been set. Please call setQueryValues() before query().\n";
+        msg << "Spatial database " << getDescription() << " has not been opened.\n"
+            << "Please call open() before calling createQueryContext().";
         throw std::logic_error(msg.str());
-    } else if (numVals != querySize) {
-        std::ostringstream msg;
-        msg << "Number of values to be returned by spatial database "
-            << getDescription() << "\n"
-            << "(" << querySize << ") does not match size of array provided ("
-            << numVals << ").\n";
-        throw std::invalid_argument(msg.str());
-    } else if (numDims != _spaceDim) {
-        std::ostringstream msg;
-        msg << "Spatial dimension (" << numDims
-            << ") does not match spatial dimension of spatial database (" << _spaceDim << ").";
-        throw std::invalid_argument(msg.str());
     } // if
 
+    return new QueryContext(*this);
+} // createQueryContext
+
+
+// ----------------------------------------------------------------------
+// Query the database using scratch storage in query context.
+int
+spatialdata::spatialdb::SimpleGridDB::_contextQuery(QueryContext* context,
+                                                    double* vals,
+                                                    const size_t numVals,
+                                                    const double* coords,
+                                                    const size_t numDims,
+                                                    const spatialdata::geocoords::CoordSys* csQuery) const {
+    assert(context);
+    return _query(vals, numVals, coords, numDims, csQuery, context->getConverter());
+} // _contextQuery
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database using scratch storage in query context.
+void
+spatialdata::spatialdb::SimpleGridDB::_contextMultiquery(QueryContext* context,
+                                                         double* vals,
+                                                         const size_t numLocs,
+                                                         const size_t numVals,
+                                                         int* err,
+                                                         const double* coords,
+                                                         const size_t numDims,
+                                                         const spatialdata::geocoords::CoordSys* csQuery) const {
+    assert(context);
+    _multiquery(vals, numLocs, numVals, err, coords, numDims, csQuery, context->getConverter());
+} // _contextMultiquery
+
+
+// ----------------------------------------------------------------------
+// Query the database.
+int
+spatialdata::spatialdb::SimpleGridDB::_query(double* vals,
+                                             const size_t numVals,
+                                             const double* coords,
+                                             const size_t numDims,
+                                             const spatialdata::geocoords::CoordSys* csQuery,
+                                             spatialdata::geocoords::Converter* converter) const {
+    _checkQueryArgs(numVals, numDims);
+
     // Convert coordinates
     assert(numDims <= 3);
-    memcpy(_xyz, coords, numDims*sizeof(double));
-    assert(_converter);
-    _converter->convert(_xyz, 1, numDims, _cs, csQuery);
+    double xyz[3];
+    memcpy(xyz, coords, numDims*sizeof(double));
+    assert(converter);
+    converter->convert(xyz, 1, numDims, _cs, csQuery);
+
+    double indices[3] = { 0.0, 0.0, 0.0 };
+    size_t sizes[3] = { 0, 0, 0 };
+    for (size_t iDim = 0; iDim < numDims; ++iDim) {
+        indices[iDim] = _searchAxis(xyz[iDim], iDim);
+    } // for
+    _reindex(indices, sizes);
 
-    int queryFlag = 0;
-    const int spaceDim = _spaceDim;
+    return _getValues(vals, numVals, indices, sizes);
+} // _query
 
-    double index0 = 0.0;
-    double index1 = 0.0;
-    double index2 = 0.0;
-    size_t size0 = 0;
-    size_t size1 = 0;
-    size_t size2 = 0;
-    if (3 == spaceDim) {
-        index0 = _search(_xyz[0], _x, _numX);
-        index1 = _search(_xyz[1], _y, _numY);
-        index2 = _search(_xyz[2], _z, _numZ);
-        _reindex3d(&index0, &size0, &index1, &size1, &index2, &size2);
-    } else if (2 == spaceDim) {
-        index0 = _search(_xyz[0], _x, _numX);
-        index1 = _search(_xyz[1], _y, _numY);
-        _reindex2d(&index0, &size0, &index1, &size1);
-    } else { // else
-        assert(1 == spaceDim);
-        index0 = _search(_xyz[0], _x, _numX);
-        size0 = _numX;
-    } // if/else
 
-    switch (_queryType) {
-    case LINEAR:
-        if (( index0 < 0.0) || (( index0 > 0) && ( index0 > size0-1.0) ) ||
-            ( index1 < 0.0) || (( index1 > 0) && ( index1 > size1-1.0) ) ||
-            ( index2 < 0.0) || (( index2 > 0) && ( index2 > size2-1.0) )) {
-            queryFlag = 1;
-            return queryFlag;
-        } // if
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database.
+void
+spatialdata::spatialdb::SimpleGridDB::_multiquery(double* vals,
+                                                  const size_t numLocs,
+                                                  const size_t numVals,
+                                                  int* err,
+                                                  const double* coords,
+                                                  const size_t numDims,
+                                                  const spatialdata::geocoords::CoordSys* csQuery,
+                                                  spatialdata::geocoords::Converter* converter) const {
+    if (0 == numLocs) {
+        return;
+    } // if
+    _checkQueryArgs(numVals, numDims);
 
-        switch (_dataDim) {
-        case 1:
-            _interpolate1D(vals, numVals, index0, size0);
-            break;
-        case 2:
-            _interpolate2D(vals, numVals, index0, size0, index1, size1);
-            break;
-        case 3:
-            _interpolate3D(vals, numVals, index0, index1, index2);
-            break;
-        default:
-            assert(false);
-            throw std::logic_error("Unsupported data dimension in SimpleGridDB::query().");
-        } // switch
-        break;
-    case NEAREST: {
-        index0 = std::min(index0, size0-1.0);
-        index0 = std::max(index0, 0.0);
-        index1 = std::min(index1, size1-1.0);
-        index1 = std::max(index1, 0.0);
-        index2 = std::min(index2, size2-1.0);
-        index2 = std::max(index2, 0.0);
-        const size_t indexNearest0 = size_t(std::floor(index0+0.5));
-        const size_t indexNearest1 = size_t(std::floor(index1+0.5));
-        const size_t indexNearest2 = size_t(std::floor(index2+0.5));
-        const size_t indexData = _getDataIndex(indexNearest0, size0, indexNearest1, size1, indexNearest2, size2);
+    // Convert coordinates of all locations at once.
+    assert(numDims <= 3);
+    std::vector<double> xyz(coords, coords+numLocs*numDims);
+    assert(converter);
+    converter->convert(&xyz[0], numLocs, numDims, _cs, csQuery);
+
+    // Search along one axis at a time for all locations.
+    std::vector<double> indices(numLocs*3, 0.0);
+    for (size_t iDim = 0; iDim < numDims; ++iDim) {
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            indices[iLoc*3+iDim] = _searchAxis(xyz[iLoc*numDims+iDim], iDim);
+        } // for
+    } // for
 
-        for (size_t iVal = 0; iVal < querySize; ++iVal) {
-            vals[iVal] = _data[indexData+_queryValues[iVal]];
-#if 0 // DEBUGGING
-            std::cout << "val["<<iVal<<"]: " << vals[iVal]
-                      << ", indexData: " << indexData
-                      << ", index0: " << index0
-                      << ", index1: " << index1
-                      << ", index2: " << index2
-                      << std::endl;
-#endif
+    if (NEAREST == _queryType) {
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            size_t sizes[3] = { 0, 0, 0 };
+            _reindex(&indices[iLoc*3], sizes);
+            err[iLoc] = _getValues(&vals[iLoc*numVals], numVals, &indices[iLoc*3], sizes);
         } // for
-        break;
-    } // NEAREST
-    default:
-        assert(false);
-        throw std::logic_error("Unsupported query type in SimpleGridDB::query().");
-    } // switch
+        return;
+    } // if
 
-    return queryFlag;
-} // query
+    // Get grid points and weights for all locations inside the grid, then interpolate all at once.
+    assert(LINEAR == _queryType);
+    const size_t numPoints = size_t(1) << _dataDim;
+    std::vector<size_t> locs(numLocs);
+    std::vector<size_t> dataIndices(numLocs*numPoints);
+    std::vector<double> weights(numLocs*numPoints);
+    size_t numInside = 0;
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        size_t sizes[3] = { 0, 0, 0 };
+        _reindex(&indices[iLoc*3], sizes);
+        if (_isInside(&indices[iLoc*3], sizes)) {
+            _getLinearWeights(&dataIndices[numInside*numPoints], &weights[numInside*numPoints], &indices[iLoc*3], sizes);
+            locs[numInside++] = iLoc;
+            err[iLoc] = 0;
+        } else {
+            err[iLoc] = 1;
+        } // if/else
+    } // for
+    _interpolate(vals, numVals, locs.data(), numInside, dataIndices.data(), weights.data());
+} // _multiquery
 
 
 // ----------------------------------------------------------------------
@@ -328,11 +442,15 @@ spatialdata::spatialdb::SimpleGridDB::allocate(const size_t numX,
     _checkCompatibility();
 
     const size_t numLocs = (3 == spaceDim) ? _numX * _numY * _numZ : (2 == spaceDim) ? _numX * _numY : _numX;
-    delete[] _data;_data = (numLocs*numValues > 0) ? new double[numLocs*numValues] : NULL;
+    _deallocateData();
+    _data = (numLocs*numValues > 0) ? new double[numLocs*numValues] : NULL;
 
     delete[] _x;_x = (numX > 0) ? new double[numX] : NULL;
     delete[] _y;_y = (numY > 0) ? new double[numY] : NULL;
     delete[] _z;_z = (numZ > 0) ? new double[numZ] : NULL;
+    _spacing[0] = 0.0;
+    _spacing[1] = 0.0;
+    _spacing[2] = 0.0;
 } // allocate
 
 
@@ -355,6 +473,7 @@ spatialdata::spatialdb::SimpleGridDB::setX(const double* values,
     for (size_t i = 0; i < size; ++i) {
         _x[i] = values[i];
     } // for
+    _spacing[0] = _getUniformSpacing(_x, size);
 } // setD
 
 
@@ -377,6 +496,7 @@ spatialdata::spatialdb::SimpleGridDB::setY(const double* values,
     for (size_t i = 0; i < size; ++i) {
         _y[i] = values[i];
     } // for
+    _spacing[1] = _getUniformSpacing(_y, size);
 } // setY
 
 
@@ -399,6 +519,7 @@ spatialdata::spatialdb::SimpleGridDB::setZ(const double* values,
     for (size_t i = 0; i < size; ++i) {
         _z[i] = values[i];
     } // for
+    _spacing[2] = _getUniformSpacing(_z, size);
 } // setZ
 
 
@@ -492,6 +613,59 @@ spatialdata::spatialdb::SimpleGridDB::setCoordSys(const geocoords::CoordSys& cs)
 } // setCoordSys
 
 
+// ----------------------------------------------------------------------
+// Deallocate data values, unmapping them if they are memory-mapped.
+void
+spatialdata::spatialdb::SimpleGridDB::_deallocateData(void) {
+    if (_dataMap) {
+        spatialdata::utils::BinaryIO::unmap(_dataMap, _dataMapSize);
+        _dataMap = NULL;
+        _dataMapSize = 0;
+        _data = NULL;
+    } else {
+        delete[] _data;_data = NULL;
+    } // if/else
+    _numBlocks[0] = 0;
+    _numBlocks[1] = 0;
+} // _deallocateData
+
+
+// ----------------------------------------------------------------------
+// Reorder data values into blocks of points.
+void
+spatialdata::spatialdb::SimpleGridDB::_setupBlockedLayout(void) {
+    assert(3 == _dataDim);
+    assert(_data);
+    assert(!_dataMap);
+
+    // Pad grid to whole number of blocks along each axis.
+    const size_t blockSize = size_t(1) << BLOCKBITS;
+    const size_t numBlocksX = (_numX + blockSize - 1) >> BLOCKBITS;
+    const size_t numBlocksY = (_numY + blockSize - 1) >> BLOCKBITS;
+    const size_t numBlocksZ = (_numZ + blockSize - 1) >> BLOCKBITS;
+    const size_t size = (numBlocksX*numBlocksY*numBlocksZ << 3*BLOCKBITS) * _numValues;
+    double* data = new double[size];
+    memset(data, 0, size*sizeof(double));
+
+    // Indices into new data array use blocks once the number of blocks is set.
+    double* dataLinear = _data;
+    _numBlocks[0] = numBlocksX;
+    _numBlocks[1] = numBlocksY;
+    for (size_t iZ = 0, iLinear = 0; iZ < _numZ; ++iZ) {
+        for (size_t iY = 0; iY < _numY; ++iY) {
+            for (size_t iX = 0; iX < _numX; ++iX, iLinear += _numValues) {
+                const size_t iBlocked = _getDataIndex(iX, _numX, iY, _numY, iZ, _numZ);
+                memcpy(&data[iBlocked], &dataLinear[iLinear], _numValues*sizeof(double));
+            } // for
+        } // for
+    } // for
+
+    // Release original data without resetting the number of blocks.
+    delete[] dataLinear;dataLinear = NULL;
+    _data = data;
+} // _setupBlockedLayout
+
+
 // ----------------------------------------------------------------------
 // Check compatibility of spatial database parameters.
 void
@@ -557,6 +731,118 @@ spatialdata::spatialdb::SimpleGridDB::_checkCompatibility(void) const {
 } // _checkCompatibility
 
 
+// ----------------------------------------------------------------------
+// Check whether coordinates along axis are uniformly spaced.
+bool
+spatialdata::spatialdb::SimpleGridDB::isUniformAxis(const size_t iAxis) const {
+    assert(iAxis < 3);
+    return _spacing[iAxis] > 0.0;
+} // isUniformAxis
+
+
+// ----------------------------------------------------------------------
+// Check arguments for query.
+void
+spatialdata::spatialdb::SimpleGridDB::_checkQueryArgs(const size_t numVals,
+                                                      const size_t numDims) const {
+    _checkQuerySize(numVals, _querySize);
+    if (numDims != _spaceDim) {
+        std::ostringstream msg;
+        msg << "Spatial dimension (" << numDims
+            << ") does not match spatial dimension of spatial database (" << _spaceDim << ").";
+        throw std::invalid_argument(msg.str());
+    } // if
+} // _checkQueryArgs
+
+
+// ----------------------------------------------------------------------
+// Adjust indices from searches along each axis.
+void
+spatialdata::spatialdb::SimpleGridDB::_reindex(double indices[3],
+                                               size_t sizes[3]) const {
+    const size_t spaceDim = _spaceDim;
+    if (3 == spaceDim) {
+        _reindex3d(&indices[0], &sizes[0], &indices[1], &sizes[1], &indices[2], &sizes[2]);
+    } else if (2 == spaceDim) {
+        _reindex2d(&indices[0], &sizes[0], &indices[1], &sizes[1]);
+    } else { // else
+        assert(1 == spaceDim);
+        sizes[0] = _numX;
+    } // if/else
+} // _reindex
+
+
+// ----------------------------------------------------------------------
+// Check whether location defined by adjusted indices is inside grid.
+bool
+spatialdata::spatialdb::SimpleGridDB::_isInside(const double indices[3],
+                                                const size_t sizes[3]) const {
+    for (size_t iDim = 0; iDim < 3; ++iDim) {
+        if (( indices[iDim] < 0.0) || (( indices[iDim] > 0) && ( indices[iDim] > sizes[iDim]-1.0) )) {
+            return false;
+        } // if
+    } // for
+    return true;
+} // _isInside
+
+
+// ----------------------------------------------------------------------
+// Get values at target location defined by adjusted indices.
+int
+spatialdata::spatialdb::SimpleGridDB::_getValues(double* vals,
+                                                 const size_t numVals,
+                                                 double indices[3],
+                                                 const size_t sizes[3]) const {
+    int queryFlag = 0;
+
+    double& index0 = indices[0];
+    double& index1 = indices[1];
+    double& index2 = indices[2];
+    const size_t size0 = sizes[0];
+    const size_t size1 = sizes[1];
+    const size_t size2 = sizes[2];
+
+    switch (_queryType) {
+    case LINEAR: {
+        if (!_isInside(indices, sizes)) {
+            queryFlag = 1;
+            return queryFlag;
+        } // if
+
+        size_t dataIndices[8];
+        double weights[8];
+        _getLinearWeights(dataIndices, weights, indices, sizes);
+        const size_t loc = 0;
+        _interpolate(vals, numVals, &loc, 1, dataIndices, weights);
+        break;
+    } // LINEAR
+    case NEAREST: {
+        index0 = std::min(index0, size0-1.0);
+        index0 = std::max(index0, 0.0);
+        index1 = std::min(index1, size1-1.0);
+        index1 = std::max(index1, 0.0);
+        index2 = std::min(index2, size2-1.0);
+        index2 = std::max(index2, 0.0);
+        const size_t indexNearest0 = size_t(std::floor(index0+0.5));
+        const size_t indexNearest1 = size_t(std::floor(index1+0.5));
+        const size_t indexNearest2 = size_t(std::floor(index2+0.5));
+        const size_t indexData = _getDataIndex(indexNearest0, size0, indexNearest1, size1, indexNearest2, size2);
+
+        assert(numVals == _querySize);
+        for (size_t iVal = 0; iVal < numVals; ++iVal) {
+            vals[iVal] = _data[indexData+_queryValues[iVal]];
+        } // for
+        break;
+    } // NEAREST
+    default:
+        assert(false);
+        throw std::logic_error("Unsupported query type in SimpleGridDB::query().");
+    } // switch
+
+    return queryFlag;
+} // _getValues
+
+
 // ----------------------------------------------------------------------
 // Bilinear search for coordinate.
 double
@@ -599,180 +885,126 @@ spatialdata::spatialdb::SimpleGridDB::_search(const double target,
 
 
 // ----------------------------------------------------------------------
-// Interpolate to get values at target location defined by indices in 1-D.
-void
-spatialdata::spatialdb::SimpleGridDB::_interpolate1D(double* vals,
-                                                     const size_t numVals,
-                                                     const double indexX,
-                                                     const size_t numX) const {
-    assert(numX >= 2);
-    const size_t indexX0 = std::min(numX-2, size_t(std::floor(indexX)));
-    const double wtX0 = 1.0 - (indexX - indexX0);
-    const size_t indexX1 = indexX0 + 1;
-    const double wtX1 = 1.0 - wtX0;
-    assert(0 <= indexX0 && indexX0 < numX);
-    assert(0 <= indexX1 && indexX1 < numX);
-
-    const size_t index000 = _getDataIndex(indexX0, numX, 0, 0, 0, 0);
-    const size_t index100 = _getDataIndex(indexX1, numX, 0, 0, 0, 0);
-
-    const double wt000 = wtX0;
-    const double wt100 = wtX1;
-
-    const size_t querySize = _querySize;
-    for (size_t iVal = 0; iVal < querySize; ++iVal) {
-        const size_t qVal = _queryValues[iVal];
-        vals[iVal] =
-            wt000 * _data[index000+qVal] +
-            wt100 * _data[index100+qVal];
-#if 0 // DEBUGGING
-        std::cout << "val["<<iVal<<"]: " << vals[iVal]
-                  << ", wt000: " << wt000 << ", data: " << _data[index000+qVal]
-                  << ", wt100: " << wt100 << ", data: " << _data[index100+qVal]
-                  << std::endl;
-#endif
-    } // for
+// Search for coordinate along axis.
+double
+spatialdata::spatialdb::SimpleGridDB::_searchAxis(const double target,
+                                                  const size_t iAxis) const {
+    assert(iAxis < 3);
+    const double* vals = (0 == iAxis) ? _x : (1 == iAxis) ? _y : _z;
+    const size_t nvals = (0 == iAxis) ? _numX : (1 == iAxis) ? _numY : _numZ;
+    const double spacing = _spacing[iAxis];
+    if (spacing <= 0.0) {
+        return _search(target, vals, nvals);
+    } // if
 
-} // _interpolate1D
+    // Same result as bisection in _search(), but without the search.
+    assert(vals);
+    assert(nvals > 1);
+    double index = -1.0;
+    const double tolerance = 1.0e-6;
+    if (( target >= vals[0]-tolerance) && ( target <= vals[nvals-1]+tolerance) ) {
+        index = (target - vals[0]) / spacing;
+    } else if (_queryType == NEAREST) {
+        index = (target <= vals[0]) ? 0.0 : double(nvals-1);
+    } // if/else
+
+    return index;
+} // _searchAxis
 
 
 // ----------------------------------------------------------------------
-// Interpolate to get values at target location defined by indices in 2-D.
-void
-spatialdata::spatialdb::SimpleGridDB::_interpolate2D(double* vals,
-                                                     const size_t numVals,
-                                                     const double indexX,
-                                                     const size_t numX,
-                                                     const double indexY,
-                                                     const size_t numY) const {
-    assert(numX >= 2);
-    const size_t indexX0 = std::min(numX-2, size_t(std::floor(indexX)));
-    const double wtX0 = 1.0 - (indexX - indexX0);
-    const size_t indexX1 = indexX0 + 1;
-    const double wtX1 = 1.0 - wtX0;
-    assert(0 <= indexX0 && indexX0 < numX);
-    assert(0 <= indexX1 && indexX1 < numX);
-
-    assert(numY >= 2);
-    const size_t indexY0 = std::min(numY-2, size_t(std::floor(indexY)));
-    const double wtY0 = 1.0 - (indexY - indexY0);
-    const size_t indexY1 = indexY0 + 1;
-    const double wtY1 = 1.0 - wtY0;
-    assert(0 <= indexY0 && indexY0 < numY);
-    assert(0 <= indexY1 && indexY1 < numY);
-
-    const size_t index000 = _getDataIndex(indexX0, numX, indexY0, numY, 0, 0);
-    const size_t index010 = _getDataIndex(indexX0, numX, indexY1, numY, 0, 0);
-    const size_t index100 = _getDataIndex(indexX1, numX, indexY0, numY, 0, 0);
-    const size_t index110 = _getDataIndex(indexX1, numX, indexY1, numY, 0, 0);
-
-    const double wt000 = wtX0 * wtY0;
-    const double wt010 = wtX0 * wtY1;
-    const double wt100 = wtX1 * wtY0;
-    const double wt110 = wtX1 * wtY1;
-
-    const size_t querySize = _querySize;
-    for (size_t iVal = 0; iVal < querySize; ++iVal) {
-        const size_t qVal = _queryValues[iVal];
-        vals[iVal] =
-            wt000 * _data[index000+qVal] +
-            wt010 * _data[index010+qVal] +
-            wt100 * _data[index100+qVal] +
-            wt110 * _data[index110+qVal];
-#if 0 // DEBUGGING
-        std::cout << "val["<<iVal<<"]: " << vals[iVal]
-                  << ", wt000: " << wt000 << ", data: " << _data[index000+qVal]
-                  << ", wt010: " << wt010 << ", data: " << _data[index010+qVal]
-                  << ", wt100: " << wt100 << ", data: " << _data[index100+qVal]
-                  << ", wt110: " << wt110 << ", data: " << _data[index110+qVal]
-                  << std::endl;
-#endif
+// Get spacing of uniformly spaced coordinates.
+double
+spatialdata::spatialdb::SimpleGridDB::_getUniformSpacing(const double* vals,
+                                                         const size_t nvals) {
+    if (!vals || (nvals < 2)) {
+        return 0.0;
+    } // if
+
+    const double spacing = (vals[nvals-1] - vals[0]) / double(nvals-1);
+    if (spacing <= 0.0) {
+        return 0.0;
+    } // if
+
+    // Deviation from uniform spacing must be negligible relative to the spacing,
+    // so that index arithmetic matches bisection.
+    const double tolerance = 1.0e-8 * spacing;
+    for (size_t i = 1; i < nvals-1; ++i) {
+        if (fabs(vals[i] - (vals[0] + double(i)*spacing)) > tolerance) {
+            return 0.0;
+        } // if
     } // for
 
-} // _interpolate2D
+    return spacing;
+} // _getUniformSpacing
 
 
 // ----------------------------------------------------------------------
-// Interpolate to get values at target location defined by indices in 3-D.
+// Get indices and weights of grid points for linear interpolation at location.
 void
-spatialdata::spatialdb::SimpleGridDB::_interpolate3D(double* vals,
-                                                     const size_t numVals,
-                                                     const double indexX,
-                                                     const double indexY,
-                                                     const double indexZ) const {
-    const size_t numX = _numX;
-    const size_t numY = _numY;
-    const size_t numZ = _numZ;
+spatialdata::spatialdb::SimpleGridDB::_getLinearWeights(size_t dataIndices[8],
+                                                        double weights[8],
+                                                        const double indices[3],
+                                                        const size_t sizes[3]) const {
+    const size_t dataDim = _dataDim;
+    assert(1 <= dataDim && dataDim <= 3);
+
+    // Lower index and weights of the two grid points along each axis.
+    size_t index0[3] = { 0, 0, 0 };
+    double wt[3][2] = { { 1.0, 0.0 }, { 1.0, 0.0 }, { 1.0, 0.0 } };
+    for (size_t iDim = 0; iDim < dataDim; ++iDim) {
+        assert(sizes[iDim] >= 2);
+        index0[iDim] = std::min(sizes[iDim]-2, size_t(std::floor(indices[iDim])));
+        wt[iDim][0] = 1.0 - (indices[iDim] - index0[iDim]);
+        wt[iDim][1] = 1.0 - wt[iDim][0];
+        assert(index0[iDim]+1 < sizes[iDim]);
+    } // for
 
-    assert(numX >= 2);
-    const size_t indexX0 = std::min(numX-2, size_t(std::floor(indexX)));
-    const double wtX0 = 1.0 - (indexX - indexX0);
-    const size_t indexX1 = indexX0 + 1;
-    const double wtX1 = 1.0 - wtX0;
-    assert(0 <= indexX0 && indexX0 < numX);
-    assert(0 <= indexX1 && indexX1 < numX);
-
-    assert(numY >= 2);
-    const size_t indexY0 = std::min(numY-2, size_t(std::floor(indexY)));
-    const double wtY0 = 1.0 - (indexY - indexY0);
-    const size_t indexY1 = indexY0 + 1;
-    const double wtY1 = 1.0 - wtY0;
-    assert(0 <= indexY0 && indexY0 < numY);
-    assert(0 <= indexY1 && indexY1 < numY);
-
-    assert(numZ >= 2);
-    const size_t indexZ0 = std::min(numZ-2, size_t(std::floor(indexZ)));
-    const double wtZ0 = 1.0 - (indexZ - indexZ0);
-    const size_t indexZ1 = indexZ0 + 1;
-    const double wtZ1 = 1.0 - wtZ0;
-    assert(0 <= indexZ0 && indexZ0 < numZ);
-    assert(0 <= indexZ1 && indexZ1 < numZ);
-
-    const size_t index000 = _getDataIndex(indexX0, numX, indexY0, numY, indexZ0, numZ);
-    const size_t index001 = _getDataIndex(indexX0, numX, indexY0, numY, indexZ1, numZ);
-    const size_t index010 = _getDataIndex(indexX0, numX, indexY1, numY, indexZ0, numZ);
-    const size_t index011 = _getDataIndex(indexX0, numX, indexY1, numY, indexZ1, numZ);
-    const size_t index100 = _getDataIndex(indexX1, numX, indexY0, numY, indexZ0, numZ);
-    const size_t index101 = _getDataIndex(indexX1, numX, indexY0, numY, indexZ1, numZ);
-    const size_t index110 = _getDataIndex(indexX1, numX, indexY1, numY, indexZ0, numZ);
-    const size_t index111 = _getDataIndex(indexX1, numX, indexY1, numY, indexZ1, numZ);
-
-    const double wt000 = wtX0 * wtY0 * wtZ0;
-    const double wt001 = wtX0 * wtY0 * wtZ1;
-    const double wt010 = wtX0 * wtY1 * wtZ0;
-    const double wt011 = wtX0 * wtY1 * wtZ1;
-    const double wt100 = wtX1 * wtY0 * wtZ0;
-    const double wt101 = wtX1 * wtY0 * wtZ1;
-    const double wt110 = wtX1 * wtY1 * wtZ0;
-    const double wt111 = wtX1 * wtY1 * wtZ1;
-
-    const size_t querySize = _querySize;
-    for (size_t iVal = 0; iVal < querySize; ++iVal) {
-        const size_t qVal = _queryValues[iVal];
-        vals[iVal] =
-            wt000 * _data[index000+qVal] +
-            wt001 * _data[index001+qVal] +
-            wt010 * _data[index010+qVal] +
-            wt011 * _data[index011+qVal] +
-            wt100 * _data[index100+qVal] +
-            wt101 * _data[index101+qVal] +
-            wt110 * _data[index110+qVal] +
-            wt111 * _data[index111+qVal];
-#if 0 // DEBUGGING
-        std::cout << "val["<<iVal<<"]: " << vals[iVal]
-                  << ", wt000: " << wt000 << ", data: " << _data[index000+qVal]
-                  << ", wt001: " << wt001 << ", data: " << _data[index001+qVal]
-                  << ", wt010: " << wt010 << ", data: " << _data[index010+qVal]
-                  << ", wt011: " << wt011 << ", data: " << _data[index011+qVal]
-                  << ", wt100: " << wt100 << ", data: " << _data[index100+qVal]
-                  << ", wt101: " << wt101 << ", data: " << _data[index101+qVal]
-                  << ", wt110: " << wt110 << ", data: " << _data[index110+qVal]
-                  << ", wt111: " << wt111 << ", data: " << _data[index111+qVal]
-                  << std::endl;
-#endif
+    // Grid points are ordered with the offset along the last axis varying fastest.
+    const size_t numPoints = size_t(1) << dataDim;
+    for (size_t iPoint = 0; iPoint < numPoints; ++iPoint) {
+        size_t index[3] = { 0, 0, 0 };
+        double weight = 1.0;
+        for (size_t iDim = 0; iDim < dataDim; ++iDim) {
+            const size_t offset = (iPoint >> (dataDim-1-iDim)) & 1;
+            index[iDim] = index0[iDim] + offset;
+            weight *= wt[iDim][offset];
+        } // for
+        dataIndices[iPoint] = _getDataIndex(index[0], sizes[0], index[1], sizes[1], index[2], sizes[2]);
+        weights[iPoint] = weight;
     } // for
+} // _getLinearWeights
 
-} // _interpolate3D
+
+// ----------------------------------------------------------------------
+// Interpolate values at locations using indices and weights of grid points.
+void
+spatialdata::spatialdb::SimpleGridDB::_interpolate(double* vals,
+                                                   const size_t numVals,
+                                                   const size_t* locs,
+                                                   const size_t numLocs,
+                                                   const size_t* dataIndices,
+                                                   const double* weights) const {
+    assert(numVals == _querySize);
+    assert(!numLocs || (vals && locs && dataIndices && weights));
+
+    const size_t numPoints = size_t(1) << _dataDim;
+    const double* data = _data;
+    const size_t* queryValues = _queryValues;
+    for (size_t i = 0; i < numLocs; ++i) {
+        double* valsLoc = &vals[locs[i]*numVals];
+        const size_t* indicesLoc = &dataIndices[i*numPoints];
+        const double* weightsLoc = &weights[i*numPoints];
+        for (size_t iVal = 0; iVal < numVals; ++iVal) {
+            const size_t qVal = queryValues[iVal];
+            double value = 0.0;
+            for (size_t iPoint = 0; iPoint < numPoints; ++iPoint) {
+                value += weightsLoc[iPoint] * data[indicesLoc[iPoint]+qVal];
+            } // for
+            valsLoc[iVal] = value;
+        } // for
+    } // for
+} // _interpolate
 
 
 // ----------------------------------------------------------------------
@@ -867,17 +1099,17 @@ spatialdata::spatialdb::SimpleGridDB::_getDataIndex(const double* const coords,
     size_t size1 = 0;
     size_t size2 = 0;
     if (spaceDim > 2) {
-        index0 = std::floor(_search(coords[0], _x, _numX)+0.5);
-        index1 = std::floor(_search(coords[1], _y, _numY)+0.5);
-        index2 = std::floor(_search(coords[2], _z, _numZ)+0.5);
+        index0 = std::floor(_searchAxis(coords[0], 0)+0.5);
+        index1 = std::floor(_searchAxis(coords[1], 1)+0.5);
+        index2 = std::floor(_searchAxis(coords[2], 2)+0.5);
         _reindex3d(&index0, &size0, &index1, &size1, &index2, &size2);
     } else if (spaceDim > 1) {
-        index0 = std::floor(_search(coords[0], _x, _numX)+0.5);
-        index1 = std::floor(_search(coords[1], _y, _numY)+0.5);
+        index0 = std::floor(_searchAxis(coords[0], 0)+0.5);
+        index1 = std::floor(_searchAxis(coords[1], 1)+0.5);
         _reindex2d(&index0, &size0, &index1, &size1);
     } else {
         assert(1 == spaceDim);
-        index0 = std::floor(_search(coords[0], _x, _numX)+0.5);
+        index0 = std::floor(_searchAxis(coords[0], 0)+0.5);
     } // if
 
     const size_t indexData = _getDataIndex(size_t(index0), size0, size_t(index1), size1, size_t(index2), size2);
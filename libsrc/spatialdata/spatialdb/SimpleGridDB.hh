@@ -16,7 +16,9 @@
 class spatialdata::spatialdb::SimpleGridDB : public SpatialDB { // SimpleGridDB
     friend class TestSimpleGridDB; // unit testing
     friend class TestSimpleGridAscii;
+    friend class TestSimpleGridBinary;
     friend class SimpleGridAscii; // reader
+    friend class SimpleGridBinary; // reader
 
 public:
 
@@ -51,6 +53,25 @@ public:
      */
     void setQueryType(const QueryEnum queryType);
 
+    /** Set flag for storing data in blocks of points.
+     *
+     * When true, open() reorders the data of grids with 3-D topology into blocks of 8x8x8 points,
+     * so the points around a query location are close together in memory regardless of the
+     * direction in which queries move through the grid. Data of grids with lower dimension
+     * topology and memory-mapped data are always stored with x varying fastest.
+     *
+     * @pre Must call before open().
+     *
+     * @param value True to store data in blocks of points, false to store data with x varying fastest.
+     */
+    void setUseBlockedLayout(const bool value);
+
+    /** Get flag for storing data in blocks of points.
+     *
+     * @returns True if storing data in blocks of points, false otherwise.
+     */
+    bool getUseBlockedLayout(void) const;
+
     /// Open the database and prepare for querying.
     void open(void);
 
@@ -65,6 +86,12 @@ public:
     void getNamesDBValues(const char*** valueNames,
                           size_t* numValues) const;
 
+    /** Get coordinate system of database.
+     *
+     * @returns Coordinate system.
+     */
+    const spatialdata::geocoords::CoordSys* getCoordSys(void) const;
+
     /** Set values to be returned by queries.
      *
      * @pre Must call open() before setQueryValues()
@@ -96,6 +123,52 @@ public:
               const size_t numDims,
               const spatialdata::geocoords::CoordSys* pCSQuery);
 
+    using SpatialDB::multiquery; // Keep float version visible.
+
+    /** Perform multiple queries of the database.
+     *
+     * Coordinates of all locations are converted together and the
+     * searches along each axis are done for all locations before
+     * interpolating, avoiding the per-location overhead of query().
+     *
+     * @pre Must call open() before multiquery().
+     *
+     * @param vals Array for computed values (output from query), must be
+     *   allocated BEFORE calling multiquery() [numLocs*numVals].
+     * @param numLocsV Number of locations.
+     * @param numValsV Number of values expected.
+     * @param err Array for error flag values (output from query), must be
+     *   allocated BEFORE calling multiquery() [numLocs].
+     * @param numLocsE Number of locations.
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numLocsC Number of locations.
+     * @param numDimsC Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     */
+    void multiquery(double* vals,
+                    const size_t numLocsV,
+                    const size_t numValsV,
+                    int* err,
+                    const size_t numLocsE,
+                    const double* coords,
+                    const size_t numLocsC,
+                    const size_t numDimsC,
+                    const spatialdata::geocoords::CoordSys* csQuery);
+
+    /** Check whether database supports query contexts.
+     *
+     * @returns True if database supports query contexts, false otherwise.
+     */
+    bool supportsQueryContexts(void) const;
+
+    /** Create context for querying the database.
+     *
+     * @pre Must call open() before createQueryContext().
+     *
+     * @returns Query context (caller is responsible for deleting it).
+     */
+    QueryContext* createQueryContext(void) const;
+
     /** Allocate room for data.
      *
      * @param numX Number of locations along x-axis.
@@ -174,12 +247,108 @@ public:
      */
     void setCoordSys(const geocoords::CoordSys& cs);
 
+    /** Check whether coordinates along axis are uniformly spaced.
+     *
+     * Searches along axes with uniform spacing use direct index
+     * arithmetic rather than bisection.
+     *
+     * @param iAxis Index of axis (0=x, 1=y, 2=z).
+     * @returns True if coordinates along axis are uniformly spaced.
+     */
+    bool isUniformAxis(const size_t iAxis) const;
+
     // PRIVATE METHODS //////////////////////////////////////////////////////
 private:
 
     /// Check compatibility of spatial database parameters.
     void _checkCompatibility(void) const;
 
+    /// Deallocate data values, unmapping them if they are memory-mapped.
+    void _deallocateData(void);
+
+    /// Reorder data values into blocks of points.
+    void _setupBlockedLayout(void);
+
+    /** Query the database using scratch storage in query context.
+     *
+     * @param context Query context created by createQueryContext().
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate)
+     */
+    int _contextQuery(QueryContext* context,
+                      double* vals,
+                      const size_t numVals,
+                      const double* coords,
+                      const size_t numDims,
+                      const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Perform multiple queries of the database using scratch storage in query context.
+     *
+     * @param context Query context created by createQueryContext().
+     * @param vals Array for computed values (output from query) [numLocs*numVals].
+     * @param numLocs Number of locations.
+     * @param numVals Number of values expected.
+     * @param err Array for error flag values (output from query) [numLocs].
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     */
+    void _contextMultiquery(QueryContext* context,
+                            double* vals,
+                            const size_t numLocs,
+                            const size_t numVals,
+                            int* err,
+                            const double* coords,
+                            const size_t numDims,
+                            const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Query the database.
+     *
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     * @param converter Converter for query points.
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate)
+     */
+    int _query(double* vals,
+               const size_t numVals,
+               const double* coords,
+               const size_t numDims,
+               const spatialdata::geocoords::CoordSys* csQuery,
+               spatialdata::geocoords::Converter* converter) const;
+
+    /** Perform multiple queries of the database.
+     *
+     * Coordinates of all locations are converted together and the
+     * searches along each axis are done for all locations before
+     * interpolating.
+     *
+     * @param vals Array for computed values (output from query) [numLocs*numVals].
+     * @param numLocs Number of locations.
+     * @param numVals Number of values expected.
+     * @param err Array for error flag values (output from query) [numLocs].
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     * @param converter Converter for query points.
+     */
+    void _multiquery(double* vals,
+                     const size_t numLocs,
+                     const size_t numVals,
+                     int* err,
+                     const double* coords,
+                     const size_t numDims,
+                     const spatialdata::geocoords::CoordSys* csQuery,
+                     spatialdata::geocoords::Converter* converter) const;
+
     /** Bilinear search for coordinate.
      *
      * Returns index of target as a double.
@@ -192,53 +361,101 @@ private:
                    const double* vals,
                    const size_t nvals) const;
 
-    /** Interpolate in 1-D to get values at target location defined by
-     * indices.
+    /** Check arguments for query.
      *
-     * @param vals Array for computed values (output from query), must be
-     *   allocated BEFORE calling query().
-     * @param numVals Number of values expected (size of pVals array)
-     * @param indexX Index along x dimension.
-     * @param numX Number of coordinates along x dimension.
+     * @param numVals Number of values expected.
+     * @param numDims Number of dimensions for coordinates.
      */
-    void _interpolate1D(double* vals,
-                        const size_t numVals,
-                        const double indexX,
-                        const size_t numX) const;
+    void _checkQueryArgs(const size_t numVals,
+                         const size_t numDims) const;
 
-    /** Interpolate in 2-D to get values at target location defined by
-     * indices.
+    /** Adjust indices from searches along each axis to account for
+     * optimizations for lower dimension distribution.
      *
-     * @param vals Array for computed values (output from query), must be
-     *   allocated BEFORE calling query().
-     * @param numVals Number of values expected (size of pVals array)
-     * @param indexX Index along x dimension.
-     * @param numX Number of coordinates along x dimension.
-     * @param indexY Index along y dimension.
-     * @param numY Number of coordinates along y dimension.
+     * @param indices Indices along axes (input) and adjusted indices (output) [3].
+     * @param sizes Adjusted sizes of dimensions [3].
      */
-    void _interpolate2D(double* vals,
-                        const size_t numVals,
-                        const double indexX,
-                        const size_t numX,
-                        const double indexY,
-                        const size_t numY) const;
+    void _reindex(double indices[3],
+                  size_t sizes[3]) const;
 
-    /** Interpolate in 3-D to get values at target location defined by
-     * indices.
+    /** Check whether location defined by adjusted indices is inside grid.
      *
-     * @param vals Array for computed values (output from query), must be
-     *   allocated BEFORE calling query().
-     * @param numVals Number of values expected (size of pVals array)
-     * @param indexX Index along x dimension.
-     * @param indexY Index along y dimension.
-     * @param indexZ Index along z dimension.
+     * @param indices Adjusted indices of location [3].
+     * @param sizes Adjusted sizes of dimensions [3].
+     *
+     * @returns True if location is inside grid, false otherwise.
      */
-    void _interpolate3D(double* vals,
-                        const size_t numVals,
-                        const double indexX,
-                        const double indexY,
-                        const double indexZ) const;
+    bool _isInside(const double indices[3],
+                   const size_t sizes[3]) const;
+
+    /** Get values at target location defined by adjusted indices.
+     *
+     * @param vals Array for computed values (output from query).
+     * @param numVals Number of values expected (size of vals array)
+     * @param indices Adjusted indices of location [3].
+     * @param sizes Adjusted sizes of dimensions [3].
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate)
+     */
+    int _getValues(double* vals,
+                   const size_t numVals,
+                   double indices[3],
+                   const size_t sizes[3]) const;
+
+    /** Search for coordinate along axis.
+     *
+     * Uses direct index arithmetic if coordinates along axis are
+     * uniformly spaced, otherwise uses bisection.
+     *
+     * Returns index of target as a double.
+     *
+     * @param target Coordinates of target.
+     * @param iAxis Index of axis (0=x, 1=y, 2=z).
+     */
+    double _searchAxis(const double target,
+                       const size_t iAxis) const;
+
+    /** Get spacing of uniformly spaced coordinates.
+     *
+     * @param vals Array of ordered values.
+     * @param nvals Number of values.
+     *
+     * @returns Spacing of coordinates if uniform, 0 otherwise.
+     */
+    static
+    double _getUniformSpacing(const double* vals,
+                              const size_t nvals);
+
+    /** Get indices and weights of grid points for linear interpolation at location.
+     *
+     * Grid points are ordered with the offset along the last axis varying
+     * fastest; there are 2, 4, or 8 grid points for data dimension 1, 2, or 3.
+     *
+     * @param dataIndices Indices into data array of grid points [8].
+     * @param weights Weights of grid points [8].
+     * @param indices Adjusted indices of location [3].
+     * @param sizes Adjusted sizes of dimensions [3].
+     */
+    void _getLinearWeights(size_t dataIndices[8],
+                           double weights[8],
+                           const double indices[3],
+                           const size_t sizes[3]) const;
+
+    /** Interpolate values at locations using indices and weights of grid points.
+     *
+     * @param vals Array for computed values (output from query) [*numVals].
+     * @param numVals Number of values expected.
+     * @param locs Indices of locations in vals [numLocs].
+     * @param numLocs Number of locations.
+     * @param dataIndices Indices into data array of grid points [numLocs*2^dataDim].
+     * @param weights Weights of grid points [numLocs*2^dataDim].
+     */
+    void _interpolate(double* vals,
+                      const size_t numVals,
+                      const size_t* locs,
+                      const size_t numLocs,
+                      const size_t* dataIndices,
+                      const double* weights) const;
 
     /** Adjust indices to account for optimizations for lower dimension
      *  distribution.
@@ -271,6 +488,8 @@ private:
                     size_t* const size2) const;
 
     /** Get index into data array.
+     *
+     * Accounts for the layout of the data, which is either x varying fastest or blocks of points.
      *
      * @param index0 Adjusted index for coordinate 0.
      * @param size0 Adjusted size for coordinate 0.
@@ -302,11 +521,13 @@ private:
 private:
 
     double* _data; ///< Array of data values.
+    void* _dataMap; ///< Memory-mapped file containing data values (NULL if data is not memory-mapped).
+    size_t _dataMapSize; ///< Size of memory-mapped file.
     double* _x; ///< Array of x coordinates.
     double* _y; ///< Array of y coordinates.
     double* _z; ///< Array of z coordinates.
 
-    double _xyz[3];
+    double _spacing[3]; ///< Spacing of coordinates along each axis if uniform, 0 otherwise.
 
     size_t* _queryValues; ///< Indices of values to be returned in queries.
     size_t _querySize; ///< Number of values requested to be returned in queries.
@@ -327,6 +548,11 @@ private:
 
     QueryEnum _queryType; ///< Query type
 
+    bool _useBlockedLayout; ///< Flag for storing data in blocks of points at open().
+    size_t _numBlocks[2]; ///< Number of blocks along x and y axes (0 if data is not in blocks).
+
+    static const size_t BLOCKBITS = 3; ///< Blocks have 2^BLOCKBITS points along each axis.
+
     static const char* FILEHEADER;
 
     // NOT IMPLEMENTED //////////////////////////////////////////////////////
@@ -19,7 +19,6 @@
 #include "SimpleDBData.hh" // USES SimpleDBData
 
 #include "spatialdata/geocoords/CoordSys.hh" // USES CoordSys
-#include "spatialdata/units/Parser.hh" // USES Parser
 
 #include <sstream> // USES std::ostringstream
 #include <string> // USES std::string
@@ -80,25 +79,17 @@ void
 spatialdata::spatialdb::SimpleIO::convertToSI(SimpleDBData* const data) {
     assert(data);
 
-    spatialdata::units::Parser parser;
-
+    const size_t numLocs = data->getNumLocs();
     const size_t numValues = data->getNumValues();
-    std::vector<double> scales(numValues);
-    for (size_t iVal = 0; iVal < numValues; ++iVal) {
-        if (strcasecmp(data->getUnits(iVal), "none") != 0) {
-            scales[iVal] = parser.parse(data->getUnits(iVal));
-        } else {
-            scales[iVal] = 1.0;
-        }
-    } // for
+    if ((0 == numLocs) || (0 == numValues)) {
+        return;
+    } // if
 
-    const size_t numLocs = data->getNumLocs();
-    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
-        double* values = data->getData(iLoc);
-        for (size_t iVal = 0; iVal < numValues; ++iVal) {
-            values[iVal] *= scales[iVal];
-        }
+    std::vector<std::string> units(numValues);
+    for (size_t iVal = 0; iVal < numValues; ++iVal) {
+        units[iVal] = data->getUnits(iVal);
     } // for
+    SpatialDB::_convertToSI(data->getData(0), &units[0], numLocs, numValues);
 } // convertToSI
 
 
@@ -21,6 +21,7 @@
 #include "spatialdata/geocoords/CSPicklerAscii.hh" // USES CSPicklerAscii
 
 #include "spatialdata/utils/LineParser.hh" // USES LineParser
+#include "spatialdata/utils/NumberParser.hh" // USES NumberParser
 
 #include <fstream> // USES std::ofstream, std::ifstream
 #include <iomanip> // USES setw(), setiosflags(), resetiosflags()
@@ -240,31 +241,29 @@ spatialdata::spatialdb::SimpleIOAscii::_readV1(SimpleDBData* pData,
     delete[] cnames;cnames = NULL;
     delete[] cunits;cunits = NULL;
 
+    // Convert numbers in each line without stream extraction.
+    const int numLineValues = spaceDim + numValues;
+    double* lineValues = new double[numLineValues];
     int count = 0;
     for (int iLoc = 0; iLoc < numLocs; ++iLoc, ++count) {
-        buffer.str(parser.next());
-        buffer.clear();
+        const std::string& line = parser.next();
+        if (!utils::NumberParser::parse(lineValues, numLineValues, line)) {
+            delete[] lineValues;lineValues = NULL;
+            std::ostringstream msg;
+            msg << "Read data for " << count << " out of " << numLocs << " points.\n"
+                << "Error reading coordinates and data from buffer '" << line << "'.";
+            throw std::runtime_error(msg.str());
+        } // if
         double* coordinates = pData->getCoordinates(iLoc);
         for (int iDim = 0; iDim < spaceDim; ++iDim) {
-            if (!buffer.good()) {
-                std::ostringstream msg;
-                msg << "Read data for " << count << " out of " << numLocs << " points.\n"
-                    << "Error reading coordinates from buffer '" << buffer.str() << "'.";
-                throw std::runtime_error(msg.str());
-            } // if
-            buffer >> coordinates[iDim];
+            coordinates[iDim] = lineValues[iDim];
         } // for
         double* data = pData->getData(iLoc);
         for (int iVal = 0; iVal < numValues; ++iVal) {
-            if (!buffer.good()) {
-                std::ostringstream msg;
-                msg << "Read data for " << count << " out of " << numLocs << " points.\n"
-                    << "Error reading data from buffer '" << buffer.str() << "'.";
-                throw std::runtime_error(msg.str());
-            } // if
-            buffer >> data[iVal];
+            data[iVal] = lineValues[spaceDim+iVal];
         } // for
     } // for
+    delete[] lineValues;lineValues = NULL;
     if (!filein.good()) {
         std::ostringstream msg;
         msg << "I/O error while reading SimpleDB data. ";
@@ -0,0 +1,390 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "SimpleIOBinary.hh" // implementation of class methods
+
+#include "SimpleDBData.hh" // USES SimpleDBData
+#include "spatialdata/geocoords/CoordSys.hh" // USES CoordSys
+#include "spatialdata/geocoords/CSPicklerAscii.hh" // USES CSPicklerAscii
+#include "spatialdata/utils/BinaryIO.hh" // USES BinaryIO
+
+#include <fstream> // USES std::ofstream, std::ifstream
+#include <sstream> // USES std::ostringstream, std::istringstream
+#include <stdexcept> // USES std::runtime_error
+#include <vector> // USES std::vector
+#include <cstring> // USES memcpy(), strlen(), strncmp()
+#include <strings.h> // USES strcasecmp()
+#include <stdint.h> // USES uint64_t
+#include <assert.h> // USES assert()
+
+// ----------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        namespace _simpleiobinary {
+            /// Layout of fixed-size header (all fields are little-endian 64-bit integers after magic header).
+            class Header {
+public:
+
+                static const size_t magicSize; ///< Size of magic header (padded with NUL characters).
+                static const size_t size; ///< Size of fixed-size header.
+                static const uint64_t version; ///< Version of file format.
+
+                uint64_t numLocs; ///< Number of locations.
+                uint64_t numValues; ///< Number of values at each location.
+                uint64_t spaceDim; ///< Spatial dimension of locations.
+                uint64_t dataDim; ///< Spatial dimension of data distribution.
+                uint64_t textSize; ///< Size of text header.
+                uint64_t coordinatesOffset; ///< Offset of coordinates of locations (multiple of 8 bytes).
+                uint64_t dataOffset; ///< Offset of data values (multiple of 8 bytes).
+
+                /** Parse fixed-size header.
+                 *
+                 * @param buffer Buffer with fixed-size header [size].
+                 * @param magic Magic header.
+                 * @param fileSize Size of file.
+                 */
+                void parse(const char* buffer,
+                           const char* magic,
+                           const size_t fileSize) {
+                    typedef spatialdata::utils::BinaryIO BinaryIO;
+
+                    if (0 != strncmp(buffer, magic, strlen(magic))) {
+                        std::ostringstream msg;
+                        msg << "Magic header does not match expected header '" << magic << "'.";
+                        throw std::runtime_error(msg.str());
+                    } // if
+
+                    const char* field = buffer + magicSize;
+                    const uint64_t fileVersion = BinaryIO::readUInt64(field);field += 8;
+                    if (fileVersion != version) {
+                        std::ostringstream msg;
+                        msg << "Unsupported version (" << fileVersion << ") of SimpleDB binary format. Expected version "
+                            << version << ".";
+                        throw std::runtime_error(msg.str());
+                    } // if
+                    numLocs = BinaryIO::readUInt64(field);field += 8;
+                    numValues = BinaryIO::readUInt64(field);field += 8;
+                    spaceDim = BinaryIO::readUInt64(field);field += 8;
+                    dataDim = BinaryIO::readUInt64(field);field += 8;
+                    textSize = BinaryIO::readUInt64(field);field += 8;
+                    coordinatesOffset = BinaryIO::readUInt64(field);field += 8;
+                    dataOffset = BinaryIO::readUInt64(field);field += 8;
+
+                    // Check sizes against file size before computing offsets, so
+                    // corrupt headers cannot overflow the arithmetic.
+                    const uint64_t maxValues = fileSize / 8;
+                    if (( spaceDim < 1) || ( spaceDim > 3) || ( dataDim > 3) ||
+                        ( numLocs < 1) || ( numLocs > maxValues) ||
+                        ( numValues < 1) || ( numValues > maxValues) ||
+                        ( textSize > fileSize) || ( coordinatesOffset > fileSize) || ( dataOffset > fileSize) ||
+                        ( coordinatesOffset < size + textSize) ||
+                        ( coordinatesOffset % 8) || ( dataOffset % 8) ||
+                        ( numLocs > maxValues / spaceDim) ||
+                        ( coordinatesOffset + 8*numLocs*spaceDim > dataOffset)) {
+                        throw std::runtime_error("Inconsistent sizes in SimpleDB binary header.");
+                    } // if
+                    if (( numLocs > maxValues / numValues) ||
+                        ( dataOffset + 8*numLocs*numValues > fileSize)) {
+                        std::ostringstream msg;
+                        msg << "File is too small to contain " << numLocs << " locations with "
+                            << numValues << " values.";
+                        throw std::runtime_error(msg.str());
+                    } // if
+                }
+
+                /** Parse text header with names and units of values and coordinate system.
+                 *
+                 * @pre Must allocate data before parsing text header.
+                 *
+                 * @param buffer Text header.
+                 * @param data Database data.
+                 * @param cs Pointer to coordinate system.
+                 */
+                static
+                void parseText(const std::string& buffer,
+                               SimpleDBData* data,
+                               spatialdata::geocoords::CoordSys** cs) {
+                    assert(data);
+                    assert(cs);
+
+                    const size_t numValues = data->getNumValues();
+                    std::istringstream sin(buffer);
+                    const int maxIgnore = 256;
+                    std::string token;
+
+                    std::vector<std::string> names(numValues);
+                    sin >> token;
+                    if (0 != strcasecmp(token.c_str(), "value-names")) {
+                        std::ostringstream msg;
+                        msg << "Could not parse '" << token << "' into 'value-names'.";
+                        throw std::runtime_error(msg.str());
+                    } // if
+                    sin.ignore(maxIgnore, '=');
+                    for (size_t iVal = 0; iVal < numValues; ++iVal) {
+                        sin >> names[iVal];
+                    } // for
+
+                    std::vector<std::string> units(numValues);
+                    sin >> token;
+                    if (0 != strcasecmp(token.c_str(), "value-units")) {
+                        std::ostringstream msg;
+                        msg << "Could not parse '" << token << "' into 'value-units'.";
+                        throw std::runtime_error(msg.str());
+                    } // if
+                    sin.ignore(maxIgnore, '=');
+                    for (size_t iVal = 0; iVal < numValues; ++iVal) {
+                        sin >> units[iVal];
+                    } // for
+
+                    sin >> token;
+                    if (0 != strcasecmp(token.c_str(), "cs-data")) {
+                        std::ostringstream msg;
+                        msg << "Could not parse '" << token << "' into 'cs-data'.";
+                        throw std::runtime_error(msg.str());
+                    } // if
+                    spatialdata::geocoords::CSPicklerAscii::unpickle(sin, cs);
+
+                    if (sin.fail()) {
+                        throw std::runtime_error("I/O error while parsing SimpleDB settings.");
+                    } // if
+
+                    std::vector<const char*> cnames(numValues);
+                    std::vector<const char*> cunits(numValues);
+                    for (size_t iVal = 0; iVal < numValues; ++iVal) {
+                        cnames[iVal] = names[iVal].c_str();
+                        cunits[iVal] = units[iVal].c_str();
+                    } // for
+                    data->setNames(&cnames[0], numValues);
+                    data->setUnits(&cunits[0], numValues);
+                }
+
+            }; // Header
+            const size_t Header::magicSize = 24;
+            const size_t Header::size = 24 + 8*8;
+            const uint64_t Header::version = 1;
+        } // _simpleiobinary
+    } // spatialdb
+} // spatialdata
+
+// ----------------------------------------------------------------------
+const char* spatialdata::spatialdb::SimpleIOBinary::HEADER = "#SPATIAL.binary";
+
+// ----------------------------------------------------------------------
+// Default constructor.
+spatialdata::spatialdb::SimpleIOBinary::SimpleIOBinary(void) :
+    _useMemoryMap(true) {}
+
+
+// ----------------------------------------------------------------------
+// Read binary database file.
+void
+spatialdata::spatialdb::SimpleIOBinary::read(SimpleDBData* pData,
+                                             spatialdata::geocoords::CoordSys** ppCS) { // read
+    assert(pData);
+    assert(ppCS);
+
+    try {
+        if (_useMemoryMap && spatialdata::utils::BinaryIO::isNativeLittleEndian()) {
+            _readMapped(pData, ppCS);
+        } else {
+            _readStream(pData, ppCS);
+        } // if/else
+
+        // Check compatibility of dimension of data, spatial dimension and
+        // number of points
+        checkCompatibility(*pData, *ppCS);
+
+        // Convert to SI units
+        convertToSI(pData);
+    } catch (const std::exception& err) {
+        std::ostringstream msg;
+        msg << "Error occurred while reading spatial database file '"
+            << getFilename() << "'.\n"
+            << err.what();
+        throw std::runtime_error(msg.str());
+    } catch (...) {
+        std::ostringstream msg;
+        msg << "Unknown error occurred while reading spatial database file '"
+            << getFilename() << "'.";
+        throw std::runtime_error(msg.str());
+    } // try/catch
+} // read
+
+
+// ----------------------------------------------------------------------
+// Write binary database file.
+void
+spatialdata::spatialdb::SimpleIOBinary::write(const SimpleDBData& data,
+                                              const spatialdata::geocoords::CoordSys* pCS) { // write
+    assert(pCS);
+
+    typedef spatialdata::utils::BinaryIO BinaryIO;
+    typedef _simpleiobinary::Header Header;
+
+    try {
+        std::ofstream fileout(getFilename(), std::ios::out | std::ios::binary);
+        if (!fileout.is_open() || !fileout.good()) {
+            std::ostringstream msg;
+            msg << "Could not open spatial database file '" << getFilename()
+                << "' for writing.";
+            throw std::runtime_error(msg.str());
+        } // if
+
+        const size_t numLocs = data.getNumLocs();
+        const size_t numValues = data.getNumValues();
+        const size_t spaceDim = data.getSpaceDim();
+
+        std::ostringstream text;
+        text << "value-names =";
+        for (size_t iVal = 0; iVal < numValues; ++iVal) {
+            text << "  " << data.getName(iVal);
+        } // for
+        text << "\n";
+        text << "value-units =";
+        for (size_t iVal = 0; iVal < numValues; ++iVal) {
+            text << "  " << data.getUnits(iVal);
+        } // for
+        text << "\n";
+        text << "cs-data = ";
+        spatialdata::geocoords::CSPicklerAscii::pickle(text, pCS);
+        const std::string& textHeader = text.str();
+
+        Header header;
+        header.numLocs = numLocs;
+        header.numValues = numValues;
+        header.spaceDim = spaceDim;
+        header.dataDim = data.getDataDim();
+        header.textSize = textHeader.length();
+        header.coordinatesOffset = 8 * ((Header::size + header.textSize + 7) / 8);
+        header.dataOffset = 8 * ((header.coordinatesOffset + 8*numLocs*spaceDim + 7) / 8);
+
+        std::vector<char> magic(Header::magicSize, '\0');
+        memcpy(&magic[0], HEADER, strlen(HEADER));
+        fileout.write(&magic[0], Header::magicSize);
+        BinaryIO::writeUInt64(fileout, Header::version);
+        BinaryIO::writeUInt64(fileout, header.numLocs);
+        BinaryIO::writeUInt64(fileout, header.numValues);
+        BinaryIO::writeUInt64(fileout, header.spaceDim);
+        BinaryIO::writeUInt64(fileout, header.dataDim);
+        BinaryIO::writeUInt64(fileout, header.textSize);
+        BinaryIO::writeUInt64(fileout, header.coordinatesOffset);
+        BinaryIO::writeUInt64(fileout, header.dataOffset);
+        fileout.write(textHeader.c_str(), header.textSize);
+        BinaryIO::writePadding(fileout, Header::size + header.textSize);
+
+        BinaryIO::writeDoubles(fileout, data.getCoordinates(0), numLocs*spaceDim);
+        BinaryIO::writeDoubles(fileout, data.getData(0), numLocs*numValues);
+
+        if (!fileout.good()) {
+            throw std::runtime_error("I/O error while writing SimpleDB data.");
+        } // if
+        fileout.close();
+    } catch (const std::exception& err) {
+        std::ostringstream msg;
+        msg << "Error occurred while writing spatial database file '"
+            << getFilename() << "'.\n"
+            << err.what();
+        throw std::runtime_error(msg.str());
+    } catch (...) {
+        std::ostringstream msg;
+        msg << "Unknown error occurred while writing spatial database file '"
+            << getFilename() << "'.";
+        throw std::runtime_error(msg.str());
+    } // try/catch
+} // write
+
+
+// ----------------------------------------------------------------------
+// Read database by memory-mapping the file.
+void
+spatialdata::spatialdb::SimpleIOBinary::_readMapped(SimpleDBData* pData,
+                                                    spatialdata::geocoords::CoordSys** ppCS) {
+    assert(pData);
+    assert(ppCS);
+    assert(spatialdata::utils::BinaryIO::isNativeLittleEndian());
+
+    typedef spatialdata::utils::BinaryIO BinaryIO;
+    typedef _simpleiobinary::Header Header;
+
+    size_t fileSize = 0;
+    void* map = BinaryIO::map(getFilename(), &fileSize);
+    char* buffer = (char*) map;
+
+    Header header;
+    try {
+        if (fileSize < Header::size) {
+            throw std::runtime_error("File is too small to contain SimpleDB header.");
+        } // if
+        header.parse(buffer, HEADER, fileSize);
+    } catch (...) {
+        BinaryIO::unmap(map, fileSize);
+        throw;
+    } // try/catch
+
+    // Data takes ownership of the mapped file.
+    pData->allocateMapped(map, fileSize,
+                          (double*)(buffer + header.coordinatesOffset),
+                          (double*)(buffer + header.dataOffset),
+                          header.numLocs, header.numValues, header.spaceDim, header.dataDim);
+    Header::parseText(std::string(buffer + Header::size, header.textSize), pData, ppCS);
+} // _readMapped
+
+
+// ----------------------------------------------------------------------
+// Read database using an input stream.
+void
+spatialdata::spatialdb::SimpleIOBinary::_readStream(SimpleDBData* pData,
+                                                    spatialdata::geocoords::CoordSys** ppCS) {
+    assert(pData);
+    assert(ppCS);
+
+    typedef spatialdata::utils::BinaryIO BinaryIO;
+    typedef _simpleiobinary::Header Header;
+
+    std::ifstream filein(getFilename(), std::ios::in | std::ios::binary);
+    if (!filein.is_open() || !filein.good()) {
+        std::ostringstream msg;
+        msg << "Could not open spatial database file '" << getFilename()
+            << "' for reading.";
+        throw std::runtime_error(msg.str());
+    } // if
+    filein.seekg(0, std::ios::end);
+    const size_t fileSize = filein.tellg();
+    filein.seekg(0, std::ios::beg);
+    if (fileSize < Header::size) {
+        throw std::runtime_error("File is too small to contain SimpleDB header.");
+    } // if
+
+    std::vector<char> buffer(Header::size);
+    filein.read(&buffer[0], Header::size);
+    Header header;
+    header.parse(&buffer[0], HEADER, fileSize);
+
+    std::string text(header.textSize, '\0');
+    if (header.textSize > 0) {
+        filein.read(&text[0], header.textSize);
+    } // if
+
+    pData->allocate(header.numLocs, header.numValues, header.spaceDim, header.dataDim);
+    Header::parseText(text, pData, ppCS);
+
+    filein.seekg(header.coordinatesOffset, std::ios::beg);
+    BinaryIO::readDoubles(pData->getCoordinates(0), filein, header.numLocs*header.spaceDim);
+    filein.seekg(header.dataOffset, std::ios::beg);
+    BinaryIO::readDoubles(pData->getData(0), filein, header.numLocs*header.numValues);
+    if (!filein.good()) {
+        throw std::runtime_error("I/O error while reading SimpleDB data.");
+    } // if
+} // _readStream
+
+
+// End of file
@@ -0,0 +1,108 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+#pragma once
+
+#include "SimpleIO.hh" // ISA SimpleIO
+
+#include <iosfwd> // USES std::ostream
+
+/** Reader/writer for SimpleDB files in binary format.
+ *
+ * The file contains a fixed-size header with the magic string and the
+ * sizes of the arrays, a text header with the names and units of the
+ * values and the coordinate system, the coordinates of the locations,
+ * and the data values. All numbers are stored as little-endian 64-bit
+ * integers or doubles, and the arrays are stored in the order used by
+ * SimpleDBData so that they can be memory-mapped without any conversion.
+ */
+class spatialdata::spatialdb::SimpleIOBinary : public SimpleIO { // SimpleIOBinary
+public:
+
+    // PUBLIC METHODS /////////////////////////////////////////////////////
+
+    /// Default constructor.
+    SimpleIOBinary(void);
+
+    // Using default destructor.
+
+    // Using default copy constructor
+
+    /** Clone object.
+     *
+     * @returns Pointer copy of this.
+     */
+    SimpleIO* clone(void) const;
+
+    /** Set flag for memory-mapping the coordinates and data values.
+     *
+     * Memory-mapped values are loaded on demand and are shared among
+     * processes reading the same file. Values are always read, rather
+     * than memory-mapped, on big-endian platforms.
+     *
+     * @param value True if coordinates and data values should be memory-mapped.
+     */
+    void setUseMemoryMap(const bool value);
+
+    /** Get flag for memory-mapping the coordinates and data values.
+     *
+     * @returns True if coordinates and data values are memory-mapped.
+     */
+    bool getUseMemoryMap(void) const;
+
+    /** Read the database.
+     *
+     * @param pData Database data
+     * @param ppCS Pointer to coordinate system
+     */
+    void read(SimpleDBData* pData,
+              spatialdata::geocoords::CoordSys** ppCS);
+
+    /** Write the database.
+     *
+     * @param data Database data
+     * @param pCS Pointer to coordinate system
+     */
+    void write(const SimpleDBData& data,
+               const spatialdata::geocoords::CoordSys* pCS);
+
+private:
+
+    // PRIVATE METHODS ////////////////////////////////////////////////////
+
+    /** Read database by memory-mapping the file.
+     *
+     * @param pData Database data
+     * @param ppCS Pointer to coordinate system
+     */
+    void _readMapped(SimpleDBData* pData,
+                     spatialdata::geocoords::CoordSys** ppCS);
+
+    /** Read database using an input stream.
+     *
+     * @param pData Database data
+     * @param ppCS Pointer to coordinate system
+     */
+    void _readStream(SimpleDBData* pData,
+                     spatialdata::geocoords::CoordSys** ppCS);
+
+private:
+
+    // PRIVATE MEMBERS ////////////////////////////////////////////////////
+
+    bool _useMemoryMap; ///< Flag for memory-mapping coordinates and data values.
+
+    /** Magic header in binary files */
+    static const char* HEADER;
+
+}; // class SimpleIOBinary
+
+#include "SimpleIOBinary.icc" // inline methods
+
+// End of file
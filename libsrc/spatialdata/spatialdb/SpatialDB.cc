@@ -12,8 +12,19 @@
 
 #include "SpatialDB.hh" // Implementation of class methods
 
+#include "QueryContext.hh" // USES QueryContext
+
 #include <cassert> // USES assert()
 #include <vector> // USES std::vector
+#include <sstream> // USES std::ostringstream
+#include <stdexcept> // USES std::logic_error
+#include <exception> // USES std::exception_ptr
+#include <algorithm> // USES std::min()
+#include <strings.h> // USES strcasecmp()
+
+#if defined(_OPENMP)
+#include <omp.h> // USES omp_get_max_threads(), omp_get_thread_num()
+#endif
 
 // Include ios here to avoid some Python/gcc issues
 #include <ios>
@@ -23,13 +34,15 @@
 // ----------------------------------------------------------------------
 /// Default constructor
 spatialdata::spatialdb::SpatialDB::SpatialDB(void) :
-    _description("") {}
+    _description(""),
+    _numThreads(1) {}
 
 
 // ----------------------------------------------------------------------
 /// Constructor with label
 spatialdata::spatialdb::SpatialDB::SpatialDB(const char* label) :
-    _description(label) {}
+    _description(label),
+    _numThreads(1) {}
 
 
 // ----------------------------------------------------------------------
@@ -37,6 +50,14 @@ spatialdata::spatialdb::SpatialDB::SpatialDB(const char* label) :
 spatialdata::spatialdb::SpatialDB::~SpatialDB(void) {}
 
 
+// ----------------------------------------------------------------------
+// Get coordinate system of database.
+const spatialdata::geocoords::CoordSys*
+spatialdata::spatialdb::SpatialDB::getCoordSys(void) const {
+    return NULL;
+} // getCoordSys
+
+
 // ----------------------------------------------------------------------
 // Query the database.
 int
@@ -77,14 +98,11 @@ spatialdata::spatialdb::SpatialDB::multiquery(double* vals,
                                               const size_t numLocsC,
                                               const size_t numDimsC,
                                               const spatialdata::geocoords::CoordSys* csQuery) {
-    assert(numLocsV == numLocsE);
-    assert(numLocsC == numLocsE);
-    assert( (!vals && 0 == numLocsV && 0 == numValsV) ||
-            (vals && numLocsV > 0 && numValsV > 0) );
-    assert( (!err && 0 == numLocsE) ||
-            (err && numLocsE > 0) );
-    assert( (!coords && 0 == numLocsC && 0 == numDimsC) ||
-            (coords && numLocsC > 0 && numDimsC > 0) );
+    assert(_isMultiqueryConsistent(vals, numLocsV, numValsV, err, numLocsE, coords, numLocsC, numDimsC));
+
+    if (_parallelMultiquery(vals, numLocsV, numValsV, err, coords, numDimsC, csQuery)) {
+        return;
+    } // if
 
     for (size_t i = 0, indexV = 0, indexC = 0;
          i < numLocsV;
@@ -106,14 +124,7 @@ spatialdata::spatialdb::SpatialDB::multiquery(float* vals,
                                               const size_t numLocsC,
                                               const size_t numDimsC,
                                               const spatialdata::geocoords::CoordSys* csQuery) {
-    assert(numLocsV == numLocsE);
-    assert(numLocsC == numLocsE);
-    assert( (!vals && 0 == numLocsV && 0 == numValsV) ||
-            (vals && numLocsV > 0 && numValsV > 0) );
-    assert( (!err && 0 == numLocsE) ||
-            (err && numLocsE > 0) );
-    assert( (!coords && 0 == numLocsC && 0 == numDimsC) ||
-            (coords && numLocsC > 0 && numDimsC > 0) );
+    assert(_isMultiqueryConsistent(vals, numLocsV, numValsV, err, numLocsE, coords, numLocsC, numDimsC));
 
     for (size_t i = 0, indexV = 0, indexC = 0;
          i < numLocsV;
@@ -123,6 +134,173 @@ spatialdata::spatialdb::SpatialDB::multiquery(float* vals,
 } // multiquery
 
 
+// ----------------------------------------------------------------------
+// Check whether database supports query contexts.
+bool
+spatialdata::spatialdb::SpatialDB::supportsQueryContexts(void) const {
+    return false;
+} // supportsQueryContexts
+
+
+// ----------------------------------------------------------------------
+// Create context for querying the database.
+spatialdata::spatialdb::QueryContext*
+spatialdata::spatialdb::SpatialDB::createQueryContext(void) const {
+    std::ostringstream msg;
+    msg << "Spatial database '" << getDescription() << "' does not support query contexts.";
+    throw std::logic_error(msg.str());
+} // createQueryContext
+
+
+// ----------------------------------------------------------------------
+// Query the database using scratch storage in query context.
+int
+spatialdata::spatialdb::SpatialDB::_contextQuery(QueryContext* /* context */,
+                                                 double* /* vals */,
+                                                 const size_t /* numVals */,
+                                                 const double* /* coords */,
+                                                 const size_t /* numDims */,
+                                                 const spatialdata::geocoords::CoordSys* /* csQuery */) const {
+    std::ostringstream msg;
+    msg << "Spatial database '" << getDescription() << "' does not support query contexts.";
+    throw std::logic_error(msg.str());
+} // _contextQuery
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database using scratch storage in query context.
+void
+spatialdata::spatialdb::SpatialDB::_contextMultiquery(QueryContext* context,
+                                                      double* vals,
+                                                      const size_t numLocs,
+                                                      const size_t numVals,
+                                                      int* err,
+                                                      const double* coords,
+                                                      const size_t numDims,
+                                                      const spatialdata::geocoords::CoordSys* csQuery) const {
+    for (size_t i = 0, indexV = 0, indexC = 0;
+         i < numLocs;
+         ++i, indexV += numVals, indexC += numDims) {
+        err[i] = _contextQuery(context, &vals[indexV], numVals, &coords[indexC], numDims, csQuery);
+    } // for
+} // _contextMultiquery
+
+
+// ----------------------------------------------------------------------
+// Perform multiple queries of the database in parallel.
+bool
+spatialdata::spatialdb::SpatialDB::_parallelMultiquery(double* vals,
+                                                       const size_t numLocs,
+                                                       const size_t numVals,
+                                                       int* err,
+                                                       const double* coords,
+                                                       const size_t numDims,
+                                                       const spatialdata::geocoords::CoordSys* csQuery) const {
+#if defined(_OPENMP)
+    const size_t maxThreads = (_numThreads > 0) ? _numThreads : size_t(omp_get_max_threads());
+    const size_t numThreads = std::min(maxThreads, numLocs);
+    if ((numThreads < 2) || !supportsQueryContexts()) {
+        return false;
+    } // if
+
+    // Create contexts before parallel region.
+    std::vector<QueryContext*> contexts(numThreads, NULL);
+    try {
+        for (size_t iThread = 0; iThread < numThreads; ++iThread) {
+            contexts[iThread] = createQueryContext();
+        } // for
+    } catch (...) {
+        for (size_t iThread = 0; iThread < numThreads; ++iThread) {
+            delete contexts[iThread];contexts[iThread] = NULL;
+        } // for
+        throw;
+    } // try/catch
+
+    // Use several blocks per thread for load balancing; results do not depend on assignment of blocks.
+    const size_t blockSize = std::max(size_t(1), std::min(size_t(4096), numLocs / (4*numThreads)));
+    const size_t numBlocks = (numLocs + blockSize - 1) / blockSize;
+    std::vector<std::exception_ptr> errors(numBlocks);
+    int failed = 0;
+
+    #pragma omp parallel for num_threads(numThreads) schedule(dynamic)
+    for (long iBlock = 0; iBlock < long(numBlocks); ++iBlock) {
+        // Skip remaining blocks after a query fails.
+        int skip = 0;
+        #pragma omp atomic read
+        skip = failed;
+        if (skip) {
+            continue;
+        } // if
+
+        const size_t iStart = iBlock * blockSize;
+        const size_t blockLocs = std::min(blockSize, numLocs - iStart);
+        try {
+            _contextMultiquery(contexts[omp_get_thread_num()], &vals[iStart*numVals], blockLocs, numVals,
+                               &err[iStart], &coords[iStart*numDims], numDims, csQuery);
+        } catch (...) {
+            errors[iBlock] = std::current_exception();
+            #pragma omp atomic write
+            failed = 1;
+        } // try/catch
+    } // for
+
+    for (size_t iThread = 0; iThread < numThreads; ++iThread) {
+        delete contexts[iThread];contexts[iThread] = NULL;
+    } // for
+
+    // Report first error, as in serial queries.
+    for (size_t iBlock = 0; iBlock < numBlocks; ++iBlock) {
+        if (errors[iBlock]) {
+            std::rethrow_exception(errors[iBlock]);
+        } // if
+    } // for
+
+    return true;
+#else
+    return false;
+#endif
+} // _parallelMultiquery
+
+
+// ----------------------------------------------------------------------
+// Check consistency of array sizes in arguments for multiple queries.
+bool
+spatialdata::spatialdb::SpatialDB::_isMultiqueryConsistent(const void* vals,
+                                                           const size_t numLocsV,
+                                                           const size_t numValsV,
+                                                           const int* err,
+                                                           const size_t numLocsE,
+                                                           const void* coords,
+                                                           const size_t numLocsC,
+                                                           const size_t numDimsC) {
+    return (numLocsV == numLocsE) && (numLocsC == numLocsE) &&
+           ( (!vals && 0 == numLocsV && 0 == numValsV) || (vals && numLocsV > 0 && numValsV > 0) ) &&
+           ( (!err && 0 == numLocsE) || (err && numLocsE > 0) ) &&
+           ( (!coords && 0 == numLocsC && 0 == numDimsC) || (coords && numLocsC > 0 && numDimsC > 0) );
+} // _isMultiqueryConsistent
+
+
+// ----------------------------------------------------------------------
+// Check number of values to be returned by query.
+void
+spatialdata::spatialdb::SpatialDB::_checkQuerySize(const size_t numVals,
+                                                   const size_t querySize) const {
+    if (0 == querySize) {
+        std::ostringstream msg;
+        msg << "Values to be returned by spatial database " << getDescription() << "\n"
+            << "have not been set. Please call setQueryValues() before query().\n";
+        throw std::logic_error(msg.str());
+    } else if (numVals != querySize) {
+        std::ostringstream msg;
+        msg << "Number of values to be returned by spatial database "
+            << getDescription() << "\n"
+            << "(" << querySize << ") does not match size of array provided ("
+            << numVals << ").\n";
+        throw std::invalid_argument(msg.str());
+    } // if
+} // _checkQuerySize
+
+
 #include <iostream>
 // ----------------------------------------------------------------------
 // Convert values to SI units.
@@ -136,16 +314,25 @@ spatialdata::spatialdb::SpatialDB::_convertToSI(double* vals,
 
     spatialdata::units::Parser parser;
 
-    const std::string& none = "none";
     std::vector<double> scales(numVals);
     for (size_t iVal = 0; iVal < numVals; ++iVal) {
-        if (none != units[iVal]) {
+        if (strcasecmp(units[iVal].c_str(), "none") != 0) {
             scales[iVal] = parser.parse(units[iVal].c_str());
         } else {
             scales[iVal] = 1.0;
         } // if/else
     } // for
 
+    // Skip values already in SI units, so that values in memory-mapped
+    // files are not touched.
+    bool isSI = true;
+    for (size_t iVal = 0; iVal < numVals; ++iVal) {
+        isSI = isSI && (1.0 == scales[iVal]);
+    } // for
+    if (isSI) {
+        return;
+    } // if
+
     for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
         for (size_t iVal = 0; iVal < numVals; ++iVal) {
             vals[iLoc*numVals+iVal] *= scales[iVal];
@@ -16,6 +16,9 @@
 
 /// C++ manager for spatial database.
 class spatialdata::spatialdb::SpatialDB {
+    friend class QueryContext; // Queries using context
+    friend class SimpleIO; // Converts values to SI units
+
 public:
 
     // PUBLIC METHODS /////////////////////////////////////////////////////
@@ -44,6 +47,23 @@ public:
      */
     const char* getDescription(void) const;
 
+    /** Set number of threads used in multiquery().
+     *
+     * Locations are divided among threads with each thread using its own
+     * query context, so the database must support query contexts (see
+     * supportsQueryContexts()); other databases are queried serially. The
+     * number of threads is ignored if spatialdata was not built with OpenMP.
+     *
+     * @param value Number of threads (0 for OpenMP default, 1 for serial queries).
+     */
+    void setNumThreads(const size_t value);
+
+    /** Get number of threads used in multiquery().
+     *
+     * @returns Number of threads (0 for OpenMP default, 1 for serial queries).
+     */
+    size_t getNumThreads(void) const;
+
     /// Open the database and prepare for querying.
     virtual
     void open(void) = 0;
@@ -61,6 +81,21 @@ public:
     void getNamesDBValues(const char*** valueNames,
                           size_t* numValues) const = 0;
 
+    /** Get coordinate system of database.
+     *
+     * Queries with the query point already in this coordinate system return
+     * the same values as queries with the query point in any other coordinate
+     * system, so callers querying several databases can convert query points
+     * once for each distinct coordinate system.
+     *
+     * @pre Must call open() before getCoordSys().
+     *
+     * @returns Coordinate system or NULL if the database uses the query point as
+     *   given (for example, values do not depend on location).
+     */
+    virtual
+    const spatialdata::geocoords::CoordSys* getCoordSys(void) const;
+
     /** Set values to be returned by queries.
      *
      * @pre Must call open() before setQueryValues()
@@ -135,7 +170,15 @@ public:
      * @param numLocsC Number of locations.
      * @param numDimsC Number of dimensions for coordinates.
      * @param csQuery Coordinate system of coordinates.
+     *
+     * @note Queries are done in parallel if the number of threads is not 1.
+     * If no query throws an exception, the values and error flags are
+     * identical to those from serial queries. If a query throws an exception,
+     * the exception for the lowest location is rethrown, but locations after it
+     * may already have been queried, so the values and error flags of other
+     * locations may differ from those of serial queries.
      */
+    virtual
     void multiquery(double* vals,
                     const size_t numLocsV,
                     const size_t numValsV,
@@ -177,9 +220,134 @@ public:
                     const size_t numDimsC,
                     const spatialdata::geocoords::CoordSys* csQuery);
 
+    /** Check whether database supports query contexts.
+     *
+     * @returns True if createQueryContext() is implemented, false otherwise.
+     */
+    virtual
+    bool supportsQueryContexts(void) const;
+
+    /** Create context for querying the database.
+     *
+     * The context holds all scratch storage used in queries, so queries
+     * using different contexts may be done concurrently.
+     *
+     * @pre Must call open() and setQueryValues() before createQueryContext().
+     *
+     * @returns Query context (caller is responsible for deleting it).
+     */
+    virtual
+    QueryContext* createQueryContext(void) const;
+
     // PROTECTED METHODS //////////////////////////////////////////////////
 protected:
 
+    /** Query the database using scratch storage in query context.
+     *
+     * @param context Query context created by createQueryContext().
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate)
+     */
+    virtual
+    int _contextQuery(QueryContext* context,
+                      double* vals,
+                      const size_t numVals,
+                      const double* coords,
+                      const size_t numDims,
+                      const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Perform multiple queries of the database using scratch storage in query context.
+     *
+     * Default implementation calls _contextQuery() for each location.
+     *
+     * @param context Query context created by createQueryContext().
+     * @param vals Array for computed values (output from query) [numLocs*numVals].
+     * @param numLocs Number of locations.
+     * @param numVals Number of values expected.
+     * @param err Array for error flag values (output from query) [numLocs].
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     */
+    virtual
+    void _contextMultiquery(QueryContext* context,
+                            double* vals,
+                            const size_t numLocs,
+                            const size_t numVals,
+                            int* err,
+                            const double* coords,
+                            const size_t numDims,
+                            const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Perform multiple queries of the database in parallel using one query context per thread.
+     *
+     * Each thread queries contiguous blocks of locations using
+     * _contextMultiquery(). If a query throws an exception, no further blocks
+     * are started and the exception from the block with the lowest locations
+     * is rethrown after all threads finish. Blocks after the failing block that
+     * were already started are completed.
+     *
+     * @param vals Array for computed values (output from query) [numLocs*numVals].
+     * @param numLocs Number of locations.
+     * @param numVals Number of values expected.
+     * @param err Array for error flag values (output from query) [numLocs].
+     * @param coords Coordinates of point for query [numLocs*numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     *
+     * @returns True if queries were done in parallel, false if caller must do
+     *   queries serially (single thread, built without OpenMP, or database does
+     *   not support query contexts).
+     */
+    bool _parallelMultiquery(double* vals,
+                             const size_t numLocs,
+                             const size_t numVals,
+                             int* err,
+                             const double* coords,
+                             const size_t numDims,
+                             const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Check consistency of array sizes in arguments for multiple queries.
+     *
+     * Intended for use in assert().
+     *
+     * @param vals Array for computed values.
+     * @param numLocsV Number of locations in array for values.
+     * @param numValsV Number of values per location in array for values.
+     * @param err Array for error flag values.
+     * @param numLocsE Number of locations in array for error flags.
+     * @param coords Array of coordinates.
+     * @param numLocsC Number of locations in array of coordinates.
+     * @param numDimsC Number of dimensions for coordinates.
+     *
+     * @returns True if sizes of arrays are consistent, false otherwise.
+     */
+    static
+    bool _isMultiqueryConsistent(const void* vals,
+                                 const size_t numLocsV,
+                                 const size_t numValsV,
+                                 const int* err,
+                                 const size_t numLocsE,
+                                 const void* coords,
+                                 const size_t numLocsC,
+                                 const size_t numDimsC);
+
+    /** Check number of values to be returned by query.
+     *
+     * @param numVals Number of values expected.
+     * @param querySize Number of values returned by query.
+     *
+     * @throws std::logic_error if values to be returned have not been set.
+     * @throws std::invalid_argument if number of values does not match.
+     */
+    void _checkQuerySize(const size_t numVals,
+                         const size_t querySize) const;
+
     /** Convert values to SI units.
      *
      * @param data Array of data.
@@ -204,6 +372,7 @@ private:
     // PRIVATE MEMBERS ////////////////////////////////////////////////////
 
     std::string _description; ///< Description of spatial database.
+    size_t _numThreads; ///< Number of threads used in multiquery().
 
 }; // class SpatialDB
 
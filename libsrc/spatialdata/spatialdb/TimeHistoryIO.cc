@@ -24,6 +24,8 @@
 #include <cassert> // USES assert()
 #include <stdexcept> // USES std::runtime_error
 #include <sstream> // USES std::ostringstream
+#include <cstring> // USES strlen()
+#include <strings.h> // USES strcasecmp()
 
 // ----------------------------------------------------------------------
 const char* spatialdata::spatialdb::TimeHistoryIO::HEADER =
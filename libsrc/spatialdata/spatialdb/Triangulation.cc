@@ -0,0 +1,1115 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "Triangulation.hh" // implementation of class methods
+
+#include <algorithm> // USES std::sort(), std::swap(), std::min(), std::max()
+#include <utility> // USES std::pair
+#include <cmath> // USES sqrt(), fabs()
+#include <stdexcept> // USES std::invalid_argument, std::runtime_error
+#include <sstream> // USES std::ostringstream
+#include <cassert> // USES assert()
+
+namespace spatialdata {
+    namespace spatialdb {
+        namespace _triangulation {
+            static const int INFINITE_VERTEX = -1; ///< Vertex at infinity closing the convex hull.
+            static const int DEAD_CELL = -2; ///< Marker for cells on free list.
+            static const double ORIENTATION_TOLERANCE = 1.0e-12; ///< Relative tolerance for degenerate cells.
+            static const double DUPLICATE_TOLERANCE = 1.0e-12; ///< Tolerance for duplicate locations.
+
+            /** Compute orientation (signed volume times dim!) of simplex.
+             *
+             * @param pts Coordinates of vertices of simplex [dim+1].
+             * @param dim Spatial dimension.
+             * @returns Orientation (positive if vertices are in counterclockwise order).
+             */
+            inline
+            double orientation(const double* const pts[],
+                               const size_t dim) {
+                if (2 == dim) {
+                    const double abX = pts[1][0] - pts[0][0];
+                    const double abY = pts[1][1] - pts[0][1];
+                    const double acX = pts[2][0] - pts[0][0];
+                    const double acY = pts[2][1] - pts[0][1];
+                    return abX*acY - abY*acX;
+                } // if
+                assert(3 == dim);
+                const double abX = pts[1][0] - pts[0][0];
+                const double abY = pts[1][1] - pts[0][1];
+                const double abZ = pts[1][2] - pts[0][2];
+                const double acX = pts[2][0] - pts[0][0];
+                const double acY = pts[2][1] - pts[0][1];
+                const double acZ = pts[2][2] - pts[0][2];
+                const double adX = pts[3][0] - pts[0][0];
+                const double adY = pts[3][1] - pts[0][1];
+                const double adZ = pts[3][2] - pts[0][2];
+                return abX*(acY*adZ - acZ*adY) - abY*(acX*adZ - acZ*adX) + abZ*(acX*adY - acY*adX);
+            } // orientation
+
+            /** Compute product of distances from one vertex of simplex to the others.
+             *
+             * The product bounds the magnitude of the orientation, so it provides the scale
+             * for the tolerance used to detect degenerate simplices.
+             *
+             * @param pts Coordinates of vertices of simplex [dim+1].
+             * @param dim Spatial dimension.
+             * @param iRef Index of reference vertex.
+             * @returns Product of distances.
+             */
+            inline
+            double scale(const double* const pts[],
+                         const size_t dim,
+                         const size_t iRef) {
+                double value = 1.0;
+                for (size_t i = 0; i <= dim; ++i) {
+                    if (i != iRef) {
+                        double dist2 = 0.0;
+                        for (size_t iDim = 0; iDim < dim; ++iDim) {
+                            const double dx = pts[i][iDim] - pts[iRef][iDim];
+                            dist2 += dx*dx;
+                        } // for
+                        value *= sqrt(dist2);
+                    } // if
+                } // for
+                return value;
+            } // scale
+
+            /** Test whether point is inside circumsphere of positively oriented simplex.
+             *
+             * @param pts Coordinates of vertices of simplex [dim+1].
+             * @param p Coordinates of point.
+             * @param dim Spatial dimension.
+             * @returns Positive if point is inside, negative if outside, and zero if on circumsphere.
+             */
+            inline
+            double inSphere(const double* const pts[],
+                            const double* p,
+                            const size_t dim) {
+                if (2 == dim) {
+                    const double aX = pts[0][0] - p[0];
+                    const double aY = pts[0][1] - p[1];
+                    const double bX = pts[1][0] - p[0];
+                    const double bY = pts[1][1] - p[1];
+                    const double cX = pts[2][0] - p[0];
+                    const double cY = pts[2][1] - p[1];
+                    const double aL = aX*aX + aY*aY;
+                    const double bL = bX*bX + bY*bY;
+                    const double cL = cX*cX + cY*cY;
+                    return aX*(bY*cL - bL*cY) - aY*(bX*cL - bL*cX) + aL*(bX*cY - bY*cX);
+                } // if
+                assert(3 == dim);
+                double r[4][3];
+                double l[4];
+                for (size_t i = 0; i < 4; ++i) {
+                    r[i][0] = pts[i][0] - p[0];
+                    r[i][1] = pts[i][1] - p[1];
+                    r[i][2] = pts[i][2] - p[2];
+                    l[i] = r[i][0]*r[i][0] + r[i][1]*r[i][1] + r[i][2]*r[i][2];
+                } // for
+                // Expand lifted 4x4 determinant along lifted column; the sign is flipped relative to
+                // 2-D so that a positive value corresponds to a point inside the circumsphere.
+                double minor[4];
+                const double* a = r[0];
+                const double* b = r[1];
+                const double* c = r[2];
+                const double* d = r[3];
+                minor[0] = b[0]*(c[1]*d[2] - c[2]*d[1]) - b[1]*(c[0]*d[2] - c[2]*d[0]) + b[2]*(c[0]*d[1] - c[1]*d[0]);
+                minor[1] = a[0]*(c[1]*d[2] - c[2]*d[1]) - a[1]*(c[0]*d[2] - c[2]*d[0]) + a[2]*(c[0]*d[1] - c[1]*d[0]);
+                minor[2] = a[0]*(b[1]*d[2] - b[2]*d[1]) - a[1]*(b[0]*d[2] - b[2]*d[0]) + a[2]*(b[0]*d[1] - b[1]*d[0]);
+                minor[3] = a[0]*(b[1]*c[2] - b[2]*c[1]) - a[1]*(b[0]*c[2] - b[2]*c[0]) + a[2]*(b[0]*c[1] - b[1]*c[0]);
+                return l[0]*minor[0] - l[1]*minor[1] + l[2]*minor[2] - l[3]*minor[3];
+            } // inSphere
+
+            /// Face of a cell identified by its sorted vertices.
+            struct Face {
+                int vertices[3]; ///< Sorted indices of vertices (unused entries are zero).
+                size_t cell; ///< Index of cell.
+                size_t face; ///< Index of face in cell (index of opposite vertex).
+
+                bool operator<(const Face& other) const {
+                    return std::lexicographical_compare(vertices, vertices+3, other.vertices, other.vertices+3);
+                } // operator<
+
+                bool operator==(const Face& other) const {
+                    return std::equal(vertices, vertices+3, other.vertices);
+                } // operator==
+
+            }; // Face
+
+            /** Match faces shared by pairs of cells.
+             *
+             * @param pairs Indices into faces of matching pairs of faces.
+             * @param faces Faces to match (sorted on output).
+             * @returns True if every face is shared by exactly two cells, false otherwise.
+             */
+            inline
+            bool matchFaces(std::vector<std::pair<size_t, size_t> >* pairs,
+                            std::vector<Face>* faces) {
+                assert(pairs);
+                assert(faces);
+
+                std::sort(faces->begin(), faces->end());
+                pairs->clear();
+                const size_t numFaces = faces->size();
+                for (size_t i = 0; i < numFaces; i += 2) {
+                    if (( i+1 >= numFaces) || !((*faces)[i] == (*faces)[i+1]) ) {
+                        return false;
+                    } // if
+                    if (( i+2 < numFaces) && ( (*faces)[i] == (*faces)[i+2]) ) {
+                        return false;
+                    } // if
+                    pairs->push_back(std::make_pair(i, i+1));
+                } // for
+                return true;
+            } // matchFaces
+
+            // -------------------------------------------------------------------------------------
+            /** Incremental Bowyer-Watson construction of Delaunay triangulation.
+             *
+             * The convex hull is closed by cells containing a single vertex at infinity, so that
+             * every face is shared by two cells. A cell containing the vertex at infinity is
+             * positively oriented if replacing the vertex at infinity by a point outside the
+             * hull gives a positively oriented simplex.
+             */
+            class Builder {
+public:
+
+                /** Constructor.
+                 *
+                 * @param coords Coordinates of locations [numLocs*dim].
+                 * @param numLocs Number of locations.
+                 * @param dim Spatial dimension.
+                 */
+                Builder(const std::vector<double>& coords,
+                        const size_t numLocs,
+                        const size_t dim) :
+                    _coords(coords),
+                    _numLocs(numLocs),
+                    _dim(dim),
+                    _numCorners(dim+1),
+                    _tag(0) {}
+
+
+                /** Build triangulation.
+                 *
+                 * @param cells Indices of locations at vertices of cells.
+                 * @param neighbors Cell opposite each vertex of cells (-1 if none).
+                 * @returns Index of location that could not be inserted, or -1 if all locations
+                 *   were inserted.
+                 */
+                int build(std::vector<int>* cells,
+                          std::vector<int>* neighbors) {
+                    assert(cells);
+                    assert(neighbors);
+
+                    int simplex[4];
+                    _findInitialSimplex(simplex);
+                    _initialize(simplex);
+
+                    // Insert remaining locations in Morton order, so consecutive locations are nearby.
+                    std::vector<std::pair<unsigned long long, int> > order;
+                    order.reserve(_numLocs);
+                    for (size_t iLoc = 0; iLoc < _numLocs; ++iLoc) {
+                        if (std::find(simplex, simplex+_numCorners, int(iLoc)) == simplex+_numCorners) {
+                            order.push_back(std::make_pair(_mortonCode(iLoc), int(iLoc)));
+                        } // if
+                    } // for
+                    std::sort(order.begin(), order.end());
+
+                    int hint = 0;
+                    std::vector<int> failed;
+                    const size_t numOrder = order.size();
+                    for (size_t i = 0; i < numOrder; ++i) {
+                        if (!_insert(order[i].second, &hint)) {
+                            failed.push_back(order[i].second);
+                        } // if
+                    } // for
+
+                    // Insertion can fail when a location would create a degenerate cell in the
+                    // current triangulation; retry after the other locations have been inserted.
+                    const size_t numFailed = failed.size();
+                    for (size_t i = 0; i < numFailed; ++i) {
+                        if (!_insert(failed[i], &hint)) {
+                            return failed[i];
+                        } // if
+                    } // for
+
+                    // Extract finite cells.
+                    const size_t numCellsAll = _cells.size() / _numCorners;
+                    std::vector<int> newIndex(numCellsAll, -1);
+                    size_t numCells = 0;
+                    for (size_t iCell = 0; iCell < numCellsAll; ++iCell) {
+                        if (( _cells[iCell*_numCorners] != DEAD_CELL) && ( _infiniteIndex(iCell) < 0) ) {
+                            newIndex[iCell] = int(numCells++);
+                        } // if
+                    } // for
+                    cells->resize(numCells*_numCorners);
+                    neighbors->resize(numCells*_numCorners);
+                    for (size_t iCell = 0; iCell < numCellsAll; ++iCell) {
+                        if (newIndex[iCell] < 0) {
+                            continue;
+                        } // if
+                        const size_t offset = newIndex[iCell]*_numCorners;
+                        for (size_t i = 0; i < _numCorners; ++i) {
+                            (*cells)[offset+i] = _cells[iCell*_numCorners+i];
+                            (*neighbors)[offset+i] = newIndex[_neighbors[iCell*_numCorners+i]];
+                        } // for
+                    } // for
+
+                    return -1;
+                } // build
+
+
+private:
+
+                /// Get coordinates of location.
+                const double* _point(const int v) const {
+                    assert(v >= 0 && size_t(v) < _numLocs);
+                    return &_coords[v*_dim];
+                } // _point
+
+
+                /// Get index of vertex at infinity in cell (-1 if cell is finite).
+                int _infiniteIndex(const size_t cell) const {
+                    for (size_t i = 0; i < _numCorners; ++i) {
+                        if (INFINITE_VERTEX == _cells[cell*_numCorners+i]) {
+                            return int(i);
+                        } // if
+                    } // for
+                    return -1;
+                } // _infiniteIndex
+
+
+                /** Compute orientation of cell with one vertex replaced by a point.
+                 *
+                 * @param tolerance Tolerance for degenerate orientation.
+                 * @param cell Index of cell.
+                 * @param iVertex Index of vertex in cell to replace.
+                 * @param p Coordinates of point.
+                 * @param q Coordinates of point replacing vertex at infinity (NULL if none).
+                 * @returns Orientation.
+                 */
+                double _orientation(double* tolerance,
+                                    const size_t cell,
+                                    const size_t iVertex,
+                                    const double* p,
+                                    const double* q=NULL) const {
+                    const double* pts[4];
+                    for (size_t i = 0; i < _numCorners; ++i) {
+                        const int v = _cells[cell*_numCorners+i];
+                        pts[i] = (i == iVertex) ? p : (INFINITE_VERTEX == v) ? q : _point(v);
+                        assert(pts[i]);
+                    } // for
+                    if (tolerance) {
+                        size_t iRef = iVertex;
+                        if (q) {
+                            for (size_t i = 0; i < _numCorners; ++i) {
+                                if (pts[i] == q) {
+                                    iRef = i;
+                                } // if
+                            } // for
+                        } // if
+                        *tolerance = ORIENTATION_TOLERANCE * scale(pts, _dim, iRef);
+                    } // if
+                    return orientation(pts, _dim);
+                } // _orientation
+
+
+                /** Test whether point conflicts with cell (is inside its circumsphere).
+                 *
+                 * @param cell Index of cell.
+                 * @param p Coordinates of point.
+                 * @returns True if point conflicts with cell.
+                 */
+                bool _inConflict(const size_t cell,
+                                 const double* p) const {
+                    const int iInfinite = _infiniteIndex(cell);
+                    if (iInfinite < 0) {
+                        const double* pts[4];
+                        for (size_t i = 0; i < _numCorners; ++i) {
+                            pts[i] = _point(_cells[cell*_numCorners+i]);
+                        } // for
+                        return inSphere(pts, p, _dim) > 0.0;
+                    } // if
+
+                    // Cell at infinity conflicts if point is outside hull face. If point is on the
+                    // plane of the hull face, it conflicts if it is inside the circumsphere of the
+                    // face, which matches the finite cell on the other side of the face.
+                    double tolerance = 0.0;
+                    const double orient = _orientation(&tolerance, cell, iInfinite, p);
+                    if (orient > tolerance) {
+                        return true;
+                    } else if (orient < -tolerance) {
+                        return false;
+                    } // if/else
+                    return _inConflict(_neighbors[cell*_numCorners+iInfinite], p);
+                } // _inConflict
+
+
+                /** Test whether replacing vertex of cell on boundary of cavity by point gives a valid cell.
+                 *
+                 * @param cell Index of cell in cavity.
+                 * @param iVertex Index of vertex opposite boundary face.
+                 * @param p Coordinates of point.
+                 * @returns True if new cell is valid.
+                 */
+                bool _isValidBoundary(const size_t cell,
+                                      const size_t iVertex,
+                                      const double* p) const {
+                    double tolerance = 0.0;
+                    const int iInfinite = _infiniteIndex(cell);
+                    if (iInfinite < 0 || size_t(iInfinite) == iVertex) {
+                        // New finite cell must not be degenerate.
+                        return _orientation(&tolerance, cell, iVertex, p) > tolerance;
+                    } // if
+
+                    // New hull face must have vertex of neighboring hull cell on its inner side.
+                    const int neighbor = _neighbors[cell*_numCorners+iVertex];
+                    const double* w = NULL;
+                    for (size_t i = 0; i < _numCorners; ++i) {
+                        if (_neighbors[neighbor*_numCorners+i] == int(cell)) {
+                            w = _point(_cells[neighbor*_numCorners+i]);
+                        } // if
+                    } // for
+                    assert(w);
+                    return _orientation(&tolerance, cell, iVertex, p, w) < tolerance;
+                } // _isValidBoundary
+
+
+                /** Find cell in conflict with point by walking through cells.
+                 *
+                 * @param hint Index of cell at which to start walk.
+                 * @param p Coordinates of point.
+                 * @returns Index of cell containing point or -1 if not found.
+                 */
+                int _locate(const int hint,
+                            const double* p) const {
+                    const size_t numCells = _cells.size() / _numCorners;
+                    size_t cell = hint;
+                    unsigned long seed = 0;
+                    for (size_t iStep = 0; iStep < numCells; ++iStep) {
+                        // Pseudo-random order of faces prevents cycling.
+                        seed = (1103515245*seed + 12345) % 2147483648;
+                        const size_t offset = (seed >> 16) % _numCorners;
+
+                        const int iInfinite = _infiniteIndex(cell);
+                        if (iInfinite >= 0) {
+                            double tolerance = 0.0;
+                            const double orient = _orientation(&tolerance, cell, iInfinite, p);
+                            const int neighbor = _neighbors[cell*_numCorners+iInfinite];
+                            if (orient > tolerance) {
+                                return int(cell);
+                            } else if (orient < -tolerance) {
+                                cell = neighbor;
+                                continue;
+                            } else if (_inConflict(neighbor, p)) {
+                                return int(cell);
+                            } // if/else
+
+                            // Point is on plane of hull face but outside its circumsphere, so walk
+                            // along hull using vertex of finite neighbor as apex of hull cells.
+                            const double* apex = NULL;
+                            for (size_t i = 0; i < _numCorners; ++i) {
+                                if (_neighbors[neighbor*_numCorners+i] == int(cell)) {
+                                    apex = _point(_cells[neighbor*_numCorners+i]);
+                                } // if
+                            } // for
+                            assert(apex);
+                            bool isMoved = false;
+                            for (size_t i = 0; i < _numCorners && !isMoved; ++i) {
+                                const size_t iVertex = (i + offset) % _numCorners;
+                                if (( int(iVertex) != iInfinite) && ( _orientation(NULL, cell, iVertex, p, apex) > 0.0) ) {
+                                    cell = _neighbors[cell*_numCorners+iVertex];
+                                    isMoved = true;
+                                } // if
+                            } // for
+                            if (!isMoved) {
+                                cell = neighbor;
+                            } // if
+                            continue;
+                        } // if
+
+                        // Orientation of a face computed from neighboring cells may differ in sign
+                        // due to roundoff, so only cross faces with orientation below tolerance.
+                        bool isInside = true;
+                        for (size_t i = 0; i < _numCorners; ++i) {
+                            const size_t iVertex = (i + offset) % _numCorners;
+                            double tolerance = 0.0;
+                            if (_orientation(&tolerance, cell, iVertex, p) < -tolerance) {
+                                cell = _neighbors[cell*_numCorners+iVertex];
+                                isInside = false;
+                                break;
+                            } // if
+                        } // for
+                        if (isInside) {
+                            return int(cell);
+                        } // if
+                    } // for
+
+                    // Walk did not terminate, so fall back to checking every cell.
+                    for (size_t iCell = 0; iCell < numCells; ++iCell) {
+                        if (( _cells[iCell*_numCorners] != DEAD_CELL) && _inConflict(iCell, p) ) {
+                            return int(iCell);
+                        } // if
+                    } // for
+                    return -1;
+                } // _locate
+
+
+                /** Insert location into triangulation.
+                 *
+                 * Locations that duplicate existing vertices are skipped.
+                 *
+                 * @param v Index of location.
+                 * @param hint Index of cell at which to start search (input) and index of cell
+                 *   containing location (output).
+                 * @returns True if location was inserted or duplicates a vertex, false if it could
+                 *   not be located or inserted without creating degenerate cells.
+                 */
+                bool _insert(const int v,
+                             int* hint) {
+                    assert(hint);
+                    const double* p = _point(v);
+
+                    const int start = _locate(*hint, p);
+                    if (start < 0) {
+                        return false;
+                    } // if
+                    for (size_t i = 0; i < _numCorners; ++i) {
+                        const int vertex = _cells[start*_numCorners+i];
+                        if (vertex != INFINITE_VERTEX) {
+                            const double* pt = _point(vertex);
+                            double dist2 = 0.0;
+                            for (size_t iDim = 0; iDim < _dim; ++iDim) {
+                                dist2 += (pt[iDim] - p[iDim]) * (pt[iDim] - p[iDim]);
+                            } // for
+                            if (dist2 <= DUPLICATE_TOLERANCE*DUPLICATE_TOLERANCE) {
+                                return true;
+                            } // if
+                        } // if
+                    } // for
+
+                    // Find cavity of cells in conflict with point.
+                    _tag += 2;
+                    const size_t inCavity = _tag;
+                    const size_t outCavity = _tag+1;
+                    _cavity.clear();
+                    _cavity.push_back(start);
+                    _mark[start] = inCavity;
+                    for (size_t iCavity = 0; iCavity < _cavity.size(); ++iCavity) {
+                        const size_t cell = _cavity[iCavity];
+                        for (size_t i = 0; i < _numCorners; ++i) {
+                            const int neighbor = _neighbors[cell*_numCorners+i];
+                            if (( _mark[neighbor] == inCavity) || ( _mark[neighbor] == outCavity) ) {
+                                continue;
+                            } // if
+                            if (_inConflict(neighbor, p)) {
+                                _mark[neighbor] = inCavity;
+                                _cavity.push_back(neighbor);
+                            } else {
+                                _mark[neighbor] = outCavity;
+                            } // if/else
+                        } // for
+                    } // for
+
+                    // Roundoff errors can produce a cavity that is not star-shaped with respect
+                    // to the point, so grow or shrink it until every new cell is valid.
+                    const size_t maxIterations = 100;
+                    bool isValid = false;
+                    for (size_t iIter = 0; iIter < maxIterations && !isValid; ++iIter) {
+                        isValid = true;
+                        for (size_t iCavity = 0; iCavity < _cavity.size(); ++iCavity) {
+                            const size_t cell = _cavity[iCavity];
+                            for (size_t i = 0; i < _numCorners && _mark[cell] == inCavity; ++i) {
+                                const int neighbor = _neighbors[cell*_numCorners+i];
+                                if (( _mark[neighbor] == inCavity) || _isValidBoundary(cell, i, p) ) {
+                                    continue;
+                                } // if
+                                isValid = false;
+                                if (int(cell) == start) {
+                                    _mark[neighbor] = inCavity;
+                                    _cavity.push_back(neighbor);
+                                } else {
+                                    _mark[cell] = outCavity;
+                                } // if/else
+                            } // for
+                        } // for
+                        size_t numCavity = 0;
+                        for (size_t iCavity = 0; iCavity < _cavity.size(); ++iCavity) {
+                            if (_mark[_cavity[iCavity]] == inCavity) {
+                                _cavity[numCavity++] = _cavity[iCavity];
+                            } // if
+                        } // for
+                        _cavity.resize(numCavity);
+                    } // for
+                    if (!isValid) {
+                        return false;
+                    } // if
+
+                    // Create new cells from boundary faces of cavity.
+                    const size_t numCavity = _cavity.size();
+                    _newCells.clear();
+                    _newOuter.clear();
+                    for (size_t iCavity = 0; iCavity < numCavity; ++iCavity) {
+                        const size_t cell = _cavity[iCavity];
+                        for (size_t i = 0; i < _numCorners; ++i) {
+                            const int neighbor = _neighbors[cell*_numCorners+i];
+                            if (_mark[neighbor] == inCavity) {
+                                continue;
+                            } // if
+                            for (size_t j = 0; j < _numCorners; ++j) {
+                                _newCells.push_back((j == i) ? v : _cells[cell*_numCorners+j]);
+                            } // for
+                            size_t iNeighborFace = 0;
+                            while (_neighbors[neighbor*_numCorners+iNeighborFace] != int(cell)) {
+                                ++iNeighborFace;
+                                assert(iNeighborFace < _numCorners);
+                            } // while
+                            _newOuter.push_back(OuterFace(neighbor, i, iNeighborFace));
+                        } // for
+                    } // for
+                    const size_t numNew = _newOuter.size();
+
+                    // Vertices of cavity must all remain vertices of new cells.
+                    for (size_t iCavity = 0; iCavity < numCavity; ++iCavity) {
+                        for (size_t i = 0; i < _numCorners; ++i) {
+                            const int vertex = _cells[_cavity[iCavity]*_numCorners+i];
+                            if (vertex != INFINITE_VERTEX) {
+                                _vertexMark[vertex] = inCavity;
+                            } // if
+                        } // for
+                    } // for
+                    for (size_t iNew = 0; iNew < numNew; ++iNew) {
+                        for (size_t i = 0; i < _numCorners; ++i) {
+                            const int vertex = _newCells[iNew*_numCorners+i];
+                            if (vertex != INFINITE_VERTEX) {
+                                _vertexMark[vertex] = outCavity;
+                            } // if
+                        } // for
+                    } // for
+                    for (size_t iCavity = 0; iCavity < numCavity; ++iCavity) {
+                        for (size_t i = 0; i < _numCorners; ++i) {
+                            const int vertex = _cells[_cavity[iCavity]*_numCorners+i];
+                            if (( vertex != INFINITE_VERTEX) && ( _vertexMark[vertex] != outCavity) ) {
+                                return false;
+                            } // if
+                        } // for
+                    } // for
+
+                    // Match faces of new cells containing the point.
+                    _faces.clear();
+                    for (size_t iNew = 0; iNew < numNew; ++iNew) {
+                        for (size_t i = 0; i < _numCorners; ++i) {
+                            if (i != _newOuter[iNew].face) {
+                                _faces.push_back(_createFace(&_newCells[iNew*_numCorners], iNew, i));
+                            } // if
+                        } // for
+                    } // for
+                    if (!matchFaces(&_pairs, &_faces)) {
+                        return false;
+                    } // if
+
+                    // Commit new cells, reusing cells in cavity.
+                    _newIndex.resize(numNew);
+                    for (size_t iNew = 0; iNew < numNew; ++iNew) {
+                        _newIndex[iNew] = (iNew < numCavity) ? int(_cavity[iNew]) : _allocateCell();
+                    } // for
+                    for (size_t iCavity = numNew; iCavity < numCavity; ++iCavity) {
+                        _freeCell(_cavity[iCavity]);
+                    } // for
+                    for (size_t iNew = 0; iNew < numNew; ++iNew) {
+                        const size_t cell = _newIndex[iNew];
+                        const OuterFace& outer = _newOuter[iNew];
+                        for (size_t i = 0; i < _numCorners; ++i) {
+                            _cells[cell*_numCorners+i] = _newCells[iNew*_numCorners+i];
+                        } // for
+                        _neighbors[cell*_numCorners+outer.face] = outer.neighbor;
+                        _neighbors[outer.neighbor*_numCorners+outer.neighborFace] = int(cell);
+                    } // for
+                    const size_t numPairs = _pairs.size();
+                    for (size_t iPair = 0; iPair < numPairs; ++iPair) {
+                        const Face& faceA = _faces[_pairs[iPair].first];
+                        const Face& faceB = _faces[_pairs[iPair].second];
+                        const int cellA = _newIndex[faceA.cell];
+                        const int cellB = _newIndex[faceB.cell];
+                        _neighbors[cellA*_numCorners+faceA.face] = cellB;
+                        _neighbors[cellB*_numCorners+faceB.face] = cellA;
+                    } // for
+
+                    *hint = _newIndex[0];
+                    for (size_t iNew = 0; iNew < numNew; ++iNew) {
+                        if (_infiniteIndex(_newIndex[iNew]) < 0) {
+                            *hint = _newIndex[iNew];
+                            break;
+                        } // if
+                    } // for
+
+                    return true;
+                } // _insert
+
+
+                /** Find well-shaped initial simplex.
+                 *
+                 * @param simplex Indices of locations at vertices of simplex [dim+1].
+                 */
+                void _findInitialSimplex(int simplex[]) const {
+                    assert(simplex);
+
+                    bool isDegenerate = _numLocs < _numCorners;
+                    if (!isDegenerate) {
+                        // Start from first location, then add location farthest from vertices found so far.
+                        simplex[0] = 0;
+                        double maxValue = 0.0;
+                        for (size_t iVertex = 1; iVertex < _numCorners; ++iVertex) {
+                            maxValue = 0.0;
+                            simplex[iVertex] = 0;
+                            for (size_t iLoc = 0; iLoc < _numLocs; ++iLoc) {
+                                const double value = _measure(simplex, iVertex, _point(iLoc));
+                                if (value > maxValue) {
+                                    maxValue = value;
+                                    simplex[iVertex] = int(iLoc);
+                                } // if
+                            } // for
+                        } // for
+                        const double* pts[4];
+                        for (size_t i = 0; i < _numCorners; ++i) {
+                            pts[i] = _point(simplex[i]);
+                        } // for
+                        isDegenerate = maxValue <= ORIENTATION_TOLERANCE * scale(pts, _dim, 0);
+                    } // if
+                    if (isDegenerate) {
+                        std::ostringstream msg;
+                        msg << "Could not build triangulation of " << _numLocs << " locations in " << _dim << "-D space. "
+                            << "Locations must not all lie on a " << (_dim == 2 ? "line." : "plane.");
+                        throw std::runtime_error(msg.str());
+                    } // if
+                } // _findInitialSimplex
+
+
+                /** Compute measure of simplex formed by first vertices of simplex and point.
+                 *
+                 * @param simplex Indices of locations at vertices of simplex.
+                 * @param numVertices Number of vertices of simplex found so far.
+                 * @param p Coordinates of point.
+                 * @returns Square of distance (1 vertex), square of twice the area (2 vertices in 3-D),
+                 *   or absolute value of orientation.
+                 */
+                double _measure(const int simplex[],
+                                const size_t numVertices,
+                                const double* p) const {
+                    const double* a = _point(simplex[0]);
+                    if (1 == numVertices) {
+                        double dist2 = 0.0;
+                        for (size_t iDim = 0; iDim < _dim; ++iDim) {
+                            dist2 += (p[iDim] - a[iDim]) * (p[iDim] - a[iDim]);
+                        } // for
+                        return dist2;
+                    } else if (numVertices < _dim) {
+                        const double* b = _point(simplex[1]);
+                        const double abX = b[0] - a[0];
+                        const double abY = b[1] - a[1];
+                        const double abZ = b[2] - a[2];
+                        const double apX = p[0] - a[0];
+                        const double apY = p[1] - a[1];
+                        const double apZ = p[2] - a[2];
+                        const double nX = abY*apZ - abZ*apY;
+                        const double nY = abZ*apX - abX*apZ;
+                        const double nZ = abX*apY - abY*apX;
+                        return nX*nX + nY*nY + nZ*nZ;
+                    } // if/else
+                    const double* pts[4];
+                    for (size_t i = 0; i < numVertices; ++i) {
+                        pts[i] = _point(simplex[i]);
+                    } // for
+                    pts[numVertices] = p;
+                    return fabs(orientation(pts, _dim));
+                } // _measure
+
+
+                /** Create cells for initial simplex and cells at infinity on its faces.
+                 *
+                 * @param simplex Indices of locations at vertices of simplex [dim+1].
+                 */
+                void _initialize(int simplex[]) {
+                    const double* pts[4];
+                    for (size_t i = 0; i < _numCorners; ++i) {
+                        pts[i] = _point(simplex[i]);
+                    } // for
+                    if (orientation(pts, _dim) < 0.0) {
+                        std::swap(simplex[0], simplex[1]);
+                    } // if
+
+                    const size_t numCells = _numCorners+1;
+                    _cells.resize(numCells*_numCorners);
+                    _neighbors.resize(numCells*_numCorners);
+                    _mark.assign(numCells, 0);
+                    _vertexMark.assign(_numLocs, 0);
+                    for (size_t i = 0; i < _numCorners; ++i) {
+                        _cells[i] = simplex[i];
+                    } // for
+                    for (size_t iFace = 0; iFace < _numCorners; ++iFace) {
+                        // Replace vertex by vertex at infinity and swap two other vertices to
+                        // preserve positive orientation.
+                        int* cell = &_cells[(iFace+1)*_numCorners];
+                        for (size_t i = 0; i < _numCorners; ++i) {
+                            cell[i] = (i == iFace) ? INFINITE_VERTEX : simplex[i];
+                        } // for
+                        const size_t iA = (0 == iFace) ? 1 : 0;
+                        const size_t iB = (iFace <= 1) ? 2 : 1;
+                        std::swap(cell[iA], cell[iB]);
+                    } // for
+
+                    _faces.clear();
+                    for (size_t iCell = 0; iCell < numCells; ++iCell) {
+                        for (size_t i = 0; i < _numCorners; ++i) {
+                            _faces.push_back(_createFace(&_cells[iCell*_numCorners], iCell, i));
+                        } // for
+                    } // for
+                    const bool isMatched = matchFaces(&_pairs, &_faces);assert(isMatched);(void)isMatched;
+                    const size_t numPairs = _pairs.size();
+                    for (size_t iPair = 0; iPair < numPairs; ++iPair) {
+                        const Face& faceA = _faces[_pairs[iPair].first];
+                        const Face& faceB = _faces[_pairs[iPair].second];
+                        _neighbors[faceA.cell*_numCorners+faceA.face] = int(faceB.cell);
+                        _neighbors[faceB.cell*_numCorners+faceB.face] = int(faceA.cell);
+                    } // for
+                } // _initialize
+
+
+                /** Create face of cell.
+                 *
+                 * @param vertices Indices of vertices of cell.
+                 * @param cell Index of cell.
+                 * @param face Index of face in cell (index of opposite vertex).
+                 * @returns Face.
+                 */
+                Face _createFace(const int* vertices,
+                                 const size_t cell,
+                                 const size_t face) const {
+                    Face f;
+                    f.vertices[0] = f.vertices[1] = f.vertices[2] = 0;
+                    for (size_t i = 0, iF = 0; i < _numCorners; ++i) {
+                        if (i != face) {
+                            f.vertices[iF++] = vertices[i];
+                        } // if
+                    } // for
+                    std::sort(f.vertices, f.vertices+_dim);
+                    f.cell = cell;
+                    f.face = face;
+                    return f;
+                } // _createFace
+
+
+                /// Allocate cell, reusing cells on free list.
+                int _allocateCell(void) {
+                    if (!_free.empty()) {
+                        const int cell = _free.back();
+                        _free.pop_back();
+                        return cell;
+                    } // if
+                    const size_t cell = _mark.size();
+                    _cells.resize((cell+1)*_numCorners);
+                    _neighbors.resize((cell+1)*_numCorners);
+                    _mark.push_back(0);
+                    return int(cell);
+                } // _allocateCell
+
+
+                /// Put cell on free list.
+                void _freeCell(const size_t cell) {
+                    _cells[cell*_numCorners] = DEAD_CELL;
+                    _mark[cell] = 0;
+                    _free.push_back(int(cell));
+                } // _freeCell
+
+
+                /// Compute Morton code of location from its normalized coordinates.
+                unsigned long long _mortonCode(const size_t iLoc) const {
+                    const size_t numBits = (2 == _dim) ? 31 : 21;
+                    const double maxIndex = double((1ULL << numBits) - 1);
+                    unsigned long long index[3] = { 0, 0, 0 };
+                    const double* xyz = _point(iLoc);
+                    for (size_t iDim = 0; iDim < _dim; ++iDim) {
+                        const double value = 0.5 * (xyz[iDim] + 1.0) * maxIndex;
+                        index[iDim] = (unsigned long long)(std::min(std::max(value, 0.0), maxIndex));
+                    } // for
+                    unsigned long long code = 0;
+                    for (size_t iBit = numBits; iBit > 0; --iBit) {
+                        for (size_t iDim = 0; iDim < _dim; ++iDim) {
+                            code = (code << 1) | ((index[iDim] >> (iBit-1)) & 1);
+                        } // for
+                    } // for
+                    return code;
+                } // _mortonCode
+
+
+                /// Face on boundary of cavity.
+                struct OuterFace {
+                    int neighbor; ///< Cell outside cavity.
+                    size_t face; ///< Index of face in new cell.
+                    size_t neighborFace; ///< Index of face in cell outside cavity.
+
+                    OuterFace(const int neighborValue,
+                              const size_t faceValue,
+                              const size_t neighborFaceValue) :
+                        neighbor(neighborValue),
+                        face(faceValue),
+                        neighborFace(neighborFaceValue) {}
+
+
+                }; // OuterFace
+
+                const std::vector<double>& _coords; ///< Normalized coordinates of locations.
+                const size_t _numLocs; ///< Number of locations.
+                const size_t _dim; ///< Spatial dimension.
+                const size_t _numCorners; ///< Number of vertices in cell.
+
+                std::vector<int> _cells; ///< Vertices of cells.
+                std::vector<int> _neighbors; ///< Neighbors of cells.
+                std::vector<int> _free; ///< Free list of cells.
+                std::vector<size_t> _mark; ///< Cavity membership of cells.
+                std::vector<size_t> _vertexMark; ///< Marks for vertices of cavity.
+                size_t _tag; ///< Current tag for marks.
+
+                std::vector<size_t> _cavity; ///< Cells in cavity.
+                std::vector<int> _newCells; ///< Vertices of new cells.
+                std::vector<OuterFace> _newOuter; ///< Boundary faces of cavity for new cells.
+                std::vector<int> _newIndex; ///< Indices of new cells.
+                std::vector<Face> _faces; ///< Faces to match.
+                std::vector<std::pair<size_t, size_t> > _pairs; ///< Matching faces.
+
+            }; // Builder
+
+        } // _triangulation
+    } // spatialdb
+} // spatialdata
+
+// ----------------------------------------------------------------------
+const double spatialdata::spatialdb::Triangulation::_tolerance = 1.0e-6;
+
+// ----------------------------------------------------------------------
+// Default constructor.
+spatialdata::spatialdb::Triangulation::Triangulation(void) :
+    _scale(1.0),
+    _spaceDim(0) {
+    _origin[0] = _origin[1] = _origin[2] = 0.0;
+} // constructor
+
+
+// ----------------------------------------------------------------------
+// Default destructor.
+spatialdata::spatialdb::Triangulation::~Triangulation(void) {
+    deallocate();
+} // destructor
+
+
+// ----------------------------------------------------------------------
+// Deallocate data structures.
+void
+spatialdata::spatialdb::Triangulation::deallocate(void) {
+    std::vector<double>().swap(_coords);
+    std::vector<int>().swap(_cells);
+    std::vector<int>().swap(_neighbors);
+    std::vector<size_t>().swap(_vertexCells);
+    _spaceDim = 0;
+} // deallocate
+
+
+// ----------------------------------------------------------------------
+// Build triangulation of locations.
+void
+spatialdata::spatialdb::Triangulation::build(const double* coords,
+                                             const size_t numLocs,
+                                             const size_t spaceDim) {
+    assert( (0 < numLocs && coords) || (0 == numLocs && !coords) );
+    if (( spaceDim < 2) || ( spaceDim > 3) ) {
+        std::ostringstream msg;
+        msg << "Spatial dimension (" << spaceDim << ") of locations for triangulation must be 2 or 3.";
+        throw std::invalid_argument(msg.str());
+    } // if
+    deallocate();
+
+    // Normalize coordinates to [-1,1] to improve conditioning of geometric predicates.
+    _origin[0] = _origin[1] = _origin[2] = 0.0;
+    _scale = 0.0;
+    for (size_t iDim = 0; iDim < spaceDim && numLocs > 0; ++iDim) {
+        double xMin = coords[iDim];
+        double xMax = coords[iDim];
+        for (size_t iLoc = 1; iLoc < numLocs; ++iLoc) {
+            xMin = std::min(xMin, coords[iLoc*spaceDim+iDim]);
+            xMax = std::max(xMax, coords[iLoc*spaceDim+iDim]);
+        } // for
+        _origin[iDim] = 0.5 * (xMin + xMax);
+        _scale = std::max(_scale, 0.5 * (xMax - xMin));
+    } // for
+    if (_scale <= 0.0) {
+        _scale = 1.0;
+    } // if
+    _coords.resize(numLocs*spaceDim);
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+            _coords[iLoc*spaceDim+iDim] = (coords[iLoc*spaceDim+iDim] - _origin[iDim]) / _scale;
+        } // for
+    } // for
+
+    _triangulation::Builder builder(_coords, numLocs, spaceDim);
+    const int iFailed = builder.build(&_cells, &_neighbors);
+    if (iFailed >= 0) {
+        deallocate();
+        std::ostringstream msg;
+        msg << "Could not insert location " << iFailed << " (";
+        for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+            msg << (iDim > 0 ? ", " : "") << coords[iFailed*spaceDim+iDim];
+        } // for
+        msg << ") into triangulation without creating degenerate cells.";
+        throw std::runtime_error(msg.str());
+    } // if
+    _spaceDim = spaceDim;
+
+    // Cells incident to locations provide starting cells for searches.
+    const size_t numCorners = spaceDim+1;
+    const size_t numCells = _cells.size() / numCorners;
+    _vertexCells.assign(numLocs, numCells);
+    for (size_t iCell = 0; iCell < numCells; ++iCell) {
+        for (size_t i = 0; i < numCorners; ++i) {
+            _vertexCells[_cells[iCell*numCorners+i]] = iCell;
+        } // for
+    } // for
+} // build
+
+
+// ----------------------------------------------------------------------
+// Get spatial dimension of triangulation.
+size_t
+spatialdata::spatialdb::Triangulation::getSpaceDim(void) const {
+    return _spaceDim;
+} // getSpaceDim
+
+
+// ----------------------------------------------------------------------
+// Get number of cells in triangulation.
+size_t
+spatialdata::spatialdb::Triangulation::getNumCells(void) const {
+    return (_spaceDim > 0) ? _cells.size() / (_spaceDim+1) : 0;
+} // getNumCells
+
+
+// ----------------------------------------------------------------------
+// Get cell with location as a vertex.
+size_t
+spatialdata::spatialdb::Triangulation::getVertexCell(const size_t iLoc) const {
+    assert(iLoc < _vertexCells.size());
+    return _vertexCells[iLoc];
+} // getVertexCell
+
+
+// ----------------------------------------------------------------------
+// Locate cell containing point.
+bool
+spatialdata::spatialdb::Triangulation::locate(size_t vertices[],
+                                              double weights[],
+                                              size_t* cell,
+                                              const double pt[3],
+                                              const size_t maxSteps) const {
+    assert(vertices);
+    assert(weights);
+    assert(cell);
+    assert(_spaceDim > 0);
+
+    const size_t numCorners = _spaceDim+1;
+    const size_t numCells = _cells.size() / numCorners;
+
+    double xyz[3] = { 0.0, 0.0, 0.0 };
+    for (size_t iDim = 0; iDim < _spaceDim; ++iDim) {
+        xyz[iDim] = (pt[iDim] - _origin[iDim]) / _scale;
+    } // for
+
+    // Walk toward point, crossing a face with a negative weight. Checking faces in a
+    // pseudo-random order prevents cycling. Leaving through a face on the hull means the
+    // point is outside the triangulation.
+    size_t iCell = (*cell < numCells) ? *cell : 0;
+    const size_t numSteps = (maxSteps > 0) ? maxSteps : numCells;
+    unsigned long seed = 0;
+    bool isFound = false;
+    bool isOutside = false;
+    for (size_t iStep = 0; iStep < numSteps && !isFound && !isOutside; ++iStep) {
+        _computeWeights(weights, iCell, xyz);
+        seed = (1103515245*seed + 12345) % 2147483648;
+        const size_t offset = (seed >> 16) % numCorners;
+        isFound = true;
+        for (size_t i = 0; i < numCorners; ++i) {
+            const size_t iVertex = (i + offset) % numCorners;
+            if (weights[iVertex] < -_tolerance) {
+                const int neighbor = _neighbors[iCell*numCorners+iVertex];
+                if (neighbor < 0) {
+                    isOutside = true;
+                } else {
+                    iCell = neighbor;
+                } // if/else
+                isFound = false;
+                break;
+            } // if
+        } // for
+    } // for
+
+    // Walk did not terminate, so fall back to checking every cell.
+    for (size_t iCellScan = 0; iCellScan < numCells && !isFound && !isOutside && !maxSteps; ++iCellScan) {
+        _computeWeights(weights, iCellScan, xyz);
+        isFound = true;
+        for (size_t i = 0; i < numCorners; ++i) {
+            if (weights[i] < -_tolerance) {
+                isFound = false;
+                break;
+            } // if
+        } // for
+        if (isFound) {
+            iCell = iCellScan;
+        } // if
+    } // for
+
+    *cell = iCell;
+    if (isFound) {
+        for (size_t i = 0; i < numCorners; ++i) {
+            vertices[i] = _cells[iCell*numCorners+i];
+        } // for
+    } // if
+    return isFound;
+} // locate
+
+
+// ----------------------------------------------------------------------
+// Compute barycentric weights of point in cell.
+void
+spatialdata::spatialdb::Triangulation::_computeWeights(double weights[],
+                                                       const size_t cell,
+                                                       const double pt[3]) const {
+    assert(weights);
+
+    const size_t numCorners = _spaceDim+1;
+    const double* pts[4];
+    for (size_t i = 0; i < numCorners; ++i) {
+        pts[i] = &_coords[_cells[cell*numCorners+i]*_spaceDim];
+    } // for
+    const double volume = _triangulation::orientation(pts, _spaceDim);
+    assert(volume > 0.0);
+
+    for (size_t i = 0; i < numCorners; ++i) {
+        const double* vertex = pts[i];
+        pts[i] = pt;
+        weights[i] = _triangulation::orientation(pts, _spaceDim) / volume;
+        pts[i] = vertex;
+    } // for
+} // _computeWeights
+
+
+// End of file
@@ -0,0 +1,127 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+#pragma once
+
+#include "spatialdbfwd.hh" // forward declarations
+
+#include <vector> // HASA std::vector
+#include <cstddef> // USES size_t
+
+/** Delaunay triangulation (2-D) or tetrahedralization (3-D) of a scattered set of points.
+ *
+ * The triangulation is built once from an array of coordinates using incremental
+ * Bowyer-Watson insertion and covers the convex hull of the points. Points are located
+ * by walking from a starting cell through neighboring cells, so locating a sequence of
+ * nearby points is amortized O(1) when the cell containing the previous point is used
+ * as the starting cell for the next one.
+ *
+ * Duplicate locations are included only once. Barycentric weights of points within the
+ * cells are computed with the same tolerance used by SimpleDBQuery, so points just
+ * outside the convex hull are still located.
+ */
+class spatialdata::spatialdb::Triangulation { // Triangulation
+    friend class TestTriangulation; // unit testing
+
+public:
+
+    // PUBLIC METHODS /////////////////////////////////////////////////////
+
+    /// Default constructor.
+    Triangulation(void);
+
+    /// Default destructor.
+    ~Triangulation(void);
+
+    /// Deallocate data structures.
+    void deallocate(void);
+
+    /** Build triangulation of locations.
+     *
+     * @param coords Coordinates of locations [numLocs*spaceDim].
+     * @param numLocs Number of locations.
+     * @param spaceDim Spatial dimension of coordinates.
+     *
+     * @throws std::runtime_error if locations all lie on a line (2-D) or plane (3-D), or if a
+     *   location cannot be inserted without creating degenerate cells.
+     */
+    void build(const double* coords,
+               const size_t numLocs,
+               const size_t spaceDim);
+
+    /** Get spatial dimension of triangulation.
+     *
+     * @returns Spatial dimension.
+     */
+    size_t getSpaceDim(void) const;
+
+    /** Get number of cells (triangles or tetrahedra) in triangulation.
+     *
+     * @returns Number of cells.
+     */
+    size_t getNumCells(void) const;
+
+    /** Get cell with location as a vertex.
+     *
+     * @param iLoc Index of location.
+     * @returns Index of cell (number of cells if location is a duplicate and not a vertex).
+     */
+    size_t getVertexCell(const size_t iLoc) const;
+
+    /** Locate cell containing point.
+     *
+     * @pre Must call build() before locate().
+     *
+     * @param vertices Indices of locations at vertices of cell [spaceDim+1].
+     * @param weights Barycentric weights of point in cell [spaceDim+1].
+     * @param cell Cell at which to start search (input) and last cell visited (output).
+     * @param pt Coordinates of point in 3-D space.
+     * @param maxSteps Maximum number of cells to visit (0 for no limit).
+     * @returns True if point is inside cell, false otherwise.
+     */
+    bool locate(size_t vertices[],
+                double weights[],
+                size_t* cell,
+                const double pt[3],
+                const size_t maxSteps=0) const;
+
+private:
+
+    // PRIVATE METHODS ////////////////////////////////////////////////////
+
+    /** Compute barycentric weights of point in cell.
+     *
+     * @param weights Barycentric weights of point in cell [spaceDim+1].
+     * @param cell Index of cell.
+     * @param pt Coordinates of point in normalized coordinates.
+     */
+    void _computeWeights(double weights[],
+                         const size_t cell,
+                         const double pt[3]) const;
+
+    Triangulation(const Triangulation&); ///< Not implemented
+    const Triangulation& operator=(const Triangulation&); ///< Not implemented
+
+private:
+
+    // PRIVATE MEMBERS ////////////////////////////////////////////////////
+
+    std::vector<double> _coords; ///< Normalized coordinates of locations [numLocs*spaceDim].
+    std::vector<int> _cells; ///< Indices of locations at vertices of cells [numCells*(spaceDim+1)].
+    std::vector<int> _neighbors; ///< Cell opposite each vertex of cells (-1 if none) [numCells*(spaceDim+1)].
+    std::vector<size_t> _vertexCells; ///< Cell with each location as a vertex [numLocs].
+    double _origin[3]; ///< Origin of normalized coordinates.
+    double _scale; ///< Length scale of normalized coordinates.
+    size_t _spaceDim; ///< Spatial dimension.
+
+    static const double _tolerance; ///< Tolerance for barycentric weights of points in cells.
+
+}; // class Triangulation
+
+// End of file
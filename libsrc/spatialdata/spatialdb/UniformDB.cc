@@ -15,6 +15,8 @@
 // Include ios here to avoid some Python/gcc issues
 #include <ios>
 
+#include "QueryContext.hh" // USES QueryContext
+
 #include "spatialdata/units/Parser.hh" // USES Parser
 
 #include <vector> // USES std::vector
@@ -169,27 +171,55 @@ spatialdata::spatialdb::UniformDB::query(double* vals,
                                          const double* coords,
                                          const size_t numDims,
                                          const spatialdata::geocoords::CoordSys* pCSQuery) {
-    if (0 == _querySize) {
-        std::ostringstream msg;
-        msg << "Values to be returned by spatial database " << getDescription() << "\n"
-            << "have not been set. Please call setQueryValues() before query().\n";
-        throw std::logic_error(msg.str());
-    } // if
-    else if (numVals != _querySize) {
-        std::ostringstream msg;
-        msg << "Number of values to be returned by spatial database "
-            << getDescription() << "\n"
-            << "(" << _querySize << ") does not match size of array provided ("
-            << numVals << ").\n";
-        throw std::invalid_argument(msg.str());
-    } // if
+    return _query(vals, numVals, coords, numDims, pCSQuery);
+} // query
+
+
+// ----------------------------------------------------------------------
+// Check whether database supports query contexts.
+bool
+spatialdata::spatialdb::UniformDB::supportsQueryContexts(void) const {
+    return true;
+} // supportsQueryContexts
+
+
+// ----------------------------------------------------------------------
+// Create context for querying the database.
+spatialdata::spatialdb::QueryContext*
+spatialdata::spatialdb::UniformDB::createQueryContext(void) const {
+    return new QueryContext(*this);
+} // createQueryContext
+
+
+// ----------------------------------------------------------------------
+// Query the database using scratch storage in query context.
+int
+spatialdata::spatialdb::UniformDB::_contextQuery(QueryContext* /* context */,
+                                                 double* vals,
+                                                 const size_t numVals,
+                                                 const double* coords,
+                                                 const size_t numDims,
+                                                 const spatialdata::geocoords::CoordSys* csQuery) const {
+    return _query(vals, numVals, coords, numDims, csQuery);
+} // _contextQuery
+
+
+// ----------------------------------------------------------------------
+// Query the database.
+int
+spatialdata::spatialdb::UniformDB::_query(double* vals,
+                                          const size_t numVals,
+                                          const double* /* coords */,
+                                          const size_t /* numDims */,
+                                          const spatialdata::geocoords::CoordSys* /* pCSQuery */) const {
+    _checkQuerySize(numVals, _querySize);
 
     for (size_t iVal = 0; iVal < _querySize; ++iVal) {
         vals[iVal] = _values[_queryValues[iVal]];
     } // for
 
     return 0;
-} // query
+} // _query
 
 
 // End of file
@@ -15,6 +15,8 @@
 // Include ios here to avoid some Python/gcc issues
 #include <ios>
 
+#include "QueryContext.hh" // USES QueryContext
+
 #include "spatialdata/geocoords/CoordSys.hh" // USES CoordSys
 #include "spatialdata/geocoords/Converter.hh" // USES Converter
 #include "spatialdata/units/Parser.hh" // USES Parser
@@ -22,6 +24,8 @@
 #include <string> // USES std::string
 #include <stdexcept> // USES std::runtime_error
 #include <sstream> // USES std::ostringstream
+#include <cstring> // USES memcpy()
+#include <strings.h> // USES strcasecmp()
 #include <cassert> // USES assert()
 #include <typeinfo> // USES typeid()
 
@@ -215,6 +219,14 @@ spatialdata::spatialdb::UserFunctionDB::getNamesDBValues(const char*** valueName
 } // getNamesDBValues
 
 
+// ----------------------------------------------------------------------
+// Get coordinate system of database.
+const spatialdata::geocoords::CoordSys*
+spatialdata::spatialdb::UserFunctionDB::getCoordSys(void) const {
+    return _cs;
+} // getCoordSys
+
+
 // ----------------------------------------------------------------------
 // Set values to be returned by queries.
 void
@@ -256,22 +268,62 @@ spatialdata::spatialdb::UserFunctionDB::query(double* vals,
                                               const double* coords,
                                               const size_t numDims,
                                               const spatialdata::geocoords::CoordSys* csQuery) {
-    const size_t querySize = _querySize;
+    return _query(vals, numVals, coords, numDims, csQuery, _converter);
+} // query
 
-    assert(_cs);
 
-    if (0 == querySize) {
+// ----------------------------------------------------------------------
+// Check whether database supports query contexts.
+bool
+spatialdata::spatialdb::UserFunctionDB::supportsQueryContexts(void) const {
+    return true;
+} // supportsQueryContexts
+
+
+// ----------------------------------------------------------------------
+// Create context for querying the database.
+spatialdata::spatialdb::QueryContext*
+spatialdata::spatialdb::UserFunctionDB::createQueryContext(void) const {
+    if (!_queryFunctions) {
         std::ostringstream msg;
-        msg << "Values to be returned by spatial database " << getDescription()
-            << " have not been set. Please call setQueryValues() before query().\n";
+        msg << "Spatial database " << getDescription() << " has not been opened.\n"
+            << "Please call open() before calling createQueryContext().";
         throw std::logic_error(msg.str());
-    } else if (numVals != querySize) {
-        std::ostringstream msg;
-        msg << "Number of values to be returned by spatial database "
-            << getDescription() << " (" << querySize << ") does not match size of array provided ("
-            << numVals << ").\n";
-        throw std::invalid_argument(msg.str());
-    } else if (numDims != _cs->getSpaceDim()) {
+    } // if
+
+    return new QueryContext(*this);
+} // createQueryContext
+
+
+// ----------------------------------------------------------------------
+// Query the database using scratch storage in query context.
+int
+spatialdata::spatialdb::UserFunctionDB::_contextQuery(QueryContext* context,
+                                                      double* vals,
+                                                      const size_t numVals,
+                                                      const double* coords,
+                                                      const size_t numDims,
+                                                      const spatialdata::geocoords::CoordSys* csQuery) const {
+    assert(context);
+    return _query(vals, numVals, coords, numDims, csQuery, context->getConverter());
+} // _contextQuery
+
+
+// ----------------------------------------------------------------------
+// Query the database.
+int
+spatialdata::spatialdb::UserFunctionDB::_query(double* vals,
+                                               const size_t numVals,
+                                               const double* coords,
+                                               const size_t numDims,
+                                               const spatialdata::geocoords::CoordSys* csQuery,
+                                               spatialdata::geocoords::Converter* converter) const {
+    const size_t querySize = _querySize;
+
+    assert(_cs);
+
+    _checkQuerySize(numVals, querySize);
+    if (numDims != _cs->getSpaceDim()) {
         std::ostringstream msg;
         msg << "Spatial dimension (" << numDims
             << ") does not match spatial dimension of spatial database (" << _cs->getSpaceDim() << ").";
@@ -282,8 +334,8 @@ spatialdata::spatialdb::UserFunctionDB::query(double* vals,
     assert(numDims <= 3);
     double xyz[3];
     memcpy(xyz, coords, numDims*sizeof(double));
-    assert(_converter);
-    _converter->convert(xyz, 1, numDims, _cs, csQuery);
+    assert(converter);
+    converter->convert(xyz, 1, numDims, _cs, csQuery);
 
     int queryFlag = 0;
     for (size_t iVal = 0; iVal < querySize; ++iVal) {
@@ -294,7 +346,7 @@ spatialdata::spatialdb::UserFunctionDB::query(double* vals,
     } // for
 
     return queryFlag;
-} // query
+} // _query
 
 
 // ----------------------------------------------------------------------
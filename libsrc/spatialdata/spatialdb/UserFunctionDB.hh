@@ -101,6 +101,12 @@ public:
     void getNamesDBValues(const char*** valueNames,
                           size_t* numValues) const;
 
+    /** Get coordinate system of database.
+     *
+     * @returns Coordinate system.
+     */
+    const spatialdata::geocoords::CoordSys* getCoordSys(void) const;
+
     /** Set values to be returned by queries.
      *
      * @pre Must call open() before setQueryValues()
@@ -138,6 +144,23 @@ public:
      */
     void setCoordSys(const geocoords::CoordSys& cs);
 
+    /** Check whether database supports query contexts.
+     *
+     * @returns True if database supports query contexts, false otherwise.
+     */
+    bool supportsQueryContexts(void) const;
+
+    /** Create context for querying the database.
+     *
+     * @pre Must call open() before createQueryContext().
+     *
+     * @note User functions are shared by all query contexts, so they must be
+     * reentrant if contexts are used concurrently.
+     *
+     * @returns Query context (caller is responsible for deleting it).
+     */
+    QueryContext* createQueryContext(void) const;
+
 private:
 
     // PRIVATE TYPEDEF//////////////////////////////////////////////////////
@@ -169,6 +192,42 @@ private:
     /// Check compatibility of spatial database parameters.
     void _checkCompatibility(void) const;
 
+    /** Query the database using scratch storage in query context.
+     *
+     * @param context Query context created by createQueryContext().
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     *
+     * @returns 0 on success, 1 on failure (i.e., could not interpolate)
+     */
+    int _contextQuery(QueryContext* context,
+                      double* vals,
+                      const size_t numVals,
+                      const double* coords,
+                      const size_t numDims,
+                      const spatialdata::geocoords::CoordSys* csQuery) const;
+
+    /** Query the database.
+     *
+     * @param vals Array for computed values (output from query) [numVals].
+     * @param numVals Number of values expected.
+     * @param coords Coordinates of point for query [numDims].
+     * @param numDims Number of dimensions for coordinates.
+     * @param csQuery Coordinate system of coordinates.
+     * @param converter Converter for query points.
+     *
+     * @returns 0 on success, 1 on failure.
+     */
+    int _query(double* vals,
+               const size_t numVals,
+               const double* coords,
+               const size_t numDims,
+               const spatialdata::geocoords::CoordSys* csQuery,
+               spatialdata::geocoords::Converter* converter) const;
+
     // PRIVATE STRUCTS //////////////////////////////////////////////////////
 private:
 
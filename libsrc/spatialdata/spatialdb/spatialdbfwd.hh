@@ -14,15 +14,20 @@ namespace spatialdata {
         class OutOfBounds;
 
         class SpatialDB;
+        class QueryContext;
         class SimpleDB;
         class SimpleDBData;
         class SimpleDBQuery;
+        class KDTree;
+        class Triangulation;
         class SimpleIO;
         class SimpleIOAscii;
+        class SimpleIOBinary;
         class UniformDB;
         class AnalyticDB;
         class SimpleGridDB;
         class SimpleGridAscii;
+        class SimpleGridBinary;
         class UserFunctionDB;
         class CompositeDB;
         class SCECCVMH;
@@ -12,45 +12,403 @@
 
 #include "Parser.hh" // implementation of class methods
 
+#include <Python.h>
+
+#include <map> // USES std::map
+#include <string> // USES std::string
 #include <sstream> // USES std::ostringstream
 #include <stdexcept> // USES std::runtime_error
+#include <cmath> // USES pow(), M_PI
+#include <cstdlib> // USES strtod()
+#include <cctype> // USES isalpha(), isdigit(), isspace()
 #include <assert.h> // USES assert()
 
+// ----------------------------------------------------------------------
+namespace spatialdata {
+    namespace units {
+        namespace _parser {
+            /// Scale factors of names known to native parser, following Pyre units modules.
+            class Names {
+public:
+
+                /** Get scale factor for name.
+                 *
+                 * @param[in] name Name of unit or prefix.
+                 * @param[out] value Scale factor.
+                 * @returns True if name is known, false otherwise.
+                 */
+                static
+                bool find(const std::string& name,
+                          double* value) {
+                    assert(value);
+                    const std::map<std::string, double>& names = _getNames();
+                    const std::map<std::string, double>::const_iterator iter = names.find(name);
+                    if (iter == names.end()) {
+                        return false;
+                    } // if
+                    *value = iter->second;
+                    return true;
+                } // find
+
+private:
+
+                /** Get map of names to scale factors.
+                 *
+                 * @returns Map of names to scale factors.
+                 */
+                static
+                const std::map<std::string, double>& _getNames(void) {
+                    static const std::map<std::string, double> names = _createNames();
+                    return names;
+                } // _getNames
+
+                /** Create map of names to scale factors.
+                 *
+                 * @returns Map of names to scale factors.
+                 */
+                static
+                std::map<std::string, double> _createNames(void) {
+                    std::map<std::string, double> n;
+
+                    // SI prefixes
+                    n["yotta"] = 1.0e+24;
+                    n["zetta"] = 1.0e+21;
+                    n["exa"] = 1.0e+18;
+                    n["peta"] = 1.0e+15;
+                    n["tera"] = 1.0e+12;
+                    n["giga"] = 1.0e+9;
+                    n["mega"] = 1.0e+6;
+                    n["kilo"] = 1.0e+3;
+                    n["hecto"] = 1.0e+2;
+                    n["deka"] = 1.0e+1;
+                    n["deci"] = 1.0e-1;
+                    n["centi"] = 1.0e-2;
+                    n["milli"] = 1.0e-3;
+                    n["micro"] = 1.0e-6;
+                    n["nano"] = 1.0e-9;
+                    n["pico"] = 1.0e-12;
+                    n["femto"] = 1.0e-15;
+                    n["atto"] = 1.0e-18;
+                    n["zepto"] = 1.0e-21;
+                    n["yocto"] = 1.0e-24;
+
+                    // SI base and derived units
+                    const char* si[] = {
+                        "meter", "kilogram", "second", "ampere", "kelvin", "mole", "candela",
+                        "radian", "steradian", "hertz", "newton", "pascal", "joule", "watt",
+                        "coulomb", "volt", "farad", "ohm", "siemens", "weber", "tesla", "henry",
+                        "celsius", "lumen", "lux", "becquerel", "gray", "sievert", "katal",
+                        "m", "kg", "s", "A", "K", "mol", "cd", "Hz", "N", "Pa", "J", "W", "C", "V",
+                        "F", "S", "Wb", "T", "H",
+                    };
+                    for (size_t i = 0; i < sizeof(si)/sizeof(si[0]); ++i) {
+                        n[si[i]] = 1.0;
+                    } // for
+
+                    // length
+                    n["km"] = n["kilometer"] = 1.0e+3;
+                    n["hm"] = n["hectometer"] = 1.0e+2;
+                    n["dm"] = n["decimeter"] = 1.0e-1;
+                    n["cm"] = n["centimeter"] = 1.0e-2;
+                    n["mm"] = n["millimeter"] = 1.0e-3;
+                    n["um"] = n["micrometer"] = n["micron"] = 1.0e-6;
+                    n["nm"] = n["nanometer"] = 1.0e-9;
+                    n["angstrom"] = 1.0e-10;
+                    n["fermi"] = 1.0e-15;
+                    n["inch"] = 0.0254;
+                    n["foot"] = 12.0*0.0254;
+                    n["yard"] = 3.0*12.0*0.0254;
+                    n["mile"] = 5280.0*12.0*0.0254;
+                    n["mil"] = 1.0e-3*0.0254;
+                    n["point"] = 0.0254/72.0;
+                    n["printers_point"] = 0.0254/72.27;
+                    n["nautical_mile"] = 1852.0;
+                    n["astronomical_unit"] = 1.495978707e+11;
+                    n["light_year"] = 9.4607304725808e+15;
+                    n["parsec"] = 3.0856775814913673e+16;
+
+                    // area
+                    n["square_meter"] = 1.0;
+                    n["square_centimeter"] = 1.0e-4;
+                    n["square_kilometer"] = 1.0e+6;
+                    n["hectare"] = 1.0e+4;
+                    n["acre"] = 4046.8564224;
+                    n["barn"] = 1.0e-28;
+                    n["square_inch"] = 0.0254*0.0254;
+                    n["square_foot"] = 0.3048*0.3048;
+                    n["square_mile"] = 1609.344*1609.344;
+
+                    // volume
+                    n["cubic_meter"] = 1.0;
+                    n["cubic_centimeter"] = 1.0e-6;
+                    n["liter"] = n["litre"] = 1.0e-3;
+                    n["milliliter"] = 1.0e-6;
+                    n["cubic_inch"] = 0.0254*0.0254*0.0254;
+                    n["cubic_foot"] = 0.3048*0.3048*0.3048;
+                    n["gallon"] = 231.0*0.0254*0.0254*0.0254;
+                    n["quart"] = 231.0/4.0*0.0254*0.0254*0.0254;
+                    n["pint"] = 231.0/8.0*0.0254*0.0254*0.0254;
+                    n["fluid_ounce"] = 231.0/128.0*0.0254*0.0254*0.0254;
+
+                    // mass
+                    n["g"] = n["gram"] = 1.0e-3;
+                    n["mg"] = n["milligram"] = 1.0e-6;
+                    n["metric_ton"] = n["tonne"] = 1.0e+3;
+                    n["pound"] = n["lb"] = 0.45359237;
+                    n["ounce"] = 0.45359237/16.0;
+                    n["ton"] = 2000.0*0.45359237;
+
+                    // time
+                    n["ms"] = n["millisecond"] = 1.0e-3;
+                    n["us"] = n["microsecond"] = 1.0e-6;
+                    n["ns"] = n["nanosecond"] = 1.0e-9;
+                    n["ps"] = n["picosecond"] = 1.0e-12;
+                    n["minute"] = 60.0;
+                    n["hour"] = 3600.0;
+                    n["day"] = 24.0*3600.0;
+                    n["week"] = 7.0*24.0*3600.0;
+                    n["year"] = 365.25*24.0*3600.0;
+
+                    // speed
+                    n["knot"] = 1852.0/3600.0;
+
+                    // force
+                    n["kN"] = 1.0e+3;
+                    n["MN"] = 1.0e+6;
+                    n["dyne"] = 1.0e-5;
+                    n["lbf"] = n["pound_force"] = 0.45359237*9.80665;
+
+                    // pressure
+                    n["kPa"] = 1.0e+3;
+                    n["MPa"] = 1.0e+6;
+                    n["GPa"] = 1.0e+9;
+                    n["bar"] = 1.0e+5;
+                    n["millibar"] = 1.0e+2;
+                    n["kbar"] = 1.0e+8;
+                    n["atmosphere"] = n["atm"] = 101325.0;
+                    n["torr"] = 101325.0/760.0;
+                    n["psi"] = 0.45359237*9.80665/(0.0254*0.0254);
+
+                    // energy
+                    n["kJ"] = 1.0e+3;
+                    n["MJ"] = 1.0e+6;
+                    n["GJ"] = 1.0e+9;
+                    n["erg"] = 1.0e-7;
+                    n["calorie"] = 4.1868;
+                    n["kilocalorie"] = 4.1868e+3;
+                    n["Btu"] = 1055.05585262;
+                    n["electron_volt"] = n["eV"] = 1.602176634e-19;
+                    n["kilowatt_hour"] = 3.6e+6;
+
+                    // power
+                    n["kW"] = 1.0e+3;
+                    n["MW"] = 1.0e+6;
+                    n["GW"] = 1.0e+9;
+                    n["horsepower"] = 745.69987158227022;
+
+                    // angle
+                    n["degree"] = n["deg"] = M_PI/180.0;
+                    n["arcminute"] = M_PI/180.0/60.0;
+                    n["arcsecond"] = M_PI/180.0/3600.0;
+
+                    // temperature
+                    n["rankine"] = 5.0/9.0;
+
+                    // substance
+                    n["kmol"] = 1.0e+3;
+                    n["mmol"] = 1.0e-3;
+
+                    return n;
+                } // _createNames
+
+            }; // Names
+
+            /** Recursive descent evaluator for units expressions.
+             *
+             * Follows Python operator precedence: '**' binds more tightly
+             * than unary '+' and '-' on its left and is right-associative,
+             * '*' and '/' are left-associative.
+             */
+            class Expression {
+public:
+
+                /** Constructor.
+                 *
+                 * @param units Units string.
+                 */
+                Expression(const char* units) :
+                    _str(units),
+                    _pos(0) {}
+
+                /** Evaluate expression.
+                 *
+                 * @param[out] value Scale factor.
+                 * @returns True if expression was evaluated, false if it contains unknown names or syntax.
+                 */
+                bool evaluate(double* value) {
+                    assert(value);
+                    if (!_expression(value)) {
+                        return false;
+                    } // if
+                    _skipSpace();
+                    return _pos == _str.length();
+                } // evaluate
+
+private:
+
+                /// Skip whitespace.
+                void _skipSpace(void) {
+                    while (_pos < _str.length() && isspace(_str[_pos])) {
+                        ++_pos;
+                    } // while
+                } // _skipSpace
+
+                /** Check for operator and consume it if present.
+                 *
+                 * @param op Operator.
+                 * @returns True if operator is next in string, false otherwise.
+                 */
+                bool _accept(const char* op) {
+                    _skipSpace();
+                    const size_t len = std::char_traits<char>::length(op);
+                    if (0 == _str.compare(_pos, len, op)) {
+                        // Do not take first '*' of '**' as multiplication.
+                        if (( 1 == len) && ( '*' == op[0]) && ( 0 == _str.compare(_pos, 2, "**")) ) {
+                            return false;
+                        } // if
+                        _pos += len;
+                        return true;
+                    } // if
+                    return false;
+                } // _accept
+
+                /// expression := factor (('*' | '/') factor)*
+                bool _expression(double* value) {
+                    if (!_factor(value)) {
+                        return false;
+                    } // if
+                    while (true) {
+                        double rhs = 0.0;
+                        if (_accept("*")) {
+                            if (!_factor(&rhs)) {
+                                return false;
+                            } // if
+                            *value *= rhs;
+                        } else if (_accept("/")) {
+                            if (!_factor(&rhs)) {
+                                return false;
+                            } // if
+                            *value /= rhs;
+                        } else {
+                            return true;
+                        } // if/else
+                    } // while
+                } // _expression
+
+                /// factor := ('+' | '-') factor | power
+                bool _factor(double* value) {
+                    if (_accept("-")) {
+                        if (!_factor(value)) {
+                            return false;
+                        } // if
+                        *value = -*value;
+                        return true;
+                    } else if (_accept("+")) {
+                        return _factor(value);
+                    } // if/else
+                    return _power(value);
+                } // _factor
+
+                /// power := primary ['**' factor]
+                bool _power(double* value) {
+                    if (!_primary(value)) {
+                        return false;
+                    } // if
+                    if (_accept("**")) {
+                        double exponent = 0.0;
+                        if (!_factor(&exponent)) {
+                            return false;
+                        } // if
+                        *value = pow(*value, exponent);
+                    } // if
+                    return true;
+                } // _power
+
+                /// primary := number | name | '(' expression ')'
+                bool _primary(double* value) {
+                    _skipSpace();
+                    if (_pos >= _str.length()) {
+                        return false;
+                    } // if
+                    const char c = _str[_pos];
+                    if (_accept("(")) {
+                        return _expression(value) && _accept(")");
+                    } else if (isdigit(c) || ('.' == c)) {
+                        const char* first = _str.c_str() + _pos;
+                        char* last = NULL;
+                        *value = strtod(first, &last);
+                        if (last == first) {
+                            return false;
+                        } // if
+                        _pos += last - first;
+                        return true;
+                    } else if (isalpha(c) || ('_' == c)) {
+                        const size_t first = _pos;
+                        while (_pos < _str.length() && (isalnum(_str[_pos]) || '_' == _str[_pos])) {
+                            ++_pos;
+                        } // while
+                        return Names::find(_str.substr(first, _pos - first), value);
+                    } // if/else
+                    return false;
+                } // _primary
+
+                const std::string _str; ///< Units string.
+                size_t _pos; ///< Current position in string.
+
+            }; // Expression
+
+            /** Get cache of scale factors.
+             *
+             * @returns Map of units strings to scale factors.
+             */
+            std::map<std::string, double>& getCache(void) {
+                static std::map<std::string, double> cache;
+                return cache;
+            } // getCache
+
+            /** Initialize Python interpreter if it is not already initialized.
+             *
+             * The interpreter is initialized at most once per process and is never finalized here,
+             * because other parsers and the application may still be using it.
+             */
+            void initializePython(void) {
+                #pragma omp critical (spatialdata_units_parser_python)
+                if (!Py_IsInitialized()) {
+                    Py_Initialize();
+                } // if
+            } // initializePython
+
+        } // _parser
+    } // units
+} // spatialdata
+
+// ----------------------------------------------------------------------
+bool spatialdata::units::Parser::_usePython = true;
+
 // ----------------------------------------------------------------------
 // Default constructor
-spatialdata::units::Parser::Parser(void) {
-    // Initialize Python interpreter if it is not already initialized.
-    _alreadyInitialized = Py_IsInitialized();
-    if (!_alreadyInitialized) {
-        Py_Initialize();
-    }
-
-    // Should check for NULL, decode the exception, and throw a C++ equivalent
-    PyObject* mod = PyImport_ImportModule("pythia.pyre.units");
-    if (!mod) {
-        throw std::runtime_error("Could not import module 'pythia.pyre.units'.");
-    } // if
-    PyObject* cls = PyObject_GetAttrString(mod, "parser");
-    if (!cls) {
-        throw std::runtime_error("Could not get 'parser' attribute in pythia.pyre.units module.");
-    } // if
-    _parser = PyObject_CallFunctionObjArgs(cls, NULL);
-    if (!_parser) {
-        throw std::runtime_error("Could not create parser Python object.");
-    } // if
-    Py_DECREF(cls);
-    Py_DECREF(mod);
-} // constructor
+spatialdata::units::Parser::Parser(void) :
+    _pyParser(NULL) {}
 
 
 // ----------------------------------------------------------------------
 // Default destructor
 spatialdata::units::Parser::~Parser(void) {
-    Py_CLEAR(_parser);
-
-    if (!_alreadyInitialized) {
-        Py_Finalize();
-    }
+    if (_pyParser) {
+        PyObject* pyParser = (PyObject*) _pyParser;
+        Py_CLEAR(pyParser);
+        _pyParser = NULL;
+    } // if
 } // destructor
 
 
@@ -59,7 +417,92 @@ spatialdata::units::Parser::~Parser(void) {
 // SI units, multiple value given by units by scaling factor.
 double
 spatialdata::units::Parser::parse(const char* units) {
+    assert(units);
+
+    const std::string key(units);
+    bool found = false;
     double scale = 1.0;
+    #pragma omp critical (spatialdata_units_parser)
+    {
+        const std::map<std::string, double>& cache = _parser::getCache();
+        const std::map<std::string, double>::const_iterator iter = cache.find(key);
+        if (iter != cache.end()) {
+            scale = iter->second;
+            found = true;
+        } // if
+    } // omp critical
+    if (found) {
+        return scale;
+    } // if
+
+    _parser::Expression expression(units);
+    if (!expression.evaluate(&scale)) {
+        if (!_usePython) {
+            std::ostringstream msg;
+            msg << "Could not parse units string '" << units << "'.";
+            throw std::runtime_error(msg.str());
+        } // if
+        scale = _parsePython(units);
+    } // if
+
+    #pragma omp critical (spatialdata_units_parser)
+    _parser::getCache()[key] = scale;
+
+    return scale;
+} // parse
+
+
+// ----------------------------------------------------------------------
+// Set flag for using Pyre units parser for units not known to native parser.
+void
+spatialdata::units::Parser::setUsePython(const bool value) {
+    _usePython = value;
+} // setUsePython
+
+
+// ----------------------------------------------------------------------
+// Get flag for using Pyre units parser for units not known to native parser.
+bool
+spatialdata::units::Parser::getUsePython(void) {
+    return _usePython;
+} // getUsePython
+
+
+// ----------------------------------------------------------------------
+// Clear cache of scale factors.
+void
+spatialdata::units::Parser::clearCache(void) {
+    #pragma omp critical (spatialdata_units_parser)
+    _parser::getCache().clear();
+} // clearCache
+
+
+// ----------------------------------------------------------------------
+// Get SI scaling factor using Pyre units parser.
+double
+spatialdata::units::Parser::_parsePython(const char* units) {
+    if (!_pyParser) {
+        _parser::initializePython();
+
+        PyObject* mod = PyImport_ImportModule("pythia.pyre.units");
+        if (!mod) {
+            PyErr_Clear();
+            throw std::runtime_error("Could not import module 'pythia.pyre.units'.");
+        } // if
+        PyObject* cls = PyObject_GetAttrString(mod, "parser");
+        if (!cls) {
+            Py_DECREF(mod);
+            PyErr_Clear();
+            throw std::runtime_error("Could not get 'parser' attribute in pythia.pyre.units module.");
+        } // if
+        _pyParser = PyObject_CallFunctionObjArgs(cls, NULL);
+        Py_DECREF(cls);
+        Py_DECREF(mod);
+        if (!_pyParser) {
+            PyErr_Clear();
+            throw std::runtime_error("Could not create parser Python object.");
+        } // if
+    } // if
 
     /* Replicate Python functionality given by
      *
@@ -68,7 +511,7 @@ spatialdata::units::Parser::parse(const char* units) {
      * x = p.parse(units) [units is a string]
      * scale = x.value
      */
-    PyObject* pyUnit = PyObject_CallMethod(_parser, (char*)"parse", (char*)"s", units);
+    PyObject* pyUnit = PyObject_CallMethod((PyObject*) _pyParser, (char*)"parse", (char*)"s", units);
     if (!pyUnit) {
         if (PyErr_Occurred()) {
             PyErr_Clear();
@@ -96,12 +539,12 @@ spatialdata::units::Parser::parse(const char* units) {
         throw std::runtime_error(msg.str());
     } // if
 
-    scale = PyFloat_AsDouble(pyScale);
+    const double scale = PyFloat_AsDouble(pyScale);
     Py_DECREF(pyScale);
     Py_DECREF(pyUnit);
 
     return scale;
-} // parser
+} // _parsePython
 
 
 // End of file
@@ -11,9 +11,15 @@
 
 #include "unitsfwd.hh"
 
-#include <Python.h>
-
-/// C++ interface to Pyre units parser.
+/** Parser for units strings using Pyre units syntax.
+ *
+ * Units strings are expressions with unit names, SI prefixes, and numbers
+ * combined with '*', '/', '**', and parentheses, such as 'kg/m**3' or
+ * 'kilo*meter/second'. Units are parsed natively and the scale factors are
+ * cached for the life of the process. Units not known to the native parser
+ * are parsed with the Pyre units parser (which requires Python) unless the
+ * Python fallback has been turned off.
+ */
 class spatialdata::units::Parser { // class Parser
     friend class TestParser; // Unit testing
 
@@ -21,11 +27,6 @@ public:
 
     // PUBLIC METHODS /////////////////////////////////////////////////////
 
-    /* MATT- I am not sure if we want just a single static method or we
-     *   want an object so that any setup/teardown is done once per
-     *   instantiation rather than each call to parse.
-     */
-
     /// Default constructor
     Parser(void);
 
@@ -39,12 +40,47 @@ public:
      */
     double parse(const char* units);
 
+    /** Set flag for using Pyre units parser for units not known to
+     * native parser.
+     *
+     * @param value True if Pyre units parser should be used as fallback.
+     */
+    static
+    void setUsePython(const bool value);
+
+    /** Get flag for using Pyre units parser for units not known to
+     * native parser.
+     *
+     * @returns True if Pyre units parser is used as fallback.
+     */
+    static
+    bool getUsePython(void);
+
+    /// Clear cache of scale factors.
+    static
+    void clearCache(void);
+
 private:
 
+    // PRIVATE METHODS ////////////////////////////////////////////////////
+
+    /** Get SI scaling factor using Pyre units parser.
+     *
+     * @param units Units string.
+     * @returns Scaling factor to convert to SI units.
+     */
+    double _parsePython(const char* units);
+
     // PRIVATE MEMBERS ////////////////////////////////////////////////////
 
-    PyObject* _parser;
-    bool _alreadyInitialized;
+    void* _pyParser; ///< Pyre units parser (PyObject*), created when first needed.
+
+    static bool _usePython; ///< Use Pyre units parser as fallback.
+
+    // NOT IMPLEMENTED ////////////////////////////////////////////////////
+
+    Parser(const Parser&); ///< Not implemented
+    const Parser& operator=(const Parser&); ///< Not implemented
 
 }; // class Parser
 
@@ -0,0 +1,245 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "BinaryIO.hh" // implementation of class methods
+
+#include <fstream> // USES std::ifstream
+#include <istream> // USES std::istream
+#include <sstream> // USES std::ostringstream
+#include <stdexcept> // USES std::runtime_error
+#include <vector> // USES std::vector
+#include <cstring> // USES memcpy(), strlen(), strncmp()
+#include <sys/mman.h> // USES mmap(), munmap()
+#include <sys/stat.h> // USES fstat()
+#include <fcntl.h> // USES open()
+#include <unistd.h> // USES close()
+#include <assert.h> // USES assert()
+
+#if defined(WORDS_BIGENDIAN)
+#define NATIVE_BIG_ENDIAN
+#else
+#define NATIVE_LITTLE_ENDIAN
+#endif
+
+// ----------------------------------------------------------------------
+namespace spatialdata {
+    namespace utils {
+        namespace _binaryio {
+            /** Memory-map file privately with given protection.
+             *
+             * @param[in] filename Name of file.
+             * @param[out] size Size of file.
+             * @param[in] prot Protection of mapped pages.
+             * @returns Address of mapped file.
+             */
+            void* mapFile(const char* filename,
+                          size_t* size,
+                          const int prot) {
+                assert(filename);
+                assert(size);
+
+                const int fd = ::open(filename, O_RDONLY);
+                if (fd < 0) {
+                    std::ostringstream msg;
+                    msg << "Could not open file '" << filename << "' for reading.";
+                    throw std::runtime_error(msg.str());
+                } // if
+                struct stat fileStat;
+                if (fstat(fd, &fileStat) < 0) {
+                    ::close(fd);
+                    std::ostringstream msg;
+                    msg << "Could not get size of file '" << filename << "'.";
+                    throw std::runtime_error(msg.str());
+                } // if
+                if (0 == fileStat.st_size) {
+                    ::close(fd);
+                    std::ostringstream msg;
+                    msg << "File '" << filename << "' is empty.";
+                    throw std::runtime_error(msg.str());
+                } // if
+
+                void* addr = mmap(NULL, fileStat.st_size, prot, MAP_PRIVATE, fd, 0);
+                ::close(fd);
+                if (MAP_FAILED == addr) {
+                    std::ostringstream msg;
+                    msg << "Could not memory-map file '" << filename << "'.";
+                    throw std::runtime_error(msg.str());
+                } // if
+
+                *size = fileStat.st_size;
+                return addr;
+            } // mapFile
+
+        } // _binaryio
+    } // utils
+} // spatialdata
+
+// ----------------------------------------------------------------------
+// Check whether native byte order is little-endian.
+bool
+spatialdata::utils::BinaryIO::isNativeLittleEndian(void) {
+#if defined(NATIVE_LITTLE_ENDIAN)
+    return true;
+#else
+    return false;
+#endif
+} // isNativeLittleEndian
+
+
+// ----------------------------------------------------------------------
+// Check whether file starts with magic header.
+bool
+spatialdata::utils::BinaryIO::hasHeader(const char* filename,
+                                        const char* header) {
+    assert(filename);
+    assert(header);
+
+    const size_t headerLen = strlen(header);
+    std::ifstream filein(filename, std::ios::in | std::ios::binary);
+    if (!filein.is_open() || !filein.good()) {
+        return false;
+    } // if
+    std::vector<char> buffer(headerLen+1);
+    filein.read(&buffer[0], headerLen);
+
+    return filein.good() && (0 == strncmp(&buffer[0], header, headerLen));
+} // hasHeader
+
+
+// ----------------------------------------------------------------------
+// Memory-map file.
+void*
+spatialdata::utils::BinaryIO::map(const char* filename,
+                                  size_t* size) {
+    return _binaryio::mapFile(filename, size, PROT_READ | PROT_WRITE);
+} // map
+
+
+// ----------------------------------------------------------------------
+// Memory-map file read-only.
+const void*
+spatialdata::utils::BinaryIO::mapReadOnly(const char* filename,
+                                          size_t* size) {
+    return _binaryio::mapFile(filename, size, PROT_READ);
+} // mapReadOnly
+
+
+// ----------------------------------------------------------------------
+// Unmap memory-mapped file.
+void
+spatialdata::utils::BinaryIO::unmap(const void* addr,
+                                    const size_t size) {
+    if (addr) {
+        munmap(const_cast<void*>(addr), size);
+    } // if
+} // unmap
+
+
+// ----------------------------------------------------------------------
+// Read little-endian unsigned integer.
+uint64_t
+spatialdata::utils::BinaryIO::readUInt64(const char* src) {
+    assert(src);
+
+    const unsigned char* bytes = (const unsigned char*) src;
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i) {
+        value = (value << 8) | bytes[i];
+    } // for
+    return value;
+} // readUInt64
+
+
+// ----------------------------------------------------------------------
+// Write little-endian unsigned integer.
+void
+spatialdata::utils::BinaryIO::writeUInt64(std::ostream& fileout,
+                                          const uint64_t value) {
+    char bytes[8];
+    for (int i = 0; i < 8; ++i) {
+        bytes[i] = char((value >> (8*i)) & 0xff);
+    } // for
+    fileout.write(bytes, 8);
+} // writeUInt64
+
+
+// ----------------------------------------------------------------------
+// Read little-endian doubles.
+void
+spatialdata::utils::BinaryIO::readDoubles(double* dest,
+                                          const char* src,
+                                          const size_t numValues) {
+    assert(!numValues || (dest && src));
+
+#if defined(NATIVE_LITTLE_ENDIAN)
+    memcpy(dest, src, 8*numValues);
+#else
+    for (size_t i = 0; i < numValues; ++i) {
+        const uint64_t bits = readUInt64(&src[8*i]);
+        memcpy(&dest[i], &bits, 8);
+    } // for
+#endif
+} // readDoubles
+
+
+// ----------------------------------------------------------------------
+// Read little-endian doubles from input stream.
+void
+spatialdata::utils::BinaryIO::readDoubles(double* dest,
+                                          std::istream& filein,
+                                          const size_t numValues) {
+    assert(!numValues || dest);
+
+    filein.read((char*) dest, 8*numValues);
+#if !defined(NATIVE_LITTLE_ENDIAN)
+    const char* src = (const char*) dest;
+    for (size_t i = 0; i < numValues; ++i) {
+        const uint64_t bits = readUInt64(&src[8*i]);
+        memcpy(&dest[i], &bits, 8);
+    } // for
+#endif
+} // readDoubles
+
+
+// ----------------------------------------------------------------------
+// Write little-endian doubles.
+void
+spatialdata::utils::BinaryIO::writeDoubles(std::ostream& fileout,
+                                           const double* src,
+                                           const size_t numValues) {
+    assert(!numValues || src);
+
+#if defined(NATIVE_LITTLE_ENDIAN)
+    fileout.write((const char*) src, 8*numValues);
+#else
+    for (size_t i = 0; i < numValues; ++i) {
+        uint64_t bits = 0;
+        memcpy(&bits, &src[i], 8);
+        writeUInt64(fileout, bits);
+    } // for
+#endif
+} // writeDoubles
+
+
+// ----------------------------------------------------------------------
+// Write NUL characters to pad output to a multiple of 8 bytes.
+uint64_t
+spatialdata::utils::BinaryIO::writePadding(std::ostream& fileout,
+                                           const uint64_t offset) {
+    const uint64_t paddedOffset = 8 * ((offset + 7) / 8);
+    const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    fileout.write(zeros, paddedOffset - offset);
+    return paddedOffset;
+} // writePadding
+
+
+// End of file
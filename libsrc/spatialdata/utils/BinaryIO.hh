@@ -0,0 +1,146 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+#pragma once
+
+#include "utilsfwd.hh"
+
+#include <iosfwd> // USES std::istream, std::ostream
+#include <cstddef> // USES size_t
+#include <stdint.h> // USES uint64_t
+
+/** Helpers for binary files with little-endian 64-bit integers and doubles.
+ *
+ * Values are read from memory (usually a memory-mapped file) and written
+ * to output streams, converting between little-endian storage and native
+ * byte order as needed.
+ */
+class spatialdata::utils::BinaryIO { // BinaryIO
+    // PUBLIC METHODS ///////////////////////////////////////////////////////
+public:
+
+    /** Check whether native byte order is little-endian.
+     *
+     * Values stored in little-endian order can be used in place if
+     * native byte order is little-endian.
+     *
+     * @returns True if native byte order is little-endian, false otherwise.
+     */
+    static
+    bool isNativeLittleEndian(void);
+
+    /** Check whether file starts with magic header.
+     *
+     * @param filename Name of file.
+     * @param header Magic header.
+     * @returns True if file starts with magic header, false otherwise.
+     */
+    static
+    bool hasHeader(const char* filename,
+                   const char* header);
+
+    /** Memory-map file.
+     *
+     * The file is mapped privately and writable, so changes to the
+     * mapped values are not written to the file and unmodified pages
+     * are shared with other processes mapping the same file.
+     *
+     * @param[in] filename Name of file.
+     * @param[out] size Size of file.
+     * @returns Address of mapped file.
+     */
+    static
+    void* map(const char* filename,
+              size_t* size);
+
+    /** Memory-map file read-only.
+     *
+     * Use this for files whose mapped values are never modified, so
+     * that writing to them is an error rather than a silent copy.
+     *
+     * @param[in] filename Name of file.
+     * @param[out] size Size of file.
+     * @returns Address of mapped file.
+     */
+    static
+    const void* mapReadOnly(const char* filename,
+                            size_t* size);
+
+    /** Unmap memory-mapped file.
+     *
+     * @param addr Address of mapped file.
+     * @param size Size of file.
+     */
+    static
+    void unmap(const void* addr,
+               const size_t size);
+
+    /** Read little-endian unsigned integer.
+     *
+     * @param src Source buffer [8].
+     * @returns Value.
+     */
+    static
+    uint64_t readUInt64(const char* src);
+
+    /** Write little-endian unsigned integer.
+     *
+     * @param fileout Output stream.
+     * @param value Value.
+     */
+    static
+    void writeUInt64(std::ostream& fileout,
+                     const uint64_t value);
+
+    /** Read little-endian doubles.
+     *
+     * @param dest Destination array [numValues].
+     * @param src Source buffer [8*numValues].
+     * @param numValues Number of values.
+     */
+    static
+    void readDoubles(double* dest,
+                     const char* src,
+                     const size_t numValues);
+
+    /** Read little-endian doubles from input stream.
+     *
+     * @param dest Destination array [numValues].
+     * @param filein Input stream.
+     * @param numValues Number of values.
+     */
+    static
+    void readDoubles(double* dest,
+                     std::istream& filein,
+                     const size_t numValues);
+
+    /** Write little-endian doubles.
+     *
+     * @param fileout Output stream.
+     * @param src Source array [numValues].
+     * @param numValues Number of values.
+     */
+    static
+    void writeDoubles(std::ostream& fileout,
+                      const double* src,
+                      const size_t numValues);
+
+    /** Write NUL characters to pad output to a multiple of 8 bytes.
+     *
+     * @param fileout Output stream.
+     * @param offset Current offset in output.
+     * @returns Offset after padding.
+     */
+    static
+    uint64_t writePadding(std::ostream& fileout,
+                          const uint64_t offset);
+
+}; // BinaryIO
+
+// End of file
@@ -0,0 +1,105 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "NumberParser.hh" // implementation of class methods
+
+#include <cstdlib> // USES strtod()
+#include <cassert> // USES assert()
+
+#if __cplusplus >= 201703L
+#include <charconv> // USES std::from_chars()
+#endif
+
+namespace spatialdata {
+    namespace utils {
+        namespace _numberparser {
+            /** Check whether character is whitespace.
+             *
+             * @param c Character.
+             * @returns True if character is whitespace, false otherwise.
+             */
+            inline
+            bool isSpace(const char c) {
+                return ' ' == c || '\n' == c || '\t' == c || '\r' == c || '\v' == c || '\f' == c;
+            } // isSpace
+
+            /** Convert token to number.
+             *
+             * @param[in] first Beginning of token.
+             * @param[in] last End of token.
+             * @param[out] value Value of number.
+             * @returns True if entire token is a number, false otherwise.
+             */
+            inline
+            bool toNumber(const char* first,
+                          const char* last,
+                          double* value) {
+                // Stream extraction accepts a leading plus sign.
+                if (('+' == *first) && (last - first > 1) && ('-' != first[1])) {
+                    ++first;
+                } // if
+#if defined(__cpp_lib_to_chars)
+                const std::from_chars_result result = std::from_chars(first, last, *value);
+                return std::errc() == result.ec && last == result.ptr;
+#else
+                // Token is followed by whitespace or NUL, so strtod() stops at end of token.
+                char* endptr = NULL;
+                *value = strtod(first, &endptr);
+                return last == endptr;
+#endif
+            } // toNumber
+
+        } // _numberparser
+    } // utils
+} // spatialdata
+
+// ----------------------------------------------------------------------
+// Convert numbers in line.
+bool
+spatialdata::utils::NumberParser::parse(double* values,
+                                        const size_t numValues,
+                                        const std::string& line) {
+    assert(!numValues || values);
+
+    const char* buffer = line.c_str();
+    const size_t length = line.length();
+    size_t count = 0;
+    size_t begin = 0;
+    while (true) {
+        // Skip whitespace.
+        while (begin < length && _numberparser::isSpace(buffer[begin])) {
+            ++begin;
+        } // while
+        if (begin == length) {
+            break;
+        } // if
+
+        if (count == numValues) {
+            break; // Ignore tokens after expected numbers, as with stream extraction.
+        } // if
+
+        size_t tokenEnd = begin;
+        while (tokenEnd < length && !_numberparser::isSpace(buffer[tokenEnd])) {
+            ++tokenEnd;
+        } // while
+        if (!_numberparser::toNumber(&buffer[begin], &buffer[tokenEnd], &values[count])) {
+            return false;
+        } // if
+        ++count;
+        begin = tokenEnd;
+    } // while
+
+    return count == numValues;
+} // parse
+
+
+// End of file
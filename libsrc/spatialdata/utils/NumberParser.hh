@@ -0,0 +1,43 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+#pragma once
+
+#include "utilsfwd.hh"
+
+#include <string> // USES std::string
+#include <cstddef> // USES size_t
+
+/** Fast conversion of whitespace-separated numbers in a line of text.
+ *
+ * Converts tokens directly from the line, avoiding locale-aware stream
+ * extraction. Lines are read with LineParser, which also removes
+ * comments, so errors can be reported with the text of the line.
+ */
+class spatialdata::utils::NumberParser { // NumberParser
+    // PUBLIC METHODS ///////////////////////////////////////////////////////
+public:
+
+    /** Convert numbers in line.
+     *
+     * Any tokens after the first numValues numbers are ignored.
+     *
+     * @param[out] values Array of values [numValues].
+     * @param[in] numValues Number of values expected in line.
+     * @param[in] line Line of text.
+     * @returns True if line starts with numValues numbers, false otherwise.
+     */
+    static
+    bool parse(double* values,
+               const size_t numValues,
+               const std::string& line);
+
+}; // NumberParser
+
+// End of file
@@ -11,7 +11,9 @@
 
 namespace spatialdata {
     namespace utils {
+        class BinaryIO;
         class LineParser;
+        class NumberParser;
         class PointsStream;
 
         class SpatialdataVersion;
@@ -48,6 +48,51 @@ public:
 
             %clear(double* coords, const size_t numLocs, const size_t numDims);
 
+            /** Set number of threads used to convert large arrays of coordinates.
+             *
+             * @param[in] value Number of threads (0 for OpenMP default, 1 for serial conversion).
+             */
+            void setNumThreads(const size_t value);
+
+            /** Get number of threads used to convert large arrays of coordinates.
+             *
+             * @returns Number of threads (0 for OpenMP default, 1 for serial conversion).
+             */
+            size_t getNumThreads(void) const;
+
+            /** Set maximum number of PROJ transformations kept in cache.
+             *
+             * @param[in] value Maximum number of transformations (must be positive).
+             */
+            void setCacheSize(const size_t value);
+
+            /** Get maximum number of PROJ transformations kept in cache.
+             *
+             * @returns Maximum number of transformations.
+             */
+            size_t getCacheSize(void) const;
+
+            /** Get number of conversions that used a cached PROJ transformation.
+             *
+             * @returns Number of cache hits.
+             */
+            size_t getNumCacheHits(void) const;
+
+            /** Get number of conversions that created a PROJ transformation.
+             *
+             * @returns Number of cache misses.
+             */
+            size_t getNumCacheMisses(void) const;
+
+            /** Get total time spent creating PROJ transformations.
+             *
+             * @returns Time in seconds.
+             */
+            double getProjCreationTime(void) const;
+
+            /// Reset cache hit, miss, and PROJ creation time counters.
+            void resetCacheStats(void);
+
         }; // class Converter
 
     } // geocoords
@@ -61,6 +61,26 @@ namespace spatialdata {
 	       const char* const* names,
 	       const size_t numNames);
       %clear(const char* const* names, const size_t numNames);
+
+      /** Add database after the databases already set.
+       *
+       * @param db Pointer to database.
+       * @param names Array of names of values to use with database.
+       * @param numNames Size of array of names.
+       */
+      %apply(const char* const* string_list, const int list_len){
+	(const char* const* names, const size_t numNames)
+	  };
+      void addDB(SpatialDB* db,
+	       const char* const* names,
+	       const size_t numNames);
+      %clear(const char* const* names, const size_t numNames);
+
+      /** Get number of databases.
+       *
+       * @returns Number of databases.
+       */
+      size_t getNumDBs(void) const;
       
       /// Open the database and prepare for querying.
       void open(void);
@@ -22,6 +22,15 @@ namespace spatialdata {
 
     class SCECCVMH : public SpatialDB
     { // SCECCVMH
+
+      // PUBLIC ENUM ////////////////////////////////////////////////////
+    public :
+
+      /** Type of query */
+      enum QueryEnum {
+	NEAREST=0,
+	LINEAR=1
+      };
  
     public :
       // PUBLIC MEMBERS /////////////////////////////////////////////////
@@ -54,6 +63,31 @@ namespace spatialdata {
        */
       void setSquashFlag(const bool flag,
 			 const double limit =-2000.0);
+
+      /** Set query type.
+       *
+       * @param queryType Set type of query
+       */
+      void setQueryType(const SCECCVMH::QueryEnum queryType);
+
+      /** Set flag for memory-mapping the voxet property files instead
+       * of reading them into memory.
+       *
+       * @param value True to memory-map property files, false otherwise.
+       */
+      void setUseMemoryMap(const bool value);
+
+      /** Set flag for storing voxet data in blocks of points.
+       *
+       * @param value True to store voxet data in blocks of points, false otherwise.
+       */
+      void setUseBlockedLayout(const bool value);
+
+      /** Get flag for storing voxet data in blocks of points.
+       *
+       * @returns True if storing voxet data in blocks of points, false otherwise.
+       */
+      bool getUseBlockedLayout(void) const;
       
       /// Open the database and prepare for querying.
       void open(void);
@@ -72,6 +72,14 @@ namespace spatialdata {
        */
       void setIOHandler(const SimpleIO* iohandler);
 
+      /** Set flag for using triangulation of locations in linear interpolation.
+       *
+       * @pre Must call setUseTriangulation() before open().
+       *
+       * @param value True to use triangulation, false otherwise.
+       */
+      void setUseTriangulation(const bool value);
+
       /** Set values to be returned by queries.
        *
        * @pre Must call open() before setQueryValues()
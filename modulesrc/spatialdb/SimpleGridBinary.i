@@ -0,0 +1,66 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+/** @file modulesrc/spatialdb/SimpleGridBinary.i
+ *
+ * @brief SWIG interface to C++ SimpleGridBinary object.
+ */
+
+namespace spatialdata {
+    namespace spatialdb {
+        class spatialdata::spatialdb::SimpleGridBinary
+        { // SimpleGridBinary
+public:
+
+            // PUBLIC METHODS /////////////////////////////////////////////////
+
+            // Using default constructor.
+
+            // Using default destructor.
+
+            // Using default copy constructor
+
+            /** Check whether file is a SimpleGridDB file in binary format.
+             *
+             * @param filename Name of file.
+             * @returns True if file starts with magic header for binary format, false otherwise.
+             */
+            static
+            bool isBinary(const char* filename);
+
+            /** Read the database.
+             *
+             * @param db Spatial database.
+             */
+            static
+            void read(SimpleGridDB* db);
+
+            /** Write the database.
+             *
+             * @param db Spatial database.
+             */
+            static
+            void write(const SimpleGridDB& db);
+
+            /** Convert SimpleGridDB file from ASCII format to binary format.
+             *
+             * @param asciiFilename Name of file in ASCII format.
+             * @param binaryFilename Name of file in binary format.
+             */
+            static
+            void convertAscii(const char* asciiFilename,
+                              const char* binaryFilename);
+
+        }; // class SimpleGridBinary
+
+    } // spatialdb
+} // spatialdata
+
+// End of file
@@ -52,6 +52,20 @@ namespace spatialdata {
        */
       void setQueryType(const SimpleGridDB::QueryEnum queryType);
 
+      /** Set flag for storing data in blocks of points.
+       *
+       * @pre Must call before open().
+       *
+       * @param value True to store data in blocks of points, false to store data with x varying fastest.
+       */
+      void setUseBlockedLayout(const bool value);
+
+      /** Get flag for storing data in blocks of points.
+       *
+       * @returns True if storing data in blocks of points, false otherwise.
+       */
+      bool getUseBlockedLayout(void) const;
+
       /// Open the database and prepare for querying.
       void open(void);
 
@@ -207,6 +221,13 @@ namespace spatialdata {
        */
       void setCoordSys(const spatialdata::geocoords::CoordSys& cs);
 
+      /** Check whether coordinates along axis are uniformly spaced.
+       *
+       * @param iAxis Index of axis (0=x, 1=y, 2=z).
+       * @returns True if coordinates along axis are uniformly spaced.
+       */
+      bool isUniformAxis(const size_t iAxis) const;
+
     }; // class SimpleGridDB
 
   } // spatialdb
@@ -0,0 +1,65 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+/** @file modulesrc/spatialdb/SimpleIOBinary.i
+ *
+ * @brief SWIG interface to C++ SimpleIOBinary object.
+ */
+
+namespace spatialdata {
+    namespace spatialdb {
+        class SimpleDBData; // forward declaration
+
+        class SimpleIOBinary: public SimpleIO
+        { // SimpleIOBinary
+public:
+
+            // PUBLIC METHODS /////////////////////////////////////////////////
+
+            /// Default constructor.
+            SimpleIOBinary(void);
+
+            /// Default destructor.
+            ~SimpleIOBinary(void);
+
+            /** Set flag for memory-mapping the coordinates and data values.
+             *
+             * @param value True if coordinates and data values should be memory-mapped.
+             */
+            void setUseMemoryMap(const bool value);
+
+            /** Get flag for memory-mapping the coordinates and data values.
+             *
+             * @returns True if coordinates and data values are memory-mapped.
+             */
+            bool getUseMemoryMap(void) const;
+
+            /** Read the database.
+             *
+             * @param pData Database data
+             * @param ppCS Pointer to coordinate system
+             */
+            void read(SimpleDBData* pData,
+                      spatialdata::geocoords::CoordSys** ppCS);
+
+            /** Write the database.
+             *
+             * @param data Database data
+             * @param pCS Pointer to coordinate system
+             */
+            void write(const SimpleDBData& data,
+                       const spatialdata::geocoords::CoordSys* pCS);
+
+        }; // class SimpleIOBinary
+
+    } // spatialdb
+} // spatialdata
+
+// End of file
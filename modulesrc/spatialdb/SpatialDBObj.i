@@ -50,6 +50,18 @@ public:
              */
             const char* getDescription(void) const;
 
+            /** Set number of threads used in multiquery().
+             *
+             * @param value Number of threads (0 for OpenMP default, 1 for serial queries).
+             */
+            void setNumThreads(const size_t value);
+
+            /** Get number of threads used in multiquery().
+             *
+             * @returns Number of threads (0 for OpenMP default, 1 for serial queries).
+             */
+            size_t getNumThreads(void) const;
+
             /// Open the database and prepare for querying.
             virtual
             void open(void) = 0;
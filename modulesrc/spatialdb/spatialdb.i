@@ -23,10 +23,12 @@
 #include "spatialdata/spatialdb/SimpleDBData.hh"
 #include "spatialdata/spatialdb/SimpleIO.hh"
 #include "spatialdata/spatialdb/SimpleIOAscii.hh"
+#include "spatialdata/spatialdb/SimpleIOBinary.hh"
 #include "spatialdata/spatialdb/UniformDB.hh"
 #include "spatialdata/spatialdb/AnalyticDB.hh"
 #include "spatialdata/spatialdb/SimpleGridDB.hh"
 #include "spatialdata/spatialdb/SimpleGridAscii.hh"
+#include "spatialdata/spatialdb/SimpleGridBinary.hh"
 #include "spatialdata/spatialdb/UserFunctionDB.hh"
 #include "spatialdata/spatialdb/CompositeDB.hh"
 #include "spatialdata/spatialdb/SCECCVMH.hh"
@@ -64,10 +66,12 @@ import_array();
 %include "SimpleDBData.i"
 %include "SimpleIO.i"
 %include "SimpleIOAscii.i"
+%include "SimpleIOBinary.i"
 %include "UniformDB.i"
 %include "AnalyticDB.i"
 %include "SimpleGridDB.i"
 %include "SimpleGridAscii.i"
+%include "SimpleGridBinary.i"
 %include "UserFunctionDB.i"
 %include "CompositeDB.i"
 %include "SCECCVMH.i"
@@ -8,14 +8,67 @@
 # See https://mit-license.org/ and LICENSE.md and for license information. 
 # =================================================================================================
 
+from pythia.pyre.components.Component import Component
+
 from .SpatialDBObj import SpatialDBObj
 from .spatialdb import CompositeDB as ModuleCompositeDB
 
 
+class CompositeDBEntry(Component):
+    """
+    Spatial database and names of values to query with it in a composite spatial database.
+    """
+    DOC_CONFIG = {
+        "cfg": """
+            [db.db_others.qp]
+            values = [qp]
+            db = spatialdata.spatialdb.SimpleDB
+            db.description = Attenuation spatial database.
+            db.iohandler.filename = qp.spatialdb
+            """,
+    }
+
+    import pythia.pyre.inventory
+
+    names = pythia.pyre.inventory.list("values", default=[])
+    names.meta['tip'] = "Names of values to query with database."
+
+    from .UniformDB import UniformDB
+    db = pythia.pyre.inventory.facility("db", factory=UniformDB, family="spatial_database")
+    db.meta['tip'] = "Spatial database."
+
+    def __init__(self, name="compositedbentry"):
+        """
+        Constructor.
+        """
+        Component.__init__(self, name, facility="composite_db_entry")
+
+
+def entryFactory(name):
+    """
+    Factory for additional databases in composite spatial database.
+    """
+    from pythia.pyre.inventory import facility
+    return facility(name, family="composite_db_entry", factory=CompositeDBEntry)
+
+
+class NoEntries(Component):
+    """
+    Container with no additional databases.
+    """
+
+    def __init__(self, name="noentries"):
+        """
+        Constructor.
+        """
+        Component.__init__(self, name, facility="composite_db_entry")
+
+
 class CompositeDB(SpatialDBObj, ModuleCompositeDB):
     """
-    Virtual spatial database implemented as a combination of two spatial databases.
+    Virtual spatial database implemented as a combination of two or more spatial databases.
     This spatial database is useful when you need to provide additional values beyond those present in an existing spatial database or some values have a different layout than others.
+    Databases beyond A and B are given by `db_others`.
 
     Implements `SpatialDB`.
     """
@@ -33,6 +86,12 @@ class CompositeDB(SpatialDBObj, ModuleCompositeDB):
             db_B = spatialdata.spatialdb.SimpleDB
             db_B.description = Wave speed spatial database.
             db_B.iohandler.filename = vpvs.spatialdb
+
+            db_others = [qp]
+            db_others.qp.values = [qp]
+            db_others.qp.db = spatialdata.spatialdb.SimpleDB
+            db_others.qp.db.description = Attenuation spatial database.
+            db_others.qp.db.iohandler.filename = qp.spatialdb
             """,
     }
 
@@ -51,6 +110,9 @@ class CompositeDB(SpatialDBObj, ModuleCompositeDB):
     dbB = pythia.pyre.inventory.facility("db_B", factory=UniformDB, family="spatial_database")
     dbB.meta['tip'] = "Spatial database B."
 
+    dbOthers = pythia.pyre.inventory.facilityArray("db_others", itemFactory=entryFactory, factory=NoEntries)
+    dbOthers.meta['tip'] = "Additional spatial databases, queried after databases A and B."
+
     # PUBLIC METHODS /////////////////////////////////////////////////////
 
     def __init__(self, name="compositedb"):
@@ -69,6 +131,8 @@ class CompositeDB(SpatialDBObj, ModuleCompositeDB):
         self._validateParameters(self.inventory)
         ModuleCompositeDB.setDBA(self, self.dbA, self.namesA)
         ModuleCompositeDB.setDBB(self, self.dbB, self.namesB)
+        for entry in self.dbOthers.components():
+            ModuleCompositeDB.addDB(self, entry.db, entry.names)
 
     def _createModuleObj(self):
         """
@@ -87,6 +151,10 @@ class CompositeDB(SpatialDBObj, ModuleCompositeDB):
         if (0 == len(data.namesB)):
             raise ValueError("Error in spatial database '%s'\n"
                              "Names of values to query in database B not set." % self.description)
+        for entry in data.dbOthers.components():
+            if (0 == len(entry.names)):
+                raise ValueError("Error in spatial database '%s'\n"
+                                 "Names of values to query in database '%s' not set." % (self.description, entry.name))
         return
 
 
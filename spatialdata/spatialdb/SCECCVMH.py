@@ -48,6 +48,16 @@ class SCECCVMH(SpatialDBObj, ModuleSCECCVMH):
     squashLimit = pythia.pyre.inventory.dimensional("squash_limit", default=-2.0 * km)
     squashLimit.meta['tip'] = "Elevation above which topography is squashed."
 
+    queryType = pythia.pyre.inventory.str("query_type", default="nearest")
+    queryType.validator = pythia.pyre.inventory.choice(["nearest", "linear"])
+    queryType.meta['tip'] = "Type of query to perform (tags always use nearest)."
+
+    useMemoryMap = pythia.pyre.inventory.bool("use_memory_map", default=False)
+    useMemoryMap.meta['tip'] = "Memory-map voxet property files instead of reading them into memory."
+
+    useBlockedLayout = pythia.pyre.inventory.bool("use_blocked_layout", default=False)
+    useBlockedLayout.meta['tip'] = "Store voxet data in blocks of points for better memory locality (ignored if memory-mapped)."
+
     def __init__(self, name="sceccvmh"):
         """
         Constructor.
@@ -66,6 +76,9 @@ class SCECCVMH(SpatialDBObj, ModuleSCECCVMH):
         ModuleSCECCVMH.setDataDir(self, self.dataDir)
         ModuleSCECCVMH.setMinVs(self, self.minVs.value)
         ModuleSCECCVMH.setSquashFlag(self, self.squash, self.squashLimit.value)
+        ModuleSCECCVMH.setQueryType(self, self._parseQueryString(self.queryType))
+        ModuleSCECCVMH.setUseMemoryMap(self, self.useMemoryMap)
+        ModuleSCECCVMH.setUseBlockedLayout(self, self.useBlockedLayout)
 
     def _createModuleObj(self):
         """
@@ -73,6 +86,15 @@ class SCECCVMH(SpatialDBObj, ModuleSCECCVMH):
         """
         ModuleSCECCVMH.__init__(self)
 
+    def _parseQueryString(self, label):
+        if label.lower() == "nearest":
+            value = ModuleSCECCVMH.NEAREST
+        elif label.lower() == "linear":
+            value = ModuleSCECCVMH.LINEAR
+        else:
+            raise ValueError("Unknown value for query type '%s' in spatial database %s." % (label, self.description))
+        return value
+
 
 # FACTORIES ////////////////////////////////////////////////////////////
 
@@ -34,6 +34,9 @@ class SimpleDB(SpatialDBObj, ModuleSimpleDB):
     queryType.validator = pythia.pyre.inventory.choice(["nearest", "linear"])
     queryType.meta['tip'] = "Type of query to perform."
 
+    useTriangulation = pythia.pyre.inventory.bool("use_triangulation", default=False)
+    useTriangulation.meta['tip'] = "Use Delaunay triangulation of locations for linear interpolation (2D and 3D data)."
+
     from .SimpleIOAscii import SimpleIOAscii
     iohandler = pythia.pyre.inventory.facility("iohandler", family="simpledb_io", factory=SimpleIOAscii)
     iohandler.meta['tip'] = "I/O handler for database."
@@ -55,6 +58,7 @@ class SimpleDB(SpatialDBObj, ModuleSimpleDB):
         SpatialDBObj._configure(self)
         ModuleSimpleDB.setIOHandler(self, self.iohandler)
         ModuleSimpleDB.setQueryType(self, self._parseQueryString(self.queryType))
+        ModuleSimpleDB.setUseTriangulation(self, self.useTriangulation)
 
     def _createModuleObj(self):
         """
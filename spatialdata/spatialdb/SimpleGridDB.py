@@ -50,6 +50,9 @@ class SimpleGridDB(SpatialDBObj, ModuleSimpleGridDB):
     queryType.validator = pythia.pyre.inventory.choice(["nearest", "linear"])
     queryType.meta['tip'] = "Type of query to perform."
 
+    useBlockedLayout = pythia.pyre.inventory.bool("use_blocked_layout", default=False)
+    useBlockedLayout.meta['tip'] = "Store data of 3-D grids in blocks of points for better memory locality (ignored for memory-mapped binary files)."
+
     # PUBLIC METHODS /////////////////////////////////////////////////////
 
     def __init__(self, name="simplegriddb"):
@@ -68,6 +71,7 @@ class SimpleGridDB(SpatialDBObj, ModuleSimpleGridDB):
         SpatialDBObj._configure(self)
         ModuleSimpleGridDB.setFilename(self, self.filename)
         ModuleSimpleGridDB.setQueryType(self, self._parseQueryString(self.queryType))
+        ModuleSimpleGridDB.setUseBlockedLayout(self, self.useBlockedLayout)
 
     def _createModuleObj(self):
         """
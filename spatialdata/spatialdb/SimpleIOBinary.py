@@ -0,0 +1,113 @@
+# =================================================================================================
+# This code is part of SpatialData, developed through the Computational Infrastructure
+# for Geodynamics (https://github.com/geodynamics/spatialdata).
+#
+# Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+# All rights reserved.
+#
+# See https://mit-license.org/ and LICENSE.md and for license information. 
+# =================================================================================================
+
+from .SimpleIO import SimpleIO
+from .spatialdb import SimpleIOBinary as ModuleSimpleIOBinary
+
+
+class SimpleIOBinary(SimpleIO, ModuleSimpleIOBinary):
+    """
+    Binary reader/writer for a simple spatial database (SimpleDB).
+
+    The coordinates and values are stored as contiguous arrays, so large
+    databases can be memory-mapped instead of parsed.
+
+    Implements `SimpleIO`.
+    """
+    DOC_CONFIG = {
+        "cfg": """
+            [dbio]
+            filename = mat_elastic.bin_spatialdb
+            use_memory_map = True
+            """,
+    }
+
+    import pythia.pyre.inventory
+
+    useMemoryMap = pythia.pyre.inventory.bool("use_memory_map", default=True)
+    useMemoryMap.meta['tip'] = "Memory-map coordinates and values instead of reading them into memory."
+
+    # PUBLIC METHODS /////////////////////////////////////////////////////
+
+    def __init__(self, name="simpleiobinary"):
+        """
+        Constructor.
+        """
+        SimpleIO.__init__(self, name)
+        return
+
+    def write(self, data):
+        """
+        Write database to file.
+
+        @param data Dictionary of the following form:
+          data = {'points': 2-D array (numLocs, spaceDim),
+                  'coordsys': Coordinate system associated with locations,
+                  'data_dim': Dimension of spatial distribution,
+                  'values': [{'name': Name of value,
+                              'units': Units of value,
+                              'data': Data for value (numLocs)}]}
+        """
+        import numpy
+
+        self._validateData(data)
+
+        (numLocs, spaceDim) = data['points'].shape
+        dataDim = data['data_dim']
+        numValues = len(data['values'])
+        names = []
+        units = []
+        values = numpy.zeros((numLocs, numValues), dtype=numpy.float64)
+        i = 0
+        for value in data['values']:
+            names.append(value['name'])
+            units.append(value['units'])
+            values[:, i] = value['data'][:]
+            i += 1
+
+        from .spatialdb import SimpleDBData
+        dbData = SimpleDBData()
+        dbData.allocate(numLocs, numValues, spaceDim, dataDim)
+        dbData.setCoordinates(data['points'])
+        dbData.setData(values)
+        dbData.setNames(names)
+        dbData.setUnits(units)
+
+        ModuleSimpleIOBinary.write(self, dbData, data['coordsys'])
+
+    # PRIVATE METHODS ////////////////////////////////////////////////////
+
+    def _configure(self):
+        ModuleSimpleIOBinary.setFilename(self, self.filename)
+        ModuleSimpleIOBinary.setUseMemoryMap(self, self.useMemoryMap)
+
+    def _createModuleObj(self):
+        """
+        Create Python module object.
+        """
+        ModuleSimpleIOBinary.__init__(self)
+
+
+# FACTORIES ////////////////////////////////////////////////////////////
+
+def createWriter(filename):
+    writer = SimpleIOBinary()
+    writer.setFilename(filename)
+    return writer
+
+
+def simpledb_io():
+    """
+    Factory associated with SimpleIOBinary.
+    """
+    return SimpleIOBinary()
+
+
+# End of file
@@ -25,6 +25,10 @@ def validateDescription(value):
 class SpatialDBObj(Component, ModuleSpatialDB):
     """
     Python abstract base class for spatial database.
+
+    When spatialdata is configured with `--enable-openmp`, queries of many locations at once (`multiquery`) are divided among threads by setting `num_threads` (0 uses the OpenMP default number of threads).
+    Each thread queries the database with its own query context, so the values and error flags are identical to those from serial queries.
+    The C++ `Converter` has the same setting for converting large arrays of coordinates.
     """
 
     import pythia.pyre.inventory
@@ -32,6 +36,9 @@ class SpatialDBObj(Component, ModuleSpatialDB):
     description = pythia.pyre.inventory.str("description", default="", validator=validateDescription)
     description.meta['tip'] = "Description for database."
 
+    numThreads = pythia.pyre.inventory.int("num_threads", default=1, validator=pythia.pyre.inventory.greaterEqual(0))
+    numThreads.meta['tip'] = "Number of threads for multiple queries (0 for OpenMP default; requires OpenMP)."
+
     # PUBLIC METHODS /////////////////////////////////////////////////////
 
     def __init__(self, name="spatialdb"):
@@ -50,6 +57,7 @@ class SpatialDBObj(Component, ModuleSpatialDB):
         Component._configure(self)
         self._createModuleObj()
         ModuleSpatialDB.setDescription(self, self.description)
+        ModuleSpatialDB.setNumThreads(self, self.numThreads)
         return
 
     def _createModuleObj(self):
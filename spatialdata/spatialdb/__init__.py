@@ -16,6 +16,7 @@ __all__ = [
     "SCECCVMH",
     "SimpleDB",
     "SimpleIOAscii",
+    "SimpleIOBinary",
     "SimpleIO",
     "SpatialDBObj",
     "TimeHistory",
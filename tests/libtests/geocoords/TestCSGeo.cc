@@ -99,6 +99,17 @@ spatialdata::geocoords::TestCSGeo::testAccessors(void) {
 
     CHECK(csString == std::string(cs.getString()));
     CHECK(spaceDim == cs.getSpaceDim());
+
+    // Strings that differ only in case share an identifier; different strings do not.
+    CSGeo csSame;
+    csSame.setString(csString.c_str());
+    CHECK(cs.getCRSId() == csSame.getCRSId());
+    csSame.setString("epsg:4269");
+    CHECK(cs.getCRSId() == csSame.getCRSId());
+    CSGeo csDefault;
+    CHECK(cs.getCRSId() != csDefault.getCRSId());
+    csSame.setString("EPSG:4326");
+    CHECK(csDefault.getCRSId() == csSame.getCRSId());
 } // testAccessors
 
 
@@ -11,6 +11,7 @@
 #include <portinfo>
 
 #include "spatialdata/geocoords/CSGeoLocal.hh" // USES CSGeoLocal
+#include "spatialdata/geocoords/Converter.hh" // USES Converter
 
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/matchers/catch_matchers_floating_point.hpp"
@@ -19,6 +20,7 @@
 
 #include <strings.h> // USES strcasecmp()
 #include <sstream> // USES std::stringstream
+#include <vector> // USES std::vector
 
 // ------------------------------------------------------------------------------------------------
 namespace spatialdata {
@@ -43,6 +45,10 @@ public:
     static
     void testComputeSurfaceNormal(void);
 
+    /// Test localToGeographic(), geographicToLocal(), and conversion between local coordinate systems.
+    static
+    void testTransforms(void);
+
     /// Test pickle() & unpickle()
     static
     void testPickle(void);
@@ -59,6 +65,9 @@ TEST_CASE("TestCSGeoLocal::testAccessors", "[TestCSGeoLocal]") {
 TEST_CASE("TestCSGeoLocal::testComputeSurfaceNormal", "[TestCSGeoLocal]") {
     spatialdata::geocoords::TestCSGeoLocal::testComputeSurfaceNormal();
 }
+TEST_CASE("TestCSGeoLocal::testTransforms", "[TestCSGeoLocal]") {
+    spatialdata::geocoords::TestCSGeoLocal::testTransforms();
+}
 TEST_CASE("TestCSGeoLocal::testPickle", "[TestCSGeoLocal]") {
     spatialdata::geocoords::TestCSGeoLocal::testPickle();
 }
@@ -223,6 +232,70 @@ spatialdata::geocoords::TestCSGeoLocal::testComputeSurfaceNormal(void) {
 } // testComputeSurfaceNormal
 
 
+// ----------------------------------------------------------------------
+// Test localToGeographic(), geographicToLocal(), and conversion between local coordinate systems.
+void
+spatialdata::geocoords::TestCSGeoLocal::testTransforms(void) {
+    const double originX = 500000.0;
+    const double originY = 3750000.0;
+    const double yAzimuth = 30.0;
+    const double cosTheta = cos(yAzimuth * M_PI / 180.0);
+    const double sinTheta = sin(yAzimuth * M_PI / 180.0);
+
+    CSGeoLocal cs;
+    cs.setString("EPSG:32611");
+    cs.setLocal(originX, originY, yAzimuth);
+
+    const size_t numLocs = 5;
+    const double tolerance = 1.0e-6;
+    for (size_t numDims = 2; numDims <= 4; ++numDims) {
+        INFO("numDims=" << numDims);
+        std::vector<double> local(numLocs*numDims);
+        for (size_t i = 0; i < local.size(); ++i) {
+            local[i] = 1000.0 * double(i % 7) - 2500.0;
+        } // for
+
+        std::vector<double> coords(local);
+        cs.localToGeographic(&coords[0], numLocs, numDims);
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            const double* xyLocal = &local[iLoc*numDims];
+            const double xE = originX + cosTheta*xyLocal[0] + sinTheta*xyLocal[1];
+            const double yE = originY - sinTheta*xyLocal[0] + cosTheta*xyLocal[1];
+            CHECK_THAT(coords[iLoc*numDims+0], Catch::Matchers::WithinAbs(xE, tolerance));
+            CHECK_THAT(coords[iLoc*numDims+1], Catch::Matchers::WithinAbs(yE, tolerance));
+            for (size_t iDim = 2; iDim < numDims; ++iDim) {
+                CHECK(xyLocal[iDim] == coords[iLoc*numDims+iDim]);
+            } // for
+        } // for
+
+        cs.geographicToLocal(&coords[0], numLocs, numDims);
+        for (size_t i = 0; i < local.size(); ++i) {
+            CHECK_THAT(coords[i], Catch::Matchers::WithinAbs(local[i], tolerance));
+        } // for
+    } // for
+
+    // Conversion between local coordinate systems with the same CRS combines the local transformations.
+    CSGeoLocal csOther;
+    csOther.setString("EPSG:32611");
+    csOther.setLocal(originX + 2000.0, originY - 1000.0, -15.0);
+    const size_t numDims = 3;
+    std::vector<double> coordsE(numLocs*numDims);
+    for (size_t i = 0; i < coordsE.size(); ++i) {
+        coordsE[i] = 1000.0 * double(i % 7) - 2500.0;
+    } // for
+    std::vector<double> coords(coordsE);
+    cs.localToGeographic(&coordsE[0], numLocs, numDims);
+    csOther.geographicToLocal(&coordsE[0], numLocs, numDims);
+
+    Converter converter;
+    converter.convert(&coords[0], numLocs, numDims, &csOther, &cs);
+    CHECK(0 == converter.getNumCacheMisses());
+    for (size_t i = 0; i < coords.size(); ++i) {
+        CHECK_THAT(coords[i], Catch::Matchers::WithinAbs(coordsE[i], tolerance));
+    } // for
+} // testTransforms
+
+
 // ----------------------------------------------------------------------
 // Test pickle() and unpickle()
 void
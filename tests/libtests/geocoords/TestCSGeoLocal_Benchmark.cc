@@ -0,0 +1,259 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "Benchmark.hh" // USES Benchmark
+
+#include "spatialdata/geocoords/CSGeoLocal.hh" // USES CSGeoLocal
+#include "spatialdata/geocoords/Converter.hh" // USES Converter
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <sstream> // USES std::ostringstream
+#include <vector> // USES std::vector
+#include <cmath> // USES M_PI, cos(), sin(), fabs()
+#include <algorithm> // USES std::max()
+
+// ------------------------------------------------------------------------------------------------
+namespace spatialdata {
+    namespace geocoords {
+        class TestCSGeoLocal_Benchmark;
+    } // geocoords
+} // spatialdata
+
+// ------------------------------------------------------------------------------------------------
+class spatialdata::geocoords::TestCSGeoLocal_Benchmark {
+public:
+
+    /** Benchmark localToGeographic() and geographicToLocal() for arrays and single locations.
+     *
+     * @param numDims Number of spatial dimensions in coordinates.
+     */
+    static
+    void benchmarkTransforms(const size_t numDims);
+
+    /** Benchmark conversion between local coordinate systems with the same CRS.
+     *
+     * @param numDims Number of spatial dimensions in coordinates.
+     */
+    static
+    void benchmarkConvertLocal(const size_t numDims);
+
+private:
+
+    /** Convert local coordinates to geographic coordinates and back, computing the rotation on each
+     * call and using a run-time stride, for reference.
+     *
+     * @param coords Array of coordinates [numLocs*numDims].
+     * @param numLocs Number of locations.
+     * @param numDims Number of spatial dimensions in coordinates.
+     * @param originX X coordinate of local origin.
+     * @param originY Y coordinate of local origin.
+     * @param yAzimuth Azimuth (degrees) of y axis.
+     */
+    static
+    void _roundTripReference(double* coords,
+                             const size_t numLocs,
+                             const size_t numDims,
+                             const double originX,
+                             const double originY,
+                             const double yAzimuth);
+
+    static const size_t _numLocs; ///< Number of locations in arrays (fits in cache).
+    static const size_t _numRepeat; ///< Number of times to transform arrays.
+
+}; // TestCSGeoLocal_Benchmark
+const size_t spatialdata::geocoords::TestCSGeoLocal_Benchmark::_numLocs = 10000;
+const size_t spatialdata::geocoords::TestCSGeoLocal_Benchmark::_numRepeat = 2000;
+
+// ------------------------------------------------------------------------------------------------
+// Benchmarks are hidden; run them with `libtest_geocoords "[benchmark]"`.
+TEST_CASE("TestCSGeoLocal::benchmarkTransforms::2D", "[TestCSGeoLocal][benchmark][.]") {
+    spatialdata::geocoords::TestCSGeoLocal_Benchmark::benchmarkTransforms(2);
+}
+TEST_CASE("TestCSGeoLocal::benchmarkTransforms::3D", "[TestCSGeoLocal][benchmark][.]") {
+    spatialdata::geocoords::TestCSGeoLocal_Benchmark::benchmarkTransforms(3);
+}
+TEST_CASE("TestCSGeoLocal::benchmarkConvertLocal::2D", "[TestCSGeoLocal][benchmark][.]") {
+    spatialdata::geocoords::TestCSGeoLocal_Benchmark::benchmarkConvertLocal(2);
+}
+TEST_CASE("TestCSGeoLocal::benchmarkConvertLocal::3D", "[TestCSGeoLocal][benchmark][.]") {
+    spatialdata::geocoords::TestCSGeoLocal_Benchmark::benchmarkConvertLocal(3);
+}
+
+// ------------------------------------------------------------------------------------------------
+void
+spatialdata::geocoords::TestCSGeoLocal_Benchmark::benchmarkTransforms(const size_t numDims) {
+    const double originX = 500000.0;
+    const double originY = 3750000.0;
+    const double yAzimuth = 30.0;
+
+    CSGeoLocal cs;
+    cs.setString("EPSG:32611");
+    cs.setLocal(originX, originY, yAzimuth);
+
+    std::vector<double> coordsOrig(_numLocs*numDims);
+    for (size_t i = 0; i < coordsOrig.size(); ++i) {
+        coordsOrig[i] = 1000.0 * double(i % 101) - 50000.0;
+    } // for
+
+    { // Arrays
+        std::vector<double> coordsRef(coordsOrig);
+        testing::Benchmark::Stopwatch stopwatch;
+        for (size_t iRepeat = 0; iRepeat < _numRepeat; ++iRepeat) {
+            _roundTripReference(&coordsRef[0], _numLocs, numDims, originX, originY, yAzimuth);
+        } // for
+        const double secondsRef = stopwatch.seconds();
+
+        std::vector<double> coords(coordsOrig);
+        stopwatch.restart();
+        for (size_t iRepeat = 0; iRepeat < _numRepeat; ++iRepeat) {
+            cs.localToGeographic(&coords[0], _numLocs, numDims);
+            cs.geographicToLocal(&coords[0], _numLocs, numDims);
+        } // for
+        const double seconds = stopwatch.seconds();
+
+        // Keep results live and check that both implementations agree.
+        double maxDiff = 0.0;
+        for (size_t i = 0; i < coords.size(); ++i) {
+            maxDiff = std::max(maxDiff, fabs(coords[i] - coordsRef[i]));
+        } // for
+        CHECK(maxDiff < 1.0e-6);
+
+        std::ostringstream label;
+        label << "CSGeoLocal arrays (" << numDims << "D)";
+        testing::Benchmark::reportSpeedup(label.str().c_str(), "reference", "current",
+                                          double(_numLocs * _numRepeat * 2), secondsRef, seconds);
+    } // Arrays
+
+    { // Single locations, as in per-point queries
+        std::vector<double> coordsRef(coordsOrig);
+        testing::Benchmark::Stopwatch stopwatch;
+        for (size_t iRepeat = 0; iRepeat < _numRepeat / 10; ++iRepeat) {
+            for (size_t iLoc = 0; iLoc < _numLocs; ++iLoc) {
+                _roundTripReference(&coordsRef[iLoc*numDims], 1, numDims, originX, originY, yAzimuth);
+            } // for
+        } // for
+        const double secondsRef = stopwatch.seconds();
+
+        std::vector<double> coords(coordsOrig);
+        stopwatch.restart();
+        for (size_t iRepeat = 0; iRepeat < _numRepeat / 10; ++iRepeat) {
+            for (size_t iLoc = 0; iLoc < _numLocs; ++iLoc) {
+                cs.localToGeographic(&coords[iLoc*numDims], 1, numDims);
+                cs.geographicToLocal(&coords[iLoc*numDims], 1, numDims);
+            } // for
+        } // for
+        const double seconds = stopwatch.seconds();
+
+        double maxDiff = 0.0;
+        for (size_t i = 0; i < coords.size(); ++i) {
+            maxDiff = std::max(maxDiff, fabs(coords[i] - coordsRef[i]));
+        } // for
+        CHECK(maxDiff < 1.0e-6);
+
+        std::ostringstream label;
+        label << "CSGeoLocal single locations (" << numDims << "D)";
+        testing::Benchmark::reportSpeedup(label.str().c_str(), "reference", "current",
+                                          double(_numLocs * (_numRepeat / 10) * 2), secondsRef, seconds);
+    } // Single locations
+} // benchmarkTransforms
+
+
+// ------------------------------------------------------------------------------------------------
+void
+spatialdata::geocoords::TestCSGeoLocal_Benchmark::benchmarkConvertLocal(const size_t numDims) {
+    CSGeoLocal csSrc;
+    csSrc.setString("EPSG:32611");
+    csSrc.setLocal(500000.0, 3750000.0, 30.0);
+    csSrc.setSpaceDim(numDims);
+    CSGeoLocal csDest;
+    csDest.setString("EPSG:32611");
+    csDest.setLocal(502000.0, 3749000.0, -15.0);
+    csDest.setSpaceDim(numDims);
+
+    std::vector<double> coordsOrig(_numLocs*numDims);
+    for (size_t i = 0; i < coordsOrig.size(); ++i) {
+        coordsOrig[i] = 1000.0 * double(i % 101) - 50000.0;
+    } // for
+
+    // Reference: separate passes through local-to-geographic and geographic-to-local transformations.
+    std::vector<double> coordsRef(coordsOrig);
+    testing::Benchmark::Stopwatch stopwatch;
+    for (size_t iRepeat = 0; iRepeat < _numRepeat; ++iRepeat) {
+        csSrc.localToGeographic(&coordsRef[0], _numLocs, numDims);
+        csDest.geographicToLocal(&coordsRef[0], _numLocs, numDims);
+    } // for
+    const double secondsRef = stopwatch.seconds();
+
+    Converter converter;
+    std::vector<double> coords(coordsOrig);
+    stopwatch.restart();
+    for (size_t iRepeat = 0; iRepeat < _numRepeat; ++iRepeat) {
+        converter.convert(&coords[0], _numLocs, numDims, &csDest, &csSrc);
+    } // for
+    const double seconds = stopwatch.seconds();
+
+    // Round-off differs after many repeated transformations, so only compare after the first one.
+    coords = coordsOrig;
+    coordsRef = coordsOrig;
+    csSrc.localToGeographic(&coordsRef[0], _numLocs, numDims);
+    csDest.geographicToLocal(&coordsRef[0], _numLocs, numDims);
+    converter.convert(&coords[0], _numLocs, numDims, &csDest, &csSrc);
+    double maxDiff = 0.0;
+    for (size_t i = 0; i < coords.size(); ++i) {
+        maxDiff = std::max(maxDiff, fabs(coords[i] - coordsRef[i]));
+    } // for
+    CHECK(maxDiff < 1.0e-6);
+
+    std::ostringstream label;
+    label << "Converter local to local (" << numDims << "D)";
+    testing::Benchmark::reportSpeedup(label.str().c_str(), "reference", "current",
+                                      double(_numLocs * _numRepeat), secondsRef, seconds);
+} // benchmarkConvertLocal
+
+
+// ------------------------------------------------------------------------------------------------
+void
+spatialdata::geocoords::TestCSGeoLocal_Benchmark::_roundTripReference(double* coords,
+                                                                      const size_t numLocs,
+                                                                      const size_t numDims,
+                                                                      const double originX,
+                                                                      const double originY,
+                                                                      const double yAzimuth) {
+    { // localToGeographic
+        const double yAzimuthR = yAzimuth * M_PI / 180.0;
+        const double cosTheta = cos(yAzimuthR);
+        const double sinTheta = sin(yAzimuthR);
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            const double localX = coords[iLoc*numDims+0];
+            const double localY = coords[iLoc*numDims+1];
+            const double unrotX = cosTheta * localX + sinTheta * localY;
+            const double unrotY = -sinTheta * localX + cosTheta * localY;
+            coords[iLoc*numDims + 0] = originX + unrotX;
+            coords[iLoc*numDims + 1] = originY + unrotY;
+        } // for
+    } // localToGeographic
+    { // geographicToLocal
+        const double yAzimuthR = yAzimuth * M_PI / 180.0;
+        const double cosTheta = cos(yAzimuthR);
+        const double sinTheta = sin(yAzimuthR);
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            const double unrotX = coords[iLoc*numDims + 0] - originX;
+            const double unrotY = coords[iLoc*numDims + 1] - originY;
+            coords[iLoc*numDims + 0] = cosTheta * unrotX - sinTheta * unrotY;
+            coords[iLoc*numDims + 1] = sinTheta * unrotX + cosTheta * unrotY;
+        } // for
+    } // geographicToLocal
+} // _roundTripReference
+
+
+// End of file
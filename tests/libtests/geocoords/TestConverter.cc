@@ -14,12 +14,16 @@
 
 #include "spatialdata/geocoords/Converter.hh" // USES Converter
 #include "spatialdata/geocoords/CoordSys.hh" // USES CoordSys
+#include "spatialdata/geocoords/CSGeo.hh" // USES CSGeo
+#include "spatialdata/geocoords/CSGeoLocal.hh" // USES CSGeoLocal
 
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/matchers/catch_matchers_floating_point.hpp"
 
 #include <cmath> // USES cmath()
 #include <cstring> // USES memcpy()
+#include <stdexcept> // USES std::invalid_argument
+#include <vector> // USES std::vector
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Constructor.
@@ -74,6 +78,130 @@ spatialdata::geocoords::TestConverter::testConvert(void) {
 } // testConvert
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Test caching of PROJ transformations.
+void
+spatialdata::geocoords::TestConverter::testCache(void) {
+    const size_t numCS = 3;
+    const char* crsStrings[numCS] = { "EPSG:4267", "EPSG:32610", "EPSG:26910" };
+    CSGeo csSrc[numCS];
+    for (size_t i = 0; i < numCS; ++i) {
+        csSrc[i].setString(crsStrings[i]);
+        csSrc[i].setSpaceDim(2);
+    } // for
+    CSGeo csDest;
+    csDest.setString("EPSG:4326");
+    csDest.setSpaceDim(2);
+
+    Converter converter;
+    CHECK(8 == converter.getCacheSize());
+    CHECK_THROWS_AS(converter.setCacheSize(0), std::invalid_argument);
+    converter.setCacheSize(2);
+    CHECK(2 == converter.getCacheSize());
+
+    const double xyLL[2] = { 37.0, -122.0 };
+    const double xyUTM[2] = { 500000.0, 4100000.0 };
+    double xy[2];
+
+    // Alternating between two source coordinate systems reuses transformations.
+    for (size_t iPass = 0; iPass < 3; ++iPass) {
+        memcpy(xy, xyLL, sizeof(xy));
+        converter.convert(xy, 1, 2, &csDest, &csSrc[0]);
+        memcpy(xy, xyUTM, sizeof(xy));
+        converter.convert(xy, 1, 2, &csDest, &csSrc[1]);
+    } // for
+    CHECK(2 == converter.getNumCacheMisses());
+    CHECK(4 == converter.getNumCacheHits());
+    CHECK(converter.getProjCreationTime() >= 0.0);
+
+    // Third source coordinate system evicts least recently used transformation (csSrc[0]).
+    memcpy(xy, xyUTM, sizeof(xy));
+    converter.convert(xy, 1, 2, &csDest, &csSrc[2]);
+    CHECK(3 == converter.getNumCacheMisses());
+    memcpy(xy, xyUTM, sizeof(xy));
+    converter.convert(xy, 1, 2, &csDest, &csSrc[1]);
+    CHECK(5 == converter.getNumCacheHits());
+    memcpy(xy, xyLL, sizeof(xy));
+    converter.convert(xy, 1, 2, &csDest, &csSrc[0]);
+    CHECK(4 == converter.getNumCacheMisses());
+
+    // Shrinking cache destroys least recently used transformations (csSrc[1]).
+    converter.setCacheSize(1);
+    converter.resetCacheStats();
+    memcpy(xy, xyLL, sizeof(xy));
+    converter.convert(xy, 1, 2, &csDest, &csSrc[0]);
+    CHECK(1 == converter.getNumCacheHits());
+    memcpy(xy, xyUTM, sizeof(xy));
+    converter.convert(xy, 1, 2, &csDest, &csSrc[1]);
+    CHECK(1 == converter.getNumCacheMisses());
+
+    converter.resetCacheStats();
+    CHECK(0 == converter.getNumCacheHits());
+    CHECK(0 == converter.getNumCacheMisses());
+    CHECK(0.0 == converter.getProjCreationTime());
+
+    // Identical source and destination coordinate systems do not use PROJ.
+    CSGeo csSame;
+    csSame.setString("EPSG:4326");
+    csSame.setSpaceDim(2);
+    memcpy(xy, xyLL, sizeof(xy));
+    converter.convert(xy, 1, 2, &csDest, &csSame);
+    CHECK(0 == converter.getNumCacheHits());
+    CHECK(0 == converter.getNumCacheMisses());
+    CHECK(xyLL[0] == xy[0]);
+    CHECK(xyLL[1] == xy[1]);
+
+    // Each converter holds its own transformations (in its own PROJ context).
+    Converter converter2;
+    memcpy(xy, xyUTM, sizeof(xy));
+    converter2.convert(xy, 1, 2, &csDest, &csSrc[1]);
+    CHECK(1 == converter2.getNumCacheMisses());
+    memcpy(xy, xyUTM, sizeof(xy));
+    converter.convert(xy, 1, 2, &csDest, &csSrc[1]);
+    CHECK(1 == converter.getNumCacheHits());
+} // testCache
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Test setNumThreads() and parallel conversion.
+void
+spatialdata::geocoords::TestConverter::testThreads(void) {
+    CSGeo csSrc;
+    csSrc.setString("EPSG:4326"); // WGS84
+    CSGeoLocal csDest;
+    csDest.setString("EPSG:32611"); // WGS84 UTM Zone 11N
+    csDest.setLocal(500000.0, 3750000.0, 30.0);
+
+    Converter converter;
+    CHECK(1 == converter.getNumThreads());
+    converter.setNumThreads(0);
+    CHECK(0 == converter.getNumThreads());
+
+    // Enough locations for several chunks per thread.
+    const size_t numLocs = 200000;
+    const size_t numDims = 3;
+    std::vector<double> coordsSerial(numLocs*numDims);
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        coordsSerial[iLoc*numDims+0] = 33.0 + 2.0*double(iLoc % 1000) / 1000.0;
+        coordsSerial[iLoc*numDims+1] = -118.0 + 2.0*double(iLoc / 1000) / double(numLocs / 1000);
+        coordsSerial[iLoc*numDims+2] = -1000.0 + double(iLoc % 17);
+    } // for
+    std::vector<double> coordsParallel(coordsSerial);
+
+    converter.setNumThreads(1);
+    converter.convert(&coordsSerial[0], numLocs, numDims, &csDest, &csSrc);
+    converter.setNumThreads(4);
+    converter.convert(&coordsParallel[0], numLocs, numDims, &csDest, &csSrc);
+
+    // Parallel conversion is bit-identical to serial conversion.
+    size_t numDifferent = 0;
+    for (size_t i = 0; i < numLocs*numDims; ++i) {
+        numDifferent += (coordsSerial[i] != coordsParallel[i]) ? 1 : 0;
+    } // for
+    CHECK(0 == numDifferent);
+} // testThreads
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Constructor
 spatialdata::geocoords::TestConverter_Data::TestConverter_Data(void) :
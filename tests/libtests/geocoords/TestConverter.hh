@@ -38,6 +38,14 @@ public:
     /// Test convert().
     void testConvert(void);
 
+    /// Test caching of PROJ transformations.
+    static
+    void testCache(void);
+
+    /// Test setNumThreads() and parallel conversion.
+    static
+    void testThreads(void);
+
     // PROTECTED MEMBERS //////////////////////////////////////////////////////////////////////////
 protected:
 
@@ -0,0 +1,98 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "Benchmark.hh" // USES Benchmark
+
+#include "spatialdata/geocoords/Converter.hh" // USES Converter
+#include "spatialdata/geocoords/CSGeo.hh" // USES CSGeo
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <sstream> // USES std::ostringstream
+#include <vector> // USES std::vector
+
+#if defined(_OPENMP)
+#include <omp.h> // USES omp_get_max_threads()
+#endif
+
+// ------------------------------------------------------------------------------------------------
+namespace spatialdata {
+    namespace geocoords {
+        class TestConverter_Benchmark;
+    } // geocoords
+} // spatialdata
+
+// ------------------------------------------------------------------------------------------------
+class spatialdata::geocoords::TestConverter_Benchmark {
+public:
+
+    /** Benchmark conversion of geographic coordinates to UTM coordinates.
+     *
+     * @param numLocs Number of locations.
+     */
+    static
+    void benchmarkThreads(const size_t numLocs);
+
+}; // TestConverter_Benchmark
+
+// ------------------------------------------------------------------------------------------------
+// Benchmarks are hidden; run them with `libtest_geocoords "[benchmark]"`.
+TEST_CASE("TestConverter::benchmarkThreads::1000000", "[TestConverter][benchmark][.]") {
+    spatialdata::geocoords::TestConverter_Benchmark::benchmarkThreads(1000000);
+}
+TEST_CASE("TestConverter::benchmarkThreads::10000000", "[TestConverter][benchmark][.]") {
+    spatialdata::geocoords::TestConverter_Benchmark::benchmarkThreads(10000000);
+}
+
+// ------------------------------------------------------------------------------------------------
+void
+spatialdata::geocoords::TestConverter_Benchmark::benchmarkThreads(const size_t numLocs) {
+    CSGeo csSrc;
+    csSrc.setString("EPSG:4326"); // WGS84
+    CSGeo csDest;
+    csDest.setString("EPSG:32611"); // WGS84 UTM Zone 11N
+
+    const size_t numDims = 3;
+    std::vector<double> coordsOrig(numLocs*numDims);
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        coordsOrig[iLoc*numDims+0] = 33.0 + 2.0*double(iLoc % 1000) / 1000.0;
+        coordsOrig[iLoc*numDims+1] = -118.0 + 2.0*double(iLoc / 1000) / double(numLocs / 1000);
+        coordsOrig[iLoc*numDims+2] = -1000.0;
+    } // for
+
+#if defined(_OPENMP)
+    const size_t maxThreads = size_t(omp_get_max_threads());
+#else
+    const size_t maxThreads = 1;
+#endif
+    std::vector<double> coords(numLocs*numDims);
+    for (size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        Converter converter;
+        converter.setNumThreads(numThreads);
+
+        // Create transformations before timing.
+        coords = coordsOrig;
+        converter.convert(&coords[0], numLocs, numDims, &csDest, &csSrc);
+
+        coords = coordsOrig;
+        const testing::Benchmark::Stopwatch stopwatch;
+        converter.convert(&coords[0], numLocs, numDims, &csDest, &csSrc);
+        const double seconds = stopwatch.seconds();
+
+        std::ostringstream label;
+        label << "Converter (" << numThreads << " threads)";
+        testing::Benchmark::reportRate(label.str().c_str(), double(numLocs), "points", seconds);
+    } // for
+} // benchmarkThreads
+
+
+// End of file
@@ -52,6 +52,12 @@ public:
 TEST_CASE("TestConverter::testConstructor", "[TestConverter]") {
     spatialdata::geocoords::TestConverter::testConstructor();
 }
+TEST_CASE("TestConverter::testCache", "[TestConverter]") {
+    spatialdata::geocoords::TestConverter::testCache();
+}
+TEST_CASE("TestConverter::testThreads", "[TestConverter]") {
+    spatialdata::geocoords::TestConverter::testThreads();
+}
 
 TEST_CASE("TestConverter::NAD27ToWGS84", "[TestConverter]") {
     spatialdata::geocoords::TestConverter(spatialdata::geocoords::TestConverter_Cases::NAD27ToWGS84()).testConvert();
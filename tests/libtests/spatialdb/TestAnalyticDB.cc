@@ -12,6 +12,8 @@
 
 #include "spatialdata/spatialdb/AnalyticDB.hh" // Test subject
 
+#include "spatialdata/spatialdb/QueryContext.hh" // USES QueryContext
+
 #include "spatialdata/geocoords/CSCart.hh" // USES CSCart
 #include "spatialdata/geocoords/CSGeo.hh" // USES CSGeo
 
@@ -19,6 +21,7 @@
 #include "catch2/matchers/catch_matchers_floating_point.hpp"
 
 #include <cmath> // USES fabs()
+#include <vector> // USES std::vector
 
 // ------------------------------------------------------------------------------------------------
 namespace spatialdata {
@@ -59,6 +62,10 @@ public:
     static
     void testQueryUTM(void);
 
+    /// Test multiquery().
+    static
+    void testMultiquery(void);
+
 }; // class TestAnalyticDB
 
 // ------------------------------------------------------------------------------------------------
@@ -83,6 +90,9 @@ TEST_CASE("TestAnalyticDB::testQuery", "[TestAnalyticDB]") {
 TEST_CASE("TestAnalyticDB::testQueryUTM", "[TestAnalyticDB]") {
     spatialdata::spatialdb::TestAnalyticDB::testQueryUTM();
 }
+TEST_CASE("TestAnalyticDB::testMultiquery", "[TestAnalyticDB]") {
+    spatialdata::spatialdb::TestAnalyticDB::testMultiquery();
+}
 
 // ----------------------------------------------------------------------
 // Test constructor.
@@ -275,4 +285,85 @@ spatialdata::spatialdb::TestAnalyticDB::testQueryUTM(void) {
 } // testQueryUTM
 
 
+// ----------------------------------------------------------------------
+// Test multiquery().
+void
+spatialdata::spatialdb::TestAnalyticDB::testMultiquery(void) {
+    AnalyticDB db;
+
+    // Expressions "six" and "seven" exercise functions, comparisons, and branches.
+    const size_t numValues = 7;
+    const char* names[numValues] = { "one", "two", "three", "four", "five", "six", "seven" };
+    const char* units[numValues] = { "none", "km", "cm", "m/s", "none", "m", "none" };
+    const char* expressions[numValues] = {
+        "x^2 + y^2", "x/z", "x + y + z", "2.0*z", "3.5",
+        "sqrt(x^2 + y^2)*exp(z/1000.0) + (z < -1000.0)",
+        "z < -2000.0 ? 1.0 : min(x, y)",
+    };
+    db.setData(names, units, expressions, numValues);
+
+    const size_t querySize = 6;
+    const char* queryNames[querySize] = { "three", "five", "one", "six", "four", "seven" };
+    db.setQueryValues(queryNames, querySize);
+
+    // Query points in kilometers, so they must be converted. Use more locations than
+    // one block, with a partial last block.
+    const size_t spaceDim = 3;
+    spatialdata::geocoords::CSCart cs;
+    cs.setSpaceDim(spaceDim);
+    cs.setToMeters(1.0e+3);
+
+    const size_t numLocs = 1000;
+    std::vector<double> coords(numLocs*spaceDim);
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        coords[iLoc*spaceDim+0] = -10.0 + 0.02 * double(iLoc);
+        coords[iLoc*spaceDim+1] = 4.0 - 0.01 * double(iLoc % 37);
+        coords[iLoc*spaceDim+2] = -0.5 - 0.03 * double(iLoc % 101);
+    } // for
+
+    // Expected values from single queries.
+    std::vector<double> valsE(numLocs*querySize);
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        const int err = db.query(&valsE[iLoc*querySize], querySize, &coords[iLoc*spaceDim], spaceDim, &cs);
+        REQUIRE(0 == err);
+    } // for
+
+    for (size_t numThreads = 1; numThreads <= 2; ++numThreads) {
+        INFO("numThreads=" << numThreads);
+        db.setNumThreads(numThreads);
+        std::vector<double> vals(numLocs*querySize);
+        std::vector<int> err(numLocs, 1);
+        db.multiquery(&vals[0], numLocs, querySize, &err[0], numLocs, &coords[0], numLocs, spaceDim, &cs);
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            CHECK(0 == err[iLoc]);
+            for (size_t i = 0; i < querySize; ++i) {
+                CHECK(valsE[iLoc*querySize+i] == vals[iLoc*querySize+i]);
+            } // for
+        } // for
+    } // for
+
+    { // Query context
+        std::vector<double> vals(numLocs*querySize);
+        std::vector<int> err(numLocs, 1);
+        QueryContext* context = db.createQueryContext();assert(context);
+        context->multiquery(&vals[0], numLocs, querySize, &err[0], numLocs, &coords[0], numLocs, spaceDim, &cs);
+        delete context;context = NULL;
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            CHECK(0 == err[iLoc]);
+            for (size_t i = 0; i < querySize; ++i) {
+                CHECK(valsE[iLoc*querySize+i] == vals[iLoc*querySize+i]);
+            } // for
+        } // for
+    } // Query context
+
+    // Single queries after multiquery() use the first value of each variable.
+    double vals[querySize];
+    const size_t iLoc = numLocs / 2;
+    db.query(vals, querySize, &coords[iLoc*spaceDim], spaceDim, &cs);
+    for (size_t i = 0; i < querySize; ++i) {
+        CHECK(valsE[iLoc*querySize+i] == vals[i]);
+    } // for
+} // testMultiquery
+
+
 // End of file
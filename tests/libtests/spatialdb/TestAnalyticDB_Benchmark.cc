@@ -0,0 +1,135 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "Benchmark.hh" // USES Benchmark
+
+#include "spatialdata/muparser/muParser.h" // USES mu::Parser
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <string> // USES std::string
+#include <vector> // USES std::vector
+
+// ------------------------------------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        class TestAnalyticDB_Benchmark;
+    } // spatialdb
+} // spatialdata
+
+// ------------------------------------------------------------------------------------------------
+class spatialdata::spatialdb::TestAnalyticDB_Benchmark {
+public:
+
+    /** Benchmark evaluating an expression one point at a time versus in blocks of points, as in
+     * AnalyticDB::query() and AnalyticDB::multiquery().
+     *
+     * @param expression Expression in x, y, and z.
+     */
+    static
+    void benchmarkEval(const char* expression);
+
+private:
+
+    static const size_t _blockSize; ///< Number of points in each block (same as AnalyticDB).
+    static const size_t _numLocs; ///< Number of points.
+    static const size_t _numRepeat; ///< Number of times to evaluate expression at all points.
+
+}; // TestAnalyticDB_Benchmark
+const size_t spatialdata::spatialdb::TestAnalyticDB_Benchmark::_blockSize = 256;
+const size_t spatialdata::spatialdb::TestAnalyticDB_Benchmark::_numLocs = 100*256;
+const size_t spatialdata::spatialdb::TestAnalyticDB_Benchmark::_numRepeat = 200;
+
+// ------------------------------------------------------------------------------------------------
+// Benchmarks are hidden; run them with `libtest_spatialdb "[benchmark]"`.
+TEST_CASE("TestAnalyticDB::benchmarkEval::linear", "[TestAnalyticDB][benchmark][.]") {
+    spatialdata::spatialdb::TestAnalyticDB_Benchmark::benchmarkEval("6000.0 - 0.05*z");
+}
+TEST_CASE("TestAnalyticDB::benchmarkEval::linear_xz", "[TestAnalyticDB][benchmark][.]") {
+    spatialdata::spatialdb::TestAnalyticDB_Benchmark::benchmarkEval("3464.0 - 0.03*z + 0.001*x");
+}
+TEST_CASE("TestAnalyticDB::benchmarkEval::quadratic", "[TestAnalyticDB][benchmark][.]") {
+    spatialdata::spatialdb::TestAnalyticDB_Benchmark::benchmarkEval("2700.0 + 0.0001*z*z - 0.02*z");
+}
+TEST_CASE("TestAnalyticDB::benchmarkEval::exponential", "[TestAnalyticDB][benchmark][.]") {
+    spatialdata::spatialdb::TestAnalyticDB_Benchmark::benchmarkEval("1500.0 + 4500.0*(1.0 - exp(z/2000.0))");
+}
+TEST_CASE("TestAnalyticDB::benchmarkEval::conditional", "[TestAnalyticDB][benchmark][.]") {
+    spatialdata::spatialdb::TestAnalyticDB_Benchmark::benchmarkEval("z > -1000.0 ? 2500.0 : 6000.0 - 0.05*z");
+}
+
+// ------------------------------------------------------------------------------------------------
+void
+spatialdata::spatialdb::TestAnalyticDB_Benchmark::benchmarkEval(const char* expression) {
+    std::vector<double> x(_numLocs);
+    std::vector<double> y(_numLocs);
+    std::vector<double> z(_numLocs);
+    for (size_t iLoc = 0; iLoc < _numLocs; ++iLoc) {
+        x[iLoc] = 100.0 * double(iLoc % 101) - 5000.0;
+        y[iLoc] = 200.0 * double(iLoc % 37) - 3000.0;
+        z[iLoc] = -10.0 * double(iLoc % 1009);
+    } // for
+
+    // Reference: evaluate one point at a time.
+    double xyz[3];
+    mu::Parser parserRef;
+    parserRef.DefineVar("x", &xyz[0]);
+    parserRef.DefineVar("y", &xyz[1]);
+    parserRef.DefineVar("z", &xyz[2]);
+    parserRef.SetExpr(expression);
+
+    std::vector<double> valuesRef(_numLocs);
+    testing::Benchmark::Stopwatch stopwatch;
+    for (size_t iRepeat = 0; iRepeat < _numRepeat; ++iRepeat) {
+        for (size_t iLoc = 0; iLoc < _numLocs; ++iLoc) {
+            xyz[0] = x[iLoc];
+            xyz[1] = y[iLoc];
+            xyz[2] = z[iLoc];
+            valuesRef[iLoc] = parserRef.Eval();
+        } // for
+    } // for
+    const double secondsRef = stopwatch.seconds();
+
+    // Evaluate blocks of points stored as separate arrays of x, y, and z.
+    std::vector<double> xyzBlock(3*_blockSize);
+    mu::Parser parser;
+    parser.DefineVar("x", &xyzBlock[0*_blockSize]);
+    parser.DefineVar("y", &xyzBlock[1*_blockSize]);
+    parser.DefineVar("z", &xyzBlock[2*_blockSize]);
+    parser.SetExpr(expression);
+
+    std::vector<double> values(_numLocs);
+    stopwatch.restart();
+    for (size_t iRepeat = 0; iRepeat < _numRepeat; ++iRepeat) {
+        for (size_t iLoc = 0; iLoc < _numLocs; iLoc += _blockSize) {
+            for (size_t i = 0; i < _blockSize; ++i) {
+                xyzBlock[0*_blockSize+i] = x[iLoc+i];
+                xyzBlock[1*_blockSize+i] = y[iLoc+i];
+                xyzBlock[2*_blockSize+i] = z[iLoc+i];
+            } // for
+            parser.Eval(&values[iLoc], int(_blockSize));
+        } // for
+    } // for
+    const double seconds = stopwatch.seconds();
+
+    // Both evaluate the same operations in the same order, so the values should be identical.
+    for (size_t iLoc = 0; iLoc < _numLocs; ++iLoc) {
+        REQUIRE(valuesRef[iLoc] == values[iLoc]);
+    } // for
+
+    const std::string label = std::string("'") + expression + "'";
+    testing::Benchmark::reportSpeedup(label.c_str(), "single points", "blocks",
+                                      double(_numLocs * _numRepeat), secondsRef, seconds);
+} // benchmarkEval
+
+
+// End of file
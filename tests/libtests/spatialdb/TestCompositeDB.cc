@@ -13,12 +13,15 @@
 #include "spatialdata/spatialdb/CompositeDB.hh" // USES CompositeDB
 
 #include "spatialdata/spatialdb/UniformDB.hh" // USES UniformDB
+#include "spatialdata/spatialdb/SimpleGridDB.hh" // USES SimpleGridDB
+#include "spatialdata/spatialdb/QueryContext.hh" // USES QueryContext
 #include "spatialdata/geocoords/CSCart.hh" // USES CSCart
 
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/matchers/catch_matchers_floating_point.hpp"
 
 #include <cmath> // USES fabs()
+#include <vector> // USES std::vector
 
 // ------------------------------------------------------------------------------------------------
 namespace spatialdata {
@@ -62,6 +65,15 @@ public:
     /// Test query() with values in dbB.
     void testQueryB(void);
 
+    /// Test query() using query context.
+    void testQueryContext(void);
+
+    /// Test multiquery().
+    void testMultiquery(void);
+
+    /// Test query() and multiquery() with more than two databases.
+    void testMultipleDBs(void);
+
 private:
 
     UniformDB _dbA; ///< Spatial database A.
@@ -97,6 +109,15 @@ TEST_CASE("TestCompositeDB::testQueryA", "[TestCompositeDB]") {
 TEST_CASE("TestCompositeDB::testQueryB", "[TestCompositeDB]") {
     spatialdata::spatialdb::TestCompositeDB().testQueryB();
 }
+TEST_CASE("TestCompositeDB::testQueryContext", "[TestCompositeDB]") {
+    spatialdata::spatialdb::TestCompositeDB().testQueryContext();
+}
+TEST_CASE("TestCompositeDB::testMultiquery", "[TestCompositeDB]") {
+    spatialdata::spatialdb::TestCompositeDB().testMultiquery();
+}
+TEST_CASE("TestCompositeDB::testMultipleDBs", "[TestCompositeDB]") {
+    spatialdata::spatialdb::TestCompositeDB().testMultipleDBs();
+}
 
 // ------------------------------------------------------------------------------------------------
 spatialdata::spatialdb::TestCompositeDB::TestCompositeDB(void) {
@@ -146,32 +167,33 @@ spatialdata::spatialdb::TestCompositeDB::testAccessors(void) {
     const char* namesA[2] = { "three", "one" };
     db.setDBA(&_dbA, namesA, numNamesA);
 
-    CHECK(db._dbA);
-    CHECK(db._infoA);
-    CHECK(!db._infoA->query_buffer);
-    CHECK(!db._infoA->query_indices);
-    CHECK(!db._infoA->query_size);
-    REQUIRE(numNamesA == db._infoA->num_names);
+    REQUIRE(db._infos.size() > 0);
+    REQUIRE(db._infos[0]);
+    CHECK(&_dbA == db._infos[0]->db);
+    CHECK(!db._infos[0]->query_buffer);
+    CHECK(!db._infos[0]->query_indices);
+    CHECK(!db._infos[0]->query_size);
+    REQUIRE(numNamesA == db._infos[0]->num_names);
     for (size_t i = 0; i < numNamesA; ++i) {
-        CHECK(std::string(namesA[i]) == db._infoA->names_values[i]);
+        CHECK(std::string(namesA[i]) == db._infos[0]->names_values[i]);
     } // for
 
-    CHECK(!db._dbB);
-    CHECK(!db._infoB);
+    CHECK(1 == db.getNumDBs());
 
     // Set database B
     const size_t numNamesB = 1;
     const char* namesB[1] = { "five" };
     db.setDBB(&_dbB, namesB, numNamesB);
 
-    CHECK(db._dbB);
-    CHECK(db._infoB);
-    CHECK(!db._infoB->query_buffer);
-    CHECK(!db._infoB->query_indices);
-    CHECK(!db._infoB->query_size);
-    REQUIRE(numNamesB == db._infoB->num_names);
+    REQUIRE(db._infos.size() > 1);
+    REQUIRE(db._infos[1]);
+    CHECK(&_dbB == db._infos[1]->db);
+    CHECK(!db._infos[1]->query_buffer);
+    CHECK(!db._infos[1]->query_indices);
+    CHECK(!db._infos[1]->query_size);
+    REQUIRE(numNamesB == db._infos[1]->num_names);
     for (size_t i = 0; i < numNamesB; ++i) {
-        CHECK(std::string(namesB[i]) == db._infoB->names_values[i]);
+        CHECK(std::string(namesB[i]) == db._infos[1]->names_values[i]);
     } // for
 } // testAccessors
 
@@ -229,24 +251,26 @@ spatialdata::spatialdb::TestCompositeDB::testQueryValsAB(void) {
     { // Check defaults (all values in A and then all values in B).
         const size_t qsizeA = 2;
         const size_t qindicesA[qsizeA] = { 0, 1 };
-        CHECK(db._dbA);
-        CHECK(db._infoA);
-        CHECK(db._infoA->query_buffer);
-        CHECK(db._infoA->query_indices);
-        REQUIRE(qsizeA == db._infoA->query_size);
+        REQUIRE(db._infos.size() > 0);
+        REQUIRE(db._infos[0]);
+        CHECK(&_dbA == db._infos[0]->db);
+        CHECK(db._infos[0]->query_buffer);
+        CHECK(db._infos[0]->query_indices);
+        REQUIRE(qsizeA == db._infos[0]->query_size);
         for (size_t i = 0; i < qsizeA; ++i) {
-            CHECK(qindicesA[i] == db._infoA->query_indices[i]);
+            CHECK(qindicesA[i] == db._infos[0]->query_indices[i]);
         } // for
 
         const size_t qsizeB = 1;
         const size_t qindicesB[1] = { 2 };
-        CHECK(db._dbB);
-        CHECK(db._infoB);
-        CHECK(db._infoB->query_buffer);
-        CHECK(db._infoB->query_indices);
-        REQUIRE(qsizeB == db._infoB->query_size);
+        REQUIRE(db._infos.size() > 1);
+        REQUIRE(db._infos[1]);
+        CHECK(&_dbB == db._infos[1]->db);
+        CHECK(db._infos[1]->query_buffer);
+        CHECK(db._infos[1]->query_indices);
+        REQUIRE(qsizeB == db._infos[1]->query_size);
         for (size_t i = 0; i < qsizeB; ++i) {
-            CHECK(qindicesB[i] == db._infoB->query_indices[i]);
+            CHECK(qindicesB[i] == db._infos[1]->query_indices[i]);
         } // for
     } // check defaults
 
@@ -255,24 +279,26 @@ spatialdata::spatialdb::TestCompositeDB::testQueryValsAB(void) {
 
     const size_t qsizeA = 2;
     const size_t qindicesA[2] = { 0, 2 };
-    CHECK(db._dbA);
-    CHECK(db._infoA);
-    CHECK(db._infoA->query_buffer);
-    CHECK(db._infoA->query_indices);
-    REQUIRE(qsizeA == db._infoA->query_size);
+    REQUIRE(db._infos.size() > 0);
+    REQUIRE(db._infos[0]);
+    CHECK(&_dbA == db._infos[0]->db);
+    CHECK(db._infos[0]->query_buffer);
+    CHECK(db._infos[0]->query_indices);
+    REQUIRE(qsizeA == db._infos[0]->query_size);
     for (size_t i = 0; i < qsizeA; ++i) {
-        CHECK(qindicesA[i] == db._infoA->query_indices[i]);
+        CHECK(qindicesA[i] == db._infos[0]->query_indices[i]);
     } // for
 
     const size_t qsizeB = 1;
     const size_t qindicesB[1] = { 1 };
-    CHECK(db._dbB);
-    CHECK(db._infoB);
-    CHECK(db._infoB->query_buffer);
-    CHECK(db._infoB->query_indices);
-    REQUIRE(qsizeB == db._infoB->query_size);
+    REQUIRE(db._infos.size() > 1);
+    REQUIRE(db._infos[1]);
+    CHECK(&_dbB == db._infos[1]->db);
+    CHECK(db._infos[1]->query_buffer);
+    CHECK(db._infos[1]->query_indices);
+    REQUIRE(qsizeB == db._infos[1]->query_size);
     for (size_t i = 0; i < qsizeB; ++i) {
-        CHECK(qindicesB[i] == db._infoB->query_indices[i]);
+        CHECK(qindicesB[i] == db._infos[1]->query_indices[i]);
     } // for
 } // testQueryValsAB
 
@@ -300,21 +326,23 @@ spatialdata::spatialdb::TestCompositeDB::testQueryValsA(void) {
 
     const size_t qsizeA = 2;
     const size_t qindicesA[2] = { 0, 1 };
-    CHECK(db._dbA);
-    CHECK(db._infoA);
-    CHECK(db._infoA->query_buffer);
-    CHECK(db._infoA->query_indices);
-    REQUIRE(qsizeA == db._infoA->query_size);
+    REQUIRE(db._infos.size() > 0);
+    REQUIRE(db._infos[0]);
+    CHECK(&_dbA == db._infos[0]->db);
+    CHECK(db._infos[0]->query_buffer);
+    CHECK(db._infos[0]->query_indices);
+    REQUIRE(qsizeA == db._infos[0]->query_size);
     for (size_t i = 0; i < qsizeA; ++i) {
-        CHECK(qindicesA[i] == db._infoA->query_indices[i]);
+        CHECK(qindicesA[i] == db._infos[0]->query_indices[i]);
     } // for
 
     const size_t qsizeB = 0;
-    CHECK(db._dbB);
-    CHECK(db._infoB);
-    CHECK(!db._infoB->query_buffer);
-    CHECK(!db._infoB->query_indices);
-    CHECK(qsizeB == db._infoB->query_size);
+    REQUIRE(db._infos.size() > 1);
+    REQUIRE(db._infos[1]);
+    CHECK(&_dbB == db._infos[1]->db);
+    CHECK(!db._infos[1]->query_buffer);
+    CHECK(!db._infos[1]->query_indices);
+    CHECK(qsizeB == db._infos[1]->query_size);
 } // testQueryValsA
 
 
@@ -340,21 +368,23 @@ spatialdata::spatialdb::TestCompositeDB::testQueryValsB(void) {
     db.close();
 
     const size_t qsizeA = 0;
-    CHECK(db._dbA);
-    CHECK(db._infoA);
-    CHECK(!db._infoA->query_buffer);
-    CHECK(!db._infoA->query_indices);
-    REQUIRE(qsizeA == db._infoA->query_size);
+    REQUIRE(db._infos.size() > 0);
+    REQUIRE(db._infos[0]);
+    CHECK(&_dbA == db._infos[0]->db);
+    CHECK(!db._infos[0]->query_buffer);
+    CHECK(!db._infos[0]->query_indices);
+    REQUIRE(qsizeA == db._infos[0]->query_size);
 
     const size_t qsizeB = 1;
     const size_t qindicesB[1] = { 0 };
-    CHECK(db._dbB);
-    CHECK(db._infoB);
-    CHECK(db._infoB->query_buffer);
-    CHECK(db._infoB->query_indices);
-    REQUIRE(qsizeB == db._infoB->query_size);
+    REQUIRE(db._infos.size() > 1);
+    REQUIRE(db._infos[1]);
+    CHECK(&_dbB == db._infos[1]->db);
+    CHECK(db._infos[1]->query_buffer);
+    CHECK(db._infos[1]->query_indices);
+    REQUIRE(qsizeB == db._infos[1]->query_size);
     for (size_t i = 0; i < qsizeB; ++i) {
-        CHECK(qindicesB[i] == db._infoB->query_indices[i]);
+        CHECK(qindicesB[i] == db._infos[1]->query_indices[i]);
     } // for
 } // testQueryValsB
 
@@ -470,4 +500,243 @@ spatialdata::spatialdb::TestCompositeDB::testQueryB(void) {
 } // testQueryB
 
 
+// ----------------------------------------------------------------------
+// Test query() using query context.
+void
+spatialdata::spatialdb::TestCompositeDB::testQueryContext(void) {
+    CompositeDB db;
+
+    const size_t numNamesA = 2;
+    const char* namesA[2] = { "three", "one" };
+    db.setDBA(&_dbA, namesA, numNamesA);
+
+    const size_t numNamesB = 1;
+    const char* namesB[1] = { "five" };
+    db.setDBB(&_dbB, namesB, numNamesB);
+
+    const size_t querySize = 3;
+    const char* queryVals[3] = { "five", "one", "three" };
+
+    const size_t spaceDim = 2;
+    spatialdata::geocoords::CSCart cs;
+    cs.setSpaceDim(spaceDim);
+    const double coords[2] = { 2.3, 5.6 };
+    double data[querySize];
+    const double valsE[3] = { 5.5, 1.1, 3.3 };
+
+    db.open();
+    db.setQueryValues(queryVals, querySize);
+    QueryContext* context = db.createQueryContext();assert(context);
+    const int err = context->query(data, querySize, coords, spaceDim, &cs);
+    delete context;context = NULL;
+    db.close();
+
+    CHECK(0 == err);
+    const double tolerance = 1.0e-6;
+    for (size_t i = 0; i < querySize; ++i) {
+        const double toleranceV = fabs(valsE[i]) > 0.0 ? tolerance*valsE[i] : tolerance;
+        CHECK_THAT(data[i], Catch::Matchers::WithinAbs(valsE[i], toleranceV));
+    } // for
+} // testQueryContext
+
+
+// ----------------------------------------------------------------------
+// Test multiquery().
+void
+spatialdata::spatialdb::TestCompositeDB::testMultiquery(void) {
+    CompositeDB db;
+
+    const size_t numNamesA = 2;
+    const char* namesA[2] = { "three", "one" };
+    db.setDBA(&_dbA, namesA, numNamesA);
+
+    // Database B covers only part of the domain, so some queries fail.
+    SimpleGridDB dbB;
+    dbB.setFilename("data/grid_area2d.spatialdb");
+    dbB.setQueryType(SimpleGridDB::LINEAR);
+    const size_t numNamesB = 1;
+    const char* namesB[1] = { "two" };
+    db.setDBB(&dbB, namesB, numNamesB);
+
+    const size_t querySize = 3;
+    const char* queryVals[3] = { "two", "one", "three" };
+
+    const size_t spaceDim = 2;
+    spatialdata::geocoords::CSCart cs;
+    cs.setSpaceDim(spaceDim);
+
+    const size_t numLocs = 500;
+    std::vector<double> coords(numLocs*spaceDim);
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        coords[iLoc*spaceDim+0] = -4.0 + 7.0 * double(iLoc % 25) / 24.0;
+        coords[iLoc*spaceDim+1] = 1.5 + 3.0 * double(iLoc / 25) / double(numLocs / 25 - 1);
+    } // for
+
+    db.open();
+    db.setQueryValues(queryVals, querySize);
+
+    // Expected values from single queries.
+    std::vector<double> valsE(numLocs*querySize);
+    std::vector<int> errE(numLocs);
+    size_t numErrors = 0;
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        errE[iLoc] = db.query(&valsE[iLoc*querySize], querySize, &coords[iLoc*spaceDim], spaceDim, &cs);
+        numErrors += errE[iLoc] ? 1 : 0;
+    } // for
+    CHECK(numErrors > 0);
+    CHECK(numErrors < numLocs);
+
+    for (size_t numThreads = 1; numThreads <= 2; ++numThreads) {
+        INFO("numThreads=" << numThreads);
+        db.setNumThreads(numThreads);
+        std::vector<double> vals(numLocs*querySize);
+        std::vector<int> err(numLocs);
+        db.multiquery(&vals[0], numLocs, querySize, &err[0], numLocs, &coords[0], numLocs, spaceDim, &cs);
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            CHECK(errE[iLoc] == err[iLoc]);
+            if (!errE[iLoc]) {
+                for (size_t i = 0; i < querySize; ++i) {
+                    CHECK(valsE[iLoc*querySize+i] == vals[iLoc*querySize+i]);
+                } // for
+            } // if
+        } // for
+    } // for
+
+    { // Query context
+        std::vector<double> vals(numLocs*querySize);
+        std::vector<int> err(numLocs);
+        QueryContext* context = db.createQueryContext();assert(context);
+        context->multiquery(&vals[0], numLocs, querySize, &err[0], numLocs, &coords[0], numLocs, spaceDim, &cs);
+        delete context;context = NULL;
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            CHECK(errE[iLoc] == err[iLoc]);
+            if (!errE[iLoc]) {
+                for (size_t i = 0; i < querySize; ++i) {
+                    CHECK(valsE[iLoc*querySize+i] == vals[iLoc*querySize+i]);
+                } // for
+            } // if
+        } // for
+    } // Query context
+
+    db.close();
+} // testMultiquery
+
+
+// ----------------------------------------------------------------------
+// Test query() and multiquery() with more than two databases.
+void
+spatialdata::spatialdb::TestCompositeDB::testMultipleDBs(void) {
+    CompositeDB db;
+
+    const char* namesA[1] = { "three" };
+    db.setDBA(&_dbA, namesA, 1);
+
+    SimpleGridDB dbB;
+    dbB.setFilename("data/grid_area2d.spatialdb");
+    dbB.setQueryType(SimpleGridDB::LINEAR);
+    const char* namesB[1] = { "two" };
+    db.setDBB(&dbB, namesB, 1);
+
+    const char* namesC[1] = { "five" };
+    db.addDB(&_dbB, namesC, 1);
+
+    // Database D has the same coordinate system as database B, but it is a different object.
+    SimpleGridDB dbD;
+    dbD.setFilename("data/grid_area2d.spatialdb");
+    dbD.setQueryType(SimpleGridDB::LINEAR);
+    const char* namesD[1] = { "one" };
+    db.addDB(&dbD, namesD, 1);
+    CHECK(4 == db.getNumDBs());
+
+    const size_t querySize = 4;
+    const char* queryVals[4] = { "one", "five", "two", "three" };
+
+    // Query points in millimeters, so they must be converted.
+    const size_t spaceDim = 2;
+    spatialdata::geocoords::CSCart cs;
+    cs.setSpaceDim(spaceDim);
+    cs.setToMeters(1.0e-3);
+
+    const size_t numLocs = 100;
+    std::vector<double> coords(numLocs*spaceDim);
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        coords[iLoc*spaceDim+0] = 1.0e+3 * (-4.0 + 7.0 * double(iLoc % 10) / 9.0);
+        coords[iLoc*spaceDim+1] = 1.0e+3 * (1.5 + 3.0 * double(iLoc / 10) / 9.0);
+    } // for
+
+    db.open();
+    db.setQueryValues(queryVals, querySize);
+
+    // Databases B and D share one coordinate system; databases A and C use query points as given.
+    REQUIRE(1 == db._coordsysDBs.size());
+    CHECK(1 == db._coordsysDBs[0]);
+    CHECK(-1 == db._infos[0]->cs_index);
+    CHECK(0 == db._infos[1]->cs_index);
+    CHECK(-1 == db._infos[2]->cs_index);
+    CHECK(0 == db._infos[3]->cs_index);
+
+    // Expected values from querying each database directly.
+    std::vector<double> valsE(numLocs*querySize);
+    std::vector<int> errE(numLocs);
+    size_t numErrors = 0;
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        double* valsLoc = &valsE[iLoc*querySize];
+        const double* xy = &coords[iLoc*spaceDim];
+        const int errD = dbD.query(&valsLoc[0], 1, xy, spaceDim, &cs);
+        const int errC = _dbB.query(&valsLoc[1], 1, xy, spaceDim, &cs);
+        const int errB = dbB.query(&valsLoc[2], 1, xy, spaceDim, &cs);
+        const int errA = _dbA.query(&valsLoc[3], 1, xy, spaceDim, &cs);
+        errE[iLoc] = errA || errB || errC || errD;
+        numErrors += errE[iLoc] ? 1 : 0;
+    } // for
+    CHECK(numErrors > 0);
+    CHECK(numErrors < numLocs);
+
+    { // query()
+        std::vector<double> vals(querySize);
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            const int err = db.query(&vals[0], querySize, &coords[iLoc*spaceDim], spaceDim, &cs);
+            CHECK(errE[iLoc] == err);
+            if (!errE[iLoc]) {
+                for (size_t i = 0; i < querySize; ++i) {
+                    CHECK(valsE[iLoc*querySize+i] == vals[i]);
+                } // for
+            } // if
+        } // for
+    } // query()
+
+    { // multiquery()
+        std::vector<double> vals(numLocs*querySize);
+        std::vector<int> err(numLocs);
+        db.multiquery(&vals[0], numLocs, querySize, &err[0], numLocs, &coords[0], numLocs, spaceDim, &cs);
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            CHECK(errE[iLoc] == err[iLoc]);
+            if (!errE[iLoc]) {
+                for (size_t i = 0; i < querySize; ++i) {
+                    CHECK(valsE[iLoc*querySize+i] == vals[iLoc*querySize+i]);
+                } // for
+            } // if
+        } // for
+    } // multiquery()
+
+    { // Query context
+        std::vector<double> vals(numLocs*querySize);
+        std::vector<int> err(numLocs);
+        QueryContext* context = db.createQueryContext();assert(context);
+        context->multiquery(&vals[0], numLocs, querySize, &err[0], numLocs, &coords[0], numLocs, spaceDim, &cs);
+        delete context;context = NULL;
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            CHECK(errE[iLoc] == err[iLoc]);
+            if (!errE[iLoc]) {
+                for (size_t i = 0; i < querySize; ++i) {
+                    CHECK(valsE[iLoc*querySize+i] == vals[iLoc*querySize+i]);
+                } // for
+            } // if
+        } // for
+    } // Query context
+
+    db.close();
+} // testMultipleDBs
+
+
 // End of file
@@ -0,0 +1,471 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "spatialdata/spatialdb/GocadVoxet.hh" // USES GocadVoxet
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include <fstream> // USES std::ofstream
+#include <stdexcept> // USES std::runtime_error
+#include <vector> // USES std::vector
+#include <cstring> // USES memcpy()
+
+// ------------------------------------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        class TestGocadVoxet;
+    } // spatialdb
+} // spatialdata
+
+class spatialdata::spatialdb::TestGocadVoxet {
+    // PUBLIC METHODS /////////////////////////////////////////////////////////////////////////////
+public:
+
+    /// Test setUseMemoryMap(), getUseMemoryMap(), setUseBlockedLayout(), and getUseBlockedLayout().
+    static
+    void testAccessors(void);
+
+    /** Test query() and queryNearest() for single and multiple locations.
+     *
+     * @param useMemoryMap True if memory-mapping property file, false otherwise.
+     * @param useBlockedLayout True if storing data in blocks of points, false otherwise.
+     */
+    static
+    void testQuery(const bool useMemoryMap,
+                   const bool useBlockedLayout=false);
+
+    /** Test queryLinear() for single and multiple locations.
+     *
+     * @param useBlockedLayout True if storing data in blocks of points, false otherwise.
+     */
+    static
+    void testQueryLinear(const bool useBlockedLayout=false);
+
+    /** Test query() for points without data.
+     *
+     * @param useMemoryMap True if memory-mapping property file, false otherwise.
+     * @param useBlockedLayout True if storing data in blocks of points, false otherwise.
+     */
+    static
+    void testQueryNoData(const bool useMemoryMap,
+                         const bool useBlockedLayout=false);
+
+    /// Test query() and queryLinear() with data stored in more than one block of points along each axis.
+    static
+    void testQueryMultipleBlocks(void);
+
+    /// Test read() with property file that is too small.
+    static
+    void testReadTruncated(void);
+
+    // PRIVATE METHODS ////////////////////////////////////////////////////////////////////////////
+private:
+
+    /** Write voxet and big-endian property file.
+     *
+     * Points at the bottom of the voxet with ix=1 do not have data. If holes is true, the point at
+     * the top of the (2,1) column and the point with iz=1 in the (0,1) column also do not have data.
+     *
+     * @param numValues Number of values to write to property file.
+     * @param holes If true, include additional points without data.
+     */
+    static
+    void _writeVoxet(const size_t numValues,
+                     const bool holes=false);
+
+    /** Get value at voxet point.
+     *
+     * @param ix Index of point along x axis.
+     * @param iy Index of point along y axis.
+     * @param iz Index of point along z axis.
+     * @returns Value at point.
+     */
+    static
+    float _pointValue(const int ix,
+                      const int iy,
+                      const int iz);
+
+    static const int _numX; ///< Number of points along x axis.
+    static const int _numY; ///< Number of points along y axis.
+    static const int _numZ; ///< Number of points along z axis.
+    static const float _noDataValue; ///< Value for points without data.
+
+}; // class TestGocadVoxet
+const int spatialdata::spatialdb::TestGocadVoxet::_numX = 3;
+const int spatialdata::spatialdb::TestGocadVoxet::_numY = 2;
+const int spatialdata::spatialdb::TestGocadVoxet::_numZ = 4;
+const float spatialdata::spatialdb::TestGocadVoxet::_noDataValue = -99999.0;
+
+// ------------------------------------------------------------------------------------------------
+TEST_CASE("TestGocadVoxet::testAccessors", "[TestGocadVoxet]") {
+    spatialdata::spatialdb::TestGocadVoxet::testAccessors();
+}
+TEST_CASE("TestGocadVoxet::testQuery", "[TestGocadVoxet]") {
+    spatialdata::spatialdb::TestGocadVoxet::testQuery(false);
+}
+TEST_CASE("TestGocadVoxet::testQuery::memoryMap", "[TestGocadVoxet]") {
+    spatialdata::spatialdb::TestGocadVoxet::testQuery(true);
+}
+TEST_CASE("TestGocadVoxet::testQuery::blocked", "[TestGocadVoxet]") {
+    spatialdata::spatialdb::TestGocadVoxet::testQuery(false, true);
+}
+TEST_CASE("TestGocadVoxet::testQuery::blocked::multipleBlocks", "[TestGocadVoxet]") {
+    spatialdata::spatialdb::TestGocadVoxet::testQueryMultipleBlocks();
+}
+TEST_CASE("TestGocadVoxet::testQueryLinear", "[TestGocadVoxet]") {
+    spatialdata::spatialdb::TestGocadVoxet::testQueryLinear();
+}
+TEST_CASE("TestGocadVoxet::testQueryLinear::blocked", "[TestGocadVoxet]") {
+    spatialdata::spatialdb::TestGocadVoxet::testQueryLinear(true);
+}
+TEST_CASE("TestGocadVoxet::testQueryNoData", "[TestGocadVoxet]") {
+    spatialdata::spatialdb::TestGocadVoxet::testQueryNoData(false);
+}
+TEST_CASE("TestGocadVoxet::testQueryNoData::memoryMap", "[TestGocadVoxet]") {
+    spatialdata::spatialdb::TestGocadVoxet::testQueryNoData(true);
+}
+TEST_CASE("TestGocadVoxet::testQueryNoData::blocked", "[TestGocadVoxet]") {
+    spatialdata::spatialdb::TestGocadVoxet::testQueryNoData(false, true);
+}
+TEST_CASE("TestGocadVoxet::testReadTruncated", "[TestGocadVoxet]") {
+    spatialdata::spatialdb::TestGocadVoxet::testReadTruncated();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Test setUseMemoryMap(), getUseMemoryMap(), setUseBlockedLayout(), and getUseBlockedLayout().
+void
+spatialdata::spatialdb::TestGocadVoxet::testAccessors(void) {
+    GocadVoxet voxet;
+    CHECK(false == voxet.getUseMemoryMap());
+
+    voxet.setUseMemoryMap(true);
+    CHECK(true == voxet.getUseMemoryMap());
+
+    voxet.setUseMemoryMap(false);
+    CHECK(false == voxet.getUseMemoryMap());
+
+    CHECK(false == voxet.getUseBlockedLayout());
+
+    voxet.setUseBlockedLayout(true);
+    CHECK(true == voxet.getUseBlockedLayout());
+
+    voxet.setUseBlockedLayout(false);
+    CHECK(false == voxet.getUseBlockedLayout());
+} // testAccessors
+
+
+// ------------------------------------------------------------------------------------------------
+// Test query() and queryNearest() for single and multiple locations.
+void
+spatialdata::spatialdb::TestGocadVoxet::testQuery(const bool useMemoryMap,
+                                                  const bool useBlockedLayout) {
+    _writeVoxet(_numX*_numY*_numZ);
+
+    GocadVoxet voxet;
+    voxet.setUseMemoryMap(useMemoryMap);
+    voxet.setUseBlockedLayout(useBlockedLayout);
+    voxet.read("data", "voxet.vo", "\"vp\"");
+
+    // Points are spaced 100 m apart starting at (1000, 2000, -300).
+    for (int iz = 1; iz < _numZ; ++iz) {
+        for (int iy = 0; iy < _numY; ++iy) {
+            for (int ix = 0; ix < _numX; ++ix) {
+                const double xyz[3] = { 1000.0 + 100.0*ix + 20.0, 2000.0 + 100.0*iy - 20.0, -300.0 + 100.0*iz + 10.0 };
+                double value = 0.0;
+                INFO("ix=" << ix << ", iy=" << iy << ", iz=" << iz);
+                CHECK(0 == voxet.query(&value, xyz));
+                CHECK(double(_pointValue(ix, iy, iz)) == value);
+                CHECK(0 == voxet.queryNearest(&value, xyz));
+                CHECK(double(_pointValue(ix, iy, iz)) == value);
+            } // for
+        } // for
+    } // for
+
+    { // Point without data uses value at next point along z axis.
+        const double xyz[3] = { 1100.0, 2000.0, -300.0 };
+        double value = 0.0;
+        CHECK(0 == voxet.query(&value, xyz));
+        CHECK(double(_pointValue(1, 0, 1)) == value);
+    } // Point without data
+
+    { // Point outside voxet
+        const double xyz[3] = { 1500.0, 2000.0, -100.0 };
+        double value = 0.0;
+        CHECK(1 == voxet.query(&value, xyz));
+        CHECK(double(_noDataValue) == value);
+        CHECK(0 == voxet.queryNearest(&value, xyz));
+        CHECK(double(_pointValue(_numX-1, 0, 2)) == value);
+    } // Point outside voxet
+
+    { // Multiple locations, not in storage order
+        const size_t numPts = 5;
+        const double pts[numPts*3] = {
+            1220.0, 2080.0, -10.0,
+            1500.0, 2000.0, -100.0, // outside
+            1000.0, 2000.0, -200.0,
+            1100.0, 2000.0, -300.0, // without data
+            1120.0, 2000.0, -110.0,
+        };
+        std::vector<double> values(numPts);
+        std::vector<int> flags(numPts, -1);
+        std::vector<double> valuesNearest(numPts);
+        std::vector<int> flagsNearest(numPts, -1);
+        voxet.query(&values[0], &flags[0], pts, numPts);
+        voxet.queryNearest(&valuesNearest[0], &flagsNearest[0], pts, numPts);
+        for (size_t iPt = 0; iPt < numPts; ++iPt) {
+            INFO("iPt=" << iPt);
+            double value = 0.0;
+            CHECK(voxet.query(&value, &pts[iPt*3]) == flags[iPt]);
+            CHECK(value == values[iPt]);
+            CHECK(voxet.queryNearest(&value, &pts[iPt*3]) == flagsNearest[iPt]);
+            CHECK(value == valuesNearest[iPt]);
+        } // for
+    } // Multiple locations
+} // testQuery
+
+
+// ------------------------------------------------------------------------------------------------
+// Test queryLinear() for single and multiple locations.
+void
+spatialdata::spatialdb::TestGocadVoxet::testQueryLinear(const bool useBlockedLayout) {
+    _writeVoxet(_numX*_numY*_numZ);
+
+    GocadVoxet voxet;
+    voxet.setUseBlockedLayout(useBlockedLayout);
+    voxet.read("data", "voxet.vo", "\"vp\"");
+
+    const double tolerance = 1.0e-6;
+    const size_t numPts = 4;
+    const double pts[numPts*3] = {
+        1020.0, 2030.0, -180.0, // interior, values are linear in x, y, z
+        1170.0, 2090.0, -15.0, // interior
+        1100.0, 2000.0, -250.0, // between point without data and point above it
+        1220.0, 2110.0, 20.0, // outside, within half of spacing
+    };
+    const double valuesE[numPts] = {
+        1000.0 + 0.2 + 10.0*0.3 + 100.0*1.2,
+        1000.0 + 1.7 + 10.0*0.9 + 100.0*2.85,
+        _pointValue(1, 0, 1),
+        _pointValue(2, 1, 3),
+    };
+    for (size_t iPt = 0; iPt < numPts; ++iPt) {
+        INFO("iPt=" << iPt);
+        double value = 0.0;
+        CHECK(0 == voxet.queryLinear(&value, &pts[iPt*3]));
+        CHECK_THAT(value, Catch::Matchers::WithinRel(valuesE[iPt], tolerance));
+    } // for
+
+    { // Point outside voxet
+        const double xyz[3] = { 1500.0, 2050.0, -100.0 };
+        double value = 0.0;
+        CHECK(1 == voxet.queryLinear(&value, xyz));
+        CHECK(double(_noDataValue) == value);
+
+        // Clamped to voxet.
+        CHECK(0 == voxet.queryLinear(&value, xyz, true));
+        CHECK_THAT(value, Catch::Matchers::WithinRel(1000.0 + 2.0 + 10.0*0.5 + 100.0*2.0, tolerance));
+    } // Point outside voxet
+
+    { // Multiple locations
+        std::vector<double> values(numPts);
+        std::vector<int> flags(numPts, 1);
+        voxet.queryLinear(&values[0], &flags[0], pts, numPts);
+        for (size_t iPt = 0; iPt < numPts; ++iPt) {
+            INFO("iPt=" << iPt);
+            double value = 0.0;
+            voxet.queryLinear(&value, &pts[iPt*3]);
+            CHECK(0 == flags[iPt]);
+            CHECK(value == values[iPt]);
+        } // for
+    } // Multiple locations
+} // testQueryLinear
+
+
+// ------------------------------------------------------------------------------------------------
+// Test query() and queryLinear() with data stored in more than one block of points along each axis.
+void
+spatialdata::spatialdb::TestGocadVoxet::testQueryMultipleBlocks(void) {
+    const int numX = 19;
+    const int numY = 11;
+    const int numZ = 10;
+    const double spacing = 100.0;
+
+    std::ofstream voxetFile("data/voxet_blocks.vo");
+    REQUIRE(voxetFile.is_open());
+    voxetFile
+        << "GOCAD Voxet 1\n"
+        << "AXIS_O 0 0 " << -spacing*(numZ-1) << "\n"
+        << "AXIS_U 1 0 0\n"
+        << "AXIS_V 0 1 0\n"
+        << "AXIS_W 0 0 1\n"
+        << "AXIS_MIN 0 0 0\n"
+        << "AXIS_MAX " << spacing*(numX-1) << " " << spacing*(numY-1) << " " << spacing*(numZ-1) << "\n"
+        << "AXIS_N " << numX << " " << numY << " " << numZ << "\n"
+        << "PROPERTY 1 \"vp\"\n"
+        << "PROP_NO_DATA_VALUE 1 " << _noDataValue << "\n"
+        << "PROP_ESIZE 1 4\n"
+        << "PROP_ETYPE 1 IEEE\n"
+        << "PROP_FILE 1 voxet_blocks_vp@@\n"
+        << "END\n";
+    voxetFile.close();
+
+    std::ofstream propertyFile("data/voxet_blocks_vp@@", std::ios::out | std::ios::binary);
+    REQUIRE(propertyFile.is_open());
+    for (int iz = 0; iz < numZ; ++iz) {
+        for (int iy = 0; iy < numY; ++iy) {
+            for (int ix = 0; ix < numX; ++ix) {
+                const float value = _pointValue(ix, iy, iz);
+                unsigned char bytes[4];
+                memcpy(bytes, &value, 4);
+#if !defined(WORDS_BIGENDIAN)
+                const unsigned char swapped[4] = { bytes[3], bytes[2], bytes[1], bytes[0] };
+                memcpy(bytes, swapped, 4);
+#endif
+                propertyFile.write((const char*) bytes, 4);
+            } // for
+        } // for
+    } // for
+    propertyFile.close();
+
+    GocadVoxet voxet;
+    voxet.setUseBlockedLayout(true);
+    voxet.read("data", "voxet_blocks.vo", "\"vp\"");
+
+    const double tolerance = 1.0e-6;
+    for (int iz = 0; iz < numZ; ++iz) {
+        for (int iy = 0; iy < numY; ++iy) {
+            for (int ix = 0; ix < numX; ++ix) {
+                INFO("ix=" << ix << ", iy=" << iy << ", iz=" << iz);
+                const double xyz[3] = { spacing*ix + 20.0, spacing*iy - 20.0, -spacing*(numZ-1-iz) + 10.0 };
+                double value = 0.0;
+                CHECK(0 == voxet.query(&value, xyz));
+                CHECK(double(_pointValue(ix, iy, iz)) == value);
+
+                // Points inside every cell, including cells spanning blocks.
+                if ((ix+1 < numX) && (iy+1 < numY) && (iz+1 < numZ)) {
+                    const double xyzCell[3] = { spacing*(ix+0.3), spacing*(iy+0.6), -spacing*(numZ-1-iz-0.8) };
+                    const double valueE = 1000.0 + 1.0*(ix+0.3) + 10.0*(iy+0.6) + 100.0*(iz+0.8);
+                    CHECK(0 == voxet.queryLinear(&value, xyzCell));
+                    CHECK_THAT(value, Catch::Matchers::WithinRel(valueE, tolerance));
+                } // if
+            } // for
+        } // for
+    } // for
+} // testQueryMultipleBlocks
+
+
+// ------------------------------------------------------------------------------------------------
+// Test query() for points without data.
+void
+spatialdata::spatialdb::TestGocadVoxet::testQueryNoData(const bool useMemoryMap,
+                                                        const bool useBlockedLayout) {
+    _writeVoxet(_numX*_numY*_numZ, true);
+
+    GocadVoxet voxet;
+    voxet.setUseMemoryMap(useMemoryMap);
+    voxet.setUseBlockedLayout(useBlockedLayout);
+    voxet.read("data", "voxet.vo", "\"vp\"");
+
+    const size_t numPts = 5;
+    const double pts[numPts*3] = {
+        1100.0, 2000.0, -300.0, // bottom, uses point above
+        1100.0, 2100.0, -290.0, // bottom, uses point above
+        1200.0, 2100.0, 0.0, // top, uses point below
+        1000.0, 2100.0, -200.0, // gap in lower half, uses point above
+        1000.0, 2100.0, -300.0, // point with data below gap
+    };
+    const double valuesE[numPts] = {
+        _pointValue(1, 0, 1),
+        _pointValue(1, 1, 1),
+        _pointValue(2, 1, 2),
+        _pointValue(0, 1, 2),
+        _pointValue(0, 1, 0),
+    };
+    for (size_t iPt = 0; iPt < numPts; ++iPt) {
+        INFO("iPt=" << iPt);
+        double value = 0.0;
+        CHECK(0 == voxet.query(&value, &pts[iPt*3]));
+        CHECK(valuesE[iPt] == value);
+    } // for
+} // testQueryNoData
+
+
+// ------------------------------------------------------------------------------------------------
+// Test read() with property file that is too small.
+void
+spatialdata::spatialdb::TestGocadVoxet::testReadTruncated(void) {
+    _writeVoxet(_numX*_numY*_numZ-1);
+
+    GocadVoxet voxet;
+    voxet.setUseMemoryMap(true);
+    CHECK_THROWS_AS(voxet.read("data", "voxet.vo", "\"vp\""), std::runtime_error);
+} // testReadTruncated
+
+
+// ------------------------------------------------------------------------------------------------
+// Write voxet and big-endian property file.
+void
+spatialdata::spatialdb::TestGocadVoxet::_writeVoxet(const size_t numValues,
+                                                    const bool holes) {
+    std::ofstream voxetFile("data/voxet.vo");
+    REQUIRE(voxetFile.is_open());
+    voxetFile
+        << "GOCAD Voxet 1\n"
+        << "AXIS_O 1000 2000 -300\n"
+        << "AXIS_U 1 0 0\n"
+        << "AXIS_V 0 1 0\n"
+        << "AXIS_W 0 0 1\n"
+        << "AXIS_MIN 0 0 0\n"
+        << "AXIS_MAX 200 100 300\n"
+        << "AXIS_N " << _numX << " " << _numY << " " << _numZ << "\n"
+        << "PROPERTY 1 \"vp\"\n"
+        << "PROP_NO_DATA_VALUE 1 " << _noDataValue << "\n"
+        << "PROP_ESIZE 1 4\n"
+        << "PROP_ETYPE 1 IEEE\n"
+        << "PROP_FILE 1 voxet_vp@@\n"
+        << "END\n";
+    voxetFile.close();
+
+    std::ofstream propertyFile("data/voxet_vp@@", std::ios::out | std::ios::binary);
+    REQUIRE(propertyFile.is_open());
+    for (size_t i = 0; i < numValues; ++i) {
+        const int ix = i % _numX;
+        const int iy = (i / _numX) % _numY;
+        const int iz = i / (_numX*_numY);
+        const bool noData = (0 == iz && 1 == ix) ||
+                            (holes && _numZ-1 == iz && 2 == ix && 1 == iy) ||
+                            (holes && 1 == iz && 0 == ix && 1 == iy);
+        const float value = (noData) ? _noDataValue : _pointValue(ix, iy, iz);
+        unsigned char bytes[4];
+        memcpy(bytes, &value, 4);
+#if !defined(WORDS_BIGENDIAN)
+        const unsigned char swapped[4] = { bytes[3], bytes[2], bytes[1], bytes[0] };
+        memcpy(bytes, swapped, 4);
+#endif
+        propertyFile.write((const char*) bytes, 4);
+    } // for
+    propertyFile.close();
+} // _writeVoxet
+
+
+// ------------------------------------------------------------------------------------------------
+// Get value at voxet point.
+float
+spatialdata::spatialdb::TestGocadVoxet::_pointValue(const int ix,
+                                                    const int iy,
+                                                    const int iz) {
+    return 1000.0 + 1.0*ix + 10.0*iy + 100.0*iz;
+} // _pointValue
+
+
+// End of file
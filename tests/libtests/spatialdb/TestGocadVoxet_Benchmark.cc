@@ -0,0 +1,195 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "Benchmark.hh" // USES Benchmark
+
+#include "spatialdata/spatialdb/GocadVoxet.hh" // USES GocadVoxet
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <fstream> // USES std::ofstream
+#include <string> // USES std::string
+#include <utility> // USES std::swap()
+#include <vector> // USES std::vector
+#include <cstring> // USES memcpy()
+#include <cassert>
+
+// ------------------------------------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        class TestGocadVoxet_Benchmark;
+    } // spatialdb
+} // spatialdata
+
+// ------------------------------------------------------------------------------------------------
+class spatialdata::spatialdb::TestGocadVoxet_Benchmark {
+public:
+
+    /** Benchmark querying a large voxet with data stored in file order versus in blocks of points,
+     * with query points in storage order (coherent) and in random order.
+     *
+     * @param useLinear True if using trilinear interpolation, false if using nearest point.
+     */
+    static
+    void benchmarkQuery(const bool useLinear);
+
+private:
+
+    /// Write voxet and big-endian property file.
+    static
+    void _writeVoxet(void);
+
+    /** Query points one at a time.
+     *
+     * @param values Array for values.
+     * @param voxet Voxet.
+     * @param points Coordinates of points.
+     * @param useLinear True if using trilinear interpolation, false if using nearest point.
+     * @returns Time in seconds.
+     */
+    static
+    double _query(std::vector<double>* values,
+                  const GocadVoxet& voxet,
+                  const std::vector<double>& points,
+                  const bool useLinear);
+
+    static const int _numPoints; ///< Number of voxet points along each axis.
+    static const double _spacing; ///< Spacing of voxet points.
+    static const size_t _numQueries; ///< Number of query points.
+
+}; // TestGocadVoxet_Benchmark
+const int spatialdata::spatialdb::TestGocadVoxet_Benchmark::_numPoints = 256;
+const double spatialdata::spatialdb::TestGocadVoxet_Benchmark::_spacing = 100.0;
+const size_t spatialdata::spatialdb::TestGocadVoxet_Benchmark::_numQueries = 1000000;
+
+// ------------------------------------------------------------------------------------------------
+// Benchmarks are hidden; run them with `libtest_spatialdb "[benchmark]"`.
+TEST_CASE("TestGocadVoxet::benchmarkQuery::nearest", "[TestGocadVoxet][benchmark][.]") {
+    spatialdata::spatialdb::TestGocadVoxet_Benchmark::benchmarkQuery(false);
+}
+TEST_CASE("TestGocadVoxet::benchmarkQuery::linear", "[TestGocadVoxet][benchmark][.]") {
+    spatialdata::spatialdb::TestGocadVoxet_Benchmark::benchmarkQuery(true);
+}
+
+// ------------------------------------------------------------------------------------------------
+void
+spatialdata::spatialdb::TestGocadVoxet_Benchmark::benchmarkQuery(const bool useLinear) {
+    _writeVoxet();
+
+    std::vector<double> coherent;
+    testing::Benchmark::createLinePoints(&coherent, _numQueries, _numPoints, _spacing);
+    std::vector<double> random(coherent);
+    testing::Benchmark::shufflePoints(&random, 3);
+
+    GocadVoxet voxetLinear;
+    voxetLinear.read("data", "voxet_benchmark.vo", "\"vp\"");
+
+    GocadVoxet voxetBlocked;
+    voxetBlocked.setUseBlockedLayout(true);
+    voxetBlocked.read("data", "voxet_benchmark.vo", "\"vp\"");
+
+    std::vector<double> valuesLinear;
+    std::vector<double> valuesBlocked;
+    const std::string label = std::string("GocadVoxet ") + ((useLinear) ? "linear" : "nearest");
+
+    double secondsLinear = _query(&valuesLinear, voxetLinear, coherent, useLinear);
+    double secondsBlocked = _query(&valuesBlocked, voxetBlocked, coherent, useLinear);
+    for (size_t i = 0; i < _numQueries; ++i) {
+        REQUIRE(valuesLinear[i] == valuesBlocked[i]);
+    } // for
+    testing::Benchmark::reportSpeedup((label + ", coherent queries").c_str(), "file order", "blocked layout",
+                                      _numQueries, secondsLinear, secondsBlocked);
+
+    secondsLinear = _query(&valuesLinear, voxetLinear, random, useLinear);
+    secondsBlocked = _query(&valuesBlocked, voxetBlocked, random, useLinear);
+    for (size_t i = 0; i < _numQueries; ++i) {
+        REQUIRE(valuesLinear[i] == valuesBlocked[i]);
+    } // for
+    testing::Benchmark::reportSpeedup((label + ", random queries").c_str(), "file order", "blocked layout",
+                                      _numQueries, secondsLinear, secondsBlocked);
+} // benchmarkQuery
+
+
+// ------------------------------------------------------------------------------------------------
+void
+spatialdata::spatialdb::TestGocadVoxet_Benchmark::_writeVoxet(void) {
+    const double length = _spacing*(_numPoints-1);
+
+    std::ofstream voxetFile("data/voxet_benchmark.vo");
+    REQUIRE(voxetFile.is_open());
+    voxetFile
+        << "GOCAD Voxet 1\n"
+        << "AXIS_O 0 0 " << -length << "\n"
+        << "AXIS_U 1 0 0\n"
+        << "AXIS_V 0 1 0\n"
+        << "AXIS_W 0 0 1\n"
+        << "AXIS_MIN 0 0 0\n"
+        << "AXIS_MAX " << length << " " << length << " " << length << "\n"
+        << "AXIS_N " << _numPoints << " " << _numPoints << " " << _numPoints << "\n"
+        << "PROPERTY 1 \"vp\"\n"
+        << "PROP_NO_DATA_VALUE 1 -99999\n"
+        << "PROP_ESIZE 1 4\n"
+        << "PROP_ETYPE 1 IEEE\n"
+        << "PROP_FILE 1 voxet_benchmark_vp@@\n"
+        << "END\n";
+    voxetFile.close();
+
+    const size_t numValues = size_t(_numPoints)*_numPoints*_numPoints;
+    std::vector<unsigned char> bytes(4*numValues);
+    for (size_t i = 0; i < numValues; ++i) {
+        const int ix = i % _numPoints;
+        const int iy = (i / _numPoints) % _numPoints;
+        const int iz = i / (_numPoints*_numPoints);
+        const float value = 1000.0 + 1.0*ix + 2.0*iy + 4.0*iz;
+        memcpy(&bytes[4*i], &value, 4);
+#if !defined(WORDS_BIGENDIAN)
+        std::swap(bytes[4*i+0], bytes[4*i+3]);
+        std::swap(bytes[4*i+1], bytes[4*i+2]);
+#endif
+    } // for
+
+    std::ofstream propertyFile("data/voxet_benchmark_vp@@", std::ios::out | std::ios::binary);
+    REQUIRE(propertyFile.is_open());
+    propertyFile.write((const char*) &bytes[0], bytes.size());
+    propertyFile.close();
+} // _writeVoxet
+
+
+// ------------------------------------------------------------------------------------------------
+double
+spatialdata::spatialdb::TestGocadVoxet_Benchmark::_query(std::vector<double>* values,
+                                                         const GocadVoxet& voxet,
+                                                         const std::vector<double>& points,
+                                                         const bool useLinear) {
+    assert(values);
+
+    const size_t spaceDim = 3;
+    values->resize(_numQueries);
+    int numErrors = 0;
+    const testing::Benchmark::Stopwatch stopwatch;
+    if (useLinear) {
+        for (size_t i = 0; i < _numQueries; ++i) {
+            numErrors += voxet.queryLinear(&(*values)[i], &points[i*spaceDim]);
+        } // for
+    } else {
+        for (size_t i = 0; i < _numQueries; ++i) {
+            numErrors += voxet.query(&(*values)[i], &points[i*spaceDim]);
+        } // for
+    } // if/else
+    const double seconds = stopwatch.seconds();
+    REQUIRE(0 == numErrors);
+
+    return seconds;
+} // _query
+
+
+// End of file
@@ -20,6 +20,7 @@
 #include "catch2/matchers/catch_matchers_floating_point.hpp"
 
 #include <cmath> // USES fabs()
+#include <vector> // USES std::vector
 
 // ----------------------------------------------------------------------
 // Constructor.
@@ -159,6 +160,42 @@ spatialdata::spatialdb::TestGravityField::testQuery(void) {
 } // testQuery
 
 
+// ----------------------------------------------------------------------
+// Test multiquery().
+void
+spatialdata::spatialdb::TestGravityField::testMultiquery(void) {
+    assert(_data);
+
+    GravityField db;
+
+    const size_t spaceDim = _data->cs->getSpaceDim();
+    if (_data->gravityDir) {
+        db.setGravityDir(_data->gravityDir[0], _data->gravityDir[1], spaceDim > 2 ? _data->gravityDir[2] : 0.0);
+    } // if
+    db.setGravityAcc(_data->gravityAcc);
+
+    db.open();
+    const size_t querySize = _data->querySize;
+    assert(_data->cs);
+    db.setQueryValues(_data->queryNames, querySize);
+
+    const size_t numPoints = _data->numPoints;
+    std::vector<double> gravity(numPoints*querySize);
+    std::vector<int> err(numPoints, 1);
+    db.multiquery(&gravity[0], numPoints, querySize, &err[0], numPoints,
+                  _data->coordinates, numPoints, spaceDim, _data->cs);
+    const double tolerance = 1.0e-06;
+    for (size_t iPt = 0; iPt < numPoints; ++iPt) {
+        REQUIRE(!err[iPt]);
+        for (size_t iDim = 0; iDim < querySize; ++iDim) {
+            const double valueE = _data->gravity[iPt*querySize+iDim];
+            CHECK_THAT(gravity[iPt*querySize+iDim], Catch::Matchers::WithinAbs(valueE, tolerance));
+        } // for
+    } // for
+    db.close();
+} // testMultiquery
+
+
 // ----------------------------------------------------------------------
 // Constructor
 spatialdata::spatialdb::TestGravityField_Data::TestGravityField_Data(void) :
@@ -50,6 +50,9 @@ public:
     /// Test query().
     void testQuery(void);
 
+    /// Test multiquery().
+    void testMultiquery(void);
+
     // PROTECTED METHODS //////////////////////////////////////////////////////////////////////////
 protected:
 
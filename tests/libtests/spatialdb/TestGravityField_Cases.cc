@@ -67,18 +67,33 @@ TEST_CASE("TestGravityField::testQueryVals", "[TestGravityField]") {
 TEST_CASE("TestGravityField::Cart2D::testQuery", "[TestGravityField]") {
     spatialdata::spatialdb::TestGravityField(spatialdata::spatialdb::TestGravityField_Cases::Cart2D()).testQuery();
 }
+TEST_CASE("TestGravityField::Cart2D::testMultiquery", "[TestGravityField]") {
+    spatialdata::spatialdb::TestGravityField(spatialdata::spatialdb::TestGravityField_Cases::Cart2D()).testMultiquery();
+}
 TEST_CASE("TestGravityField::Cart3D::testQuery", "[TestGravityField]") {
     spatialdata::spatialdb::TestGravityField(spatialdata::spatialdb::TestGravityField_Cases::Cart3D()).testQuery();
 }
+TEST_CASE("TestGravityField::Cart3D::testMultiquery", "[TestGravityField]") {
+    spatialdata::spatialdb::TestGravityField(spatialdata::spatialdb::TestGravityField_Cases::Cart3D()).testMultiquery();
+}
 TEST_CASE("TestGravityField::Geo::testQuery", "[TestGravityField]") {
     spatialdata::spatialdb::TestGravityField(spatialdata::spatialdb::TestGravityField_Cases::Geo()).testQuery();
 }
+TEST_CASE("TestGravityField::Geo::testMultiquery", "[TestGravityField]") {
+    spatialdata::spatialdb::TestGravityField(spatialdata::spatialdb::TestGravityField_Cases::Geo()).testMultiquery();
+}
 TEST_CASE("TestGravityField::GeoProj::testQuery", "[TestGravityField]") {
     spatialdata::spatialdb::TestGravityField(spatialdata::spatialdb::TestGravityField_Cases::GeoProj()).testQuery();
 }
+TEST_CASE("TestGravityField::GeoProj::testMultiquery", "[TestGravityField]") {
+    spatialdata::spatialdb::TestGravityField(spatialdata::spatialdb::TestGravityField_Cases::GeoProj()).testMultiquery();
+}
 TEST_CASE("TestGravityField::Geocentric::testQuery", "[TestGravityField]") {
     spatialdata::spatialdb::TestGravityField(spatialdata::spatialdb::TestGravityField_Cases::Geocentric()).testQuery();
 }
+TEST_CASE("TestGravityField::Geocentric::testMultiquery", "[TestGravityField]") {
+    spatialdata::spatialdb::TestGravityField(spatialdata::spatialdb::TestGravityField_Cases::Geocentric()).testMultiquery();
+}
 
 // ------------------------------------------------------------------------------------------------
 spatialdata::spatialdb::TestGravityField_Data*
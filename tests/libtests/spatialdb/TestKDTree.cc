@@ -0,0 +1,229 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "spatialdata/spatialdb/KDTree.hh" // Test subject
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <vector> // USES std::vector
+#include <algorithm> // USES std::sort()
+#include <utility> // USES std::pair
+#include <stdexcept> // USES std::invalid_argument
+#include <cassert> // USES assert()
+
+// ------------------------------------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        class TestKDTree;
+    } // spatialdb
+} // spatialdata
+
+class spatialdata::spatialdb::TestKDTree {
+    // PUBLIC METHODS /////////////////////////////////////////////////////////////////////////////
+public:
+
+    /// Test constructor.
+    static
+    void testConstructor(void);
+
+    /// Test build().
+    static
+    void testBuild(void);
+
+    /// Test findNearest() against brute force search.
+    static
+    void testFindNearest(void);
+
+    // PRIVATE METHODS ////////////////////////////////////////////////////////////////////////////
+private:
+
+    /** Generate coordinates of locations, including duplicate locations.
+     *
+     * @param coords Coordinates of locations.
+     * @param numLocs Number of locations.
+     * @param spaceDim Spatial dimension.
+     */
+    static
+    void _generate(std::vector<double>* coords,
+                   const size_t numLocs,
+                   const size_t spaceDim);
+
+    /** Find nearest locations using brute force search.
+     *
+     * @param nearest Indices of nearest locations.
+     * @param coords Coordinates of locations.
+     * @param spaceDim Spatial dimension.
+     * @param pt Coordinates of point in 3-D space.
+     * @param numNearest Maximum number of locations to find.
+     */
+    static
+    void _bruteForce(std::vector<size_t>* nearest,
+                     const std::vector<double>& coords,
+                     const size_t spaceDim,
+                     const double pt[3],
+                     const size_t numNearest);
+
+}; // class TestKDTree
+
+// ------------------------------------------------------------------------------------------------
+TEST_CASE("TestKDTree::testConstructor", "[TestKDTree]") {
+    spatialdata::spatialdb::TestKDTree::testConstructor();
+}
+TEST_CASE("TestKDTree::testBuild", "[TestKDTree]") {
+    spatialdata::spatialdb::TestKDTree::testBuild();
+}
+TEST_CASE("TestKDTree::testFindNearest", "[TestKDTree]") {
+    spatialdata::spatialdb::TestKDTree::testFindNearest();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Test constructor.
+void
+spatialdata::spatialdb::TestKDTree::testConstructor(void) {
+    KDTree tree;
+    CHECK(size_t(0) == tree.getNumLocs());
+} // testConstructor
+
+
+// ------------------------------------------------------------------------------------------------
+// Test build().
+void
+spatialdata::spatialdb::TestKDTree::testBuild(void) {
+    const size_t numLocs = 50;
+    const size_t spaceDim = 2;
+    std::vector<double> coords;
+    _generate(&coords, numLocs, spaceDim);
+
+    KDTree tree;
+    tree.build(&coords[0], numLocs, spaceDim);
+    REQUIRE(numLocs == tree.getNumLocs());
+
+    // Tree holds each location exactly once.
+    std::vector<size_t> indices(tree._indices);
+    std::sort(indices.begin(), indices.end());
+    for (size_t i = 0; i < numLocs; ++i) {
+        CHECK(i == indices[i]);
+    } // for
+
+    tree.deallocate();
+    CHECK(size_t(0) == tree.getNumLocs());
+
+    CHECK_THROWS_AS(tree.build(&coords[0], numLocs/4, 4), std::invalid_argument);
+} // testBuild
+
+
+// ------------------------------------------------------------------------------------------------
+// Test findNearest().
+void
+spatialdata::spatialdb::TestKDTree::testFindNearest(void) {
+    const size_t numLocs = 500;
+    const size_t numPoints = 40;
+    const size_t numNearest = 25;
+
+    for (size_t spaceDim = 1; spaceDim <= 3; ++spaceDim) {
+        std::vector<double> coords;
+        _generate(&coords, numLocs, spaceDim);
+
+        KDTree tree;
+        tree.build(&coords[0], numLocs, spaceDim);
+
+        for (size_t iPt = 0; iPt < numPoints; ++iPt) {
+            double pt[3] = { 0.0, 0.0, 0.0 };
+            for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+                pt[iDim] = -1.0 + 0.05*iPt + 0.3*iDim;
+            } // for
+
+            std::vector<size_t> nearestE;
+            _bruteForce(&nearestE, coords, spaceDim, pt, numNearest);
+
+            std::vector<size_t> nearest;
+            tree.findNearest(&nearest, pt, numNearest);
+            REQUIRE(nearestE.size() == nearest.size());
+            for (size_t i = 0; i < nearest.size(); ++i) {
+                CHECK(nearestE[i] == nearest[i]);
+            } // for
+
+            CHECK(nearestE[0] == tree.findNearest(pt));
+        } // for
+
+        // Request more locations than in tree.
+        const double origin[3] = { 0.0, 0.0, 0.0 };
+        std::vector<size_t> nearest;
+        tree.findNearest(&nearest, origin, 2*numLocs);
+        CHECK(numLocs == nearest.size());
+    } // for
+} // testFindNearest
+
+
+// ------------------------------------------------------------------------------------------------
+// Generate coordinates of locations.
+void
+spatialdata::spatialdb::TestKDTree::_generate(std::vector<double>* coords,
+                                              const size_t numLocs,
+                                              const size_t spaceDim) {
+    assert(coords);
+
+    // Linear congruential generator for reproducible locations.
+    unsigned long seed = 12345;
+    coords->resize(numLocs*spaceDim);
+    for (size_t i = 0; i < numLocs*spaceDim; ++i) {
+        seed = (1103515245*seed + 12345) % 2147483648;
+        (*coords)[i] = -1.0 + 2.0 * double(seed) / 2147483648.0;
+    } // for
+
+    // Include duplicate locations and locations on a coarse lattice to exercise ties.
+    for (size_t iLoc = 0; iLoc < numLocs/10; ++iLoc) {
+        for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+            (*coords)[(2*iLoc+1)*spaceDim+iDim] = (*coords)[2*iLoc*spaceDim+iDim];
+        } // for
+    } // for
+    for (size_t iLoc = numLocs/2; iLoc < numLocs/2+numLocs/10; ++iLoc) {
+        for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+            (*coords)[iLoc*spaceDim+iDim] = 0.25 * double((iLoc+iDim) % 5);
+        } // for
+    } // for
+} // _generate
+
+
+// ------------------------------------------------------------------------------------------------
+// Find nearest locations using brute force search.
+void
+spatialdata::spatialdb::TestKDTree::_bruteForce(std::vector<size_t>* nearest,
+                                                const std::vector<double>& coords,
+                                                const size_t spaceDim,
+                                                const double pt[3],
+                                                const size_t numNearest) {
+    assert(nearest);
+
+    const size_t numLocs = coords.size() / spaceDim;
+    std::vector<std::pair<double, size_t> > dist2(numLocs);
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        double xyz[3] = { 0.0, 0.0, 0.0 };
+        for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+            xyz[iDim] = coords[iLoc*spaceDim+iDim];
+        } // for
+        const double abX = xyz[0] - pt[0];
+        const double abY = xyz[1] - pt[1];
+        const double abZ = xyz[2] - pt[2];
+        dist2[iLoc] = std::make_pair(abX*abX + abY*abY + abZ*abZ, iLoc);
+    } // for
+    std::sort(dist2.begin(), dist2.end());
+
+    const size_t numFound = std::min(numNearest, numLocs);
+    nearest->resize(numFound);
+    for (size_t i = 0; i < numFound; ++i) {
+        (*nearest)[i] = dist2[i].second;
+    } // for
+} // _bruteForce
+
+
+// End of file
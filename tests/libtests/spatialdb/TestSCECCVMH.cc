@@ -17,6 +17,7 @@
 #include "catch2/matchers/catch_matchers_floating_point.hpp"
 
 #include <cmath> // USES fabs()
+#include <vector> // USES std::vector
 
 namespace spatialdata {
     namespace spatialdb {
@@ -60,6 +61,10 @@ public:
     static
     void testQuerySquashed(void);
 
+    /// Test multiquery().
+    static
+    void testMultiquery(void);
+
 }; // class TestSCECCVMH
 
 // ------------------------------------------------------------------------------------------------
@@ -81,6 +86,9 @@ TEST_CASE("TestSCECCVMH::testQuery", "[TestSCECCVMH]") {
 TEST_CASE("TestSCECCVMH::testQuerySquashed", "[TestSCECCVMH]") {
     spatialdata::spatialdb::TestSCECCVMH::testQuerySquashed();
 }
+TEST_CASE("TestSCECCVMH::testMultiquery", "[TestSCECCVMH]") {
+    spatialdata::spatialdb::TestSCECCVMH::testMultiquery();
+}
 TEST_CASE("TestSCECCVMH::testCalcDensity", "[TestSCECCVMH]") {
     spatialdata::spatialdb::TestSCECCVMH::testCalcDensity();
 }
@@ -131,6 +139,21 @@ spatialdata::spatialdb::TestSCECCVMH::testAccessors(void) {
     db.setSquashFlag(true, limit);
     CHECK(true == db._squashTopo);
     CHECK(limit == db._squashLimit);
+
+    // Query type
+    CHECK(SCECCVMH::NEAREST == db._queryType);
+    db.setQueryType(SCECCVMH::LINEAR);
+    CHECK(SCECCVMH::LINEAR == db._queryType);
+
+    // Memory-mapping
+    CHECK(false == db._useMemoryMap);
+    db.setUseMemoryMap(true);
+    CHECK(true == db._useMemoryMap);
+
+    // Blocked layout
+    CHECK(false == db.getUseBlockedLayout());
+    db.setUseBlockedLayout(true);
+    CHECK(true == db.getUseBlockedLayout());
 } // testAccessors
 
 
@@ -316,6 +339,14 @@ spatialdata::spatialdb::TestSCECCVMH::testQuerySquashed(void) {
 }
 
 
+// ----------------------------------------------------------------------
+// Test multiquery().
+void
+spatialdata::spatialdb::TestSCECCVMH::testMultiquery(void) {
+    INFO("SCECCVMH_DATADIR not defined. Skipping test.");
+}
+
+
 #else
 // ----------------------------------------------------------------------
 // Test query().
@@ -621,6 +652,72 @@ spatialdata::spatialdb::TestSCECCVMH::testQuerySquashed(void) {
 } // testQuerySquashed
 
 
+// ----------------------------------------------------------------------
+// Test multiquery().
+void
+spatialdata::spatialdb::TestSCECCVMH::testMultiquery(void) {
+    SCECCVMH db;
+    db.setDataDir(SCECCVMH_DATADIR);
+
+    spatialdata::geocoords::CSGeo cs;
+    cs.setString("+proj=lonlat +ellipsoid=clrk66 +datum=NAD27");
+
+    const size_t numLocs = 10;
+    const size_t spaceDim = 3;
+    const double lonlatelev[10*3] = {
+        -118.560000,  32.550000,  -2450.00,
+        -118.513208,  33.884888,  -1400.00,
+        -118.337765,  34.095691, -17700.00,
+        -117.989344,  34.034148,  -3000.00,
+        -125.000000,  35.000000,  -40000.0, // outside domain
+        -125.000000,  35.000000,  -4000.0,
+        -115.000000,  30.000000,  -800000.0, // outside domain
+        -117.989344,  34.034148,  5000.00, // above domain
+        -117.989344,  34.034148,  -500000.0, // below domain
+        -117.682186,  34.357760,  1793.81,
+    };
+
+    const size_t querySize = 7;
+    const char* queryNames[7] = {
+        "moho-depth",
+        "topo-elev",
+        "vp-tag",
+        "Basement-Depth",
+        "vP",
+        "DenSity",
+        "VS"
+    };
+
+    db.open();
+    db.setQueryValues(queryNames, querySize);
+
+    const SCECCVMH::QueryEnum queryTypes[2] = { SCECCVMH::NEAREST, SCECCVMH::LINEAR };
+    for (int iType = 0; iType < 2; ++iType) {
+        for (int squash = 0; squash < 2; ++squash) {
+            db.setQueryType(queryTypes[iType]);
+            db.setSquashFlag(bool(squash));
+
+            std::vector<double> vals(numLocs*querySize);
+            std::vector<int> err(numLocs);
+            db.multiquery(&vals[0], numLocs, querySize, &err[0], numLocs, lonlatelev, numLocs, spaceDim, &cs);
+
+            // Multiple queries should match single queries.
+            double data[querySize];
+            for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+                INFO("query type: " << queryTypes[iType] << ", squash: " << squash << ", iLoc: " << iLoc);
+                const int errE = db.query(data, querySize, &lonlatelev[iLoc*spaceDim], spaceDim, &cs);
+                CHECK(errE == err[iLoc]);
+                for (size_t iVal = 0; iVal < querySize; ++iVal) {
+                    CHECK(data[iVal] == vals[iLoc*querySize+iVal]);
+                } // for
+            } // for
+        } // for
+    } // for
+
+    db.close();
+} // testMultiquery
+
+
 #endif
 
 // End of file
@@ -15,6 +15,9 @@
 #include "spatialdata/spatialdb/SimpleDB.hh" // USES SimpleDB
 #include "spatialdata/spatialdb/SimpleDBData.hh" // USES SimpleDBData
 #include "spatialdata/spatialdb/SimpleDBQuery.hh" // USES SimpleDBQuery
+#include "spatialdata/spatialdb/QueryContext.hh" // USES QueryContext
+#include "spatialdata/spatialdb/KDTree.hh" // USES KDTree
+#include "spatialdata/spatialdb/Triangulation.hh" // USES Triangulation
 #include "spatialdata/spatialdb/SimpleIOAscii.hh" // USES SimpleIOAscii
 
 #include "spatialdata/geocoords/CSCart.hh" // USE CSCart
@@ -123,6 +126,68 @@ spatialdata::spatialdb::TestSimpleDB::testQueryLinear(void) {
 } // _testQueryLinear
 
 
+// ------------------------------------------------------------------------------------------------
+// Test query() using linear interpolation with triangulation
+void
+spatialdata::spatialdb::TestSimpleDB::testQueryLinearTriangulation(void) {
+    assert(_db);
+    _db->setUseTriangulation(true);
+    _initializeDB();
+
+    assert(_data);
+    CHECK(_db->_triangulation);
+
+    _db->setQueryType(SimpleDB::LINEAR);
+    _checkQuery(_data->queryLinear, _data->errFlags);
+} // testQueryLinearTriangulation
+
+
+// ------------------------------------------------------------------------------------------------
+// Test query() using query context.
+void
+spatialdata::spatialdb::TestSimpleDB::testQueryContext(void) {
+    assert(_db);
+    _initializeDB();
+
+    assert(_data);
+    _db->setQueryType(SimpleDB::LINEAR);
+    const size_t numValues = _data->numValues;
+    _db->setQueryValues(_data->names, numValues);
+
+    QueryContext* context = _db->createQueryContext();assert(context);
+    CHECK(_db == &context->getDB());
+
+    // Changing query type of database after creating context does not affect context.
+    _db->setQueryType(SimpleDB::NEAREST);
+
+    double* values = (numValues > 0) ? new double[numValues] : 0;
+    const double tolerance = 1.0e-06;
+
+    const size_t spaceDim = _data->spaceDim;
+    const size_t numQueries = _data->numQueries;
+    const size_t locSize = spaceDim + numValues;
+    const int* flagsE = _data->errFlags;
+    spatialdata::geocoords::CSCart csCart;
+    for (size_t iQuery = 0; iQuery < numQueries; ++iQuery) {
+        const double* coordinates = &_data->queryLinear[iQuery*locSize];
+        const double* valuesE = &_data->queryLinear[iQuery*locSize+spaceDim];
+        const int err = context->query(values, numValues, coordinates, spaceDim, &csCart);
+        if (flagsE) {
+            CHECK(flagsE[iQuery] == err);
+        } else {
+            CHECK(0 == err);
+        } // if/else
+        for (size_t iVal = 0; iVal < numValues; ++iVal) {
+            const double valueE = valuesE[iVal];
+            const double toleranceV = fabs(valueE) > 0.0 ? fabs(valueE) * tolerance : tolerance;
+            CHECK_THAT(values[iVal], Catch::Matchers::WithinAbs(valueE, toleranceV));
+        } // for
+    } // for
+    delete[] values;values = NULL;
+    delete context;context = NULL;
+} // testQueryContext
+
+
 // ------------------------------------------------------------------------------------------------
 // Populate database with data.
 void
@@ -138,6 +203,12 @@ spatialdata::spatialdb::TestSimpleDB::_initializeDB(void) {
 
     assert(_db);
     _db->_data = dbData;
+    _db->_tree = new KDTree;
+    _db->_tree->build(_data->dbCoordinates, _data->numLocs, _data->spaceDim);
+    if (_db->_useTriangulation) {
+        _db->_triangulation = new Triangulation;
+        _db->_triangulation->build(_data->dbCoordinates, _data->numLocs, _data->spaceDim);
+    } // if
     _db->_query = new SimpleDBQuery(*_db);
     _db->_cs = new spatialdata::geocoords::CSCart();
 } // _setupDB
@@ -48,6 +48,12 @@ public:
     /// Test queryLinear()
     void testQueryLinear(void);
 
+    /// Test queryLinear() using triangulation.
+    void testQueryLinearTriangulation(void);
+
+    /// Test query() using query context.
+    void testQueryContext(void);
+
 protected:
 
     // PROTECTED METHODS //////////////////////////////////////////////////////////////////////////
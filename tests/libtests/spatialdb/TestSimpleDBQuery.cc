@@ -15,13 +15,19 @@
 #include "spatialdata/spatialdb/SimpleDB.hh" // USES SimpleDB
 #include "spatialdata/spatialdb/SimpleDBQuery.hh" // USES SimpleDBQuery
 #include "spatialdata/spatialdb/SimpleDBData.hh" // USES SimpleDBData
+#include "spatialdata/spatialdb/KDTree.hh" // USES KDTree
+#include "spatialdata/spatialdb/Triangulation.hh" // USES Triangulation
+
+#include "spatialdata/spatialdb/Exception.hh" // USES OutOfBounds
 
 #include "spatialdata/geocoords/CSCart.hh" // USE CSCart
 
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/matchers/catch_matchers_floating_point.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
 
 #include <cmath> // USES fabs()
+#include <vector> // USES std::vector
 
 // ----------------------------------------------------------------------
 // Constructor.
@@ -149,6 +155,73 @@ spatialdata::spatialdb::TestSimpleDBQuery::testVolume(void) {
 } // testVolume
 
 
+// ----------------------------------------------------------------------
+// Benchmark query() for nearest and linear interpolation.
+void
+spatialdata::spatialdb::TestSimpleDBQuery::benchmarkQuery(void) {
+    _initializeDB();
+    assert(_data);
+    assert(_query);
+
+    const size_t numValues = _data->numValues;
+    const size_t spaceDim = _data->spaceDim;
+    const size_t numPoints = _data->numPoints;
+    _query->setQueryValues(_data->names, numValues);
+
+    spatialdata::geocoords::CSCart csCart;
+    csCart.setSpaceDim(spaceDim);
+    std::vector<double> values(numValues);
+
+    BENCHMARK("build k-d tree") {
+        KDTree tree;
+        tree.build(_data->dbCoordinates, _data->numLocs, spaceDim);
+        return tree.getNumLocs();
+    };
+
+    _query->setQueryType(SimpleDB::NEAREST);
+    BENCHMARK("query NEAREST") {
+        for (size_t iPt = 0; iPt < numPoints; ++iPt) {
+            _query->query(&values[0], numValues, &_data->coordinates[iPt*spaceDim], spaceDim, &csCart);
+        } // for
+        return values[0];
+    };
+
+    _query->setQueryType(SimpleDB::LINEAR);
+    BENCHMARK("query LINEAR") {
+        size_t numOutOfBounds = 0;
+        for (size_t iPt = 0; iPt < numPoints; ++iPt) {
+            try {
+                _query->query(&values[0], numValues, &_data->coordinates[iPt*spaceDim], spaceDim, &csCart);
+            } catch (const OutOfBounds& err) {
+                ++numOutOfBounds;
+            } // try/catch
+        } // for
+        return numOutOfBounds;
+    };
+
+    BENCHMARK("build triangulation") {
+        Triangulation triangulation;
+        triangulation.build(_data->dbCoordinates, _data->numLocs, spaceDim);
+        return triangulation.getNumCells();
+    };
+
+    delete _db->_triangulation;_db->_triangulation = new Triangulation;assert(_db->_triangulation);
+    _db->_triangulation->build(_data->dbCoordinates, _data->numLocs, spaceDim);
+    BENCHMARK("query LINEAR triangulation") {
+        size_t numOutOfBounds = 0;
+        for (size_t iPt = 0; iPt < numPoints; ++iPt) {
+            try {
+                _query->query(&values[0], numValues, &_data->coordinates[iPt*spaceDim], spaceDim, &csCart);
+            } catch (const OutOfBounds& err) {
+                ++numOutOfBounds;
+            } // try/catch
+        } // for
+        return numOutOfBounds;
+    };
+    delete _db->_triangulation;_db->_triangulation = NULL;
+} // benchmarkQuery
+
+
 // ----------------------------------------------------------------------
 // Populate database with data.
 void
@@ -163,6 +236,8 @@ spatialdata::spatialdb::TestSimpleDBQuery::_initializeDB(void) {
     dbData->setUnits(_data->units, _data->numValues);
 
     delete _db->_data;_db->_data = dbData;
+    delete _db->_tree;_db->_tree = new KDTree;assert(_db->_tree);
+    _db->_tree->build(_data->dbCoordinates, _data->numLocs, _data->spaceDim);
     delete _db->_cs;_db->_cs = new spatialdata::geocoords::CSCart;assert(_db->_cs);
 } // _initializeDB
 
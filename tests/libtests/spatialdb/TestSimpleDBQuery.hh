@@ -50,6 +50,9 @@ public:
     /// Test volume().
     void testVolume(void);
 
+    /// Benchmark query() for nearest and linear interpolation.
+    void benchmarkQuery(void);
+
     // PROTECTED MEMBERS //////////////////////////////////////////////////////////////////////////
 protected:
 
@@ -0,0 +1,117 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "TestSimpleDBQuery.hh" // ISA TestSimpleDBQuery
+
+#include "Benchmark.hh" // USES Benchmark
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <vector> // USES std::vector
+#include <cassert>
+
+// ------------------------------------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        class TestSimpleDBQuery_Benchmark;
+    } // spatialdb
+} // spatialdata
+
+// ------------------------------------------------------------------------------------------------
+class spatialdata::spatialdb::TestSimpleDBQuery_Benchmark {
+public:
+
+    // Factory methods
+    static
+    TestSimpleDBQuery_Data* createData(const size_t numLocs);
+
+}; // TestSimpleDBQuery_Benchmark
+
+// ------------------------------------------------------------------------------------------------
+// Benchmarks are hidden; run them with `libtest_spatialdb "[benchmark]"`.
+TEST_CASE("TestSimpleDBQuery::benchmarkQuery::1000", "[TestSimpleDBQuery][benchmark][.]") {
+    spatialdata::spatialdb::TestSimpleDBQuery(spatialdata::spatialdb::TestSimpleDBQuery_Benchmark::createData(1000)).benchmarkQuery();
+}
+TEST_CASE("TestSimpleDBQuery::benchmarkQuery::10000", "[TestSimpleDBQuery][benchmark][.]") {
+    spatialdata::spatialdb::TestSimpleDBQuery(spatialdata::spatialdb::TestSimpleDBQuery_Benchmark::createData(10000)).benchmarkQuery();
+}
+TEST_CASE("TestSimpleDBQuery::benchmarkQuery::100000", "[TestSimpleDBQuery][benchmark][.]") {
+    spatialdata::spatialdb::TestSimpleDBQuery(spatialdata::spatialdb::TestSimpleDBQuery_Benchmark::createData(100000)).benchmarkQuery();
+}
+TEST_CASE("TestSimpleDBQuery::benchmarkQuery::500000", "[TestSimpleDBQuery][benchmark][.]") {
+    spatialdata::spatialdb::TestSimpleDBQuery(spatialdata::spatialdb::TestSimpleDBQuery_Benchmark::createData(500000)).benchmarkQuery();
+}
+
+// ------------------------------------------------------------------------------------------------
+spatialdata::spatialdb::TestSimpleDBQuery_Data*
+spatialdata::spatialdb::TestSimpleDBQuery_Benchmark::createData(const size_t numLocs) {
+    spatialdata::spatialdb::TestSimpleDBQuery_Data* data = new TestSimpleDBQuery_Data;assert(data);
+
+    const size_t spaceDim = 3;
+    const size_t numValues = 3;
+    const size_t numPoints = 1000;
+
+    data->numLocs = numLocs;
+    data->spaceDim = spaceDim;
+    data->numValues = numValues;
+    data->dataDim = 3;
+    data->numPoints = numPoints;
+
+    // Data is not deallocated by TestSimpleDBQuery_Data, so keep it in static storage.
+    static std::vector<double> dbCoordinates;
+    static std::vector<double> dbValues;
+    static std::vector<double> coordinates;
+
+    // Scattered locations in unit cube from linear congruential generator.
+    testing::Benchmark::Random random;
+    dbCoordinates.resize(numLocs*spaceDim);
+    for (size_t i = 0; i < numLocs*spaceDim; ++i) {
+        dbCoordinates[i] = random.next();
+    } // for
+    data->dbCoordinates = &dbCoordinates[0];
+
+    // Values are linear functions of coordinates.
+    dbValues.resize(numLocs*numValues);
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        const double* xyz = &dbCoordinates[iLoc*spaceDim];
+        dbValues[iLoc*numValues+0] = 1.0 + 2.0*xyz[0];
+        dbValues[iLoc*numValues+1] = 3.0 - 1.5*xyz[1] + xyz[2];
+        dbValues[iLoc*numValues+2] = xyz[0] + xyz[1] + xyz[2];
+    } // for
+    data->dbValues = &dbValues[0];
+
+    static const char* names[3] = {
+        "one",
+        "two",
+        "three",
+    };
+    data->names = names;
+
+    static const char* units[3] = {
+        "m",
+        "s",
+        "m/s",
+    };
+    data->units = units;
+
+    // Query points in interior of domain.
+    coordinates.resize(numPoints*spaceDim);
+    for (size_t i = 0; i < numPoints*spaceDim; ++i) {
+        coordinates[i] = 0.1 + 0.8 * random.next();
+    } // for
+    data->coordinates = &coordinates[0];
+
+    return data;
+} // TestSimpleDBQuery_Benchmark
+
+
+// End of file
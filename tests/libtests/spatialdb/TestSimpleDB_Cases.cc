@@ -40,6 +40,9 @@ public:
     static
     TestSimpleDB_Data* Volume3D(void);
 
+    static
+    TestSimpleDB_Data* Area2D(void);
+
 }; // class TestSimpleDB
 
 // ------------------------------------------------------------------------------------------------
@@ -91,6 +94,25 @@ TEST_CASE("TestSimpleDB::testQueryNearest", "[TestSimpleDB][Volume3D]") {
 TEST_CASE("TestSimpleDB::testQueryLinear", "[TestSimpleDB][Volume3D]") {
     spatialdata::spatialdb::TestSimpleDB(spatialdata::spatialdb::TestSimpleDB_Cases::Volume3D()).testQueryLinear();
 }
+TEST_CASE("TestSimpleDB::testQueryContext", "[TestSimpleDB][Volume3D]") {
+    spatialdata::spatialdb::TestSimpleDB(spatialdata::spatialdb::TestSimpleDB_Cases::Volume3D()).testQueryContext();
+}
+
+TEST_CASE("TestSimpleDB::testGetNamesDBValues", "[TestSimpleDB][Area2D]") {
+    spatialdata::spatialdb::TestSimpleDB(spatialdata::spatialdb::TestSimpleDB_Cases::Area2D()).testGetNamesDBValues();
+}
+TEST_CASE("TestSimpleDB::testQueryNearest", "[TestSimpleDB][Area2D]") {
+    spatialdata::spatialdb::TestSimpleDB(spatialdata::spatialdb::TestSimpleDB_Cases::Area2D()).testQueryNearest();
+}
+TEST_CASE("TestSimpleDB::testQueryLinear", "[TestSimpleDB][Area2D]") {
+    spatialdata::spatialdb::TestSimpleDB(spatialdata::spatialdb::TestSimpleDB_Cases::Area2D()).testQueryLinear();
+}
+TEST_CASE("TestSimpleDB::testQueryContext", "[TestSimpleDB][Area2D]") {
+    spatialdata::spatialdb::TestSimpleDB(spatialdata::spatialdb::TestSimpleDB_Cases::Area2D()).testQueryContext();
+}
+TEST_CASE("TestSimpleDB::testQueryLinearTriangulation", "[TestSimpleDB][Area2D]") {
+    spatialdata::spatialdb::TestSimpleDB(spatialdata::spatialdb::TestSimpleDB_Cases::Area2D()).testQueryLinearTriangulation();
+}
 
 // ------------------------------------------------------------------------------------------------
 spatialdata::spatialdb::TestSimpleDB_Data*
@@ -353,4 +375,81 @@ spatialdata::spatialdb::TestSimpleDB_Cases::Volume3D(void) {
 } // Volume3D
 
 
+// ------------------------------------------------------------------------------------------------
+spatialdata::spatialdb::TestSimpleDB_Data*
+spatialdata::spatialdb::TestSimpleDB_Cases::Area2D(void) {
+    spatialdata::spatialdb::TestSimpleDB_Data* data = new TestSimpleDB_Data;assert(data);
+
+    data->numLocs = 9;
+    data->spaceDim = 2;
+    data->numValues = 2;
+    data->dataDim = 2;
+    data->numQueries = 5;
+
+    // Scattered locations with values that are linear functions of the coordinates, so
+    // linear interpolation is exact for any triangle containing the query location.
+    static const double dbCoordinates[9*2] = {
+        0.00000000e+00,  0.00000000e+00,
+        4.00000000e+00,  5.00000000e-01,
+        8.00000000e+00, -5.00000000e-01,
+        1.50000000e+00,  3.00000000e+00,
+        5.50000000e+00,  3.50000000e+00,
+        9.00000000e+00,  3.00000000e+00,
+        5.00000000e-01,  6.50000000e+00,
+        4.50000000e+00,  7.00000000e+00,
+        8.50000000e+00,  6.00000000e+00,
+    };
+    data->dbCoordinates = dbCoordinates;
+
+    static const double dbValues[9*2] = {
+        1.00000000e+00, -2.00000000e+00,
+        2.90000000e+00, -1.45000000e+00,
+        5.10000000e+00, -1.35000000e+00,
+        1.15000000e+00, -9.50000000e-01,
+        3.05000000e+00, -4.00000000e-01,
+        4.90000000e+00, -2.00000000e-01,
+        -5.00000000e-02,  0.00000000e+00,
+        1.85000000e+00,  5.50000000e-01,
+        4.05000000e+00,  6.50000000e-01,
+    };
+    data->dbValues = dbValues;
+
+    static const char* names[] = {
+        "One",
+        "Two",
+    };
+    data->names = names;
+
+    static const char* units[] = {
+        "m",
+        "m/s",
+    };
+    data->units = units;
+
+    static const double queryNearest[5*(2+2)] = {
+        2.00000000e+00,  1.50000000e+00,  1.15000000e+00, -9.50000000e-01,
+        6.50000000e+00,  2.00000000e+00,  3.05000000e+00, -4.00000000e-01,
+        3.00000000e+00,  5.20000000e+00,  1.85000000e+00,  5.50000000e-01,
+        7.50000000e+00,  5.50000000e+00,  4.05000000e+00,  6.50000000e-01,
+        1.20000000e+01,  2.00000000e+00,  4.90000000e+00, -2.00000000e-01,
+    };
+    data->queryNearest = queryNearest;
+
+    static const double queryLinear[5*(2+2)] = {
+        2.00000000e+00,  1.50000000e+00,  1.70000000e+00, -1.35000000e+00,
+        6.50000000e+00,  2.00000000e+00,  3.85000000e+00, -7.50000000e-01,
+        3.00000000e+00,  5.20000000e+00,  1.46000000e+00, -1.40000000e-01,
+        7.50000000e+00,  5.50000000e+00,  3.65000000e+00,  4.00000000e-01,
+        1.20000000e+01,  2.00000000e+00,  0.00000000e+00,  0.00000000e+00,
+    };
+    data->queryLinear = queryLinear;
+
+    static const int errFlags[5] = {
+        0, 0, 0, 0, 1, };
+    data->errFlags = errFlags;
+
+    return data;
+} // Area2D
+
+
 // End of file
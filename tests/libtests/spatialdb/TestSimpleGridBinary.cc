@@ -0,0 +1,325 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "spatialdata/spatialdb/SimpleGridBinary.hh" // Test subject
+
+#include "spatialdata/spatialdb/SimpleGridDB.hh" // USES SimpleGridDB
+
+#include "spatialdata/geocoords/CSGeo.hh" // USE CSGeo
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include <fstream> // USES std::ofstream
+#include <stdexcept> // USES std::runtime_error
+#include <cmath> // USES fabs()
+
+// ------------------------------------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        class TestSimpleGridBinary;
+    } // spatialdb
+} // spatialdata
+
+class spatialdata::spatialdb::TestSimpleGridBinary {
+    // PUBLIC METHODS /////////////////////////////////////////////////////////////////////////////
+public:
+
+    /// Test write() and read() with CSGeo.
+    static
+    void testIOCSGeo(void);
+
+    /// Test convertAscii().
+    static
+    void testConvertAscii(void);
+
+    /// Test write() with data stored in blocks of points.
+    static
+    void testWriteBlocked(void);
+
+    /// Test read() with invalid files.
+    static
+    void testReadErrors(void);
+
+}; // class TestSimpleGridBinary
+
+// ------------------------------------------------------------------------------------------------
+TEST_CASE("TestSimpleGridBinary::testIOCSGeo", "[TestSimpleGridBinary]") {
+    spatialdata::spatialdb::TestSimpleGridBinary::testIOCSGeo();
+}
+TEST_CASE("TestSimpleGridBinary::testConvertAscii", "[TestSimpleGridBinary]") {
+    spatialdata::spatialdb::TestSimpleGridBinary::testConvertAscii();
+}
+TEST_CASE("TestSimpleGridBinary::testWriteBlocked", "[TestSimpleGridBinary]") {
+    spatialdata::spatialdb::TestSimpleGridBinary::testWriteBlocked();
+}
+TEST_CASE("TestSimpleGridBinary::testReadErrors", "[TestSimpleGridBinary]") {
+    spatialdata::spatialdb::TestSimpleGridBinary::testReadErrors();
+}
+
+// ----------------------------------------------------------------------
+// Test write() and read() with CSGeo.
+void
+spatialdata::spatialdb::TestSimpleGridBinary::testIOCSGeo(void) {
+    const size_t numX = 1;
+    const size_t numY = 2;
+    const size_t numZ = 3;
+    const size_t spaceDim = 3;
+    const size_t numValues = 3;
+    const size_t dataDim = 2;
+
+    const double x[numX] = { -2.0 };
+    const double y[numY] = { 0.0, 1.0 };
+    const double z[numZ] = { -2.0, -1.0, 2.0 };
+
+    const double coords[numX*numY*numZ*spaceDim] = {
+        -2.0,  0.0, -2.0,
+        -2.0,  1.0, -2.0,
+        -2.0,  0.0, -1.0,
+        -2.0,  1.0, -1.0,
+        -2.0,  0.0,  2.0,
+        -2.0,  1.0,  2.0,
+    };
+    const double data[numX*numY*numZ*numValues] = {
+        6.6,  3.4, 2.3,
+        5.5,  6.7, 3.4,
+        2.3,  4.1, 4.5,
+        5.7,  2.0, 5.6,
+        6.3,  6.9, 6.7,
+        3.4,  6.4, 7.8,
+    };
+    const char* names[numValues] = { "One", "Two", "Three" };
+    const char* units[numValues] = { "m", "km", "none" };
+    const double scales[numValues] = { 1.0, 1.0e+3, 1.0 };
+
+    spatialdata::geocoords::CSGeo csOut;
+    csOut.setString("+proj=tmerc +datum=WGS84 +lon_0=-122.6765 +lat_0=45.5231 +k=0.9996 +units=m +vunits=m");
+    SimpleGridDB dbOut;
+    dbOut.setCoordSys(csOut);
+    dbOut.allocate(numX, numY, numZ, numValues, spaceDim, dataDim);
+    dbOut.setX(x, numX);
+    dbOut.setY(y, numY);
+    dbOut.setZ(z, numZ);
+    dbOut.setData(coords, numX*numY*numZ, spaceDim, data, numX*numY*numZ, numValues);
+    dbOut.setNames(names, numValues);
+    dbOut.setUnits(units, numValues);
+
+    const char* filename = "data/grid_geo.bin_spatialdb";
+    dbOut.setFilename(filename);
+    SimpleGridBinary::write(dbOut);
+    CHECK(SimpleGridBinary::isBinary(filename));
+    CHECK(!SimpleGridBinary::isBinary("data/grid_volume3d.spatialdb"));
+
+    SimpleGridDB dbIn;
+    dbIn.setDescription("GridDB binary");
+    dbIn.setFilename(filename);
+    dbIn.open();
+
+    CHECK(numX == dbIn._numX);
+    CHECK(numY == dbIn._numY);
+    CHECK(numZ == dbIn._numZ);
+    CHECK(dataDim == dbIn._dataDim);
+    CHECK(spaceDim == dbIn._spaceDim);
+    REQUIRE(numValues == dbIn._numValues);
+    REQUIRE(dbIn._cs);
+    CHECK(csOut.getString() == std::string(dynamic_cast<const geocoords::CSGeo*>(dbIn._cs)->getString()));
+
+    CHECK(dbIn._names);
+    CHECK(dbIn._units);
+    for (size_t iVal = 0; iVal < numValues; ++iVal) {
+        CHECK(std::string(names[iVal]) == dbIn._names[iVal]);
+        CHECK(std::string(units[iVal]) == dbIn._units[iVal]);
+    } // for
+
+    const double tolerance = 1.0e-06;
+    for (size_t i = 0; i < numZ; ++i) {
+        CHECK_THAT(dbIn._z[i], Catch::Matchers::WithinAbs(z[i], tolerance));
+    } // for
+
+    // Check to make sure values were read in correctly and converted to SI units.
+    REQUIRE(dbIn._data);
+    for (size_t iX = 0, i = 0; iX < numX; ++iX) {
+        for (size_t iZ = 0; iZ < numZ; ++iZ) {
+            for (size_t iY = 0; iY < numY; ++iY) {
+                const size_t iD = dbIn._getDataIndex(iX, numX, iY, numY, iZ, numZ);
+                for (size_t iVal = 0; iVal < numValues; ++iVal, ++i) {
+                    const double valueE = scales[iVal]*data[i];
+                    CHECK_THAT(dbIn._data[iD+iVal], Catch::Matchers::WithinAbs(valueE, tolerance*valueE));
+                } // for
+            } // for
+        } // for
+    } // for
+
+    // Converting to SI units must not modify the file.
+    SimpleGridDB dbIn2;
+    dbIn2.setFilename(filename);
+    dbIn2.open();
+    for (size_t i = 0; i < numX*numY*numZ*numValues; ++i) {
+        CHECK(dbIn._data[i] == dbIn2._data[i]);
+    } // for
+
+    dbIn.close();
+    CHECK(!dbIn._data);
+    CHECK(!dbIn._dataMap);
+} // testIOCSGeo
+
+
+// ----------------------------------------------------------------------
+// Test convertAscii().
+void
+spatialdata::spatialdb::TestSimpleGridBinary::testConvertAscii(void) {
+    const size_t numFiles = 7;
+    const char* filenames[numFiles] = {
+        "data/grid_line1d.spatialdb",
+        "data/grid_line2d.spatialdb",
+        "data/grid_line3d.spatialdb",
+        "data/grid_area2d.spatialdb",
+        "data/grid_area3d.spatialdb",
+        "data/grid_volume3d.spatialdb",
+        "data/grid_comments.spatialdb",
+    };
+    const char* filenameBinary = "data/grid_convert.bin_spatialdb";
+
+    for (size_t iFile = 0; iFile < numFiles; ++iFile) {
+        INFO("Converting file " << filenames[iFile]);
+        SimpleGridBinary::convertAscii(filenames[iFile], filenameBinary);
+
+        SimpleGridDB dbA;
+        dbA.setFilename(filenames[iFile]);
+        dbA.open();
+
+        SimpleGridDB dbB;
+        dbB.setFilename(filenameBinary);
+        dbB.open();
+#if !defined(WORDS_BIGENDIAN)
+        CHECK(dbB._dataMap);
+#endif
+
+        CHECK(dbA._numX == dbB._numX);
+        CHECK(dbA._numY == dbB._numY);
+        CHECK(dbA._numZ == dbB._numZ);
+        CHECK(dbA._dataDim == dbB._dataDim);
+        CHECK(dbA._spaceDim == dbB._spaceDim);
+        REQUIRE(dbA._numValues == dbB._numValues);
+        for (size_t iVal = 0; iVal < dbA._numValues; ++iVal) {
+            CHECK(dbA._names[iVal] == dbB._names[iVal]);
+            CHECK(dbA._units[iVal] == dbB._units[iVal]);
+        } // for
+        for (size_t i = 0; i < dbA._numX; ++i) {
+            CHECK(dbA._x[i] == dbB._x[i]);
+        } // for
+        for (size_t i = 0; i < dbA._numY; ++i) {
+            CHECK(dbA._y[i] == dbB._y[i]);
+        } // for
+        for (size_t i = 0; i < dbA._numZ; ++i) {
+            CHECK(dbA._z[i] == dbB._z[i]);
+        } // for
+        const size_t spaceDim = dbA._spaceDim;
+        const size_t numLocs = (3 == spaceDim) ? dbA._numX*dbA._numY*dbA._numZ : (2 == spaceDim) ? dbA._numX*dbA._numY : dbA._numX;
+        for (size_t i = 0; i < numLocs*dbA._numValues; ++i) {
+            CHECK(dbA._data[i] == dbB._data[i]);
+        } // for
+
+        // Queries must match.
+        dbA.setQueryType(SimpleGridDB::LINEAR);
+        dbB.setQueryType(SimpleGridDB::LINEAR);
+        const size_t numVals = dbA._numValues;
+        double valsA[32];
+        double valsB[32];
+        REQUIRE(numVals <= 32);
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            double xyz[3] = { 0.0, 0.0, 0.0 };
+            const double* axes[3] = { dbA._x, dbA._y, dbA._z };
+            const size_t sizes[3] = { dbA._numX, dbA._numY, dbA._numZ };
+            size_t index = iLoc;
+            for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+                xyz[iDim] = axes[iDim][index % sizes[iDim]];
+                index /= sizes[iDim];
+            } // for
+            const int errA = dbA.query(valsA, numVals, xyz, spaceDim, dbA._cs);
+            const int errB = dbB.query(valsB, numVals, xyz, spaceDim, dbA._cs);
+            CHECK(errA == errB);
+            for (size_t iVal = 0; iVal < numVals; ++iVal) {
+                CHECK(valsA[iVal] == valsB[iVal]);
+            } // for
+        } // for
+    } // for
+} // testConvertAscii
+
+
+// ----------------------------------------------------------------------
+// Test write() with data stored in blocks of points.
+void
+spatialdata::spatialdb::TestSimpleGridBinary::testWriteBlocked(void) {
+    const char* filename = "data/grid_volume3d.spatialdb";
+    const char* filenameBinary = "data/grid_convert.bin_spatialdb";
+
+    SimpleGridDB dbBlocked;
+    dbBlocked.setFilename(filename);
+    dbBlocked.setUseBlockedLayout(true);
+    dbBlocked.open();
+    REQUIRE(dbBlocked._numBlocks[0] > 0);
+    dbBlocked.setFilename(filenameBinary);
+    SimpleGridBinary::write(dbBlocked);
+
+    // File is written in linear order.
+    SimpleGridDB dbA;
+    dbA.setFilename(filename);
+    dbA.open();
+
+    SimpleGridDB dbB;
+    dbB.setFilename(filenameBinary);
+    dbB.open();
+
+    REQUIRE(dbA._numValues == dbB._numValues);
+    const size_t numLocs = dbA._numX*dbA._numY*dbA._numZ;
+    for (size_t i = 0; i < numLocs*dbA._numValues; ++i) {
+        CHECK(dbA._data[i] == dbB._data[i]);
+    } // for
+} // testWriteBlocked
+
+
+// ----------------------------------------------------------------------
+// Test read() with invalid files.
+void
+spatialdata::spatialdb::TestSimpleGridBinary::testReadErrors(void) {
+    SimpleGridDB db;
+
+    // Missing file.
+    db.setFilename("data/missing.bin_spatialdb");
+    CHECK_THROWS_AS(SimpleGridBinary::read(&db), std::runtime_error);
+
+    // ASCII file.
+    db.setFilename("data/grid_volume3d.spatialdb");
+    CHECK_THROWS_AS(SimpleGridBinary::read(&db), std::runtime_error);
+
+    // Truncated file.
+    const char* filenameBinary = "data/grid_truncated.bin_spatialdb";
+    SimpleGridBinary::convertAscii("data/grid_volume3d.spatialdb", filenameBinary);
+    std::string contents;
+    { // read
+        std::ifstream filein(filenameBinary, std::ios::in | std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(filein), std::istreambuf_iterator<char>());
+    } // read
+    { // write
+        std::ofstream fileout(filenameBinary, std::ios::out | std::ios::binary);
+        fileout.write(contents.c_str(), contents.length()-8);
+    } // write
+    db.setFilename(filenameBinary);
+    CHECK(SimpleGridBinary::isBinary(filenameBinary));
+    CHECK_THROWS_AS(db.open(), std::runtime_error);
+    db.close();
+    CHECK(!db._dataMap);
+} // testReadErrors
+
+
+// End of file
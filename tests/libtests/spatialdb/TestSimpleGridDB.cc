@@ -13,7 +13,9 @@
 #include "TestSimpleGridDB.hh" // Implementation of class methods
 
 #include "spatialdata/spatialdb/SimpleGridDB.hh" // USES SimpleGridDB
+#include "spatialdata/spatialdb/QueryContext.hh" // USES QueryContext
 #include "spatialdata/spatialdb/SimpleGridAscii.hh" // USES SimpleGridAscii
+#include "spatialdata/spatialdb/SimpleGridBinary.hh" // USES SimpleGridBinary
 
 #include "spatialdata/geocoords/CSCart.hh" // USE CSCart
 
@@ -21,6 +23,7 @@
 #include "catch2/matchers/catch_matchers_floating_point.hpp"
 
 #include <cmath> // USES fabs()
+#include <vector> // USES std::vector
 
 // ----------------------------------------------------------------------
 // Constructor.
@@ -67,6 +70,12 @@ spatialdata::spatialdb::TestSimpleGridDB::testAccessors(void) {
 
     db.setQueryType(SimpleGridDB::NEAREST);
     CHECK(SimpleGridDB::NEAREST == db._queryType);
+
+    // Test blocked layout flag.
+    CHECK(false == db.getUseBlockedLayout());
+
+    db.setUseBlockedLayout(true);
+    CHECK(true == db.getUseBlockedLayout());
 } // testAccessors
 
 
@@ -127,6 +136,35 @@ spatialdata::spatialdb::TestSimpleGridDB::testSearch(void) {
     const double indexH = -1.0;
     index = db._search(xH, x, numX);
     CHECK_THAT(index, Catch::Matchers::WithinAbs(indexH, tolerance));
+
+    // Nonuniform axis uses bisection.
+    const size_t numY = 4;
+    const double y[numY] = {
+        -2.0, 0.0, 2.0, 4.0,
+    };
+    spatialdata::geocoords::CSCart csCart;
+    csCart.setSpaceDim(2);
+    db.setCoordSys(csCart);
+    db.allocate(numX, numY, 1, 1, 2, 2);
+    db.setX(x, numX);
+    db.setY(y, numY);
+    CHECK(!db.isUniformAxis(0));
+    CHECK(db.isUniformAxis(1));
+    CHECK(!db.isUniformAxis(2));
+
+    // Uniform axis uses index arithmetic; results must match bisection.
+    const size_t numTargets = 7;
+    const double targets[numTargets] = {
+        -20.0, -2.0, -1.5, 0.0, 3.9, 4.0, 20.0,
+    };
+    const SimpleGridDB::QueryEnum queryTypes[2] = { SimpleGridDB::NEAREST, SimpleGridDB::LINEAR };
+    for (size_t iType = 0; iType < 2; ++iType) {
+        db.setQueryType(queryTypes[iType]);
+        for (size_t i = 0; i < numTargets; ++i) {
+            CHECK_THAT(db._searchAxis(targets[i], 0), Catch::Matchers::WithinAbs(db._search(targets[i], x, numX), tolerance));
+            CHECK_THAT(db._searchAxis(targets[i], 1), Catch::Matchers::WithinAbs(db._search(targets[i], y, numY), tolerance));
+        } // for
+    } // for
 } // testSearch
 
 
@@ -148,6 +186,18 @@ spatialdata::spatialdb::TestSimpleGridDB::testDataIndex(void) {
 
     CHECK(size_t(1*10) == db._getDataIndex(1, db._numX, 0, db._numY, 0, db._numZ));
     CHECK(size_t(3*4*3*10 + 1*4*10 + 2*10) == db._getDataIndex(2, db._numX, 1, db._numY, 3, db._numZ));
+
+    // Blocks of 8x8x8 points in grid with 2x3x2 blocks.
+    db._numX = 12;
+    db._numY = 20;
+    db._numZ = 9;
+    db._numBlocks[0] = 2;
+    db._numBlocks[1] = 3;
+    CHECK(size_t(0) == db._getDataIndex(0, db._numX, 0, db._numY, 0, db._numZ));
+    CHECK(size_t((7 + 8*6 + 64*5)*10) == db._getDataIndex(7, db._numX, 6, db._numY, 5, db._numZ));
+    CHECK(size_t((1*512 + 2)*10) == db._getDataIndex(10, db._numX, 0, db._numY, 0, db._numZ));
+    CHECK(size_t((2*512 + 1*8)*10) == db._getDataIndex(0, db._numX, 9, db._numY, 0, db._numZ));
+    CHECK(size_t(((6 + 2*2 + 1)*512 + 3 + 8*4 + 64*0)*10) == db._getDataIndex(11, db._numX, 20, db._numY, 8, db._numZ));
 } // testDataIndex
 
 
@@ -199,6 +249,275 @@ spatialdata::spatialdb::TestSimpleGridDB::testQueryLinear(void) {
 } // _testQueryLinear
 
 
+// ----------------------------------------------------------------------
+// Test multiquery() using nearest neighbor and linear interpolation.
+//
+// Results must match those from query() at each location.
+void
+spatialdata::spatialdb::TestSimpleGridDB::testMultiquery(void) {
+    assert(_data);
+
+    SimpleGridDB db;
+    _setupDB(&db);
+
+    const size_t numQueries = _data->numQueries;
+    const size_t spaceDim = _data->spaceDim;
+    const size_t numValues = _data->numValues;
+    const size_t locSize = spaceDim + numValues;
+    const double tolerance = 1.0e-06;
+
+    spatialdata::geocoords::CSCart csCart;
+    csCart.setSpaceDim(spaceDim);
+    db.setQueryValues(_data->names, numValues);
+
+    const SimpleGridDB::QueryEnum queryTypes[2] = { SimpleGridDB::NEAREST, SimpleGridDB::LINEAR };
+    const double* queryData[2] = { _data->queryNearest, _data->queryLinear };
+    for (size_t iType = 0; iType < 2; ++iType) {
+        db.setQueryType(queryTypes[iType]);
+
+        std::vector<double> coords(numQueries*spaceDim);
+        for (size_t iQuery = 0; iQuery < numQueries; ++iQuery) {
+            for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+                coords[iQuery*spaceDim+iDim] = queryData[iType][iQuery*locSize+iDim];
+            } // for
+        } // for
+        std::vector<double> vals(numQueries*numValues);
+        std::vector<int> err(numQueries);
+        db.multiquery(vals.data(), numQueries, numValues, err.data(), numQueries,
+                      coords.data(), numQueries, spaceDim, &csCart);
+
+        // Multiple threads must give identical results.
+        std::vector<double> valsThreads(numQueries*numValues);
+        std::vector<int> errThreads(numQueries);
+        db.setNumThreads(2);
+        db.multiquery(valsThreads.data(), numQueries, numValues, errThreads.data(), numQueries,
+                      coords.data(), numQueries, spaceDim, &csCart);
+        db.setNumThreads(1);
+        CHECK(err == errThreads);
+        for (size_t iQuery = 0; iQuery < numQueries; ++iQuery) {
+            if (err[iQuery]) {
+                continue;
+            } // if
+            for (size_t iVal = 0; iVal < numValues; ++iVal) {
+                CHECK(vals[iQuery*numValues+iVal] == valsThreads[iQuery*numValues+iVal]);
+            } // for
+        } // for
+
+        // Values must match those from individual queries.
+        std::vector<double> valsE(numValues);
+        for (size_t iQuery = 0; iQuery < numQueries; ++iQuery) {
+            const int errE = db.query(valsE.data(), numValues, &coords[iQuery*spaceDim], spaceDim, &csCart);
+            REQUIRE(errE == err[iQuery]);
+            if (errE) {
+                continue;
+            } // if
+            for (size_t iVal = 0; iVal < numValues; ++iVal) {
+                const double valueE = valsE[iVal];
+                const double toleranceV = fabs(valueE) > 0.0 ? fabs(valueE) * tolerance : tolerance;
+                CHECK_THAT(vals[iQuery*numValues+iVal], Catch::Matchers::WithinAbs(valueE, toleranceV));
+            } // for
+        } // for
+    } // for
+} // testMultiquery
+
+
+// ----------------------------------------------------------------------
+// Test querying with query context.
+// Results must match those from query() at each location.
+void
+spatialdata::spatialdb::TestSimpleGridDB::testQueryContext(void) {
+    assert(_data);
+
+    SimpleGridDB db;
+    _setupDB(&db);
+
+    const size_t numQueries = _data->numQueries;
+    const size_t spaceDim = _data->spaceDim;
+    const size_t numValues = _data->numValues;
+    const size_t locSize = spaceDim + numValues;
+    const double tolerance = 1.0e-06;
+
+    spatialdata::geocoords::CSCart csCart;
+    csCart.setSpaceDim(spaceDim);
+    db.setQueryValues(_data->names, numValues);
+
+    const SimpleGridDB::QueryEnum queryTypes[2] = { SimpleGridDB::NEAREST, SimpleGridDB::LINEAR };
+    const double* queryData[2] = { _data->queryNearest, _data->queryLinear };
+    for (size_t iType = 0; iType < 2; ++iType) {
+        db.setQueryType(queryTypes[iType]);
+        QueryContext* context = db.createQueryContext();assert(context);
+        CHECK(&db == &context->getDB());
+
+        std::vector<double> coords(numQueries*spaceDim);
+        for (size_t iQuery = 0; iQuery < numQueries; ++iQuery) {
+            for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+                coords[iQuery*spaceDim+iDim] = queryData[iType][iQuery*locSize+iDim];
+            } // for
+        } // for
+        std::vector<double> valsMulti(numQueries*numValues);
+        std::vector<int> errMulti(numQueries);
+        context->multiquery(valsMulti.data(), numQueries, numValues, errMulti.data(), numQueries,
+                            coords.data(), numQueries, spaceDim, &csCart);
+
+        std::vector<double> vals(numValues);
+        std::vector<double> valsE(numValues);
+        for (size_t iQuery = 0; iQuery < numQueries; ++iQuery) {
+            const int err = context->query(vals.data(), numValues, &coords[iQuery*spaceDim], spaceDim, &csCart);
+            const int errE = db.query(valsE.data(), numValues, &coords[iQuery*spaceDim], spaceDim, &csCart);
+            REQUIRE(errE == err);
+            REQUIRE(errE == errMulti[iQuery]);
+            if (errE) {
+                continue;
+            } // if
+            for (size_t iVal = 0; iVal < numValues; ++iVal) {
+                const double valueE = valsE[iVal];
+                const double toleranceV = fabs(valueE) > 0.0 ? fabs(valueE) * tolerance : tolerance;
+                CHECK_THAT(vals[iVal], Catch::Matchers::WithinAbs(valueE, toleranceV));
+                CHECK_THAT(valsMulti[iQuery*numValues+iVal], Catch::Matchers::WithinAbs(valueE, toleranceV));
+            } // for
+        } // for
+        delete context;context = NULL;
+    } // for
+} // testQueryContext
+
+
+// ----------------------------------------------------------------------
+// Test query() with data stored in blocks of points.
+void
+spatialdata::spatialdb::TestSimpleGridDB::testQueryBlocked(void) {
+    assert(_data);
+
+    SimpleGridDB db;
+    db.setFilename(_data->filename);
+    db.setUseBlockedLayout(true);
+    db.open();
+
+    // Only data with 3-D topology is stored in blocks.
+    CHECK((3 == _data->dataDim) == (db._numBlocks[0] > 0));
+
+    db.setQueryType(SimpleGridDB::NEAREST);
+    _checkQuery(db, _data->names, _data->queryNearest, 0, _data->numQueries, _data->spaceDim, _data->numValues);
+
+    db.setQueryType(SimpleGridDB::LINEAR);
+    _checkQuery(db, _data->names, _data->queryLinear, _data->errFlags, _data->numQueries, _data->spaceDim, _data->numValues);
+
+    db.close();
+    CHECK(0 == db._numBlocks[0]);
+} // testQueryBlocked
+
+
+// ----------------------------------------------------------------------
+// Test query() with data stored in more than one block of points along each axis.
+void
+spatialdata::spatialdb::TestSimpleGridDB::testQueryMultipleBlocks(void) {
+    const size_t numX = 11;
+    const size_t numY = 19;
+    const size_t numZ = 10;
+    const size_t numLocs = numX*numY*numZ;
+    const size_t spaceDim = 3;
+    const size_t numValues = 2;
+    const double dx = 10.0;
+    const double tolerance = 1.0e-6;
+
+    // Values are linear functions of the coordinates, so linear interpolation is exact.
+    std::vector<double> x(numX);
+    std::vector<double> y(numY);
+    std::vector<double> z(numZ);
+    for (size_t i = 0; i < numX; ++i) {
+        x[i] = dx*i;
+    } // for
+    for (size_t i = 0; i < numY; ++i) {
+        y[i] = -100.0 + dx*i;
+    } // for
+    for (size_t i = 0; i < numZ; ++i) {
+        z[i] = -dx*(numZ-1) + dx*i;
+    } // for
+    std::vector<double> coords(numLocs*spaceDim);
+    std::vector<double> values(numLocs*numValues);
+    for (size_t iZ = 0, iLoc = 0; iZ < numZ; ++iZ) {
+        for (size_t iY = 0; iY < numY; ++iY) {
+            for (size_t iX = 0; iX < numX; ++iX, ++iLoc) {
+                coords[iLoc*spaceDim+0] = x[iX];
+                coords[iLoc*spaceDim+1] = y[iY];
+                coords[iLoc*spaceDim+2] = z[iZ];
+                values[iLoc*numValues+0] = 1.0 + 2.0*x[iX] - 3.0*y[iY] + 0.5*z[iZ];
+                values[iLoc*numValues+1] = 4.0*iLoc;
+            } // for
+        } // for
+    } // for
+
+    const char* names[numValues] = { "one", "two" };
+    const char* units[numValues] = { "m", "m" };
+    spatialdata::geocoords::CSCart cs;
+    cs.setSpaceDim(spaceDim);
+
+    SimpleGridDB dbOut;
+    dbOut.setCoordSys(cs);
+    dbOut.allocate(numX, numY, numZ, numValues, spaceDim, spaceDim);
+    dbOut.setX(&x[0], numX);
+    dbOut.setY(&y[0], numY);
+    dbOut.setZ(&z[0], numZ);
+    dbOut.setData(&coords[0], numLocs, spaceDim, &values[0], numLocs, numValues);
+    dbOut.setNames(names, numValues);
+    dbOut.setUnits(units, numValues);
+    dbOut.setFilename("data/grid_blocks.spatialdb");
+    SimpleGridAscii::write(dbOut);
+    dbOut.setFilename("data/grid_blocks.bin_spatialdb");
+    SimpleGridBinary::write(dbOut);
+
+    SimpleGridDB db;
+    db.setFilename("data/grid_blocks.spatialdb");
+    db.setUseBlockedLayout(true);
+    CHECK(db.getUseBlockedLayout());
+    db.open();
+    CHECK(2 == db._numBlocks[0]);
+    CHECK(3 == db._numBlocks[1]);
+
+    // Every grid point, queried slightly away from the point.
+    db.setQueryType(SimpleGridDB::NEAREST);
+    double vals[numValues];
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        const double xyz[spaceDim] = {
+            coords[iLoc*spaceDim+0] + 0.2*dx,
+            coords[iLoc*spaceDim+1] - 0.3*dx,
+            coords[iLoc*spaceDim+2] + 0.1*dx,
+        };
+        INFO("iLoc=" << iLoc);
+        REQUIRE(0 == db.query(vals, numValues, xyz, spaceDim, &cs));
+        CHECK(values[iLoc*numValues+0] == vals[0]);
+        CHECK(values[iLoc*numValues+1] == vals[1]);
+    } // for
+
+    // Points inside every cell, including cells spanning blocks.
+    db.setQueryType(SimpleGridDB::LINEAR);
+    for (size_t iZ = 0; iZ+1 < numZ; ++iZ) {
+        for (size_t iY = 0; iY+1 < numY; ++iY) {
+            for (size_t iX = 0; iX+1 < numX; ++iX) {
+                const double xyz[spaceDim] = { x[iX] + 0.3*dx, y[iY] + 0.6*dx, z[iZ] + 0.8*dx };
+                const double valueE = 1.0 + 2.0*xyz[0] - 3.0*xyz[1] + 0.5*xyz[2];
+                INFO("iX=" << iX << ", iY=" << iY << ", iZ=" << iZ);
+                REQUIRE(0 == db.query(vals, numValues, xyz, spaceDim, &cs));
+                CHECK_THAT(vals[0], Catch::Matchers::WithinAbs(valueE, tolerance*fabs(valueE)));
+            } // for
+        } // for
+    } // for
+    db.close();
+
+    // Memory-mapped data keep the order of the file.
+    SimpleGridDB dbMapped;
+    dbMapped.setFilename("data/grid_blocks.bin_spatialdb");
+    dbMapped.setUseBlockedLayout(true);
+    dbMapped.open();
+    CHECK(0 == dbMapped._numBlocks[0]);
+    dbMapped.setQueryType(SimpleGridDB::NEAREST);
+    const size_t iLoc = numLocs-1;
+    REQUIRE(0 == dbMapped.query(vals, numValues, &coords[iLoc*spaceDim], spaceDim, &cs));
+    CHECK(values[iLoc*numValues+0] == vals[0]);
+    CHECK(values[iLoc*numValues+1] == vals[1]);
+    dbMapped.close();
+} // testQueryMultipleBlocks
+
+
 // ----------------------------------------------------------------------
 // Test read().
 void
@@ -48,6 +48,10 @@ public:
     static
     void testDataIndex(void);
 
+    /// Test query() with data stored in more than one block of points along each axis.
+    static
+    void testQueryMultipleBlocks(void);
+
     /// Test getNamesDBValues().
     void testGetNamesDBValues(void);
 
@@ -57,6 +61,15 @@ public:
     /// Test query() using linear interpolation.
     void testQueryLinear(void);
 
+    /// Test multiquery() using nearest neighbor and linear interpolation.
+    void testMultiquery(void);
+
+    /// Test querying with query context.
+    void testQueryContext(void);
+
+    /// Test query() with data stored in blocks of points.
+    void testQueryBlocked(void);
+
     /// Test read().
     void testRead(void);
 
@@ -0,0 +1,209 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "Benchmark.hh" // USES Benchmark
+
+#include "spatialdata/spatialdb/SimpleGridDB.hh" // USES SimpleGridDB
+#include "spatialdata/spatialdb/SimpleGridAscii.hh" // USES SimpleGridAscii
+
+#include "spatialdata/geocoords/CSCart.hh" // USES CSCart
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <string> // USES std::string
+#include <vector> // USES std::vector
+#include <cassert>
+
+// ------------------------------------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        class TestSimpleGridDB_Benchmark;
+    } // spatialdb
+} // spatialdata
+
+// ------------------------------------------------------------------------------------------------
+class spatialdata::spatialdb::TestSimpleGridDB_Benchmark {
+public:
+
+    /** Benchmark querying a large 3-D grid with data stored in linear order versus in blocks of
+     * points, with query points in storage order (coherent) and in random order.
+     *
+     * @param queryType Type of query.
+     */
+    static
+    void benchmarkQuery(const SimpleGridDB::QueryEnum queryType);
+
+private:
+
+    /// Write ASCII spatial database with large 3-D grid (binary files are memory-mapped and not blocked).
+    static
+    void _writeGrid(void);
+
+    /** Query points one at a time.
+     *
+     * @param values Array for values.
+     * @param db Spatial database.
+     * @param points Coordinates of points.
+     * @returns Time in seconds.
+     */
+    static
+    double _query(std::vector<double>* values,
+                  SimpleGridDB& db,
+                  const std::vector<double>& points);
+
+    static const size_t _numPoints; ///< Number of grid points along each axis.
+    static const double _spacing; ///< Spacing of grid points.
+    static const size_t _numQueries; ///< Number of query points.
+    static const char* _filename; ///< Name of spatial database file.
+
+}; // TestSimpleGridDB_Benchmark
+const size_t spatialdata::spatialdb::TestSimpleGridDB_Benchmark::_numPoints = 128;
+const double spatialdata::spatialdb::TestSimpleGridDB_Benchmark::_spacing = 10.0;
+const size_t spatialdata::spatialdb::TestSimpleGridDB_Benchmark::_numQueries = 500000;
+const char* spatialdata::spatialdb::TestSimpleGridDB_Benchmark::_filename = "data/grid_benchmark.spatialdb";
+
+// ------------------------------------------------------------------------------------------------
+// Benchmarks are hidden; run them with `libtest_spatialdb "[benchmark]"`.
+TEST_CASE("TestSimpleGridDB::benchmarkQuery::nearest", "[TestSimpleGridDB][benchmark][.]") {
+    spatialdata::spatialdb::TestSimpleGridDB_Benchmark::benchmarkQuery(spatialdata::spatialdb::SimpleGridDB::NEAREST);
+}
+TEST_CASE("TestSimpleGridDB::benchmarkQuery::linear", "[TestSimpleGridDB][benchmark][.]") {
+    spatialdata::spatialdb::TestSimpleGridDB_Benchmark::benchmarkQuery(spatialdata::spatialdb::SimpleGridDB::LINEAR);
+}
+
+// ------------------------------------------------------------------------------------------------
+void
+spatialdata::spatialdb::TestSimpleGridDB_Benchmark::benchmarkQuery(const SimpleGridDB::QueryEnum queryType) {
+    _writeGrid();
+
+    std::vector<double> coherent;
+    testing::Benchmark::createLinePoints(&coherent, _numQueries, _numPoints, _spacing);
+    std::vector<double> random(coherent);
+    testing::Benchmark::shufflePoints(&random, 3);
+
+    const char* valueNames[1] = { "one" };
+
+    SimpleGridDB dbLinear;
+    dbLinear.setFilename(_filename);
+    dbLinear.open();
+    dbLinear.setQueryType(queryType);
+    dbLinear.setQueryValues(valueNames, 1);
+
+    SimpleGridDB dbBlocked;
+    dbBlocked.setFilename(_filename);
+    dbBlocked.setUseBlockedLayout(true);
+    dbBlocked.open();
+    dbBlocked.setQueryType(queryType);
+    dbBlocked.setQueryValues(valueNames, 1);
+
+    std::vector<double> valuesLinear;
+    std::vector<double> valuesBlocked;
+    const std::string label = std::string("SimpleGridDB ") + ((SimpleGridDB::NEAREST == queryType) ? "nearest" : "linear");
+
+    double secondsLinear = _query(&valuesLinear, dbLinear, coherent);
+    double secondsBlocked = _query(&valuesBlocked, dbBlocked, coherent);
+    for (size_t i = 0; i < _numQueries; ++i) {
+        REQUIRE(valuesLinear[i] == valuesBlocked[i]);
+    } // for
+    testing::Benchmark::reportSpeedup((label + ", coherent queries").c_str(), "linear layout", "blocked layout",
+                                      _numQueries, secondsLinear, secondsBlocked);
+
+    secondsLinear = _query(&valuesLinear, dbLinear, random);
+    secondsBlocked = _query(&valuesBlocked, dbBlocked, random);
+    for (size_t i = 0; i < _numQueries; ++i) {
+        REQUIRE(valuesLinear[i] == valuesBlocked[i]);
+    } // for
+    testing::Benchmark::reportSpeedup((label + ", random queries").c_str(), "linear layout", "blocked layout",
+                                      _numQueries, secondsLinear, secondsBlocked);
+
+    dbLinear.close();
+    dbBlocked.close();
+} // benchmarkQuery
+
+
+// ------------------------------------------------------------------------------------------------
+void
+spatialdata::spatialdb::TestSimpleGridDB_Benchmark::_writeGrid(void) {
+    const size_t numX = _numPoints;
+    const size_t numY = _numPoints;
+    const size_t numZ = _numPoints;
+    const size_t numLocs = numX*numY*numZ;
+    const size_t spaceDim = 3;
+    const double dx = _spacing;
+
+    std::vector<double> x(numX);
+    std::vector<double> y(numY);
+    std::vector<double> z(numZ);
+    for (size_t i = 0; i < _numPoints; ++i) {
+        x[i] = dx*i;
+        y[i] = dx*i;
+        z[i] = -dx*(_numPoints-1) + dx*i;
+    } // for
+
+    std::vector<double> coords(numLocs*spaceDim);
+    std::vector<double> values(numLocs);
+    for (size_t iZ = 0, iLoc = 0; iZ < numZ; ++iZ) {
+        for (size_t iY = 0; iY < numY; ++iY) {
+            for (size_t iX = 0; iX < numX; ++iX, ++iLoc) {
+                coords[iLoc*spaceDim+0] = x[iX];
+                coords[iLoc*spaceDim+1] = y[iY];
+                coords[iLoc*spaceDim+2] = z[iZ];
+                values[iLoc] = 1000.0 + 0.5*x[iX] - 0.25*y[iY] - z[iZ];
+            } // for
+        } // for
+    } // for
+
+    const char* names[1] = { "one" };
+    const char* units[1] = { "m" };
+
+    spatialdata::geocoords::CSCart cs;
+    cs.setSpaceDim(spaceDim);
+
+    SimpleGridDB db;
+    db.setCoordSys(cs);
+    db.allocate(numX, numY, numZ, 1, spaceDim, 3);
+    db.setX(&x[0], numX);
+    db.setY(&y[0], numY);
+    db.setZ(&z[0], numZ);
+    db.setData(&coords[0], numLocs, spaceDim, &values[0], numLocs, 1);
+    db.setNames(names, 1);
+    db.setUnits(units, 1);
+    db.setFilename(_filename);
+    SimpleGridAscii::write(db);
+} // _writeGrid
+
+
+// ------------------------------------------------------------------------------------------------
+double
+spatialdata::spatialdb::TestSimpleGridDB_Benchmark::_query(std::vector<double>* values,
+                                                           SimpleGridDB& db,
+                                                           const std::vector<double>& points) {
+    assert(values);
+
+    const size_t spaceDim = 3;
+    spatialdata::geocoords::CSCart cs;
+    cs.setSpaceDim(spaceDim);
+
+    values->resize(_numQueries);
+    int numErrors = 0;
+    const testing::Benchmark::Stopwatch stopwatch;
+    for (size_t i = 0; i < _numQueries; ++i) {
+        numErrors += db.query(&(*values)[i], 1, &points[i*spaceDim], spaceDim, &cs);
+    } // for
+    const double seconds = stopwatch.seconds();
+    REQUIRE(0 == numErrors);
+
+    return seconds;
+} // _query
+
+
+// End of file
@@ -64,6 +64,9 @@ TEST_CASE("TestSimpleGridDB::testSearch", "[TestSimpleGridDB]") {
 TEST_CASE("TestSimpleGridDB::testDataIndex", "[TestSimpleGridDB]") {
     spatialdata::spatialdb::TestSimpleGridDB::testDataIndex();
 }
+TEST_CASE("TestSimpleGridDB::testQueryBlocked::multipleBlocks", "[TestSimpleGridDB]") {
+    spatialdata::spatialdb::TestSimpleGridDB::testQueryMultipleBlocks();
+}
 
 // Data test cases
 TEST_CASE("TestSimpleGridDB::testGetNamesDBValues", "[TestSimpleGridDB][Line1D]") {
@@ -75,6 +78,15 @@ TEST_CASE("TestSimpleGridDB::testQueryNearest", "[TestSimpleGridDB][Line1D]") {
 TEST_CASE("TestSimpleGridDB::testQueryLinear", "[TestSimpleGridDB][Line1D]") {
     spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line1D()).testQueryLinear();
 }
+TEST_CASE("TestSimpleGridDB::testMultiquery", "[TestSimpleGridDB][Line1D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line1D()).testMultiquery();
+}
+TEST_CASE("TestSimpleGridDB::testQueryContext", "[TestSimpleGridDB][Line1D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line1D()).testQueryContext();
+}
+TEST_CASE("TestSimpleGridDB::testQueryBlocked", "[TestSimpleGridDB][Line1D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line1D()).testQueryBlocked();
+}
 TEST_CASE("TestSimpleGridDB::testRead", "[TestSimpleGridDB][Line1D]") {
     spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line1D()).testRead();
 }
@@ -88,6 +100,15 @@ TEST_CASE("TestSimpleGridDB::testQueryNearest", "[TestSimpleGridDB][Line2D]") {
 TEST_CASE("TestSimpleGridDB::testQueryLinear", "[TestSimpleGridDB][Line2D]") {
     spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line2D()).testQueryLinear();
 }
+TEST_CASE("TestSimpleGridDB::testMultiquery", "[TestSimpleGridDB][Line2D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line2D()).testMultiquery();
+}
+TEST_CASE("TestSimpleGridDB::testQueryContext", "[TestSimpleGridDB][Line2D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line2D()).testQueryContext();
+}
+TEST_CASE("TestSimpleGridDB::testQueryBlocked", "[TestSimpleGridDB][Line2D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line2D()).testQueryBlocked();
+}
 TEST_CASE("TestSimpleGridDB::testRead", "[TestSimpleGridDB][Line2D]") {
     spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line2D()).testRead();
 }
@@ -101,6 +122,15 @@ TEST_CASE("TestSimpleGridDB::testQueryNearest", "[TestSimpleGridDB][Line3D]") {
 TEST_CASE("TestSimpleGridDB::testQueryLinear", "[TestSimpleGridDB][Line3D]") {
     spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line3D()).testQueryLinear();
 }
+TEST_CASE("TestSimpleGridDB::testMultiquery", "[TestSimpleGridDB][Line3D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line3D()).testMultiquery();
+}
+TEST_CASE("TestSimpleGridDB::testQueryContext", "[TestSimpleGridDB][Line3D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line3D()).testQueryContext();
+}
+TEST_CASE("TestSimpleGridDB::testQueryBlocked", "[TestSimpleGridDB][Line3D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line3D()).testQueryBlocked();
+}
 TEST_CASE("TestSimpleGridDB::testRead", "[TestSimpleGridDB][Line3D]") {
     spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Line3D()).testRead();
 }
@@ -114,6 +144,15 @@ TEST_CASE("TestSimpleGridDB::testQueryNearest", "[TestSimpleGridDB][Area2D]") {
 TEST_CASE("TestSimpleGridDB::testQueryLinear", "[TestSimpleGridDB][Area2D]") {
     spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Area2D()).testQueryLinear();
 }
+TEST_CASE("TestSimpleGridDB::testMultiquery", "[TestSimpleGridDB][Area2D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Area2D()).testMultiquery();
+}
+TEST_CASE("TestSimpleGridDB::testQueryContext", "[TestSimpleGridDB][Area2D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Area2D()).testQueryContext();
+}
+TEST_CASE("TestSimpleGridDB::testQueryBlocked", "[TestSimpleGridDB][Area2D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Area2D()).testQueryBlocked();
+}
 TEST_CASE("TestSimpleGridDB::testRead", "[TestSimpleGridDB][Area2D]") {
     spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Area2D()).testRead();
 }
@@ -127,6 +166,15 @@ TEST_CASE("TestSimpleGridDB::testQueryNearest", "[TestSimpleGridDB][Area3D]") {
 TEST_CASE("TestSimpleGridDB::testQueryLinear", "[TestSimpleGridDB][Area3D]") {
     spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Area3D()).testQueryLinear();
 }
+TEST_CASE("TestSimpleGridDB::testMultiquery", "[TestSimpleGridDB][Area3D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Area3D()).testMultiquery();
+}
+TEST_CASE("TestSimpleGridDB::testQueryContext", "[TestSimpleGridDB][Area3D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Area3D()).testQueryContext();
+}
+TEST_CASE("TestSimpleGridDB::testQueryBlocked", "[TestSimpleGridDB][Area3D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Area3D()).testQueryBlocked();
+}
 TEST_CASE("TestSimpleGridDB::testRead", "[TestSimpleGridDB][Area3D]") {
     spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Area3D()).testRead();
 }
@@ -140,6 +188,15 @@ TEST_CASE("TestSimpleGridDB::testQueryNearest", "[TestSimpleGridDB][Volume3D]")
 TEST_CASE("TestSimpleGridDB::testQueryLinear", "[TestSimpleGridDB][Volume3D]") {
     spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Volume3D()).testQueryLinear();
 }
+TEST_CASE("TestSimpleGridDB::testMultiquery", "[TestSimpleGridDB][Volume3D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Volume3D()).testMultiquery();
+}
+TEST_CASE("TestSimpleGridDB::testQueryContext", "[TestSimpleGridDB][Volume3D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Volume3D()).testQueryContext();
+}
+TEST_CASE("TestSimpleGridDB::testQueryBlocked", "[TestSimpleGridDB][Volume3D]") {
+    spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Volume3D()).testQueryBlocked();
+}
 TEST_CASE("TestSimpleGridDB::testRead", "[TestSimpleGridDB][Volume3D]") {
     spatialdata::spatialdb::TestSimpleGridDB(spatialdata::spatialdb::TestSimpleGridDB_Cases::Volume3D()).testRead();
 }
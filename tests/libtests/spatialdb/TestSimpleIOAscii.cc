@@ -18,6 +18,8 @@
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/matchers/catch_matchers_floating_point.hpp"
 
+#include <fstream> // USES std::ofstream
+#include <stdexcept> // USES std::runtime_error
 #include <cmath> // USES fabs()
 
 // ----------------------------------------------------------------------
@@ -40,6 +42,35 @@ public:
     static
     void testReadComments(void);
 
+    /// Test read() with lines in data section that have extra columns.
+    static
+    void testReadExtraColumns(void);
+
+    /// Test read() with lines in data section that are missing values.
+    static
+    void testReadErrors(void);
+
+    // PRIVATE METHODS ////////////////////////////////////////////////////
+private:
+
+    /** Write spatial database file with 3 points and 2 values.
+     *
+     * @param filename Name of spatial database file.
+     * @param dataSection Data section of spatial database file.
+     */
+    static
+    void _writeDB(const char* filename,
+                  const char* dataSection);
+
+    /** Write spatial database file and check that reading it fails.
+     *
+     * @param dataSection Data section of spatial database file.
+     * @param message Text expected in error message.
+     */
+    static
+    void _checkReadError(const char* dataSection,
+                         const char* message);
+
 }; // class TestSimpleIOAscii
 
 // ------------------------------------------------------------------------------------------------
@@ -49,6 +80,12 @@ TEST_CASE("TestSimpleIOAscii::testWriteRead", "[TestSimpleIOAscii]") {
 TEST_CASE("TestSimpleIOAscii::testReadComments", "[TestSimpleIOAscii]") {
     spatialdata::spatialdb::TestSimpleIOAscii::testReadComments();
 }
+TEST_CASE("TestSimpleIOAscii::testReadExtraColumns", "[TestSimpleIOAscii]") {
+    spatialdata::spatialdb::TestSimpleIOAscii::testReadExtraColumns();
+}
+TEST_CASE("TestSimpleIOAscii::testReadErrors", "[TestSimpleIOAscii]") {
+    spatialdata::spatialdb::TestSimpleIOAscii::testReadErrors();
+}
 
 // ----------------------------------------------------------------------
 // Test filename(), write(), read().
@@ -186,4 +223,112 @@ spatialdata::spatialdb::TestSimpleIOAscii::testReadComments(void) {
 } // testReadComments
 
 
+// ----------------------------------------------------------------------
+// Test read() with lines in data section that have extra columns.
+void
+spatialdata::spatialdb::TestSimpleIOAscii::testReadExtraColumns(void) {
+    const size_t spaceDimE = 3;
+    const size_t numLocsE = 3;
+    const size_t numValsE = 2;
+    const double coordsE[numLocsE*spaceDimE] = {
+        0.6, 0.1, 0.2,
+        1.0, 1.1, 1.2,
+        4.7, 9.5, 8.7,
+    };
+    const double dataE[numLocsE*numValsE] = {
+        6.6, 3.4,
+        5.5, 6.7,
+        2.3, 4.1,
+    };
+
+    // Columns after coordinates and values are ignored.
+    const char* filename = "data/spatial_extracolumns.dat";
+    _writeDB(filename, "0.6 0.1 0.2  6.6 3.4  9.9\n1.0 1.1 1.2  5.5 6.7  9.9 note\n4.7 9.5 8.7  2.3 4.1\n");
+
+    SimpleIOAscii dbIO;
+    dbIO.setFilename(filename);
+    SimpleDBData dataIn;
+    geocoords::CoordSys* csIn = NULL;
+    dbIO.read(&dataIn, &csIn);
+
+    REQUIRE(numLocsE == dataIn.getNumLocs());
+    REQUIRE(numValsE == dataIn.getNumValues());
+    REQUIRE(spaceDimE == dataIn.getSpaceDim());
+    for (size_t iLoc = 0; iLoc < numLocsE; ++iLoc) {
+        const double* coordinates = dataIn.getCoordinates(iLoc);
+        for (size_t iDim = 0; iDim < spaceDimE; ++iDim) {
+            CHECK(coordsE[iLoc*spaceDimE+iDim] == coordinates[iDim]);
+        } // for
+        const double* values = dataIn.getData(iLoc);
+        for (size_t iVal = 0; iVal < numValsE; ++iVal) {
+            CHECK(dataE[iLoc*numValsE+iVal] == values[iVal]);
+        } // for
+    } // for
+
+    delete csIn;csIn = NULL;
+} // testReadExtraColumns
+
+
+// ----------------------------------------------------------------------
+// Test read() with lines in data section that are missing values.
+void
+spatialdata::spatialdb::TestSimpleIOAscii::testReadErrors(void) {
+    // Missing value in line before last line must not shift values from following lines.
+    _checkReadError("0.6 0.1 0.2  6.6 3.4\n1.0 1.1 1.2  5.5\n4.7 9.5 8.7  2.3 4.1\n4.7 9.5 8.7  2.3 4.1\n",
+                    "'1.0 1.1 1.2  5.5'");
+
+    // Last line without end-of-line character.
+    _checkReadError("0.6 0.1 0.2  6.6 3.4\n1.0 1.1 1.2  5.5 6.7\n4.7 9.5 8.7  2.3 4.1",
+                    "end-of-line character");
+} // testReadErrors
+
+
+// ----------------------------------------------------------------------
+// Write spatial database file with 3 points and 2 values.
+void
+spatialdata::spatialdb::TestSimpleIOAscii::_writeDB(const char* filename,
+                                                    const char* dataSection) {
+    std::ofstream fileout(filename);
+    REQUIRE(fileout.is_open());
+    fileout
+        << "#SPATIAL.ascii 1\n"
+        << "SimpleDB {\n"
+        << "  num-values = 2\n"
+        << "  value-names = One Two\n"
+        << "  value-units = m m\n"
+        << "  num-locs = 3\n"
+        << "  data-dim = 2\n"
+        << "  cs-data = cartesian {\n"
+        << "    to-meters = 1.0\n"
+        << "  }\n"
+        << "}\n"
+        << dataSection;
+    fileout.close();
+} // _writeDB
+
+
+// ----------------------------------------------------------------------
+// Write spatial database file and check that reading it fails.
+void
+spatialdata::spatialdb::TestSimpleIOAscii::_checkReadError(const char* dataSection,
+                                                           const char* message) {
+    const char* filename = "data/spatial_errors.dat";
+    _writeDB(filename, dataSection);
+
+    SimpleIOAscii dbIO;
+    dbIO.setFilename(filename);
+    SimpleDBData dataIn;
+    geocoords::CoordSys* csIn = NULL;
+    INFO("Data section: '" << dataSection << "'");
+    try {
+        dbIO.read(&dataIn, &csIn);
+        FAIL("Expected reading spatial database to fail.");
+    } catch (const std::runtime_error& err) {
+        INFO("Error message: " << err.what());
+        CHECK(std::string::npos != std::string(err.what()).find(message));
+    } // try/catch
+    delete csIn;csIn = NULL;
+} // _checkReadError
+
+
 // End of file
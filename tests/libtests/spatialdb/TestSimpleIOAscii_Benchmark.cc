@@ -0,0 +1,272 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "Benchmark.hh" // USES Benchmark
+
+#include "spatialdata/spatialdb/SimpleIOAscii.hh" // USES SimpleIOAscii
+#include "spatialdata/spatialdb/SimpleDBData.hh" // USES SimpleDBData
+#include "spatialdata/spatialdb/SimpleGridAscii.hh" // USES SimpleGridAscii
+#include "spatialdata/spatialdb/SimpleGridDB.hh" // USES SimpleGridDB
+#include "spatialdata/geocoords/CSCart.hh" // USES CSCart
+#include "spatialdata/utils/LineParser.hh" // USES LineParser
+
+#include "catch2/catch_test_macros.hpp"
+
+#include <fstream> // USES std::ifstream
+#include <sstream> // USES std::istringstream
+#include <vector> // USES std::vector
+#include <cstdio> // USES remove()
+
+// ------------------------------------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        class TestSimpleIOAscii_Benchmark;
+    } // spatialdb
+} // spatialdata
+
+// ------------------------------------------------------------------------------------------------
+class spatialdata::spatialdb::TestSimpleIOAscii_Benchmark {
+public:
+
+    /** Benchmark reading SimpleDB ASCII file.
+     *
+     * @param numLocs Number of locations in file.
+     */
+    static
+    void benchmarkSimpleDB(const size_t numLocs);
+
+    /** Benchmark reading SimpleGridDB ASCII file.
+     *
+     * @param numX Number of locations along each coordinate axis.
+     */
+    static
+    void benchmarkSimpleGridDB(const size_t numX);
+
+private:
+
+    /** Read numeric data section using stream extraction, for reference.
+     *
+     * @param filename Name of file.
+     * @param numValues Number of values to read.
+     * @returns Sum of values.
+     */
+    static
+    double _readStreamExtraction(const char* filename,
+                                 const size_t numValues);
+
+    /** Report read rate in MB/s.
+     *
+     * @param label Label for benchmark.
+     * @param filename Name of file.
+     * @param seconds Time to read file once.
+     */
+    static
+    void _report(const char* label,
+                 const char* filename,
+                 const double seconds);
+
+    static const size_t _numRepeat; ///< Number of times to read each file.
+
+}; // TestSimpleIOAscii_Benchmark
+const size_t spatialdata::spatialdb::TestSimpleIOAscii_Benchmark::_numRepeat = 3;
+
+// ------------------------------------------------------------------------------------------------
+// Benchmarks are hidden; run them with `libtest_spatialdb "[benchmark]"`.
+TEST_CASE("TestSimpleIOAscii::benchmarkRead::100000", "[TestSimpleIOAscii][benchmark][.]") {
+    spatialdata::spatialdb::TestSimpleIOAscii_Benchmark::benchmarkSimpleDB(100000);
+}
+TEST_CASE("TestSimpleIOAscii::benchmarkRead::1000000", "[TestSimpleIOAscii][benchmark][.]") {
+    spatialdata::spatialdb::TestSimpleIOAscii_Benchmark::benchmarkSimpleDB(1000000);
+}
+TEST_CASE("TestSimpleGridAscii::benchmarkRead::50", "[TestSimpleGridAscii][benchmark][.]") {
+    spatialdata::spatialdb::TestSimpleIOAscii_Benchmark::benchmarkSimpleGridDB(50);
+}
+TEST_CASE("TestSimpleGridAscii::benchmarkRead::100", "[TestSimpleGridAscii][benchmark][.]") {
+    spatialdata::spatialdb::TestSimpleIOAscii_Benchmark::benchmarkSimpleGridDB(100);
+}
+
+// ------------------------------------------------------------------------------------------------
+// Benchmark reading SimpleDB ASCII file.
+void
+spatialdata::spatialdb::TestSimpleIOAscii_Benchmark::benchmarkSimpleDB(const size_t numLocs) {
+    const size_t spaceDim = 3;
+    const size_t numValues = 3;
+    const char* names[numValues] = { "one", "two", "three" };
+    const char* units[numValues] = { "m", "s", "m/s" };
+
+    // Scattered locations in unit cube from linear congruential generator.
+    std::vector<double> coordinates(numLocs*spaceDim);
+    std::vector<double> values(numLocs*numValues);
+    testing::Benchmark::Random random;
+    for (size_t i = 0; i < numLocs*spaceDim; ++i) {
+        coordinates[i] = random.next();
+    } // for
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        const double* xyz = &coordinates[iLoc*spaceDim];
+        values[iLoc*numValues+0] = 1.0 + 2.0*xyz[0];
+        values[iLoc*numValues+1] = 3.0 - 1.5*xyz[1] + xyz[2];
+        values[iLoc*numValues+2] = xyz[0] + xyz[1] + xyz[2];
+    } // for
+
+    SimpleDBData dataOut;
+    dataOut.allocate(numLocs, numValues, spaceDim, spaceDim);
+    dataOut.setCoordinates(&coordinates[0], numLocs, spaceDim);
+    dataOut.setData(&values[0], numLocs, numValues);
+    dataOut.setNames(names, numValues);
+    dataOut.setUnits(units, numValues);
+
+    const char* filename = "data/benchmark_simpledb.spatialdb";
+    geocoords::CSCart cs;
+    SimpleIOAscii io;
+    io.setFilename(filename);
+    io.write(dataOut, &cs);
+
+    double seconds = 0.0;
+    for (size_t i = 0; i < _numRepeat; ++i) {
+        SimpleDBData dataIn;
+        geocoords::CoordSys* csIn = NULL;
+        const testing::Benchmark::Stopwatch stopwatch;
+        io.read(&dataIn, &csIn);
+        seconds += stopwatch.seconds();
+        CHECK(numLocs == dataIn.getNumLocs());
+        delete csIn;csIn = NULL;
+    } // for
+    _report("SimpleIOAscii::read()", filename, seconds / _numRepeat);
+
+    seconds = 0.0;
+    for (size_t i = 0; i < _numRepeat; ++i) {
+        const testing::Benchmark::Stopwatch stopwatch;
+        _readStreamExtraction(filename, numLocs*(spaceDim+numValues));
+        seconds += stopwatch.seconds();
+    } // for
+    _report("Stream extraction (reference)", filename, seconds / _numRepeat);
+
+    remove(filename);
+} // benchmarkSimpleDB
+
+
+// ------------------------------------------------------------------------------------------------
+// Benchmark reading SimpleGridDB ASCII file.
+void
+spatialdata::spatialdb::TestSimpleIOAscii_Benchmark::benchmarkSimpleGridDB(const size_t numX) {
+    const size_t spaceDim = 3;
+    const size_t numValues = 3;
+    const size_t numLocs = numX*numX*numX;
+    const char* names[numValues] = { "one", "two", "three" };
+    const char* units[numValues] = { "m", "s", "m/s" };
+
+    std::vector<double> x(numX);
+    for (size_t i = 0; i < numX; ++i) {
+        x[i] = -1.0e+3 + 2.0e+3 * double(i) / double(numX-1);
+    } // for
+    std::vector<double> coordinates(numLocs*spaceDim);
+    std::vector<double> values(numLocs*numValues);
+    for (size_t iZ = 0, iLoc = 0; iZ < numX; ++iZ) {
+        for (size_t iY = 0; iY < numX; ++iY) {
+            for (size_t iX = 0; iX < numX; ++iX, ++iLoc) {
+                double* xyz = &coordinates[iLoc*spaceDim];
+                xyz[0] = x[iX];
+                xyz[1] = x[iY];
+                xyz[2] = x[iZ];
+                values[iLoc*numValues+0] = 1.0 + 2.0*xyz[0];
+                values[iLoc*numValues+1] = 3.0 - 1.5*xyz[1] + xyz[2];
+                values[iLoc*numValues+2] = xyz[0] + xyz[1] + xyz[2];
+            } // for
+        } // for
+    } // for
+
+    geocoords::CSCart cs;
+    SimpleGridDB dbOut;
+    dbOut.setCoordSys(cs);
+    dbOut.allocate(numX, numX, numX, numValues, spaceDim, spaceDim);
+    dbOut.setX(&x[0], numX);
+    dbOut.setY(&x[0], numX);
+    dbOut.setZ(&x[0], numX);
+    dbOut.setData(&coordinates[0], numLocs, spaceDim, &values[0], numLocs, numValues);
+    dbOut.setNames(names, numValues);
+    dbOut.setUnits(units, numValues);
+
+    const char* filename = "data/benchmark_simplegriddb.spatialdb";
+    dbOut.setFilename(filename);
+    SimpleGridAscii::write(dbOut);
+
+    double seconds = 0.0;
+    for (size_t i = 0; i < _numRepeat; ++i) {
+        SimpleGridDB dbIn;
+        dbIn.setFilename(filename);
+        const testing::Benchmark::Stopwatch stopwatch;
+        SimpleGridAscii::read(&dbIn);
+        seconds += stopwatch.seconds();
+    } // for
+    _report("SimpleGridAscii::read()", filename, seconds / _numRepeat);
+
+    seconds = 0.0;
+    for (size_t i = 0; i < _numRepeat; ++i) {
+        const testing::Benchmark::Stopwatch stopwatch;
+        _readStreamExtraction(filename, 3*numX + numLocs*(spaceDim+numValues));
+        seconds += stopwatch.seconds();
+    } // for
+    _report("Stream extraction (reference)", filename, seconds / _numRepeat);
+
+    remove(filename);
+} // benchmarkSimpleGridDB
+
+
+// ------------------------------------------------------------------------------------------------
+// Read numeric data section using stream extraction, for reference.
+double
+spatialdata::spatialdb::TestSimpleIOAscii_Benchmark::_readStreamExtraction(const char* filename,
+                                                                            const size_t numValues) {
+    std::ifstream filein(filename);
+    utils::LineParser parser(filein, "//", 32768);
+    parser.eatwhitespace(true);
+
+    // Skip header.
+    std::string line;
+    do {
+        line = parser.next();
+    } while (filein.good() && std::string::npos == line.find('}'));
+    line = parser.next();
+    while (filein.good() && std::string::npos != line.find('}')) {
+        line = parser.next();
+    } // while
+
+    std::istringstream buffer;
+    double sum = 0.0;
+    double value = 0.0;
+    buffer.str(line);
+    for (size_t i = 0; i < numValues; ++i) {
+        buffer >> value;
+        while (!buffer && filein.good()) {
+            buffer.str(parser.next());
+            buffer.clear();
+            buffer >> value;
+        } // while
+        sum += value;
+    } // for
+    return sum;
+} // _readStreamExtraction
+
+
+// ------------------------------------------------------------------------------------------------
+// Report read rate.
+void
+spatialdata::spatialdb::TestSimpleIOAscii_Benchmark::_report(const char* label,
+                                                             const char* filename,
+                                                             const double seconds) {
+    std::ifstream filein(filename, std::ios::in | std::ios::binary | std::ios::ate);
+    const double megabytes = double(filein.tellg()) / (1024.0*1024.0);
+    testing::Benchmark::reportRate(label, megabytes, "MB", seconds);
+} // _report
+
+
+// End of file
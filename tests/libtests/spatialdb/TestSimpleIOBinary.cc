@@ -0,0 +1,300 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "spatialdata/spatialdb/SimpleIOBinary.hh" // Test subject
+
+#include "spatialdata/spatialdb/SimpleIOAscii.hh" // USES SimpleIOAscii
+#include "spatialdata/spatialdb/SimpleDB.hh" // USES SimpleDB
+#include "spatialdata/spatialdb/SimpleDBData.hh" // USES SimpleDBData
+#include "spatialdata/geocoords/CSCart.hh" // USES CSCart
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include <fstream> // USES std::ifstream, std::ofstream
+#include <stdexcept> // USES std::runtime_error
+#include <cmath> // USES fabs()
+
+// ----------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        class TestSimpleIOBinary;
+    } // spatialdb
+} // spatialdata
+
+class spatialdata::spatialdb::TestSimpleIOBinary {
+    // PUBLIC METHODS /////////////////////////////////////////////////////
+public:
+
+    /// Test write() and read() with and without memory-mapping.
+    static
+    void testWriteRead(void);
+
+    /// Test read() gives same data and queries as SimpleIOAscii.
+    static
+    void testMatchAscii(void);
+
+    /// Test read() with invalid files.
+    static
+    void testReadErrors(void);
+
+    // PRIVATE METHODS ////////////////////////////////////////////////////
+private:
+
+    /** Check write() and read().
+     *
+     * @param useMemoryMap True if values should be memory-mapped.
+     */
+    static
+    void _checkWriteRead(const bool useMemoryMap);
+
+}; // class TestSimpleIOBinary
+
+// ------------------------------------------------------------------------------------------------
+TEST_CASE("TestSimpleIOBinary::testWriteRead", "[TestSimpleIOBinary]") {
+    spatialdata::spatialdb::TestSimpleIOBinary::testWriteRead();
+}
+TEST_CASE("TestSimpleIOBinary::testMatchAscii", "[TestSimpleIOBinary]") {
+    spatialdata::spatialdb::TestSimpleIOBinary::testMatchAscii();
+}
+TEST_CASE("TestSimpleIOBinary::testReadErrors", "[TestSimpleIOBinary]") {
+    spatialdata::spatialdb::TestSimpleIOBinary::testReadErrors();
+}
+
+// ----------------------------------------------------------------------
+// Test write() and read() with and without memory-mapping.
+void
+spatialdata::spatialdb::TestSimpleIOBinary::testWriteRead(void) {
+    SimpleIOBinary dbIO;
+    CHECK(dbIO.getUseMemoryMap());
+    dbIO.setUseMemoryMap(false);
+    CHECK(!dbIO.getUseMemoryMap());
+
+    _checkWriteRead(true);
+    _checkWriteRead(false);
+} // testWriteRead
+
+
+// ----------------------------------------------------------------------
+// Test read() gives same data and queries as SimpleIOAscii.
+void
+spatialdata::spatialdb::TestSimpleIOBinary::testMatchAscii(void) {
+    const char* filenameAscii = "data/spatial_comments.dat";
+    const char* filenameBinary = "data/spatial_comments.bin_spatialdb";
+
+    SimpleIOAscii ioAscii;
+    ioAscii.setFilename(filenameAscii);
+    SimpleDBData dataA;
+    geocoords::CoordSys* csA = NULL;
+    ioAscii.read(&dataA, &csA);
+    REQUIRE(csA);
+
+    SimpleIOBinary ioBinary;
+    ioBinary.setFilename(filenameBinary);
+    ioBinary.write(dataA, csA);
+
+    SimpleDBData dataB;
+    geocoords::CoordSys* csB = NULL;
+    ioBinary.read(&dataB, &csB);
+    REQUIRE(csB);
+#if !defined(WORDS_BIGENDIAN)
+    CHECK(dataB.isMapped());
+#endif
+
+    CHECK(dataA.getNumLocs() == dataB.getNumLocs());
+    CHECK(dataA.getDataDim() == dataB.getDataDim());
+    REQUIRE(dataA.getSpaceDim() == dataB.getSpaceDim());
+    REQUIRE(dataA.getNumValues() == dataB.getNumValues());
+    const size_t numLocs = dataA.getNumLocs();
+    const size_t spaceDim = dataA.getSpaceDim();
+    const size_t numValues = dataA.getNumValues();
+    for (size_t iVal = 0; iVal < numValues; ++iVal) {
+        CHECK(std::string(dataA.getName(iVal)) == std::string(dataB.getName(iVal)));
+        CHECK(std::string(dataA.getUnits(iVal)) == std::string(dataB.getUnits(iVal)));
+    } // for
+    for (size_t i = 0; i < numLocs*spaceDim; ++i) {
+        CHECK(dataA.getCoordinates(0)[i] == dataB.getCoordinates(0)[i]);
+    } // for
+    for (size_t i = 0; i < numLocs*numValues; ++i) {
+        CHECK(dataA.getData(0)[i] == dataB.getData(0)[i]);
+    } // for
+    delete csA;csA = NULL;
+    delete csB;csB = NULL;
+
+    // Queries through SimpleDB must match.
+    SimpleDB dbA;
+    dbA.setIOHandler(&ioAscii);
+    dbA.open();
+    dbA.setQueryType(SimpleDB::LINEAR);
+    SimpleDB dbB;
+    dbB.setIOHandler(&ioBinary);
+    dbB.open();
+    dbB.setQueryType(SimpleDB::LINEAR);
+
+    geocoords::CSCart cs;
+    const size_t numQueries = 4;
+    const double points[numQueries*3] = {
+        0.6, 0.1, 0.2,
+        1.0, 1.0, 1.0,
+        3.0, 5.0, 7.0,
+        4.0, 9.0, 6.0,
+    };
+    double valuesA[2];
+    double valuesB[2];
+    REQUIRE(numValues <= 2);
+    for (size_t iQuery = 0; iQuery < numQueries; ++iQuery) {
+        const int errA = dbA.query(valuesA, numValues, &points[iQuery*spaceDim], spaceDim, &cs);
+        const int errB = dbB.query(valuesB, numValues, &points[iQuery*spaceDim], spaceDim, &cs);
+        CHECK(errA == errB);
+        for (size_t iVal = 0; iVal < numValues; ++iVal) {
+            CHECK(valuesA[iVal] == valuesB[iVal]);
+        } // for
+    } // for
+    dbA.close();
+    dbB.close();
+} // testMatchAscii
+
+
+// ----------------------------------------------------------------------
+// Test read() with invalid files.
+void
+spatialdata::spatialdb::TestSimpleIOBinary::testReadErrors(void) {
+    SimpleIOBinary dbIO;
+    SimpleDBData data;
+    geocoords::CoordSys* cs = NULL;
+
+    // Missing file.
+    dbIO.setFilename("data/missing.bin_spatialdb");
+    CHECK_THROWS_AS(dbIO.read(&data, &cs), std::runtime_error);
+    dbIO.setUseMemoryMap(false);
+    CHECK_THROWS_AS(dbIO.read(&data, &cs), std::runtime_error);
+
+    // ASCII file.
+    dbIO.setFilename("data/spatial_comments.dat");
+    dbIO.setUseMemoryMap(true);
+    CHECK_THROWS_AS(dbIO.read(&data, &cs), std::runtime_error);
+    dbIO.setUseMemoryMap(false);
+    CHECK_THROWS_AS(dbIO.read(&data, &cs), std::runtime_error);
+
+    // Truncated file.
+    const char* filenameBinary = "data/spatialdb_truncated.bin_spatialdb";
+    SimpleIOAscii ioAscii;
+    ioAscii.setFilename("data/spatial_comments.dat");
+    ioAscii.read(&data, &cs);
+    dbIO.setFilename(filenameBinary);
+    dbIO.write(data, cs);
+    delete cs;cs = NULL;
+
+    std::string contents;
+    { // read
+        std::ifstream filein(filenameBinary, std::ios::in | std::ios::binary);
+        contents.assign(std::istreambuf_iterator<char>(filein), std::istreambuf_iterator<char>());
+    } // read
+    { // write
+        std::ofstream fileout(filenameBinary, std::ios::out | std::ios::binary);
+        fileout.write(contents.c_str(), contents.length()-8);
+    } // write
+    SimpleDBData dataT;
+    dbIO.setUseMemoryMap(true);
+    CHECK_THROWS_AS(dbIO.read(&dataT, &cs), std::runtime_error);
+    CHECK(!dataT.isMapped());
+    dbIO.setUseMemoryMap(false);
+    CHECK_THROWS_AS(dbIO.read(&dataT, &cs), std::runtime_error);
+    delete cs;cs = NULL;
+} // testReadErrors
+
+
+// ----------------------------------------------------------------------
+// Check write() and read().
+void
+spatialdata::spatialdb::TestSimpleIOBinary::_checkWriteRead(const bool useMemoryMap) {
+    INFO("useMemoryMap=" << useMemoryMap);
+
+    const size_t spaceDimE = 3;
+    const size_t numLocsE = 5;
+    const size_t numValsE = 2;
+    const size_t dataDimE = 3;
+    const char* names[numValsE] = { "One", "Two" };
+    const char* units[numValsE] = { "m", "km" };
+    const double scales[numValsE] = { 1.0, 1.0e+3 };
+    const double coordsE[numLocsE*spaceDimE] = {
+        0.6, 0.1, 0.2,
+        1.0, 1.1, 1.2,
+        4.7, 9.5, 8.7,
+        3.4, 0.7, 9.8,
+        3.4, 9.8, 5.7,
+    };
+    const double dataE[numLocsE*numValsE] = {
+        6.6, 3.4,
+        5.5, 6.7,
+        2.3, 4.1,
+        5.7, 2.0,
+        6.3, 6.7,
+    };
+
+    SimpleDBData dataOut;
+    dataOut.allocate(numLocsE, numValsE, spaceDimE, dataDimE);
+    dataOut.setData(dataE, numLocsE, numValsE);
+    dataOut.setCoordinates(coordsE, numLocsE, spaceDimE);
+    dataOut.setNames(names, numValsE);
+    dataOut.setUnits(units, numValsE);
+
+    const char* filename = "data/spatialdb_binary.bin_spatialdb";
+    geocoords::CSCart csOut;
+    SimpleIOBinary dbIO;
+    dbIO.setFilename(filename);
+    dbIO.setUseMemoryMap(useMemoryMap);
+    dbIO.write(dataOut, &csOut);
+
+    for (size_t iRead = 0; iRead < 2; ++iRead) {
+        // Reading file a second time checks converting to SI units did not modify file.
+        SimpleDBData dataIn;
+        geocoords::CoordSys* csIn = NULL;
+        dbIO.read(&dataIn, &csIn);
+        CHECK(csIn);
+#if !defined(WORDS_BIGENDIAN)
+        CHECK(useMemoryMap == dataIn.isMapped());
+#endif
+
+        CHECK(numLocsE == dataIn.getNumLocs());
+        CHECK(dataDimE == dataIn.getDataDim());
+        CHECK(spaceDimE == dataIn.getSpaceDim());
+        REQUIRE(numValsE == dataIn.getNumValues());
+        for (size_t iVal = 0; iVal < numValsE; ++iVal) {
+            CHECK(std::string(names[iVal]) == std::string(dataIn.getName(iVal)));
+            CHECK(std::string(units[iVal]) == std::string(dataIn.getUnits(iVal)));
+        } // for
+
+        const double tolerance = 1.0e-06;
+        for (size_t iLoc = 0, i = 0; iLoc < numLocsE; ++iLoc) {
+            const double* coordinates = dataIn.getCoordinates(iLoc);
+            for (size_t iDim = 0; iDim < spaceDimE; ++iDim, ++i) {
+                const double toleranceV = fabs(coordsE[i]) > 0.0 ? fabs(coordsE[i]) * tolerance : tolerance;
+                CHECK_THAT(coordinates[iDim], Catch::Matchers::WithinAbs(coordsE[i], toleranceV));
+            } // for
+        } // for
+
+        for (size_t iLoc = 0, i = 0; iLoc < numLocsE; ++iLoc) {
+            const double* values = dataIn.getData(iLoc);
+            for (size_t iVal = 0; iVal < numValsE; ++iVal, ++i) {
+                const double valueE = scales[iVal] * dataE[i];
+                const double toleranceV = fabs(valueE) > 0.0 ? fabs(valueE) * tolerance : tolerance;
+                CHECK_THAT(values[iVal], Catch::Matchers::WithinAbs(valueE, toleranceV));
+            } // for
+        } // for
+
+        delete csIn;csIn = NULL;
+    } // for
+} // _checkWriteRead
+
+
+// End of file
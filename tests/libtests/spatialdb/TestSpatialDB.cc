@@ -51,6 +51,9 @@ public:
     /// Test SpatialDB queries w/multiple points.
     void testDBmulti(void);
 
+    /// Test SpatialDB queries w/multiple points using multiple threads.
+    void testDBmultiThreads(void);
+
     /// Test C API of SpatialDB
     void testDB_CAPI(void);
 
@@ -68,6 +71,9 @@ TEST_CASE("TestSpatialDB::testDB", "[TestSpatialDB]") {
 TEST_CASE("TestSpatialDB::testDBmulti", "[TestSpatialDB]") {
     spatialdata::spatialdb::TestSpatialDB().testDBmulti();
 }
+TEST_CASE("TestSpatialDB::testDBmultiThreads", "[TestSpatialDB]") {
+    spatialdata::spatialdb::TestSpatialDB().testDBmultiThreads();
+}
 TEST_CASE("TestSpatialDB::testDB_CAPI", "[TestSpatialDB]") {
     spatialdata::spatialdb::TestSpatialDB().testDB_CAPI();
 }
@@ -174,6 +180,55 @@ spatialdata::spatialdb::TestSpatialDB::testDBmulti(void) { // testDBmulti
 } // testDBmulti
 
 
+// ----------------------------------------------------------------------
+// Test SpatialDB queries w/multiple points using multiple threads.
+void
+spatialdata::spatialdb::TestSpatialDB::testDBmultiThreads(void) {
+    assert(_db);
+
+    CHECK(1 == _db->getNumThreads());
+    const size_t numThreads = 3;
+    _db->setNumThreads(numThreads);
+    CHECK(numThreads == _db->getNumThreads());
+    CHECK(_db->supportsQueryContexts());
+
+    const size_t numVals = 4;
+    const size_t spaceDim = 3;
+    const char* names[numVals] = {"two", "one", "four", "three"};
+    _db->setQueryValues(names, numVals);
+
+    // Query many locations, so each thread does several blocks of queries.
+    const size_t numLocs = 1000;
+    double* queryLocs = new double[numLocs*spaceDim];
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        queryLocs[iLoc*spaceDim+0] = 0.6 - 0.5*iLoc/numLocs;
+        queryLocs[iLoc*spaceDim+1] = 0.1 + 0.5*iLoc/numLocs;
+        queryLocs[iLoc*spaceDim+2] = 0.2 + 0.1*iLoc/numLocs;
+    } // for
+
+    double* valsQ = new double[numLocs*numVals];
+    int* errQ = new int[numLocs];
+    spatialdata::geocoords::CSCart csCart;
+    _db->multiquery(valsQ, numLocs, numVals, errQ, numLocs, queryLocs, numLocs, spaceDim, &csCart);
+
+    // Values must match those from individual queries.
+    double valsE[numVals];
+    for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+        const int errE = _db->query(valsE, numVals, &queryLocs[iLoc*spaceDim], spaceDim, &csCart);
+        REQUIRE(errE == errQ[iLoc]);
+        for (size_t iVal = 0; iVal < numVals; ++iVal) {
+            CHECK(valsE[iVal] == valsQ[iLoc*numVals+iVal]);
+        } // for
+    } // for
+
+    delete[] queryLocs;queryLocs = NULL;
+    delete[] valsQ;valsQ = NULL;
+    delete[] errQ;errQ = NULL;
+
+    _db->close();
+} // testDBmultiThreads
+
+
 // ----------------------------------------------------------------------
 // Test SpatialDB w/C query
 void
@@ -0,0 +1,475 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "spatialdata/spatialdb/Triangulation.hh" // Test subject
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include <vector> // USES std::vector
+#include <string> // USES std::string
+#include <stdexcept> // USES std::invalid_argument, std::runtime_error
+#include <cmath> // USES fabs()
+#include <cassert> // USES assert()
+
+// ------------------------------------------------------------------------------------------------
+namespace spatialdata {
+    namespace spatialdb {
+        class TestTriangulation;
+    } // spatialdb
+} // spatialdata
+
+class spatialdata::spatialdb::TestTriangulation {
+    // PUBLIC METHODS /////////////////////////////////////////////////////////////////////////////
+public:
+
+    /// Test constructor.
+    static
+    void testConstructor(void);
+
+    /// Test build() with locations on a grid.
+    static
+    void testBuildGrid(void);
+
+    /// Test build() with scattered locations satisfies Delaunay criterion.
+    static
+    void testBuildDelaunay(void);
+
+    /// Test locate().
+    static
+    void testLocate(void);
+
+    /// Test build() and locate() with nearly collinear (2-D) or coplanar (3-D) locations on hull.
+    static
+    void testNearDegenerateHull(void);
+
+    // PRIVATE METHODS ////////////////////////////////////////////////////////////////////////////
+private:
+
+    /** Generate coordinates of scattered locations in [-1,1].
+     *
+     * @param coords Coordinates of locations.
+     * @param numLocs Number of locations.
+     * @param spaceDim Spatial dimension.
+     */
+    static
+    void _generate(std::vector<double>* coords,
+                   const size_t numLocs,
+                   const size_t spaceDim);
+
+    /** Check topology and orientation of cells.
+     *
+     * @param triangulation Triangulation.
+     * @param coords Coordinates of locations.
+     * @returns Sum of volumes of cells.
+     */
+    static
+    double _checkCells(const Triangulation& triangulation,
+                       const std::vector<double>& coords);
+
+    /** Compute signed volume of simplex.
+     *
+     * @param pts Coordinates of vertices of simplex [spaceDim+1].
+     * @param spaceDim Spatial dimension.
+     * @returns Signed volume.
+     */
+    static
+    double _volume(const double* const pts[],
+                   const size_t spaceDim);
+
+}; // class TestTriangulation
+
+// ------------------------------------------------------------------------------------------------
+TEST_CASE("TestTriangulation::testConstructor", "[TestTriangulation]") {
+    spatialdata::spatialdb::TestTriangulation::testConstructor();
+}
+TEST_CASE("TestTriangulation::testBuildGrid", "[TestTriangulation]") {
+    spatialdata::spatialdb::TestTriangulation::testBuildGrid();
+}
+TEST_CASE("TestTriangulation::testBuildDelaunay", "[TestTriangulation]") {
+    spatialdata::spatialdb::TestTriangulation::testBuildDelaunay();
+}
+TEST_CASE("TestTriangulation::testLocate", "[TestTriangulation]") {
+    spatialdata::spatialdb::TestTriangulation::testLocate();
+}
+TEST_CASE("TestTriangulation::testNearDegenerateHull", "[TestTriangulation]") {
+    spatialdata::spatialdb::TestTriangulation::testNearDegenerateHull();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Test constructor.
+void
+spatialdata::spatialdb::TestTriangulation::testConstructor(void) {
+    Triangulation triangulation;
+    CHECK(size_t(0) == triangulation.getSpaceDim());
+    CHECK(size_t(0) == triangulation.getNumCells());
+} // testConstructor
+
+
+// ------------------------------------------------------------------------------------------------
+// Test build() with locations on a grid.
+void
+spatialdata::spatialdb::TestTriangulation::testBuildGrid(void) {
+    const double tolerance = 1.0e-10;
+
+    { // 2-D grid, 5x5 with spacing 0.5, has many cocircular locations.
+        const size_t numX = 5;
+        std::vector<double> coords;
+        for (size_t iY = 0; iY < numX; ++iY) {
+            for (size_t iX = 0; iX < numX; ++iX) {
+                coords.push_back(10.0 + 0.5*iX);
+                coords.push_back(-3.0 + 0.5*iY);
+            } // for
+        } // for
+        // Duplicate location is skipped.
+        coords.push_back(11.0);
+        coords.push_back(-2.0);
+        const size_t numLocs = coords.size() / 2;
+
+        Triangulation triangulation;
+        triangulation.build(&coords[0], numLocs, 2);
+        CHECK(size_t(2) == triangulation.getSpaceDim());
+        CHECK(size_t(2*(numX-1)*(numX-1)) == triangulation.getNumCells());
+        CHECK_THAT(_checkCells(triangulation, coords), Catch::Matchers::WithinAbs(4.0, tolerance));
+
+        triangulation.deallocate();
+        CHECK(size_t(0) == triangulation.getNumCells());
+    } // 2-D
+
+    { // 3-D grid, 3x3x3 with spacing 1.0, has many cospherical locations.
+        const size_t numX = 3;
+        std::vector<double> coords;
+        for (size_t iZ = 0; iZ < numX; ++iZ) {
+            for (size_t iY = 0; iY < numX; ++iY) {
+                for (size_t iX = 0; iX < numX; ++iX) {
+                    coords.push_back(1.0*iX);
+                    coords.push_back(1.0*iY);
+                    coords.push_back(-1.0*iZ);
+                } // for
+            } // for
+        } // for
+        const size_t numLocs = coords.size() / 3;
+
+        Triangulation triangulation;
+        triangulation.build(&coords[0], numLocs, 3);
+        CHECK(size_t(3) == triangulation.getSpaceDim());
+        CHECK_THAT(_checkCells(triangulation, coords), Catch::Matchers::WithinAbs(8.0, tolerance));
+    } // 3-D
+
+    { // Invalid spatial dimension and degenerate locations.
+        const double coords[4*2] = {
+            0.0, 0.0,
+            1.0, 1.0,
+            2.0, 2.0,
+            3.0, 3.0,
+        };
+        Triangulation triangulation;
+        CHECK_THROWS_AS(triangulation.build(coords, 8, 1), std::invalid_argument);
+        CHECK_THROWS_AS(triangulation.build(coords, 4, 2), std::runtime_error);
+    } // Errors
+} // testBuildGrid
+
+
+// ------------------------------------------------------------------------------------------------
+// Test build() with scattered locations satisfies Delaunay criterion.
+void
+spatialdata::spatialdb::TestTriangulation::testBuildDelaunay(void) {
+    const size_t numLocs = 200;
+
+    for (size_t spaceDim = 2; spaceDim <= 3; ++spaceDim) {
+        std::vector<double> coords;
+        _generate(&coords, numLocs, spaceDim);
+
+        Triangulation triangulation;
+        triangulation.build(&coords[0], numLocs, spaceDim);
+        _checkCells(triangulation, coords);
+
+        // Every location is a vertex.
+        const size_t numCorners = spaceDim+1;
+        const size_t numCells = triangulation.getNumCells();
+        std::vector<bool> isVertex(numLocs, false);
+        for (size_t i = 0; i < numCells*numCorners; ++i) {
+            isVertex[triangulation._cells[i]] = true;
+        } // for
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            CHECK(isVertex[iLoc]);
+        } // for
+
+        // No location is inside circumsphere of any cell.
+        for (size_t iCell = 0; iCell < numCells; ++iCell) {
+            const int* cell = &triangulation._cells[iCell*numCorners];
+            const double* a = &coords[cell[0]*spaceDim];
+            double matrix[3][3];
+            double rhs[3];
+            for (size_t i = 0; i < spaceDim; ++i) {
+                const double* b = &coords[cell[i+1]*spaceDim];
+                rhs[i] = 0.0;
+                for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+                    matrix[i][iDim] = b[iDim] - a[iDim];
+                    rhs[i] += 0.5 * (b[iDim] - a[iDim]) * (b[iDim] - a[iDim]);
+                } // for
+            } // for
+            double center[3] = { 0.0, 0.0, 0.0 };
+            if (2 == spaceDim) {
+                const double det = matrix[0][0]*matrix[1][1] - matrix[0][1]*matrix[1][0];
+                center[0] = (rhs[0]*matrix[1][1] - matrix[0][1]*rhs[1]) / det;
+                center[1] = (matrix[0][0]*rhs[1] - rhs[0]*matrix[1][0]) / det;
+            } else {
+                const double det =
+                    matrix[0][0]*(matrix[1][1]*matrix[2][2] - matrix[1][2]*matrix[2][1]) -
+                    matrix[0][1]*(matrix[1][0]*matrix[2][2] - matrix[1][2]*matrix[2][0]) +
+                    matrix[0][2]*(matrix[1][0]*matrix[2][1] - matrix[1][1]*matrix[2][0]);
+                for (size_t iDim = 0; iDim < 3; ++iDim) {
+                    double m[3][3];
+                    for (size_t i = 0; i < 3; ++i) {
+                        for (size_t j = 0; j < 3; ++j) {
+                            m[i][j] = (j == iDim) ? rhs[i] : matrix[i][j];
+                        } // for
+                    } // for
+                    center[iDim] = (m[0][0]*(m[1][1]*m[2][2] - m[1][2]*m[2][1]) -
+                                    m[0][1]*(m[1][0]*m[2][2] - m[1][2]*m[2][0]) +
+                                    m[0][2]*(m[1][0]*m[2][1] - m[1][1]*m[2][0])) / det;
+                } // for
+            } // if/else
+            double radius2 = 0.0;
+            for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+                radius2 += center[iDim] * center[iDim];
+            } // for
+            for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+                double dist2 = 0.0;
+                for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+                    const double dx = coords[iLoc*spaceDim+iDim] - a[iDim] - center[iDim];
+                    dist2 += dx*dx;
+                } // for
+                CHECK(dist2 >= radius2*(1.0 - 1.0e-8));
+            } // for
+        } // for
+    } // for
+} // testBuildDelaunay
+
+
+// ------------------------------------------------------------------------------------------------
+// Test locate().
+void
+spatialdata::spatialdb::TestTriangulation::testLocate(void) {
+    const size_t numLocs = 500;
+    const size_t numPoints = 200;
+    const double tolerance = 1.0e-10;
+
+    for (size_t spaceDim = 2; spaceDim <= 3; ++spaceDim) {
+        std::vector<double> coords;
+        _generate(&coords, numLocs, spaceDim);
+
+        Triangulation triangulation;
+        triangulation.build(&coords[0], numLocs, spaceDim);
+        const size_t numCorners = spaceDim+1;
+
+        // Points are averages of pairs of locations, so they lie inside the convex hull.
+        size_t cell = 0;
+        for (size_t iPt = 0; iPt < numPoints; ++iPt) {
+            const size_t iA = (7*iPt) % numLocs;
+            const size_t iB = (7*iPt + 13) % numLocs;
+            double pt[3] = { 0.0, 0.0, 0.0 };
+            for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+                pt[iDim] = 0.5 * (coords[iA*spaceDim+iDim] + coords[iB*spaceDim+iDim]);
+            } // for
+
+            size_t vertices[4];
+            double weights[4];
+            REQUIRE(triangulation.locate(vertices, weights, &cell, pt));
+            CHECK(cell < triangulation.getNumCells());
+
+            double sum = 0.0;
+            double xyz[3] = { 0.0, 0.0, 0.0 };
+            for (size_t i = 0; i < numCorners; ++i) {
+                CHECK(weights[i] >= -1.0e-6);
+                sum += weights[i];
+                for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+                    xyz[iDim] += weights[i] * coords[vertices[i]*spaceDim+iDim];
+                } // for
+            } // for
+            CHECK_THAT(sum, Catch::Matchers::WithinAbs(1.0, tolerance));
+            for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+                CHECK_THAT(xyz[iDim], Catch::Matchers::WithinAbs(pt[iDim], tolerance));
+            } // for
+        } // for
+
+        // Locations are inside triangulation and inside cells with location as a vertex.
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            double pt[3] = { 0.0, 0.0, 0.0 };
+            for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+                pt[iDim] = coords[iLoc*spaceDim+iDim];
+            } // for
+            size_t vertices[4];
+            double weights[4];
+            CHECK(triangulation.locate(vertices, weights, &cell, pt));
+
+            size_t vertexCell = triangulation.getVertexCell(iLoc);
+            REQUIRE(vertexCell < triangulation.getNumCells());
+            CHECK(triangulation.locate(vertices, weights, &vertexCell, pt, 1));
+        } // for
+
+        // Points outside convex hull.
+        const double ptsOutside[3][3] = {
+            { 1.5, 0.0, 0.0 },
+            { 0.0, -1.5, 0.0 },
+            { 1.2, 1.2, 1.2 },
+        };
+        for (size_t iPt = 0; iPt < 3; ++iPt) {
+            size_t vertices[4];
+            double weights[4];
+            CHECK_FALSE(triangulation.locate(vertices, weights, &cell, ptsOutside[iPt]));
+        } // for
+    } // for
+} // testLocate
+
+
+// ------------------------------------------------------------------------------------------------
+// Test build() and locate() with nearly collinear (2-D) or coplanar (3-D) locations on hull.
+void
+spatialdata::spatialdb::TestTriangulation::testNearDegenerateHull(void) {
+    const size_t numEdge = 41;
+    const double offset = 1.0e-13;
+
+    for (size_t spaceDim = 2; spaceDim <= 3; ++spaceDim) {
+        // Bottom of hull is a line (2-D) or plane (3-D) of locations perturbed by roundoff-sized offsets.
+        std::vector<double> coords;
+        const size_t numY = (3 == spaceDim) ? numEdge : 1;
+        for (size_t iY = 0; iY < numY; ++iY) {
+            for (size_t iX = 0; iX < numEdge; ++iX) {
+                const double z = offset * double((iX*7 + iY*3) % 5) - 2.0*offset;
+                coords.push_back(double(iX) / double(numEdge-1));
+                if (3 == spaceDim) {
+                    coords.push_back(double(iY) / double(numEdge-1));
+                } // if
+                coords.push_back(z);
+            } // for
+        } // for
+        std::vector<double> top;
+        _generate(&top, 50, spaceDim);
+        for (size_t i = 0; i < top.size(); ++i) {
+            const bool isVertical = (spaceDim-1) == (i % spaceDim);
+            coords.push_back(isVertical ? 0.55 + 0.45*top[i] : 0.5 + 0.5*top[i]);
+        } // for
+        const size_t numLocs = coords.size() / spaceDim;
+
+        Triangulation triangulation;
+        INFO("spaceDim=" << spaceDim);
+        try {
+            triangulation.build(&coords[0], numLocs, spaceDim);
+        } catch (const std::runtime_error& err) {
+            // Locations that cannot be inserted must be reported rather than skipped.
+            INFO("Error message: " << err.what());
+            CHECK(std::string::npos != std::string(err.what()).find("Could not insert location"));
+            CHECK(size_t(0) == triangulation.getNumCells());
+            continue;
+        } // try/catch
+
+        // Every location is a vertex, so locations on the bottom of the hull are inside the triangulation.
+        size_t cell = 0;
+        for (size_t iLoc = 0; iLoc < numLocs; ++iLoc) {
+            INFO("iLoc=" << iLoc);
+            REQUIRE(triangulation.getVertexCell(iLoc) < triangulation.getNumCells());
+
+            double pt[3] = { 0.0, 0.0, 0.0 };
+            for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+                pt[iDim] = coords[iLoc*spaceDim+iDim];
+            } // for
+            size_t vertices[4];
+            double weights[4];
+            CHECK(triangulation.locate(vertices, weights, &cell, pt));
+        } // for
+    } // for
+} // testNearDegenerateHull
+
+
+// ------------------------------------------------------------------------------------------------
+// Generate coordinates of locations.
+void
+spatialdata::spatialdb::TestTriangulation::_generate(std::vector<double>* coords,
+                                                     const size_t numLocs,
+                                                     const size_t spaceDim) {
+    assert(coords);
+
+    // Linear congruential generator for reproducible locations.
+    unsigned long seed = 54321;
+    coords->resize(numLocs*spaceDim);
+    for (size_t i = 0; i < numLocs*spaceDim; ++i) {
+        seed = (1103515245*seed + 12345) % 2147483648;
+        (*coords)[i] = -1.0 + 2.0 * double(seed) / 2147483648.0;
+    } // for
+} // _generate
+
+
+// ------------------------------------------------------------------------------------------------
+// Check topology and orientation of cells.
+double
+spatialdata::spatialdb::TestTriangulation::_checkCells(const Triangulation& triangulation,
+                                                       const std::vector<double>& coords) {
+    const size_t spaceDim = triangulation.getSpaceDim();
+    const size_t numCorners = spaceDim+1;
+    const size_t numCells = triangulation.getNumCells();
+    REQUIRE(numCells > 0);
+    REQUIRE(numCells*numCorners == triangulation._cells.size());
+    REQUIRE(numCells*numCorners == triangulation._neighbors.size());
+
+    double volume = 0.0;
+    for (size_t iCell = 0; iCell < numCells; ++iCell) {
+        const int* cell = &triangulation._cells[iCell*numCorners];
+        const double* pts[4];
+        for (size_t i = 0; i < numCorners; ++i) {
+            pts[i] = &coords[cell[i]*spaceDim];
+        } // for
+        const double cellVolume = _volume(pts, spaceDim);
+        CHECK(cellVolume > 0.0);
+        volume += cellVolume;
+
+        // Neighbors share all vertices except the opposite one.
+        for (size_t i = 0; i < numCorners; ++i) {
+            const int neighbor = triangulation._neighbors[iCell*numCorners+i];
+            if (neighbor < 0) {
+                continue;
+            } // if
+            const int* cellN = &triangulation._cells[neighbor*numCorners];
+            size_t numShared = 0;
+            bool isReciprocal = false;
+            for (size_t j = 0; j < numCorners; ++j) {
+                for (size_t k = 0; k < numCorners; ++k) {
+                    numShared += (k != i && cell[k] == cellN[j]) ? 1 : 0;
+                } // for
+                isReciprocal = isReciprocal || triangulation._neighbors[neighbor*numCorners+j] == int(iCell);
+            } // for
+            CHECK(spaceDim == numShared);
+            CHECK(isReciprocal);
+        } // for
+    } // for
+
+    return volume;
+} // _checkCells
+
+
+// ------------------------------------------------------------------------------------------------
+// Compute signed volume of simplex.
+double
+spatialdata::spatialdb::TestTriangulation::_volume(const double* const pts[],
+                                                   const size_t spaceDim) {
+    if (2 == spaceDim) {
+        return 0.5 * ((pts[1][0]-pts[0][0])*(pts[2][1]-pts[0][1]) - (pts[1][1]-pts[0][1])*(pts[2][0]-pts[0][0]));
+    } // if
+    const double ab[3] = { pts[1][0]-pts[0][0], pts[1][1]-pts[0][1], pts[1][2]-pts[0][2] };
+    const double ac[3] = { pts[2][0]-pts[0][0], pts[2][1]-pts[0][1], pts[2][2]-pts[0][2] };
+    const double ad[3] = { pts[3][0]-pts[0][0], pts[3][1]-pts[0][1], pts[3][2]-pts[0][2] };
+    return (ab[0]*(ac[1]*ad[2] - ac[2]*ad[1]) - ab[1]*(ac[0]*ad[2] - ac[2]*ad[0]) + ab[2]*(ac[0]*ad[1] - ac[1]*ad[0])) / 6.0;
+} // _volume
+
+
+// End of file
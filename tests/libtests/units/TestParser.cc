@@ -13,6 +13,7 @@
 #include "spatialdata/units/Parser.hh" // USES Parser
 
 #include <stdexcept> // USES std::runtime_error
+#include <cmath> // USES M_PI
 
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/matchers/catch_matchers_floating_point.hpp"
@@ -52,10 +53,22 @@ public:
     static
     void testPressure(void);
 
+    /// Test parse() with prefixes, numbers, and operators.
+    static
+    void testExpressions(void);
+
+    /// Test parse() uses cache of scale factors.
+    static
+    void testCache(void);
+
     /// Test trapping errors with parse().
     static
     void testError(void);
 
+    /// Test trapping errors with parse() without Python fallback.
+    static
+    void testErrorNoPython(void);
+
     // PRIVATE MEMBERS ////////////////////////////////////////////////////////////////////////////
 private:
 
@@ -82,9 +95,18 @@ TEST_CASE("TestParser::testDensity", "[TestParser]") {
 TEST_CASE("TestParser::testPressure", "[TestParser]") {
     spatialdata::units::TestParser::testPressure();
 }
+TEST_CASE("TestParser::testExpressions", "[TestParser]") {
+    spatialdata::units::TestParser::testExpressions();
+}
+TEST_CASE("TestParser::testCache", "[TestParser]") {
+    spatialdata::units::TestParser::testCache();
+}
 TEST_CASE("TestParser::testError", "[TestParser]") {
     spatialdata::units::TestParser::testError();
 }
+TEST_CASE("TestParser::testErrorNoPython", "[TestParser]") {
+    spatialdata::units::TestParser::testErrorNoPython();
+}
 
 // ------------------------------------------------------------------------------------------------
 // Test constructor.
@@ -153,6 +175,44 @@ spatialdata::units::TestParser::testPressure(void) {
 } // testPressure
 
 
+// ------------------------------------------------------------------------------------------------
+// Test parse() with prefixes, numbers, and operators.
+void
+spatialdata::units::TestParser::testExpressions(void) {
+    Parser parser;
+
+    CHECK_THAT(parser.parse("kilo*meter"), Catch::Matchers::WithinAbs(1.0e+3, _tolerance));
+    CHECK_THAT(parser.parse("1/s"), Catch::Matchers::WithinAbs(1.0, _tolerance));
+    CHECK_THAT(parser.parse("cm/s**2"), Catch::Matchers::WithinAbs(0.01, _tolerance));
+    CHECK_THAT(parser.parse(" ( km / hour ) ** 2 "), Catch::Matchers::WithinAbs(1.0/(3.6*3.6), _tolerance));
+    CHECK_THAT(parser.parse("2.5e+3*mm"), Catch::Matchers::WithinAbs(2.5, _tolerance));
+    CHECK_THAT(parser.parse("m**-1"), Catch::Matchers::WithinAbs(1.0, _tolerance));
+    CHECK_THAT(parser.parse("-2**2"), Catch::Matchers::WithinAbs(-4.0, _tolerance));
+    CHECK_THAT(parser.parse("km**2/km/2"), Catch::Matchers::WithinAbs(500.0, _tolerance));
+    CHECK_THAT(parser.parse("year"), Catch::Matchers::WithinAbs(31557600.0, _tolerance));
+    CHECK_THAT(parser.parse("degree"), Catch::Matchers::WithinAbs(M_PI/180.0, _tolerance));
+    CHECK_THAT(parser.parse("GPa"), Catch::Matchers::WithinRel(1.0e+9, _tolerance));
+} // testExpressions
+
+
+// ------------------------------------------------------------------------------------------------
+// Test parse() uses cache of scale factors.
+void
+spatialdata::units::TestParser::testCache(void) {
+    Parser::clearCache();
+    Parser parserA;
+    CHECK_THAT(parserA.parse("km/s"), Catch::Matchers::WithinAbs(1.0e+3, _tolerance));
+
+    // Cache is shared among parsers.
+    Parser parserB;
+    CHECK_THAT(parserB.parse("km/s"), Catch::Matchers::WithinAbs(1.0e+3, _tolerance));
+    CHECK(!parserB._pyParser);
+
+    Parser::clearCache();
+    CHECK_THAT(parserB.parse("km/s"), Catch::Matchers::WithinAbs(1.0e+3, _tolerance));
+} // testCache
+
+
 // ------------------------------------------------------------------------------------------------
 // Test trapping errors with parse().
 void
@@ -163,4 +223,25 @@ spatialdata::units::TestParser::testError(void) {
 } // testError
 
 
+// ------------------------------------------------------------------------------------------------
+// Test trapping errors with parse() without Python fallback.
+void
+spatialdata::units::TestParser::testErrorNoPython(void) {
+    CHECK(Parser::getUsePython());
+    Parser::setUsePython(false);
+    CHECK(!Parser::getUsePython());
+
+    Parser parser;
+    CHECK_THROWS_AS(parser.parse("abc"), std::runtime_error);
+    CHECK_THROWS_AS(parser.parse("m/"), std::runtime_error);
+    CHECK_THROWS_AS(parser.parse("(m"), std::runtime_error);
+    CHECK_THROWS_AS(parser.parse("m^2"), std::runtime_error);
+    CHECK_THROWS_AS(parser.parse(""), std::runtime_error);
+    CHECK(!parser._pyParser);
+    CHECK_THAT(parser.parse("MPa"), Catch::Matchers::WithinAbs(1.0e+6, _tolerance));
+
+    Parser::setUsePython(true);
+} // testErrorNoPython
+
+
 // End of file
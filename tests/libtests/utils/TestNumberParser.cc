@@ -0,0 +1,102 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+
+#include <portinfo>
+
+#include "spatialdata/utils/NumberParser.hh" // Test subject
+
+#include "catch2/catch_test_macros.hpp"
+
+// ------------------------------------------------------------------------------------------------
+namespace spatialdata {
+    namespace utils {
+        class TestNumberParser;
+    } // utils
+} // spatialdata
+
+class spatialdata::utils::TestNumberParser {
+    // PUBLIC METHODS /////////////////////////////////////////////////////////////////////////////
+public:
+
+    /// Test parse() with numbers in various formats.
+    static
+    void testParse(void);
+
+    /// Test parse() with too few numbers and with extra tokens.
+    static
+    void testCount(void);
+
+    /// Test parse() with invalid tokens.
+    static
+    void testErrors(void);
+
+}; // class TestNumberParser
+
+// ------------------------------------------------------------------------------------------------
+TEST_CASE("TestNumberParser::testParse", "[TestNumberParser]") {
+    spatialdata::utils::TestNumberParser::testParse();
+}
+TEST_CASE("TestNumberParser::testCount", "[TestNumberParser]") {
+    spatialdata::utils::TestNumberParser::testCount();
+}
+TEST_CASE("TestNumberParser::testErrors", "[TestNumberParser]") {
+    spatialdata::utils::TestNumberParser::testErrors();
+}
+
+// ------------------------------------------------------------------------------------------------
+// Test parse() with numbers in various formats.
+void
+spatialdata::utils::TestNumberParser::testParse(void) {
+    const size_t numValues = 9;
+    const double valuesE[numValues] = { 1.0, -2.5, 3.0e+3, 4.25e-2, 0.5, 6.0, 7.0, -8.0, 1.0e+300 };
+
+    double values[numValues];
+    CHECK(NumberParser::parse(values, numValues, "  1 -2.5\t3.0e+3 4.25E-2 .5 +6 7.  -8.0e0 1.0e+300\r"));
+    for (size_t i = 0; i < numValues; ++i) {
+        CHECK(valuesE[i] == values[i]);
+    } // for
+
+    CHECK(NumberParser::parse(values, 0, "   "));
+} // testParse
+
+
+// ------------------------------------------------------------------------------------------------
+// Test parse() with too few numbers and with extra tokens.
+void
+spatialdata::utils::TestNumberParser::testCount(void) {
+    const size_t numValues = 3;
+    double values[numValues+1];
+
+    CHECK(!NumberParser::parse(values, numValues, "1.0 2.0"));
+    CHECK(!NumberParser::parse(values, numValues, ""));
+    CHECK(NumberParser::parse(values, numValues, "1.0 2.0 3.0 "));
+
+    // Tokens after expected numbers are ignored.
+    values[numValues] = 0.0;
+    CHECK(NumberParser::parse(values, numValues, "1.0 2.0 3.0 4.0"));
+    CHECK(0.0 == values[numValues]);
+    CHECK(NumberParser::parse(values, numValues, "4.0 5.0 6.0 abc"));
+    CHECK(6.0 == values[2]);
+} // testCount
+
+
+// ------------------------------------------------------------------------------------------------
+// Test parse() with invalid tokens.
+void
+spatialdata::utils::TestNumberParser::testErrors(void) {
+    double values[2];
+    CHECK(!NumberParser::parse(values, 2, "1.0 abc")); // Not a number
+    CHECK(!NumberParser::parse(values, 1, "1.0x")); // Trailing characters
+    CHECK(!NumberParser::parse(values, 2, "1.0,2.0")); // Comma separator
+    CHECK(!NumberParser::parse(values, 2, "+ 2.0")); // Sign only
+} // testErrors
+
+
+// End of file
@@ -13,10 +13,23 @@ import unittest
 import numpy
 from spatialdata.testing.TestCases import make_suite
 from pythia.pyre.units.length import m
+from spatialdata.spatialdb.CompositeDB import (CompositeDBEntry, NoEntries)
 
 
 class TestCompositeDB(unittest.TestCase):
 
+    class OtherEntries(NoEntries):
+        """
+        Container with given additional databases.
+        """
+
+        def __init__(self, entries):
+            NoEntries.__init__(self, name="otherentries")
+            self._entries = entries
+
+        def components(self):
+            return self._entries
+
     def setUp(self):
         from spatialdata.spatialdb.UniformDB import UniformDB
         dbA = UniformDB()
@@ -43,18 +56,51 @@ class TestCompositeDB(unittest.TestCase):
         self._db = db
 
     def test_database(self):
+        queryVals = ["three", "one", "five"]
+        dataE = numpy.array([[3.1, 1.1, 5.1],
+                             [3.1, 1.1, 5.1]], numpy.float64)
+        errE = [0, 0]
+        self._checkQuery(self._db, queryVals, dataE, errE)
+
+    def test_db_others(self):
+        from spatialdata.spatialdb.UniformDB import UniformDB
+        dbC = UniformDB()
+        dbC.inventory.label = "db C"
+        dbC.inventory.values = ["five", "six", "seven"]
+        dbC.inventory.data = [5.2 * m, 6.2 * m, 7.2 * m]
+        dbC._configure()
+
+        entry = CompositeDBEntry("dbC")
+        entry.inventory.names = ["six", "seven"]
+        entry.inventory.db = dbC
+
+        db = self._db
+        db.inventory.dbOthers = self.OtherEntries([entry])
+        db._configure()
+
+        queryVals = ["seven", "three", "one", "six", "five"]
+        dataE = numpy.array([[7.2, 3.1, 1.1, 6.2, 5.1],
+                             [7.2, 3.1, 1.1, 6.2, 5.1]], numpy.float64)
+        errE = [0, 0]
+        self._checkQuery(db, queryVals, dataE, errE)
+
+    def test_db_others_no_values(self):
+        entry = CompositeDBEntry("dbC")
+        entry.inventory.names = []
+
+        db = self._db
+        db.inventory.dbOthers = self.OtherEntries([entry])
+        with self.assertRaises(ValueError):
+            db._configure()
+
+    def _checkQuery(self, db, queryVals, dataE, errE):
         locs = numpy.array([[1.0, 2.0, 3.0],
                             [5.6, 4.2, 8.6]],
                            numpy.float64)
         from spatialdata.geocoords.CSCart import CSCart
         cs = CSCart()
         cs._configure()
-        queryVals = ["three", "one", "five"]
-        dataE = numpy.array([[3.1, 1.1, 5.1],
-                             [3.1, 1.1, 5.1]], numpy.float64)
-        errE = [0, 0]
 
-        db = self._db
         db.open()
         db.setQueryValues(queryVals)
         data = numpy.zeros(dataE.shape, dtype=numpy.float64)
@@ -13,6 +13,7 @@
 from spatialdata.testing.UnitTestApp import UnitTestApp
 
 import TestSimpleIOAscii
+import TestSimpleIOBinary
 import TestSimpleDB
 import TestUniformDB
 import TestAnalyticDB
@@ -27,6 +28,7 @@ import TestGenSimpleDBApp
 
 TEST_MODULES = [
     TestSimpleIOAscii,
+    TestSimpleIOBinary,
     TestSimpleDB,
     TestUniformDB,
     TestAnalyticDB,
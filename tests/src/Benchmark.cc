@@ -0,0 +1,135 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+#include <portinfo>
+
+#include "Benchmark.hh" // Implementation of class methods
+
+#include <iostream> // USES std::cout
+#include <utility> // USES std::swap()
+#include <cassert> // USES assert()
+
+// ------------------------------------------------------------------------------------------------
+// Constructor.
+spatialdata::testing::Benchmark::Stopwatch::Stopwatch(void) :
+    _start(std::chrono::steady_clock::now()) {}
+
+
+// ------------------------------------------------------------------------------------------------
+// Restart timer.
+void
+spatialdata::testing::Benchmark::Stopwatch::restart(void) {
+    _start = std::chrono::steady_clock::now();
+} // restart
+
+
+// ------------------------------------------------------------------------------------------------
+// Get time since timer was started.
+double
+spatialdata::testing::Benchmark::Stopwatch::seconds(void) const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+} // seconds
+
+
+// ------------------------------------------------------------------------------------------------
+// Constructor.
+spatialdata::testing::Benchmark::Random::Random(const unsigned long seed) :
+    _seed(seed) {}
+
+
+// ------------------------------------------------------------------------------------------------
+// Get next number.
+double
+spatialdata::testing::Benchmark::Random::next(void) {
+    _seed = (1103515245*_seed + 12345) % 2147483648;
+    return double(_seed) / 2147483648.0;
+} // next
+
+
+// ------------------------------------------------------------------------------------------------
+// Get next index.
+size_t
+spatialdata::testing::Benchmark::Random::nextIndex(const size_t size) {
+    assert(size > 0);
+    _seed = (1103515245*_seed + 12345) % 2147483648;
+    return _seed % size;
+} // nextIndex
+
+
+// ------------------------------------------------------------------------------------------------
+// Create points in a 3-D grid along lines parallel to the x axis.
+void
+spatialdata::testing::Benchmark::createLinePoints(std::vector<double>* points,
+                                                  const size_t numQueries,
+                                                  const size_t numPoints,
+                                                  const double spacing) {
+    assert(points);
+    assert(numPoints > 1);
+
+    const size_t spaceDim = 3;
+    const double length = spacing*(numPoints-1);
+
+    points->resize(numQueries*spaceDim);
+    const size_t numPerLine = 4*numPoints;
+    for (size_t i = 0; i < numQueries; ++i) {
+        const size_t iLine = i / numPerLine;
+        (*points)[i*spaceDim+0] = 0.1*spacing + (length-0.2*spacing) * double(i % numPerLine) / double(numPerLine);
+        (*points)[i*spaceDim+1] = 0.3*spacing + spacing*double(iLine % (numPoints-1));
+        (*points)[i*spaceDim+2] = -length + 0.6*spacing + spacing*double((iLine / (numPoints-1)) % (numPoints-1));
+    } // for
+} // createLinePoints
+
+
+// ------------------------------------------------------------------------------------------------
+// Shuffle points into random order.
+void
+spatialdata::testing::Benchmark::shufflePoints(std::vector<double>* points,
+                                               const size_t spaceDim) {
+    assert(points);
+    assert(spaceDim > 0);
+
+    const size_t numPoints = points->size() / spaceDim;
+    Random random;
+    for (size_t i = numPoints-1; i > 0; --i) {
+        const size_t j = random.nextIndex(i+1);
+        for (size_t iDim = 0; iDim < spaceDim; ++iDim) {
+            std::swap((*points)[i*spaceDim+iDim], (*points)[j*spaceDim+iDim]);
+        } // for
+    } // for
+} // shufflePoints
+
+
+// ------------------------------------------------------------------------------------------------
+// Report rates of reference and current implementations.
+void
+spatialdata::testing::Benchmark::reportSpeedup(const char* label,
+                                               const char* labelRef,
+                                               const char* labelCurrent,
+                                               const double numPoints,
+                                               const double secondsRef,
+                                               const double seconds) {
+    std::cout << label << ", " << labelRef << ": " << numPoints / secondsRef << " points/s, "
+              << labelCurrent << ": " << numPoints / seconds << " points/s, "
+              << "speedup: " << secondsRef / seconds << std::endl;
+} // reportSpeedup
+
+
+// ------------------------------------------------------------------------------------------------
+// Report rate.
+void
+spatialdata::testing::Benchmark::reportRate(const char* label,
+                                            const double amount,
+                                            const char* units,
+                                            const double seconds) {
+    std::cout << label << ": " << amount << " " << units << " in " << seconds << " s ("
+              << amount / seconds << " " << units << "/s)" << std::endl;
+} // reportRate
+
+
+// End of file
@@ -0,0 +1,143 @@
+// =================================================================================================
+// This code is part of SpatialData, developed through the Computational Infrastructure
+// for Geodynamics (https://github.com/geodynamics/spatialdata).
+//
+// Copyright (c) 2010-2026, University of California, Davis and the SpatialData Development Team.
+// All rights reserved.
+//
+// See https://mit-license.org/ and LICENSE.md and for license information.
+// =================================================================================================
+#pragma once
+
+#include <chrono> // HASA std::chrono::steady_clock
+#include <vector> // USES std::vector
+#include <cstddef> // USES size_t
+
+namespace spatialdata {
+    namespace testing {
+        class Benchmark;
+    } // testing
+} // spatialdata
+
+/** Utilities shared by the hidden benchmarks in the unit tests.
+ *
+ * Benchmarks are tagged `[benchmark][.]`, so they only run when selected, e.g.,
+ * `libtest_spatialdb "[benchmark]"`.
+ */
+class spatialdata::testing::Benchmark {
+    // PUBLIC CLASSES /////////////////////////////////////////////////////////////////////////////
+public:
+
+    /// Wall-clock timer.
+    class Stopwatch {
+public:
+
+        /// Constructor (starts timer).
+        Stopwatch(void);
+
+        /// Restart timer.
+        void restart(void);
+
+        /** Get time since timer was started.
+         *
+         * @returns Elapsed time in seconds.
+         */
+        double seconds(void) const;
+
+private:
+
+        std::chrono::steady_clock::time_point _start; ///< Time when timer was started.
+
+    }; // Stopwatch
+
+    /// Linear congruential generator, so benchmarks use the same numbers on every platform.
+    class Random {
+public:
+
+        /** Constructor.
+         *
+         * @param seed Seed for generator.
+         */
+        Random(const unsigned long seed=12345);
+
+        /** Get next number.
+         *
+         * @returns Number uniformly distributed in [0, 1).
+         */
+        double next(void);
+
+        /** Get next index.
+         *
+         * @param size Number of indices.
+         * @returns Index in [0, size).
+         */
+        size_t nextIndex(const size_t size);
+
+private:
+
+        unsigned long _seed; ///< Current state of generator.
+
+    }; // Random
+
+    // PUBLIC METHODS /////////////////////////////////////////////////////////////////////////////
+public:
+
+    /** Create points in a 3-D grid along lines parallel to the x axis, visited in the order grid
+     * points are stored (x varying fastest).
+     *
+     * The grid covers [0, length] along the x and y axes and [-length, 0] along the z axis, where
+     * length is spacing*(numPoints-1). Each line has 4*numPoints points.
+     *
+     * @param[out] points Array of points [numQueries*3].
+     * @param[in] numQueries Number of points.
+     * @param[in] numPoints Number of grid points along each axis.
+     * @param[in] spacing Spacing of grid points.
+     */
+    static
+    void createLinePoints(std::vector<double>* points,
+                          const size_t numQueries,
+                          const size_t numPoints,
+                          const double spacing);
+
+    /** Shuffle points into random order.
+     *
+     * @param[inout] points Array of points [numPoints*spaceDim].
+     * @param[in] spaceDim Spatial dimension of points.
+     */
+    static
+    void shufflePoints(std::vector<double>* points,
+                       const size_t spaceDim);
+
+    /** Report rates of reference and current implementations.
+     *
+     * @param label Label for benchmark.
+     * @param labelRef Label for reference implementation.
+     * @param labelCurrent Label for current implementation.
+     * @param numPoints Number of points processed.
+     * @param secondsRef Time for reference implementation.
+     * @param seconds Time for current implementation.
+     */
+    static
+    void reportSpeedup(const char* label,
+                       const char* labelRef,
+                       const char* labelCurrent,
+                       const double numPoints,
+                       const double secondsRef,
+                       const double seconds);
+
+    /** Report rate.
+     *
+     * @param label Label for benchmark.
+     * @param amount Amount processed.
+     * @param units Units of amount.
+     * @param seconds Time to process amount.
+     */
+    static
+    void reportRate(const char* label,
+                    const double amount,
+                    const char* units,
+                    const double seconds);
+
+}; // Benchmark
+
+// End of file